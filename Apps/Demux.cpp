@@ -0,0 +1,28 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "ISOBMFF/Demuxer.hpp"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <isobmff file path> <output file path> [track ID]\n";
+        return -1;
+    }
+    try
+    {
+        uint32_t trackID = (argc > 3) ? static_cast<uint32_t>(std::stoul(argv[3])) : 0;
+        ISOBMFF::Demuxer demuxer(argv[1], trackID);
+        std::cout << "track ID : " << demuxer.GetTrack().GetTrackID() << " codec : " << demuxer.GetTrack().GetCodec()
+                  << " samples : " << demuxer.GetTrack().GetSampleTable().GetSampleCount() << "\n";
+        demuxer.Demux(std::string(argv[2]));
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Demux failed : " << e.what() << "\n";
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,259 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Defragmenter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+#include "Movie.hpp"
+#include <cstdio>
+
+struct Run
+{
+    uint32_t trackID;
+    uint64_t decodeTime;
+    uint32_t sampleCount;
+};
+
+static void WriteTrack( ISOBMFF::BinaryOutputStream & stream, uint32_t trackID )
+{
+    ISOBMFF::TKHD tkhd;
+    ISOBMFF::MDHD mdhd;
+    ISOBMFF::STSD stsd;
+    size_t        trak( stream.BeginBox( "trak" ) );
+    size_t        mdia;
+    size_t        minf;
+    size_t        stbl;
+    
+    tkhd.SetTrackID( trackID );
+    tkhd.Write( stream );
+    
+    mdia = stream.BeginBox( "mdia" );
+    
+    mdhd.SetTimescale( 1000 );
+    mdhd.Write( stream );
+    
+    minf = stream.BeginBox( "minf" );
+    stbl = stream.BeginBox( "stbl" );
+    
+    stsd.Write( stream );
+    
+    stream.EndBox( stbl );
+    stream.EndBox( minf );
+    stream.EndBox( mdia );
+    stream.EndBox( trak );
+}
+
+/*
+ * Samples have a duration of 100 and a size of 4, from the TFHD defaults,
+ * and are stored in the MDAT box following the fragment.
+ */
+static void WriteFragment( ISOBMFF::BinaryOutputStream & stream, uint32_t sequence, const std::vector< Run > & runs )
+{
+    size_t                moof( stream.BeginBox( "moof" ) );
+    size_t                box;
+    size_t                mdat;
+    uint32_t              offset( 0 );
+    std::vector< size_t > dataOffsets;
+    
+    box = stream.BeginFullBox( "mfhd", 0, 0 );
+    
+    stream.WriteBigEndianUInt32( sequence );
+    stream.EndBox( box );
+    
+    for( const auto & run: runs )
+    {
+        size_t traf( stream.BeginBox( "traf" ) );
+        
+        box = stream.BeginFullBox( "tfhd", 0, 0x020018 );
+        
+        stream.WriteBigEndianUInt32( run.trackID );
+        stream.WriteBigEndianUInt32( 100 );
+        stream.WriteBigEndianUInt32( 4 );
+        stream.EndBox( box );
+        
+        box = stream.BeginFullBox( "tfdt", 1, 0 );
+        
+        stream.WriteBigEndianUInt64( run.decodeTime );
+        stream.EndBox( box );
+        
+        box = stream.BeginFullBox( "trun", 0, 0x000001 );
+        
+        stream.WriteBigEndianUInt32( run.sampleCount );
+        dataOffsets.push_back( stream.Tell() );
+        stream.WriteBigEndianUInt32( 0 );
+        stream.EndBox( box );
+        stream.EndBox( traf );
+    }
+    
+    stream.EndBox( moof );
+    
+    mdat = stream.Tell();
+    
+    for( size_t i = 0; i < runs.size(); i++ )
+    {
+        stream.Seek( static_cast< std::streamoff >( dataOffsets[ i ] ), ISOBMFF::BinaryOutputStream::SeekDirection::Begin );
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( mdat + 8 - moof ) + offset );
+        
+        offset += runs[ i ].sampleCount * 4;
+    }
+    
+    stream.Seek( 0, ISOBMFF::BinaryOutputStream::SeekDirection::End );
+    
+    box = stream.BeginBox( "mdat" );
+    
+    stream.WriteZeros( offset );
+    stream.EndBox( box );
+}
+
+/*
+ * Two tracks, the second one starting 200 after the first one, and a
+ * second fragment where the first track jumps from 400 to 600.
+ */
+static void WriteFragmentedFile( const std::string & path )
+{
+    ISOBMFF::BinaryFileOutputStream stream( path );
+    ISOBMFF::FTYP                   ftyp;
+    ISOBMFF::MVHD                   mvhd;
+    size_t                          moov;
+    size_t                          mvex;
+    
+    ftyp.SetMajorBrand( "iso6" );
+    ftyp.Write( stream );
+    
+    moov = stream.BeginBox( "moov" );
+    
+    mvhd.SetTimescale( 1000 );
+    mvhd.SetNextTrackID( 3 );
+    mvhd.Write( stream );
+    
+    WriteTrack( stream, 1 );
+    WriteTrack( stream, 2 );
+    
+    mvex = stream.BeginBox( "mvex" );
+    
+    for( uint32_t trackID = 1; trackID <= 2; trackID++ )
+    {
+        size_t trex( stream.BeginFullBox( "trex", 0, 0 ) );
+        
+        stream.WriteBigEndianUInt32( trackID );
+        stream.WriteBigEndianUInt32( 1 );
+        stream.WriteBigEndianUInt32( 0 );
+        stream.WriteBigEndianUInt32( 0 );
+        stream.WriteBigEndianUInt32( 0 );
+        stream.EndBox( trex );
+    }
+    
+    stream.EndBox( mvex );
+    stream.EndBox( moov );
+    
+    WriteFragment( stream, 1, { { 1, 0, 4 }, { 2, 200, 4 } } );
+    WriteFragment( stream, 2, { { 1, 600, 2 } } );
+}
+
+static std::shared_ptr< ISOBMFF::ContainerBox > GetTrack( const ISOBMFF::File & file, uint32_t trackID )
+{
+    std::shared_ptr< ISOBMFF::ContainerBox > moov( file.GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) );
+    
+    for( const auto & box: static_cast< const ISOBMFF::Container & >( *( moov ) ).GetBoxes( "trak" ) )
+    {
+        std::shared_ptr< ISOBMFF::ContainerBox > trak( std::dynamic_pointer_cast< ISOBMFF::ContainerBox >( box ) );
+        
+        if( trak->GetTypedBox< ISOBMFF::TKHD >( "tkhd" )->GetTrackID() == trackID )
+        {
+            return trak;
+        }
+    }
+    
+    return nullptr;
+}
+
+XSTest( ISOBMFF_Defragmenter, DecodeTimes )
+{
+    std::string     input( "ISOBMFF-Tests-Defragmenter-Input.mp4" );
+    std::string     output( "ISOBMFF-Tests-Defragmenter-Output.mp4" );
+    ISOBMFF::Parser parser;
+    
+    WriteFragmentedFile( input );
+    ISOBMFF::Defragmenter( input ).Write( output );
+    parser.Parse( output );
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+    
+    {
+        auto file( parser.GetFile() );
+        auto trak1( GetTrack( *( file ), 1 ) );
+        auto trak2( GetTrack( *( file ), 2 ) );
+        
+        XSTestAssertTrue( trak1 != nullptr );
+        XSTestAssertTrue( trak2 != nullptr );
+        
+        /* The jump from 400 to 600 extends the last sample of the first fragment */
+        {
+            auto mdia( trak1->GetTypedBox< ISOBMFF::ContainerBox >( "mdia" ) );
+            auto stbl( mdia->GetTypedBox< ISOBMFF::ContainerBox >( "minf" )->GetTypedBox< ISOBMFF::ContainerBox >( "stbl" ) );
+            auto stts( stbl->GetTypedBox< ISOBMFF::STTS >( "stts" ) );
+            
+            XSTestAssertTrue( trak1->GetBox( "edts" ) == nullptr );
+            XSTestAssertEqual( mdia->GetTypedBox< ISOBMFF::MDHD >( "mdhd" )->GetDuration(), 800U );
+            XSTestAssertEqual( stts->GetEntryCount(), 3U );
+            XSTestAssertEqual( stts->GetSampleCount( 1 ), 1U );
+            XSTestAssertEqual( stts->GetSampleOffset( 1 ), 300U );
+        }
+        
+        /* The second track starts with an empty edit */
+        {
+            auto                   edts( trak2->GetTypedBox< ISOBMFF::ContainerBox >( "edts" ) );
+            std::vector< uint8_t > elst( ( edts != nullptr ) ? edts->GetBox( "elst" )->GetData() : std::vector< uint8_t >() );
+            
+            XSTestAssertTrue( elst == std::vector< uint8_t >( {
+                0, 0, 0, 0, 0, 0, 0, 2,
+                0, 0, 0, 200, 0xFF, 0xFF, 0xFF, 0xFF, 0, 1, 0, 0,
+                0, 0, 1, 144,    0,    0,    0,    0, 0, 1, 0, 0
+            } ) );
+            XSTestAssertEqual( trak2->GetTypedBox< ISOBMFF::TKHD >( "tkhd" )->GetDuration(), 600U );
+        }
+        
+        XSTestAssertEqual( file->GetTypedBox< ISOBMFF::ContainerBox >( "moov" )->GetTypedBox< ISOBMFF::MVHD >( "mvhd" )->GetDuration(), 800U );
+    }
+}
+
+XSTest( ISOBMFF_Defragmenter, NotFragmented )
+{
+    std::string input( "ISOBMFF-Tests-Defragmenter-NotFragmented-Input.mp4" );
+    std::string output( "ISOBMFF-Tests-Defragmenter-NotFragmented-Output.mp4" );
+    
+    Movie::Write( input );
+    
+    XSTestAssertThrow( ISOBMFF::Defragmenter( input ).Write( output ), std::runtime_error );
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
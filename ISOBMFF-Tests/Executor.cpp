@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Executor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+XSTest( ISOBMFF_Executor, SerialParallelFor )
+{
+    ISOBMFF::SerialExecutor                    executor;
+    std::vector< std::pair< size_t, size_t > > chunks;
+    std::vector< std::pair< size_t, size_t > > expected( { { 3, 7 }, { 7, 11 }, { 11, 13 } } );
+    
+    executor.ParallelFor( 3, 13, 4, [ & ]( size_t begin, size_t end ) { chunks.push_back( { begin, end } ); } );
+    
+    XSTestAssertEqual( executor.GetConcurrency(), 1U );
+    XSTestAssertTrue( chunks == expected );
+}
+
+XSTest( ISOBMFF_Executor, ThreadPoolParallelFor )
+{
+    ISOBMFF::ThreadPoolExecutor       executor( 4 );
+    std::vector< std::atomic< int > > counts( 1000 );
+    
+    for( auto & count: counts )
+    {
+        count = 0;
+    }
+    
+    executor.ParallelFor( 0, counts.size(), 7, [ & ]( size_t begin, size_t end )
+    {
+        for( size_t i = begin; i < end; i++ )
+        {
+            counts[ i ]++;
+        }
+    } );
+    
+    XSTestAssertEqual( executor.GetConcurrency(), 4U );
+    
+    for( const auto & count: counts )
+    {
+        XSTestAssertEqual( count.load(), 1 );
+    }
+}
+
+XSTest( ISOBMFF_Executor, NestedParallelFor )
+{
+    ISOBMFF::ThreadPoolExecutor executor( 2 );
+    std::atomic< size_t >       total( 0 );
+    
+    /* Outer chunks block on inner loops, which must not deadlock with two workers */
+    executor.ParallelFor( 0, 8, 1, [ & ]( size_t, size_t )
+    {
+        executor.ParallelFor( 0, 100, 10, [ & ]( size_t begin, size_t end ) { total += end - begin; } );
+    } );
+    
+    XSTestAssertEqual( total.load(), 800U );
+}
+
+XSTest( ISOBMFF_Executor, ParallelForException )
+{
+    ISOBMFF::ThreadPoolExecutor executor( 4 );
+    
+    XSTestAssertThrow
+    (
+        executor.ParallelFor( 0, 100, 1, []( size_t begin, size_t ) { if( begin == 42 ) { throw std::runtime_error( "Invalid index" ); } } ),
+        std::runtime_error
+    );
+}
+
+XSTest( ISOBMFF_Executor, TaskException )
+{
+    ISOBMFF::ThreadPoolExecutor executor( 2 );
+    std::promise< void >        done;
+    
+    executor.Submit( []() { throw std::runtime_error( "Invalid task" ); } );
+    executor.Submit( [ & ]() { done.set_value(); } );
+    
+    done.get_future().wait();
+    
+    /* Both tasks may run concurrently, so wait for the first one to be recorded */
+    {
+        std::exception_ptr e;
+        
+        while( e == nullptr )
+        {
+            e = executor.TakeException();
+        }
+        
+        XSTestAssertThrow( std::rethrow_exception( e ), std::runtime_error );
+        XSTestAssertTrue( executor.TakeException() == nullptr );
+    }
+}
+
+XSTest( ISOBMFF_Executor, Default )
+{
+    auto serial( std::make_shared< ISOBMFF::SerialExecutor >() );
+    
+    XSTestAssertTrue( ISOBMFF::Executor::GetDefault() != nullptr );
+    
+    ISOBMFF::Executor::SetDefault( serial );
+    XSTestAssertTrue( ISOBMFF::Executor::GetDefault() == serial );
+    
+    ISOBMFF::Executor::SetDefault( nullptr );
+    XSTestAssertTrue( ISOBMFF::Executor::GetDefault() != serial );
+    XSTestAssertTrue( ISOBMFF::Executor::GetDefault() != nullptr );
+}
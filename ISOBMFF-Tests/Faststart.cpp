@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Faststart.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include "Movie.hpp"
+#include <cstdio>
+
+XSTest( ISOBMFF_Faststart, MoveMoov )
+{
+    std::string     input( "ISOBMFF-Tests-Faststart-Input.mp4" );
+    std::string     output( "ISOBMFF-Tests-Faststart-Output.mp4" );
+    ISOBMFF::Parser parser;
+    
+    Movie::Write( input );
+    
+    XSTestAssertFalse( ISOBMFF::Faststart( input ).IsFaststart() );
+    
+    ISOBMFF::Faststart( input ).Write( output );
+    parser.Parse( output );
+    
+    XSTestAssertTrue( ISOBMFF::Faststart( output ).IsFaststart() );
+    XSTestAssertTrue( Movie::GetTopLevelBoxes( *( parser.GetFile() ) ) == std::vector< std::string >( { "ftyp", "moov", "mdat" } ) );
+    XSTestAssertTrue( Movie::Check( output ) );
+    XSTestAssertEqual( Movie::ReadFile( output ).size(), Movie::ReadFile( input ).size() );
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+XSTest( ISOBMFF_Faststart, Unchanged )
+{
+    std::string input( "ISOBMFF-Tests-Faststart-Unchanged-Input.mp4" );
+    std::string output( "ISOBMFF-Tests-Faststart-Unchanged-Output.mp4" );
+    
+    /* A file which is already faststart is copied as-is */
+    Movie::Write( input, ISOBMFF::Muxer::Layout::MoovAtFront, ISOBMFF::Muxer::EstimateMoovSize( 2, Movie::VideoSamples + Movie::AudioSamples ) );
+    
+    XSTestAssertTrue( ISOBMFF::Faststart( input ).IsFaststart() );
+    
+    ISOBMFF::Faststart( input ).Write( output );
+    
+    XSTestAssertTrue( Movie::ReadFile( output ) == Movie::ReadFile( input ) );
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+XSTest( ISOBMFF_Faststart, ModifiedFile )
+{
+    std::string     input( "ISOBMFF-Tests-Faststart-Modified-Input.mp4" );
+    std::string     output( "ISOBMFF-Tests-Faststart-Modified-Output.mp4" );
+    ISOBMFF::Parser parser;
+    
+    Movie::Write( input );
+    parser.AddOption( ISOBMFF::Parser::Options::SkipMDATData );
+    parser.Parse( input );
+    
+    /* Boxes modified after parsing are written, with relocated chunk offsets */
+    {
+        auto file( parser.GetFile() );
+        auto mvhd( file->GetTypedBox< ISOBMFF::ContainerBox >( "moov" )->GetTypedBox< ISOBMFF::MVHD >( "mvhd" ) );
+        
+        mvhd->SetNextTrackID( 42 );
+        ISOBMFF::Faststart( file, input ).Write( output );
+    }
+    
+    parser.Parse( output );
+    
+    XSTestAssertTrue( Movie::Check( output ) );
+    XSTestAssertEqual( parser.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" )->GetTypedBox< ISOBMFF::MVHD >( "mvhd" )->GetNextTrackID(), 42U );
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Fragmenter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include "Movie.hpp"
+#include <cstdio>
+
+struct Fragment
+{
+    uint32_t trackID;
+    uint64_t decodeTime;
+    uint32_t sampleCount;
+};
+
+static std::vector< Fragment > GetFragments( const ISOBMFF::File & file )
+{
+    std::vector< Fragment > fragments;
+    
+    for( const auto & box: static_cast< const ISOBMFF::Container & >( file ).GetBoxes( "moof" ) )
+    {
+        auto moof( std::dynamic_pointer_cast< ISOBMFF::ContainerBox >( box ) );
+        
+        for( const auto & traf: static_cast< const ISOBMFF::Container & >( *( moof ) ).GetBoxes( "traf" ) )
+        {
+            auto container( std::dynamic_pointer_cast< ISOBMFF::ContainerBox >( traf ) );
+            
+            fragments.push_back
+            (
+                {
+                    container->GetTypedBox< ISOBMFF::TFHD >( "tfhd" )->GetTrackID(),
+                    container->GetTypedBox< ISOBMFF::TFDT >( "tfdt" )->GetBaseMediaDecodeTime(),
+                    container->GetTypedBox< ISOBMFF::TRUN >( "trun" )->GetSampleCount()
+                }
+            );
+        }
+    }
+    
+    return fragments;
+}
+
+XSTest( ISOBMFF_Fragmenter, Fragments )
+{
+    std::string     input( "ISOBMFF-Tests-Fragmenter-Input.mp4" );
+    std::string     output( "ISOBMFF-Tests-Fragmenter-Output.mp4" );
+    ISOBMFF::Parser parser;
+    
+    Movie::Write( input );
+    
+    {
+        ISOBMFF::Fragmenter fragmenter( input, 1000 );
+        
+        XSTestAssertEqual( fragmenter.GetFragmentCount(), 6U );
+        
+        fragmenter.Write( output );
+    }
+    
+    parser.Parse( output );
+    
+    {
+        auto                    file( parser.GetFile() );
+        auto                    moov( file->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) );
+        std::vector< Fragment > fragments( GetFragments( *( file ) ) );
+        
+        XSTestAssertEqual( Movie::GetTopLevelBoxes( *( file ) ).front(), "ftyp" );
+        XSTestAssertTrue( moov->GetBox( "mvex" ) != nullptr );
+        XSTestAssertEqual( static_cast< const ISOBMFF::Container & >( *( moov->GetTypedBox< ISOBMFF::ContainerBox >( "mvex" ) ) ).GetBoxes( "trex" ).size(), 2U );
+        
+        for( const auto & track: ISOBMFF::Track::GetTracks( *( moov ) ) )
+        {
+            XSTestAssertEqual( track.GetSampleTable().GetSampleCount(), 0U );
+        }
+        
+        /* One fragment per second and per track, in decoding order */
+        XSTestAssertEqual( fragments.size(), 6U );
+        
+        for( size_t i = 0; i < fragments.size(); i++ )
+        {
+            uint32_t trackID( static_cast< uint32_t >( i % 2 + 1 ) );
+            
+            XSTestAssertEqual( fragments[ i ].trackID,     trackID );
+            XSTestAssertEqual( fragments[ i ].decodeTime,  ( i / 2 ) * ( ( trackID == 1 ) ? 1000U : 48000U ) );
+            XSTestAssertEqual( fragments[ i ].sampleCount, ( trackID == 1 ) ? 10U : 50U );
+        }
+    }
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+XSTest( ISOBMFF_Fragmenter, Defragment )
+{
+    std::string input( "ISOBMFF-Tests-Fragmenter-Defragment-Input.mp4" );
+    std::string fragmented( "ISOBMFF-Tests-Fragmenter-Defragment-Fragmented.mp4" );
+    std::string output( "ISOBMFF-Tests-Fragmenter-Defragment-Output.mp4" );
+    
+    Movie::Write( input );
+    ISOBMFF::Fragmenter( input ).Write( fragmented );
+    ISOBMFF::Defragmenter( fragmented ).Write( output );
+    
+    XSTestAssertTrue( Movie::Check( output ) );
+    
+    std::remove( input.c_str() );
+    std::remove( fragmented.c_str() );
+    std::remove( output.c_str() );
+}
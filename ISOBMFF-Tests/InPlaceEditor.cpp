@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        InPlaceEditor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include "Movie.hpp"
+#include <cstdio>
+#include <map>
+
+static std::string GetExampleFile( const std::string & name )
+{
+    std::string path( __FILE__ );
+    
+    return path.substr( 0, path.find_last_of( "/\\" ) + 1 ) + "../Example-Files/" + name;
+}
+
+static void CopyFile( const std::string & from, const std::string & to )
+{
+    std::ifstream input( from, std::ios::binary );
+    std::ofstream output( to, std::ios::binary );
+    
+    output << input.rdbuf();
+}
+
+static std::shared_ptr< ISOBMFF::Box > CreateBox( const std::string & name, size_t size )
+{
+    ISOBMFF::Parser           parser;
+    ISOBMFF::BinaryDataStream stream( std::vector< uint8_t >( size, 0x42 ) );
+    auto                      box( std::make_shared< ISOBMFF::Box >( name ) );
+    
+    box->ReadData( parser, stream );
+    
+    return box;
+}
+
+static uint64_t GetFreeSpace( const ISOBMFF::File & file )
+{
+    uint64_t size( 0 );
+    
+    for( const auto & box: static_cast< const ISOBMFF::Container & >( file ).GetBoxes( "free" ) )
+    {
+        size += box->GetSize();
+    }
+    
+    return size;
+}
+
+static uint64_t GetItemOffset( const ISOBMFF::META & meta )
+{
+    ISOBMFF::ItemReader reader( meta );
+    
+    return reader.GetRanges( meta.GetTypedBox< ISOBMFF::ILOC >( "iloc" )->GetItems().front()->GetItemID() ).front().offset;
+}
+
+static std::map< uint32_t, std::vector< uint8_t > > ReadItems( const std::string & path )
+{
+    ISOBMFF::Parser                              parser;
+    ISOBMFF::BinaryFileStream                    stream( path );
+    std::map< uint32_t, std::vector< uint8_t > > items;
+    
+    parser.AddOption( ISOBMFF::Parser::Options::SkipMDATData );
+    parser.Parse( path );
+    
+    {
+        auto                meta( parser.GetFile()->GetTypedBox< ISOBMFF::META >( "meta" ) );
+        ISOBMFF::ItemReader reader( *( meta ) );
+        
+        for( const auto & item: meta->GetTypedBox< ISOBMFF::ILOC >( "iloc" )->GetItems() )
+        {
+            items[ item->GetItemID() ] = reader.ReadItem( item->GetItemID(), stream );
+        }
+    }
+    
+    return items;
+}
+
+XSTest( ISOBMFF_InPlaceEditor, ReplaceInPlace )
+{
+    std::string path( "ISOBMFF-Tests-InPlaceEditor-ReplaceInPlace.mp4" );
+    size_t      size;
+    
+    Movie::Write( path, ISOBMFF::Muxer::Layout::MoovAtFront, ISOBMFF::Muxer::EstimateMoovSize( 2, Movie::VideoSamples + Movie::AudioSamples ) );
+    
+    size = Movie::ReadFile( path ).size();
+    
+    {
+        ISOBMFF::InPlaceEditor editor( path );
+        auto                   moov( editor.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) );
+        
+        moov->AddBox( CreateBox( "udta", 100 ) );
+        
+        XSTestAssertTrue( editor.CanReplaceInPlace( moov, *( moov ) ) );
+        XSTestAssertTrue( editor.Replace( moov, moov ) );
+        XSTestAssertTrue( editor.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" )->GetBox( "udta" ) != nullptr );
+    }
+    
+    XSTestAssertEqual( Movie::ReadFile( path ).size(), size );
+    XSTestAssertTrue( Movie::Check( path ) );
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_InPlaceEditor, GrowAtEnd )
+{
+    std::string path( "ISOBMFF-Tests-InPlaceEditor-GrowAtEnd.mp4" );
+    size_t      size;
+    
+    Movie::Write( path );
+    
+    size = Movie::ReadFile( path ).size();
+    
+    {
+        ISOBMFF::InPlaceEditor editor( path );
+        auto                   moov( editor.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) );
+        
+        moov->AddBox( CreateBox( "udta", 1000 ) );
+        
+        XSTestAssertTrue( editor.Replace( moov, moov ) );
+    }
+    
+    XSTestAssertEqual( Movie::ReadFile( path ).size(), size + 1008 );
+    XSTestAssertTrue( Movie::Check( path ) );
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_InPlaceEditor, Rewrite )
+{
+    std::string path( "ISOBMFF-Tests-InPlaceEditor-Rewrite.mp4" );
+    
+    Movie::Write( path, ISOBMFF::Muxer::Layout::MoovAtFront, ISOBMFF::Muxer::EstimateMoovSize( 2, Movie::VideoSamples + Movie::AudioSamples ) );
+    
+    /* The MOOV box outgrows the reserved space, so the MDAT box and the chunk offsets move */
+    {
+        ISOBMFF::InPlaceEditor editor( path );
+        auto                   moov( editor.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) );
+        
+        moov->AddBox( CreateBox( "udta", static_cast< size_t >( GetFreeSpace( *( editor.GetFile() ) ) ) + 1000 ) );
+        
+        XSTestAssertFalse( editor.CanReplaceInPlace( moov, *( moov ) ) );
+        XSTestAssertFalse( editor.Replace( moov, moov ) );
+        XSTestAssertTrue( Movie::GetTopLevelBoxes( *( editor.GetFile() ) ) == std::vector< std::string >( { "ftyp", "moov", "free", "mdat" } ) );
+    }
+    
+    XSTestAssertTrue( Movie::Check( path ) );
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_InPlaceEditor, RelocateItems )
+{
+    for( const std::string & name: std::vector< std::string >( { "IMG1.HEIC", "IMG2.HEIC" } ) )
+    {
+        std::string                                  path( "ISOBMFF-Tests-InPlaceEditor-" + name );
+        std::map< uint32_t, std::vector< uint8_t > > items;
+        uint64_t                                     offset;
+        
+        CopyFile( GetExampleFile( name ), path );
+        
+        items = ReadItems( path );
+        
+        XSTestAssertFalse( items.empty() );
+        
+        /* The META box grows, so the item data in the MDAT box moves */
+        {
+            ISOBMFF::InPlaceEditor editor( path );
+            auto                   meta( editor.GetFile()->GetTypedBox< ISOBMFF::META >( "meta" ) );
+            
+            offset = GetItemOffset( *( meta ) );
+            
+            meta->AddBox( CreateBox( "udta", 4096 ) );
+            
+            XSTestAssertFalse( editor.Replace( meta, meta ) );
+            
+            meta = editor.GetFile()->GetTypedBox< ISOBMFF::META >( "meta" );
+            
+            XSTestAssertEqual( GetItemOffset( *( meta ) ), offset + 4104 );
+        }
+        
+        XSTestAssertTrue( ReadItems( path ) == items );
+        
+        std::remove( path.c_str() );
+    }
+}
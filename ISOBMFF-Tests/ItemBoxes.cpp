@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ItemBoxes.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+static std::vector< uint8_t > WriteBoxes( const std::vector< std::shared_ptr< ISOBMFF::Box > > & boxes )
+{
+    ISOBMFF::BinaryDataOutputStream stream;
+    
+    for( const auto & box: boxes )
+    {
+        box->Write( stream );
+    }
+    
+    return stream.TakeData();
+}
+
+static std::shared_ptr< ISOBMFF::File > ParseBoxes( const std::vector< uint8_t > & data )
+{
+    ISOBMFF::Parser parser;
+    
+    parser.Parse( data );
+    
+    return parser.GetFile();
+}
+
+static std::vector< uint8_t > CreateItemBoxes()
+{
+    auto ftyp   = std::make_shared< ISOBMFF::FTYP >();
+    auto iloc   = std::make_shared< ISOBMFF::ILOC >();
+    auto item   = std::make_shared< ISOBMFF::ILOC::Item >();
+    auto extent = std::make_shared< ISOBMFF::ILOC::Item::Extent >();
+    auto ipma   = std::make_shared< ISOBMFF::IPMA >();
+    auto entry  = std::make_shared< ISOBMFF::IPMA::Entry >();
+    auto assoc  = std::make_shared< ISOBMFF::IPMA::Entry::Association >();
+    auto iref   = std::make_shared< ISOBMFF::IREF >();
+    auto dimg   = std::make_shared< ISOBMFF::DIMG >();
+    
+    ftyp->SetMajorBrand( "heic" );
+    
+    iloc->SetOffsetSize( 4 );
+    iloc->SetLengthSize( 4 );
+    extent->SetOffset( 100 );
+    extent->SetLength( 10 );
+    item->SetItemID( 1 );
+    item->AddExtent( extent );
+    iloc->AddItem( item );
+    
+    assoc->SetPropertyIndex( 1 );
+    entry->SetItemID( 1 );
+    entry->AddAssociation( assoc );
+    ipma->AddEntry( entry );
+    
+    dimg->SetFromItemID( 1 );
+    dimg->AddToItemID( 2 );
+    iref->AddBox( dimg );
+    
+    return WriteBoxes( { ftyp, iloc, ipma, iref } );
+}
+
+XSTest( ISOBMFF_ItemBoxes, WriteUnchanged )
+{
+    std::vector< uint8_t > data( CreateItemBoxes() );
+    auto                   file( ParseBoxes( data ) );
+    
+    XSTestAssertTrue( WriteBoxes( file->GetBoxes() ) == data );
+}
+
+XSTest( ISOBMFF_ItemBoxes, WriteEdited )
+{
+    auto file( ParseBoxes( CreateItemBoxes() ) );
+    auto iloc( file->GetTypedBox< ISOBMFF::ILOC >( "iloc" ) );
+    auto ipma( file->GetTypedBox< ISOBMFF::IPMA >( "ipma" ) );
+    auto iref( file->GetTypedBox< ISOBMFF::IREF >( "iref" ) );
+    
+    XSTestAssertTrue( iloc != nullptr );
+    XSTestAssertTrue( ipma != nullptr );
+    XSTestAssertTrue( iref != nullptr );
+    
+    iloc->GetItemAtIndex( 0 )->SetItemID( 999 );
+    iloc->GetItemAtIndex( 0 )->GetExtents()[ 0 ]->SetOffset( 12345 );
+    ipma->GetEntries()[ 0 ]->SetItemID( 777 );
+    iref->GetTypedBox< ISOBMFF::DIMG >( "dimg" )->SetFromItemID( 555 );
+    
+    file = ParseBoxes( WriteBoxes( file->GetBoxes() ) );
+    iloc = file->GetTypedBox< ISOBMFF::ILOC >( "iloc" );
+    ipma = file->GetTypedBox< ISOBMFF::IPMA >( "ipma" );
+    iref = file->GetTypedBox< ISOBMFF::IREF >( "iref" );
+    
+    XSTestAssertEqual( iloc->GetTable().itemIDs[ 0 ], 999U );
+    XSTestAssertEqual( iloc->GetTable().extentOffsets[ 0 ], 12345U );
+    XSTestAssertEqual( iloc->GetItem( 999 )->GetExtents()[ 0 ]->GetLength(), 10U );
+    XSTestAssertEqual( ipma->GetTable().itemIDs[ 0 ], 777U );
+    XSTestAssertEqual( ipma->GetTable().propertyIndices[ 0 ], 1U );
+    XSTestAssertEqual( iref->GetTable().fromItemIDs[ 0 ], 555U );
+    XSTestAssertEqual( iref->GetTable().toItemIDs[ 0 ], 2U );
+}
+
+XSTest( ISOBMFF_ItemBoxes, TableMatchesObjects )
+{
+    auto file( ParseBoxes( CreateItemBoxes() ) );
+    auto iloc( file->GetTypedBox< ISOBMFF::ILOC >( "iloc" ) );
+    auto ipma( file->GetTypedBox< ISOBMFF::IPMA >( "ipma" ) );
+    auto iref( file->GetTypedBox< ISOBMFF::IREF >( "iref" ) );
+    
+    const uint32_t * ids( iloc->GetTable().itemIDs.data() );
+    
+    /* Lookups do not rebuild the table */
+    XSTestAssertTrue( iloc->GetItem( 1 ) != nullptr );
+    XSTestAssertTrue( iloc->GetItem( 2 ) == nullptr );
+    XSTestAssertTrue( iloc->GetTable().itemIDs.data() == ids );
+    XSTestAssertTrue( ipma->GetEntry( 1 ) != nullptr );
+    
+    iloc->GetItem( 1 )->GetExtents()[ 0 ]->SetLength( 20 );
+    ipma->GetEntry( 1 )->GetAssociations()[ 0 ]->SetEssential( true );
+    iref->GetTypedBox< ISOBMFF::DIMG >( "dimg" )->AddToItemID( 3 );
+    
+    XSTestAssertEqual( iloc->GetTable().extentLengths[ 0 ], 20U );
+    XSTestAssertEqual( ipma->GetTable().essentials[ 0 ], 1U );
+    XSTestAssertEqual( iref->GetTable().toItemIDs.size(), 2U );
+    XSTestAssertEqual( iref->GetTable().toItemIDs[ 1 ], 3U );
+    
+    {
+        auto item( std::make_shared< ISOBMFF::ILOC::Item >() );
+        
+        item->SetItemID( 2 );
+        iloc->AddItem( item );
+        item->SetBaseOffset( 64 );
+        
+        XSTestAssertEqual( iloc->GetTable().itemIDs.size(), 2U );
+        XSTestAssertEqual( iloc->GetTable().baseOffsets[ 1 ], 64U );
+        XSTestAssertTrue( iloc->GetItem( 2 ) == item );
+    }
+}
+
+XSTest( ISOBMFF_ItemBoxes, CopiesAreIndependent )
+{
+    auto          file( ParseBoxes( CreateItemBoxes() ) );
+    auto          iloc( file->GetTypedBox< ISOBMFF::ILOC >( "iloc" ) );
+    auto          ipma( file->GetTypedBox< ISOBMFF::IPMA >( "ipma" ) );
+    auto          iref( file->GetTypedBox< ISOBMFF::IREF >( "iref" ) );
+    ISOBMFF::ILOC ilocCopy;
+    ISOBMFF::IPMA ipmaCopy;
+    ISOBMFF::IREF irefCopy;
+    
+    iloc->GetItem( 1 )->SetBaseOffset( 8 );
+    ipma->GetEntry( 1 )->SetItemID( 5 );
+    iref->GetTypedBox< ISOBMFF::DIMG >( "dimg" )->SetFromItemID( 6 );
+    
+    ilocCopy = *( iloc );
+    ipmaCopy = *( ipma );
+    irefCopy = *( iref );
+    
+    XSTestAssertEqual( ilocCopy.GetTable().baseOffsets[ 0 ], 8U );
+    XSTestAssertEqual( ipmaCopy.GetTable().itemIDs[ 0 ], 5U );
+    XSTestAssertEqual( irefCopy.GetTable().fromItemIDs[ 0 ], 6U );
+    
+    ilocCopy.GetItem( 1 )->SetBaseOffset( 16 );
+    ipmaCopy.GetEntry( 5 )->SetItemID( 7 );
+    irefCopy.GetTypedBox< ISOBMFF::DIMG >( "dimg" )->SetFromItemID( 9 );
+    
+    XSTestAssertEqual( ilocCopy.GetTable().baseOffsets[ 0 ], 16U );
+    XSTestAssertEqual( iloc->GetTable().baseOffsets[ 0 ], 8U );
+    XSTestAssertEqual( ipmaCopy.GetTable().itemIDs[ 0 ], 7U );
+    XSTestAssertEqual( ipma->GetTable().itemIDs[ 0 ], 5U );
+    XSTestAssertEqual( irefCopy.GetTable().fromItemIDs[ 0 ], 9U );
+    XSTestAssertEqual( iref->GetTable().fromItemIDs[ 0 ], 6U );
+}
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Movie.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ * @discussion  Synthetic movie shared by the tests of the writers.
+ *              The movie has a video track of 30 samples of 100 at a
+ *              timescale of 1000, with a sync sample every 10 samples
+ *              and alternating composition offsets, and an audio track
+ *              of 150 samples of 960 at a timescale of 48000.
+ *              Each sample has distinct contents, so the sample tables
+ *              of a file can be checked against its sample data.
+ */
+
+#ifndef ISOBMFF_TESTS_MOVIE_HPP
+#define ISOBMFF_TESTS_MOVIE_HPP
+
+#include <ISOBMFF.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace Movie
+{
+    static const size_t VideoSamples = 30;
+    static const size_t AudioSamples = 150;
+    
+    inline std::vector< uint8_t > GetSampleData( uint32_t trackID, size_t sample )
+    {
+        std::vector< uint8_t > data( 16 + sample % 7 );
+        
+        for( size_t i = 0; i < data.size(); i++ )
+        {
+            data[ i ] = static_cast< uint8_t >( trackID * 64 + sample + i );
+        }
+        
+        return data;
+    }
+    
+    inline uint32_t GetSampleDuration( uint32_t trackID )
+    {
+        return ( trackID == 1 ) ? 100 : 960;
+    }
+    
+    inline int32_t GetCompositionOffset( uint32_t trackID, size_t sample )
+    {
+        return ( trackID == 1 && sample % 2 == 1 ) ? 200 : 0;
+    }
+    
+    inline bool IsSyncSample( uint32_t trackID, size_t sample )
+    {
+        return trackID != 1 || sample % 10 == 0;
+    }
+    
+    inline std::vector< uint8_t > ReadFile( const std::string & path )
+    {
+        std::ifstream stream( path, std::ios::binary );
+        
+        return std::vector< uint8_t >( std::istreambuf_iterator< char >( stream ), std::istreambuf_iterator< char >() );
+    }
+    
+    inline std::vector< std::string > GetTopLevelBoxes( const ISOBMFF::File & file )
+    {
+        std::vector< std::string > names;
+        
+        for( const auto & box: file.GetBoxes() )
+        {
+            names.push_back( box->GetName() );
+        }
+        
+        return names;
+    }
+    
+    inline void Write( const std::string & path, ISOBMFF::Muxer::Layout layout = ISOBMFF::Muxer::Layout::MoovAtEnd, uint64_t reservedSize = 0, size_t maxChunkSize = ISOBMFF::Muxer::DefaultMaxChunkSize )
+    {
+        ISOBMFF::BinaryFileOutputStream stream( path );
+        ISOBMFF::Muxer                  muxer( stream, layout, reservedSize );
+        ISOBMFF::BinaryDataOutputStream video;
+        ISOBMFF::BinaryDataOutputStream audio;
+        size_t                          box;
+        
+        /* VisualSampleEntry, 320x240 */
+        box = video.BeginBox( "avc1" );
+        
+        video.WriteZeros( 6 );
+        video.WriteBigEndianUInt16( 1 );
+        video.WriteZeros( 16 );
+        video.WriteBigEndianUInt16( 320 );
+        video.WriteBigEndianUInt16( 240 );
+        video.WriteBigEndianUInt32( 0x00480000 );
+        video.WriteBigEndianUInt32( 0x00480000 );
+        video.WriteZeros( 4 );
+        video.WriteBigEndianUInt16( 1 );
+        video.WriteZeros( 32 );
+        video.WriteBigEndianUInt16( 0x18 );
+        video.WriteBigEndianUInt16( 0xFFFF );
+        video.EndBox( box );
+        
+        /* AudioSampleEntry, 2 channels of 16 bits at 48000 Hz */
+        box = audio.BeginBox( "mp4a" );
+        
+        audio.WriteZeros( 6 );
+        audio.WriteBigEndianUInt16( 1 );
+        audio.WriteZeros( 8 );
+        audio.WriteBigEndianUInt16( 2 );
+        audio.WriteBigEndianUInt16( 16 );
+        audio.WriteZeros( 4 );
+        audio.WriteBigEndianUInt32( 48000 << 16 );
+        audio.EndBox( box );
+        
+        muxer.SetMaxChunkSize( maxChunkSize );
+        muxer.AddTrack( "vide", 1000,  video.GetData() );
+        muxer.AddTrack( "soun", 48000, audio.GetData() );
+        
+        for( size_t i = 0; i < VideoSamples; i++ )
+        {
+            muxer.WriteSample( 1, GetSampleData( 1, i ), GetSampleDuration( 1 ), GetCompositionOffset( 1, i ), IsSyncSample( 1, i ) );
+            
+            for( size_t j = i * 5; j < i * 5 + 5; j++ )
+            {
+                muxer.WriteSample( 2, GetSampleData( 2, j ), GetSampleDuration( 2 ), GetCompositionOffset( 2, j ), IsSyncSample( 2, j ) );
+            }
+        }
+        
+        muxer.Finish();
+    }
+    
+    /*!
+     * @function    Check
+     * @abstract    Checks that a file holds the samples of the movie.
+     * @param       path    The file path.
+     * @param       first   The first video sample expected in the file.
+     * @param       count   The number of video samples expected in the file.
+     * @result      true if the samples, their timing and sync flags match.
+     * @discussion  Audio samples are expected for the same time range.
+     */
+    inline bool Check( const std::string & path, size_t first = 0, size_t count = VideoSamples )
+    {
+        ISOBMFF::Parser        parser;
+        std::vector< uint8_t > data( ReadFile( path ) );
+        
+        parser.AddOption( ISOBMFF::Parser::Options::SkipMDATData );
+        parser.Parse( path );
+        
+        {
+            auto tracks( ISOBMFF::Track::GetTracks( *( parser.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) ) ) );
+            
+            if( tracks.size() != 2 )
+            {
+                return false;
+            }
+            
+            for( const auto & track: tracks )
+            {
+                uint32_t                     trackID( track.GetTrackID() );
+                size_t                       offset( ( trackID == 1 ) ? first : first * 5 );
+                const ISOBMFF::SampleTable & table( track.GetSampleTable() );
+                
+                if( table.GetSampleCount() != ( ( trackID == 1 ) ? count : count * 5 ) )
+                {
+                    return false;
+                }
+                
+                for( size_t i = 0; i < table.GetSampleCount(); i++ )
+                {
+                    std::vector< uint8_t > sample( GetSampleData( trackID, offset + i ) );
+                    uint64_t               position( table.GetSampleOffset( i ) );
+                    
+                    if
+                    (
+                           table.GetSampleSize( i )             != sample.size()
+                        || position + sample.size()             >  data.size()
+                        || table.GetSampleDuration( i )         != GetSampleDuration( trackID )
+                        || table.GetCompositionOffset( i )      != GetCompositionOffset( trackID, offset + i )
+                        || table.IsSyncSample( i )              != IsSyncSample( trackID, offset + i )
+                        || std::equal( sample.begin(), sample.end(), data.begin() + static_cast< std::ptrdiff_t >( position ) ) == false
+                    )
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        
+        return true;
+    }
+}
+
+#endif /* ISOBMFF_TESTS_MOVIE_HPP */
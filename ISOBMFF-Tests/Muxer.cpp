@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Muxer.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include "Movie.hpp"
+#include <cstdio>
+
+XSTest( ISOBMFF_Muxer, MoovAtEnd )
+{
+    std::string     path( "ISOBMFF-Tests-Muxer-MoovAtEnd.mp4" );
+    ISOBMFF::Parser parser;
+    
+    Movie::Write( path );
+    parser.Parse( path );
+    
+    XSTestAssertTrue( Movie::Check( path ) );
+    XSTestAssertTrue( Movie::GetTopLevelBoxes( *( parser.GetFile() ) ) == std::vector< std::string >( { "ftyp", "mdat", "moov" } ) );
+    
+    {
+        auto moov( parser.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) );
+        auto tracks( ISOBMFF::Track::GetTracks( *( moov ) ) );
+        auto tkhd( tracks[ 0 ].GetTRAK()->GetTypedBox< ISOBMFF::TKHD >( "tkhd" ) );
+        
+        XSTestAssertEqual( tracks[ 0 ].GetHandlerType(), "vide" );
+        XSTestAssertEqual( tracks[ 0 ].GetTimescale(),   1000U );
+        XSTestAssertEqual( tracks[ 0 ].GetDuration(),    3000U );
+        XSTestAssertEqual( tracks[ 1 ].GetHandlerType(), "soun" );
+        XSTestAssertEqual( tracks[ 1 ].GetTimescale(),   48000U );
+        XSTestAssertEqual( tracks[ 1 ].GetDuration(),    144000U );
+        XSTestAssertEqual( tkhd->GetWidth(),             320.0f );
+        XSTestAssertEqual( tkhd->GetHeight(),            240.0f );
+        XSTestAssertEqual( moov->GetTypedBox< ISOBMFF::MVHD >( "mvhd" )->GetNextTrackID(), 3U );
+    }
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_Muxer, MoovAtFront )
+{
+    std::string     path( "ISOBMFF-Tests-Muxer-MoovAtFront.mp4" );
+    ISOBMFF::Parser parser;
+    
+    Movie::Write( path, ISOBMFF::Muxer::Layout::MoovAtFront, ISOBMFF::Muxer::EstimateMoovSize( 2, Movie::VideoSamples + Movie::AudioSamples ) );
+    parser.Parse( path );
+    
+    XSTestAssertTrue( Movie::Check( path ) );
+    
+    {
+        std::vector< std::string > boxes( Movie::GetTopLevelBoxes( *( parser.GetFile() ) ) );
+        
+        XSTestAssertEqual( boxes.front(), "ftyp" );
+        XSTestAssertEqual( boxes[ 1 ],    "moov" );
+        XSTestAssertEqual( boxes.back(),  "mdat" );
+    }
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_Muxer, ReservedSpaceTooSmall )
+{
+    std::string     path( "ISOBMFF-Tests-Muxer-ReservedSpaceTooSmall.mp4" );
+    ISOBMFF::Parser parser;
+    
+    /* The MOOV box is moved to the end, and the reserved space is left as a FREE box */
+    Movie::Write( path, ISOBMFF::Muxer::Layout::MoovAtFront, 100 );
+    parser.Parse( path );
+    
+    XSTestAssertTrue( Movie::Check( path ) );
+    XSTestAssertTrue( Movie::GetTopLevelBoxes( *( parser.GetFile() ) ) == std::vector< std::string >( { "ftyp", "free", "mdat", "moov" } ) );
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_Muxer, MaxChunkSize )
+{
+    std::string     path( "ISOBMFF-Tests-Muxer-MaxChunkSize.mp4" );
+    ISOBMFF::Parser parser;
+    
+    Movie::Write( path, ISOBMFF::Muxer::Layout::MoovAtEnd, 0, 64 );
+    parser.Parse( path );
+    
+    XSTestAssertTrue( Movie::Check( path ) );
+    
+    for( const auto & track: ISOBMFF::Track::GetTracks( *( parser.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) ) ) )
+    {
+        const ISOBMFF::SampleTable & table( track.GetSampleTable() );
+        
+        XSTestAssertTrue( table.GetChunkCount() > 1 );
+        
+        for( size_t i = 0; i < table.GetChunkCount(); i++ )
+        {
+            size_t   first( table.GetChunkFirstSample( i ) );
+            uint64_t size( 0 );
+            
+            for( size_t j = first; j < first + table.GetChunkSampleCount( i ); j++ )
+            {
+                size += table.GetSampleSize( j );
+            }
+            
+            XSTestAssertTrue( size <= 64 || table.GetChunkSampleCount( i ) == 1 );
+        }
+    }
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_Muxer, InvalidSamples )
+{
+    ISOBMFF::BinaryDataOutputStream stream;
+    ISOBMFF::Muxer                  muxer( stream );
+    std::vector< uint8_t >          entry( { 0, 0, 0, 8, 'a', 'v', 'c', '1' } );
+    std::vector< uint8_t >          sample( 4 );
+    
+    /* The sample entry size must match the box header */
+    XSTestAssertThrow( muxer.AddTrack( "vide", 1000, std::vector< uint8_t >( { 0, 0, 0, 9, 'a', 'v', 'c', '1' } ) ), std::runtime_error );
+    
+    muxer.AddTrack( "vide", 1000, entry );
+    
+    XSTestAssertThrow( muxer.WriteSample( 2, sample, 100, 0, true ), std::runtime_error );
+    
+    muxer.WriteSample( 1, sample, 100, 0, true );
+    muxer.Finish();
+    
+    XSTestAssertThrow( muxer.WriteSample( 1, sample, 100, 0, true ), std::runtime_error );
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ParameterSets.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include <stdexcept>
+
+/* H.264 baseline SPS, 1280x720 at 25 frames per second, with an emulation prevention byte */
+static const uint8_t AVCSPS[] =
+{
+    0x67, 0x42, 0xC0, 0x1F, 0xDA, 0x01, 0x40, 0x16, 0xEC, 0x04, 0x40, 0x00, 0x00, 0x03, 0x00, 0x40,
+    0x00, 0x00, 0x0C, 0x83, 0xC6, 0x0C, 0xA8
+};
+
+static const uint8_t AVCPPS[] =
+{
+    0x68, 0xCE, 0x3C, 0x80
+};
+
+/* HVCC box of a 512x512 H.265 main still picture, with one VPS, SPS and PPS */
+static const uint8_t HVCC[] =
+{
+    0x00, 0x00, 0x00, 0x70, 0x68, 0x76, 0x63, 0x43, 0x01, 0x03, 0x70, 0x00, 0x00, 0x00, 0xB0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x5A, 0xF0, 0x00, 0xFC, 0xFD, 0xF8, 0xF8, 0x00, 0x00, 0x0B, 0x03, 0xA0,
+    0x00, 0x01, 0x00, 0x17, 0x40, 0x01, 0x0C, 0x01, 0xFF, 0xFF, 0x03, 0x70, 0x00, 0x00, 0x03, 0x00,
+    0xB0, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x5A, 0x70, 0x24, 0xA1, 0x00, 0x01, 0x00, 0x22,
+    0x42, 0x01, 0x01, 0x03, 0x70, 0x00, 0x00, 0x03, 0x00, 0xB0, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03,
+    0x00, 0x5A, 0xA0, 0x04, 0x02, 0x00, 0x80, 0x58, 0x87, 0xB9, 0x16, 0x55, 0x37, 0x02, 0x02, 0x02,
+    0xA4, 0x02, 0xA2, 0x00, 0x01, 0x00, 0x09, 0x44, 0x01, 0xC0, 0x61, 0x72, 0xC8, 0x40, 0x53, 0x24
+};
+
+static ISOBMFF::Span< const uint8_t > HEVCVPS( HVCC + 0x24, 0x17 );
+static ISOBMFF::Span< const uint8_t > HEVCSPS( HVCC + 0x40, 0x22 );
+static ISOBMFF::Span< const uint8_t > HEVCPPS( HVCC + 0x67, 0x09 );
+
+XSTest( ISOBMFF_ParameterSets, RBSP )
+{
+    std::vector< uint8_t > nal( { 0x25, 0x00, 0x00, 0x03, 0x01, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00 } );
+    std::vector< uint8_t > rbsp( { 0x25, 0x00, 0x00, 0x01, 0x00, 0x00, 0x03, 0x00, 0x00 } );
+    std::vector< uint8_t > buffer( 4 );
+    
+    XSTestAssertTrue( ISOBMFF::RBSP::Extract( nal ) == rbsp );
+    XSTestAssertThrow( ISOBMFF::RBSP::Extract( nal, buffer ), std::runtime_error );
+}
+
+XSTest( ISOBMFF_ParameterSets, AVC )
+{
+    ISOBMFF::SequenceParameterSet sps( ISOBMFF::SequenceParameterSet::ReadAVC( ISOBMFF::Span< const uint8_t >( AVCSPS, sizeof( AVCSPS ) ) ) );
+    ISOBMFF::PictureParameterSet  pps( ISOBMFF::PictureParameterSet::ReadAVC( ISOBMFF::Span< const uint8_t >( AVCPPS, sizeof( AVCPPS ) ) ) );
+    
+    XSTestAssertEqual( sps.id,             0 );
+    XSTestAssertEqual( sps.profileIDC,     66 );
+    XSTestAssertEqual( sps.levelIDC,       31 );
+    XSTestAssertEqual( sps.chromaFormat,   1 );
+    XSTestAssertEqual( sps.bitDepthLuma,   8 );
+    XSTestAssertEqual( sps.bitDepthChroma, 8 );
+    XSTestAssertEqual( sps.width,          1280U );
+    XSTestAssertEqual( sps.height,         720U );
+    XSTestAssertEqual( sps.codedWidth,     1280U );
+    XSTestAssertEqual( sps.codedHeight,    720U );
+    XSTestAssertTrue(  sps.frameMBsOnly );
+    XSTestAssertFalse( sps.hasVideoSignalType );
+    XSTestAssertTrue(  sps.hasTiming );
+    XSTestAssertEqual( sps.numUnitsInTick, 1U );
+    XSTestAssertEqual( sps.timeScale,      50U );
+    
+    XSTestAssertEqual( pps.id,    0 );
+    XSTestAssertEqual( pps.spsID, 0 );
+    XSTestAssertFalse( pps.entropyCodingMode );
+}
+
+XSTest( ISOBMFF_ParameterSets, HEVC )
+{
+    ISOBMFF::VideoParameterSet    vps( ISOBMFF::VideoParameterSet::ReadHEVC( HEVCVPS ) );
+    ISOBMFF::SequenceParameterSet sps( ISOBMFF::SequenceParameterSet::ReadHEVC( HEVCSPS ) );
+    ISOBMFF::PictureParameterSet  pps( ISOBMFF::PictureParameterSet::ReadHEVC( HEVCPPS ) );
+    
+    XSTestAssertEqual( vps.id,           0 );
+    XSTestAssertEqual( vps.maxSubLayers, 1 );
+    XSTestAssertEqual( vps.profileIDC,   3 );
+    XSTestAssertEqual( vps.levelIDC,     90 );
+    
+    XSTestAssertEqual( sps.id,             0 );
+    XSTestAssertEqual( sps.profileIDC,     3 );
+    XSTestAssertEqual( sps.levelIDC,       90 );
+    XSTestAssertEqual( sps.chromaFormat,   1 );
+    XSTestAssertEqual( sps.bitDepthLuma,   8 );
+    XSTestAssertEqual( sps.bitDepthChroma, 8 );
+    XSTestAssertEqual( sps.width,          512U );
+    XSTestAssertEqual( sps.height,         512U );
+    
+    XSTestAssertEqual( pps.id,    0 );
+    XSTestAssertEqual( pps.spsID, 0 );
+    XSTestAssertFalse( pps.dependentSliceSegmentsEnabled );
+    XSTestAssertFalse( pps.outputFlagPresent );
+    XSTestAssertEqual( pps.numExtraSliceHeaderBits, 0 );
+}
+
+XSTest( ISOBMFF_ParameterSets, HVCC )
+{
+    ISOBMFF::Parser           parser;
+    ISOBMFF::HVCC             hvcc;
+    ISOBMFF::BinaryDataStream stream( std::vector< uint8_t >( HVCC + 8, HVCC + sizeof( HVCC ) ) );
+    
+    hvcc.ReadData( parser, stream );
+    
+    {
+        ISOBMFF::SequenceParameterSet sps( ISOBMFF::SequenceParameterSet::Read( hvcc ) );
+        
+        XSTestAssertEqual( sps.width,  512U );
+        XSTestAssertEqual( sps.height, 512U );
+    }
+}
+
+XSTest( ISOBMFF_ParameterSets, Invalid )
+{
+    /* A PPS is not a SPS */
+    XSTestAssertThrow( ISOBMFF::SequenceParameterSet::ReadAVC( ISOBMFF::Span< const uint8_t >( AVCPPS, sizeof( AVCPPS ) ) ), std::runtime_error );
+    XSTestAssertThrow( ISOBMFF::SequenceParameterSet::ReadHEVC( HEVCVPS ), std::runtime_error );
+    
+    /* Truncated */
+    XSTestAssertThrow( ISOBMFF::SequenceParameterSet::ReadAVC( ISOBMFF::Span< const uint8_t >( AVCSPS, 6 ) ), std::runtime_error );
+    XSTestAssertThrow( ISOBMFF::SequenceParameterSet::ReadHEVC( ISOBMFF::Span< const uint8_t >( HVCC + 0x40, 10 ) ), std::runtime_error );
+}
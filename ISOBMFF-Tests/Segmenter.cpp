@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Segmenter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include "Movie.hpp"
+#include <cstdio>
+
+static std::shared_ptr< ISOBMFF::ContainerBox > GetMOOV( const std::string & path )
+{
+    ISOBMFF::Parser parser;
+    
+    parser.AddOption( ISOBMFF::Parser::Options::SkipMDATData );
+    parser.Parse( path );
+    
+    return parser.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" );
+}
+
+static void WriteSegment( std::ofstream & stream, const ISOBMFF::Segmenter::Segment & segment, const std::vector< uint8_t > & source )
+{
+    for( const auto & range: segment.ranges )
+    {
+        const std::vector< uint8_t > & data( ( range.source == ISOBMFF::Segmenter::Source::Header ) ? segment.header : source );
+        
+        stream.write( reinterpret_cast< const char * >( data.data() + range.offset ), static_cast< std::streamsize >( range.length ) );
+    }
+}
+
+XSTest( ISOBMFF_Segmenter, Segments )
+{
+    std::string path( "ISOBMFF-Tests-Segmenter-Segments.mp4" );
+    
+    Movie::Write( path );
+    
+    {
+        auto               moov( GetMOOV( path ) );
+        ISOBMFF::Segmenter video( moov, 1, 1000 );
+        ISOBMFF::Segmenter audio( moov, 2, 1000 );
+        
+        XSTestAssertTrue( video.GetSegmentTable() == std::vector< uint32_t >( { 0, 10, 20, 30 } ) );
+        XSTestAssertEqual( video.GetSegmentCount(), 3U );
+        XSTestAssertEqual( audio.GetSegmentCount(), 3U );
+        XSTestAssertEqual( audio.GetTimescale(),    48000U );
+        
+        for( size_t i = 0; i < 3; i++ )
+        {
+            XSTestAssertEqual( video.GetSegmentTime( i ),     i * 1000 );
+            XSTestAssertEqual( video.GetSegmentDuration( i ), 1000U );
+            XSTestAssertEqual( audio.GetSegmentTime( i ),     i * 48000 );
+            XSTestAssertEqual( audio.GetSegmentDuration( i ), 48000U );
+        }
+        
+        /* Segments starting between sync samples are extended to the next sync sample */
+        XSTestAssertTrue( ISOBMFF::Segmenter( moov, 1, 500 ).GetSegmentTable() == video.GetSegmentTable() );
+    }
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_Segmenter, SegmentTable )
+{
+    std::string path( "ISOBMFF-Tests-Segmenter-SegmentTable.mp4" );
+    
+    Movie::Write( path );
+    
+    {
+        auto               moov( GetMOOV( path ) );
+        ISOBMFF::Segmenter segmenter( moov, 1, 1000 );
+        ISOBMFF::Segmenter copy( moov, 1, segmenter.GetSegmentTable() );
+        
+        XSTestAssertEqual( copy.GetSegmentCount(), segmenter.GetSegmentCount() );
+        
+        for( size_t i = 0; i < segmenter.GetSegmentCount(); i++ )
+        {
+            XSTestAssertTrue( copy.GetSegment( i ).header == segmenter.GetSegment( i ).header );
+        }
+        
+        XSTestAssertThrow( ISOBMFF::Segmenter( moov, 1, std::vector< uint32_t >( { 0, 0 } ) ), std::runtime_error );
+        XSTestAssertThrow( ISOBMFF::Segmenter( moov, 3 ), std::runtime_error );
+    }
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_Segmenter, Defragment )
+{
+    std::string input( "ISOBMFF-Tests-Segmenter-Defragment-Input.mp4" );
+    std::string fragmented( "ISOBMFF-Tests-Segmenter-Defragment-Fragmented.mp4" );
+    std::string output( "ISOBMFF-Tests-Segmenter-Defragment-Output.mp4" );
+    
+    Movie::Write( input );
+    
+    /* The segments of both tracks, interleaved after a common initialization segment */
+    {
+        auto                            moov( GetMOOV( input ) );
+        std::vector< uint8_t >          source( Movie::ReadFile( input ) );
+        ISOBMFF::BinaryDataOutputStream init;
+        std::ofstream                   stream( fragmented, std::ios::binary );
+        ISOBMFF::Segmenter              video( moov, 1, 1000 );
+        ISOBMFF::Segmenter              audio( moov, 2, 1000 );
+        uint32_t                        sequence( 1 );
+        
+        ISOBMFF::Segmenter::WriteInitSegment( init, *( moov ), { 1, 2 } );
+        stream.write( reinterpret_cast< const char * >( init.GetData().data() ), static_cast< std::streamsize >( init.GetData().size() ) );
+        
+        for( size_t i = 0; i < video.GetSegmentCount(); i++ )
+        {
+            WriteSegment( stream, video.GetSegment( i, sequence++ ), source );
+            WriteSegment( stream, audio.GetSegment( i, sequence++ ), source );
+        }
+    }
+    
+    ISOBMFF::Defragmenter( fragmented ).Write( output );
+    
+    XSTestAssertTrue( Movie::Check( output ) );
+    
+    std::remove( input.c_str() );
+    std::remove( fragmented.c_str() );
+    std::remove( output.c_str() );
+}
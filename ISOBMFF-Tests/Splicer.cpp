@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Splicer.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <XSTest/XSTest.hpp>
+
+#include "Movie.hpp"
+#include <cstdio>
+
+static std::vector< ISOBMFF::Track > GetTracks( const std::string & path )
+{
+    ISOBMFF::Parser parser;
+    
+    parser.AddOption( ISOBMFF::Parser::Options::SkipMDATData );
+    parser.Parse( path );
+    
+    return ISOBMFF::Track::GetTracks( *( parser.GetFile()->GetTypedBox< ISOBMFF::ContainerBox >( "moov" ) ) );
+}
+
+/*
+ * Checks that a track holds the given samples of the movie, in order.
+ * Durations are not checked, as the last sample of a clip may be extended.
+ */
+static bool HasSamples( const std::string & path, const ISOBMFF::Track & track, const std::vector< std::pair< size_t, size_t > > & ranges )
+{
+    std::vector< uint8_t >       data( Movie::ReadFile( path ) );
+    const ISOBMFF::SampleTable & table( track.GetSampleTable() );
+    uint32_t                     trackID( track.GetTrackID() );
+    size_t                       i( 0 );
+    
+    for( const auto & range: ranges )
+    {
+        for( size_t sample = range.first; sample < range.first + range.second; sample++, i++ )
+        {
+            std::vector< uint8_t > expected( Movie::GetSampleData( trackID, sample ) );
+            
+            if
+            (
+                   i                                >= table.GetSampleCount()
+                || table.GetSampleSize( i )         != expected.size()
+                || table.GetCompositionOffset( i )  != Movie::GetCompositionOffset( trackID, sample )
+                || table.IsSyncSample( i )          != Movie::IsSyncSample( trackID, sample )
+                || std::equal( expected.begin(), expected.end(), data.begin() + static_cast< std::ptrdiff_t >( table.GetSampleOffset( i ) ) ) == false
+            )
+            {
+                return false;
+            }
+        }
+    }
+    
+    return i == table.GetSampleCount();
+}
+
+static std::vector< uint8_t > GetEditList( const ISOBMFF::Track & track )
+{
+    auto edts( track.GetTRAK()->GetTypedBox< ISOBMFF::ContainerBox >( "edts" ) );
+    
+    return ( edts != nullptr ) ? edts->GetBox( "elst" )->GetData() : std::vector< uint8_t >();
+}
+
+XSTest( ISOBMFF_Splicer, Trim )
+{
+    std::string      input( "ISOBMFF-Tests-Splicer-Trim-Input.mp4" );
+    std::string      output( "ISOBMFF-Tests-Splicer-Trim-Output.mp4" );
+    ISOBMFF::Splicer splicer;
+    
+    Movie::Write( input );
+    splicer.AddClip( input, 1.0, 2.0 );
+    splicer.Write( output );
+    
+    {
+        auto tracks( GetTracks( output ) );
+        
+        /* The last video sample is presented at 2.1 seconds */
+        XSTestAssertEqual( tracks.size(), 2U );
+        XSTestAssertTrue( HasSamples( output, tracks[ 0 ], { { 10, 9 } } ) );
+        XSTestAssertTrue( HasSamples( output, tracks[ 1 ], { { 50, 50 } } ) );
+        XSTestAssertTrue( GetEditList( tracks[ 0 ] ).empty() );
+    }
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+XSTest( ISOBMFF_Splicer, TrimBetweenSyncSamples )
+{
+    std::string      input( "ISOBMFF-Tests-Splicer-TrimBetweenSyncSamples-Input.mp4" );
+    std::string      output( "ISOBMFF-Tests-Splicer-TrimBetweenSyncSamples-Output.mp4" );
+    ISOBMFF::Splicer splicer;
+    
+    Movie::Write( input );
+    splicer.AddClip( input, 1.5, 2.5 );
+    splicer.Write( output );
+    
+    {
+        auto tracks( GetTracks( output ) );
+        
+        /* All tracks start at the previous video sync sample */
+        XSTestAssertTrue( HasSamples( output, tracks[ 0 ], { { 10, 15 } } ) );
+        XSTestAssertTrue( HasSamples( output, tracks[ 1 ], { { 50, 75 } } ) );
+    }
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+XSTest( ISOBMFF_Splicer, EditList )
+{
+    std::string      input( "ISOBMFF-Tests-Splicer-EditList-Input.mp4" );
+    std::string      output( "ISOBMFF-Tests-Splicer-EditList-Output.mp4" );
+    ISOBMFF::Splicer splicer( ISOBMFF::Splicer::StartMode::EditList );
+    
+    Movie::Write( input );
+    splicer.AddClip( input, 1.5, 2.5 );
+    splicer.Write( output );
+    
+    {
+        auto tracks( GetTracks( output ) );
+        
+        /* Video is decoded from the previous sync sample, and presented from 1.5 seconds */
+        XSTestAssertTrue( HasSamples( output, tracks[ 0 ], { { 10, 15 } } ) );
+        XSTestAssertTrue( HasSamples( output, tracks[ 1 ], { { 75, 50 } } ) );
+        XSTestAssertTrue( GetEditList( tracks[ 0 ] ) == std::vector< uint8_t >( { 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 3, 232, 0, 0, 1, 244, 0, 1, 0, 0 } ) );
+        XSTestAssertTrue( GetEditList( tracks[ 1 ] ) == std::vector< uint8_t >( { 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 3, 232, 0, 0, 0,   0, 0, 1, 0, 0 } ) );
+    }
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+XSTest( ISOBMFF_Splicer, Concatenate )
+{
+    std::string      input( "ISOBMFF-Tests-Splicer-Concatenate-Input.mp4" );
+    std::string      output( "ISOBMFF-Tests-Splicer-Concatenate-Output.mp4" );
+    ISOBMFF::Splicer splicer;
+    
+    Movie::Write( input );
+    splicer.AddClip( input, 0.0, 1.0 );
+    splicer.AddClip( input, 2.0, 3.0 );
+    splicer.Write( output );
+    
+    XSTestAssertEqual( splicer.GetClipCount(), 2U );
+    
+    {
+        auto tracks( GetTracks( output ) );
+        
+        XSTestAssertTrue( HasSamples( output, tracks[ 0 ], { { 0, 9 }, { 20, 9 } } ) );
+        XSTestAssertTrue( HasSamples( output, tracks[ 1 ], { { 0, 50 }, { 100, 50 } } ) );
+        
+        /* The second clip starts at 1 second in all tracks */
+        XSTestAssertEqual( tracks[ 0 ].GetSampleTable().GetSampleTime( 9 ),  1000U );
+        XSTestAssertEqual( tracks[ 1 ].GetSampleTable().GetSampleTime( 50 ), 48000U );
+    }
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+XSTest( ISOBMFF_Splicer, EmptyClip )
+{
+    std::string      input( "ISOBMFF-Tests-Splicer-EmptyClip-Input.mp4" );
+    std::string      output( "ISOBMFF-Tests-Splicer-EmptyClip-Output.mp4" );
+    ISOBMFF::Splicer splicer;
+    
+    Movie::Write( input );
+    splicer.AddClip( input, 5.0, 6.0 );
+    
+    XSTestAssertThrow( splicer.Write( output ), std::runtime_error );
+    
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
@@ -33,10 +33,21 @@
 
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/Utils.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <ISOBMFF/Parser.hpp>
 #include <ISOBMFF/BinaryStream.hpp>
 #include <ISOBMFF/BinaryDataStream.hpp>
 #include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/BinaryFileOutputStream.hpp>
+#include <ISOBMFF/ScatterGatherWriter.hpp>
+#include <ISOBMFF/Faststart.hpp>
+#include <ISOBMFF/InPlaceEditor.hpp>
+#include <ISOBMFF/Fragmenter.hpp>
+#include <ISOBMFF/Segmenter.hpp>
+#include <ISOBMFF/Defragmenter.hpp>
+#include <ISOBMFF/Splicer.hpp>
 #include <ISOBMFF/DisplayableObject.hpp>
 #include <ISOBMFF/DisplayableObjectContainer.hpp>
 #include <ISOBMFF/Box.hpp>
@@ -75,11 +86,39 @@
 #include <ISOBMFF/STSD.hpp>
 #include <ISOBMFF/STSS.hpp>
 #include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/CTTS.hpp>
 #include <ISOBMFF/FRMA.hpp>
 #include <ISOBMFF/SCHM.hpp>
 #include <ISOBMFF/HVC1.hpp>
 #include <ISOBMFF/AVC1.hpp>
 #include <ISOBMFF/STSC.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/Executor.hpp>
+#include <ISOBMFF/ThreadPoolExecutor.hpp>
+#include <ISOBMFF/SerialExecutor.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
+#include <ISOBMFF/FlatBoxTree.hpp>
+#include <ISOBMFF/ItemGraph.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/AnnexB.hpp>
+#include <ISOBMFF/GridExtractor.hpp>
+#include <ISOBMFF/ROIPlanner.hpp>
+#include <ISOBMFF/ThumbnailProbe.hpp>
+#include <ISOBMFF/HEIFSummary.hpp>
+#include <ISOBMFF/MovieSummary.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <ISOBMFF/RBSP.hpp>
+#include <ISOBMFF/ParameterSets.hpp>
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/Track.hpp>
+#include <ISOBMFF/Demuxer.hpp>
+#include <ISOBMFF/FrameTypeIndex.hpp>
+#include <ISOBMFF/SampleTableBuilder.hpp>
+#include <ISOBMFF/Muxer.hpp>
 
 #ifdef _WIN32
 #include <ISOBMFF/WIN32.hpp>
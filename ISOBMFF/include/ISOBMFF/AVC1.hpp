@@ -51,8 +51,10 @@ namespace ISOBMFF
 
             AVC1 & operator =( AVC1 o );
 
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
 
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
 
@@ -76,6 +78,7 @@ namespace ISOBMFF
 
             void                                  AddBox( std::shared_ptr< Box > box ) override;
             std::vector< std::shared_ptr< Box > > GetBoxes() const override;
+            Span< const std::shared_ptr< Box > >  GetBoxesSpan() const override;
 
             ISOBMFF_EXPORT friend void swap( AVC1 & o1, AVC1 & o2 );
 
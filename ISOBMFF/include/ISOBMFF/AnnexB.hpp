@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      AnnexB.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ANNEX_B_HPP
+#define ISOBMFF_ANNEX_B_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/AVCC.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @namespace   AnnexB
+     * @abstract    Conversion of length-prefixed NAL units to Annex-B byte streams.
+     * @discussion  ISOBMFF samples and items store NAL units prefixed by
+     *              their length, while most decoders expect an Annex-B
+     *              byte stream, where NAL units are prefixed by a
+     *              four bytes start code (0x00000001).
+     */
+    namespace AnnexB
+    {
+        /*!
+         * @function    GetParameterSets
+         * @abstract    Gets the NAL units of an HVCC box as an Annex-B byte stream.
+         * @param       hvcc    The HVCC box.
+         * @result      The NAL units of all arrays (VPS, SPS, PPS, SEI), in box order, each prefixed by a start code.
+         */
+        ISOBMFF_EXPORT std::vector< uint8_t > GetParameterSets( const HVCC & hvcc );
+        
+        /*!
+         * @function    GetParameterSets
+         * @abstract    Gets the NAL units of an AVCC box as an Annex-B byte stream.
+         * @param       avcc    The AVCC box.
+         * @result      The SPS and PPS NAL units, in box order, each prefixed by a start code.
+         */
+        ISOBMFF_EXPORT std::vector< uint8_t > GetParameterSets( const AVCC & avcc );
+        
+        /*!
+         * @function    GetSize
+         * @abstract    Gets the Annex-B size of length-prefixed NAL units.
+         * @param       data        The length-prefixed NAL units.
+         * @param       lengthSize  The size of the length fields (1, 2 or 4).
+         * @result      The size of the Annex-B byte stream.
+         * @discussion  Throws if the data is truncated.
+         */
+        ISOBMFF_EXPORT size_t GetSize( Span< const uint8_t > data, uint8_t lengthSize );
+        
+        /*!
+         * @function    Convert
+         * @abstract    Converts length-prefixed NAL units to an Annex-B byte stream.
+         * @param       data        The length-prefixed NAL units.
+         * @param       lengthSize  The size of the length fields (1, 2 or 4).
+         * @param       buffer      The output buffer, of at least GetSize() bytes.
+         * @result      The number of bytes written to the output buffer.
+         * @discussion  Throws if the data is truncated, or if the output
+         *              buffer is too small.
+         */
+        ISOBMFF_EXPORT size_t Convert( Span< const uint8_t > data, uint8_t lengthSize, Span< uint8_t > buffer );
+        
+        /*!
+         * @function    ConvertInPlace
+         * @abstract    Converts length-prefixed NAL units to an Annex-B byte stream, in place.
+         * @param       data        The length-prefixed NAL units.
+         * @param       lengthSize  The size of the length fields.
+         * @result      true if the data was converted, otherwise false.
+         * @discussion  In-place conversion overwrites each length field with
+         *              a start code, so it is only possible with 4 bytes
+         *              length fields, and without empty NAL units. The data
+         *              is left untouched if false is returned.
+         *              Throws if the data is truncated.
+         */
+        ISOBMFF_EXPORT bool ConvertInPlace( Span< uint8_t > data, uint8_t lengthSize );
+    }
+}
+
+#endif /* ISOBMFF_ANNEX_B_HPP */
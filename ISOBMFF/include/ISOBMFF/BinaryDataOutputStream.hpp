@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BinaryDataOutputStream.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BINARY_DATA_OUTPUT_STREAM_HPP
+#define ISOBMFF_BINARY_DATA_OUTPUT_STREAM_HPP
+
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <vector>
+#include <cstdint>
+#include <memory>
+
+namespace ISOBMFF
+{
+    class ISOBMFF_EXPORT BinaryDataOutputStream: public BinaryOutputStream
+    {
+        public:
+            
+            BinaryDataOutputStream();
+            
+            virtual ~BinaryDataOutputStream() override;
+            
+            BinaryDataOutputStream( const BinaryDataOutputStream & o )              = delete;
+            BinaryDataOutputStream( BinaryDataOutputStream && o )                   = delete;
+            BinaryDataOutputStream & operator =( const BinaryDataOutputStream & o ) = delete;
+            BinaryDataOutputStream & operator =( BinaryDataOutputStream && o )      = delete;
+            
+            using BinaryOutputStream::Write;
+            
+            void   Write( const uint8_t * buf, size_t size )        override;
+            void   Seek( std::streamoff offset, SeekDirection dir ) override;
+            size_t Tell()                                     const override;
+            
+            const std::vector< uint8_t > & GetData() const;
+            std::vector< uint8_t >         TakeData();
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_BINARY_DATA_OUTPUT_STREAM_HPP */
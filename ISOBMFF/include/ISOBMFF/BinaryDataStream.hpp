@@ -32,6 +32,7 @@
 #define ISOBMFF_BINARY_DATA_STREAM_HPP
 
 #include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <string>
 #include <iostream>
 #include <cstdint>
@@ -46,6 +47,7 @@ namespace ISOBMFF
             
             BinaryDataStream();
             BinaryDataStream( const std::vector< uint8_t > & data );
+            BinaryDataStream( std::vector< uint8_t > && data );
             BinaryDataStream( const BinaryDataStream & o );
             BinaryDataStream( BinaryDataStream && o ) noexcept;
             
@@ -59,6 +61,12 @@ namespace ISOBMFF
             void   Seek( std::streamoff offset, SeekDirection dir ) override;
             size_t Tell()                                     const override;
             
+            BinaryDataStream      Slice( size_t size );
+            Span< const uint8_t > GetDataSpan() const;
+            
+            static BinaryDataStream ReadSlice( BinaryStream & stream, size_t size );
+            static BinaryDataStream ReadCompactSlice( BinaryStream & stream, size_t size );
+            
             ISOBMFF_EXPORT friend void swap( BinaryDataStream & o1, BinaryDataStream & o2 );
             
         private:
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BinaryOutputStream.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BINARY_OUTPUT_STREAM_HPP
+#define ISOBMFF_BINARY_OUTPUT_STREAM_HPP
+
+#include <string>
+#include <cstdint>
+#include <vector>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Matrix.hpp>
+#include <ISOBMFF/Span.hpp>
+
+namespace ISOBMFF
+{
+    class ISOBMFF_EXPORT BinaryOutputStream
+    {
+        public:
+            
+            typedef BinaryStream::SeekDirection SeekDirection;
+            
+            virtual ~BinaryOutputStream() = default;
+            
+            virtual void   Write( const uint8_t * buf, size_t size )        = 0;
+            virtual size_t Tell()                                     const = 0;
+            virtual void   Seek( std::streamoff offset, SeekDirection dir ) = 0;
+            
+            void Write( Span< const uint8_t > data );
+            void Write( const std::vector< uint8_t > & data );
+            void WriteZeros( size_t size );
+            
+            void WriteUInt8( uint8_t value );
+            void WriteBigEndianUInt16( uint16_t value );
+            void WriteBigEndianUInt32( uint32_t value );
+            void WriteBigEndianUInt64( uint64_t value );
+            
+            void WriteBigEndianFixedPoint( float value, unsigned int integerLength, unsigned int fractionalLength );
+            
+            void WriteFourCC( const std::string & value );
+            void WriteString( const std::string & value );
+            void WriteNULLTerminatedString( const std::string & value );
+            void WritePascalString( const std::string & value );
+            
+            void WriteMatrix( const Matrix & value );
+            
+            /*!
+             * @function    WriteSourceRange
+             * @abstract    Writes a range of the source file, as-is.
+             * @param       offset  The offset of the range in the source file.
+             * @param       size    The size of the range, in bytes.
+             * @discussion  This is used to write data that was not read by
+             *              the parser, like a skipped MDAT. Streams that
+             *              don't have a source file throw.
+             */
+            virtual void WriteSourceRange( uint64_t offset, uint64_t size );
+            
+            /*!
+             * @function    BeginBox
+             * @abstract    Writes a box header, with a placeholder size.
+             * @param       type    The box type.
+             * @result      The offset of the box, to pass to EndBox().
+             */
+            size_t BeginBox( const std::string & type );
+            
+            /*!
+             * @function    BeginFullBox
+             * @abstract    Writes a full box header, with a placeholder size.
+             * @param       type    The box type.
+             * @param       version The box version.
+             * @param       flags   The box flags.
+             * @result      The offset of the box, to pass to EndBox().
+             */
+            size_t BeginFullBox( const std::string & type, uint8_t version, uint32_t flags );
+            
+            /*!
+             * @function    EndBox
+             * @abstract    Writes the size of a box started with BeginBox() or BeginFullBox().
+             * @param       offset  The offset of the box.
+             * @discussion  The stream must support seeking backwards.
+             *              Throws if the box is larger than 4GB.
+             */
+            void EndBox( size_t offset );
+    };
+}
+
+#endif /* ISOBMFF_BINARY_OUTPUT_STREAM_HPP */
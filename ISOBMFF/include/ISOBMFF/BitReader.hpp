@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BitReader.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BIT_READER_HPP
+#define ISOBMFF_BIT_READER_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       BitReader
+     * @abstract    Reads bit fields from a byte buffer, most significant bit first.
+     * @discussion  The reader does not copy the buffer, which must outlive
+     *              it. All read methods throw if not enough bits are
+     *              available.
+     */
+    class ISOBMFF_EXPORT BitReader
+    {
+        public:
+            
+            /*!
+             * @function    BitReader
+             * @abstract    Constructor.
+             * @param       data    The bytes to read from.
+             */
+            BitReader( Span< const uint8_t > data );
+            
+            /*!
+             * @function    ReadBit
+             * @abstract    Reads a single bit.
+             * @result      The bit value.
+             */
+            bool ReadBit();
+            
+            /*!
+             * @function    ReadBits
+             * @abstract    Reads an unsigned integer.
+             * @param       count   The number of bits to read (0 to 32).
+             * @result      The integer value.
+             */
+            uint32_t ReadBits( unsigned int count );
+            
+            /*!
+             * @function    ReadUE
+             * @abstract    Reads an unsigned Exp-Golomb coded integer (ue(v)).
+             * @result      The integer value.
+             * @discussion  Throws if the code is longer than 32 bits.
+             */
+            uint32_t ReadUE();
+            
+            /*!
+             * @function    ReadSE
+             * @abstract    Reads a signed Exp-Golomb coded integer (se(v)).
+             * @result      The integer value.
+             */
+            int32_t ReadSE();
+            
+            /*!
+             * @function    SkipBits
+             * @abstract    Skips bits.
+             * @param       count   The number of bits to skip.
+             */
+            void SkipBits( size_t count );
+            
+            /*!
+             * @function    GetPosition
+             * @abstract    Gets the current position.
+             * @result      The number of bits read so far.
+             */
+            size_t GetPosition() const;
+            
+            /*!
+             * @function    GetBitsAvailable
+             * @abstract    Gets the number of bits left to read.
+             * @result      The number of bits left to read.
+             */
+            size_t GetBitsAvailable() const;
+            
+        private:
+            
+            Span< const uint8_t > _data;
+            size_t                _position;
+    };
+}
+
+#endif /* ISOBMFF_BIT_READER_HPP */
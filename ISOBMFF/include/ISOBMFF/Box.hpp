@@ -35,7 +35,9 @@
 #include <algorithm>
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
 #include <ISOBMFF/DisplayableObject.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <string>
 #include <ostream>
 #include <vector>
@@ -118,6 +120,93 @@ namespace ISOBMFF
              */
             virtual std::vector< uint8_t > GetData() const;
             
+            /*!
+             * @function    GetDataSpan
+             * @abstract    Gets the box data without copying it.
+             * @result      A view of the box data.
+             * @discussion  The view references the buffer the box was read
+             *              from, which is kept alive by the box, or a copy
+             *              of the data when the box was only a small part of
+             *              that buffer. It is invalidated when the box is
+             *              read again or destroyed.
+             */
+            Span< const uint8_t > GetDataSpan() const;
+            
+            /*!
+             * @function    GetSize
+             * @abstract    Gets the size of the box, as it will be written.
+             * @result      The box size, in bytes, header included.
+             * @discussion  The size is computed from the box data without
+             *              writing it. A 64-bit size is used if the box
+             *              doesn't fit in 32 bits, or if the box was read
+             *              with one.
+             */
+            uint64_t GetSize() const;
+            
+            /*!
+             * @function    GetDataSize
+             * @abstract    Gets the size of the box data, as it will be written.
+             * @result      The size, in bytes, of the data written by WriteData.
+             */
+            virtual uint64_t GetDataSize() const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the box, header included, to a stream.
+             * @param       stream  The stream to which to write the box.
+             */
+            void Write( BinaryOutputStream & stream ) const;
+            
+            /*!
+             * @function    WriteData
+             * @abstract    Writes the box data to a stream.
+             * @param       stream  The stream to which to write the box data.
+             * @discussion  This is the counterpart of ReadData. Boxes whose
+             *              data was not read, like a skipped MDAT, write
+             *              their range of the source file instead.
+             * @see         BinaryOutputStream::WriteSourceRange
+             */
+            virtual void WriteData( BinaryOutputStream & stream ) const;
+            
+            /*!
+             * @function    HasSourceRange
+             * @abstract    Whether the location of the box in the source file is known.
+             * @result      True if the box was read from a file, otherwise false.
+             */
+            bool HasSourceRange() const;
+            
+            /*!
+             * @function    GetSourceOffset
+             * @abstract    Gets the offset of the box in the source file.
+             * @result      The offset of the box header, in bytes.
+             */
+            uint64_t GetSourceOffset() const;
+            
+            /*!
+             * @function    GetSourceSize
+             * @abstract    Gets the size of the box in the source file.
+             * @result      The box size, in bytes, header included.
+             */
+            uint64_t GetSourceSize() const;
+            
+            /*!
+             * @function    GetSourceHeaderSize
+             * @abstract    Gets the size of the box header in the source file.
+             * @result      The header size, in bytes (8 or 16).
+             */
+            uint64_t GetSourceHeaderSize() const;
+            
+            /*!
+             * @function    SetSourceRange
+             * @abstract    Sets the location of the box in the source file.
+             * @param       offset      The offset of the box header.
+             * @param       size        The box size, header included.
+             * @param       headerSize  The size of the box header.
+             * @discussion  This is set by the parser before the box data is
+             *              read.
+             */
+            void SetSourceRange( uint64_t offset, uint64_t size, uint64_t headerSize );
+            
             /*!
              * @function    swap
              * @abstract    Swap two objects.
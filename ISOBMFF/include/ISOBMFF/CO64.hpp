@@ -50,11 +50,16 @@ namespace ISOBMFF
             CO64 & operator =( CO64 o );
 
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
 
             size_t   GetEntryCount()                 const;
             uint64_t GetChunkOffset(  size_t index ) const;
 
+            void SetChunkOffset( size_t index, uint64_t value );
+            void AddChunkOffset( uint64_t value );
+
             ISOBMFF_EXPORT friend void swap( CO64 & o1, CO64 & o2 );
 
         private:
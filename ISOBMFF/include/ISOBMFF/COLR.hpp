@@ -53,6 +53,8 @@ namespace ISOBMFF
             COLR & operator =( COLR o );
             
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
             std::string            GetColourType()              const;
@@ -61,6 +63,7 @@ namespace ISOBMFF
             uint16_t               GetMatrixCoefficients()      const;
             bool                   GetFullRangeFlag()           const;
             std::vector< uint8_t > GetICCProfile()              const;
+            Span< const uint8_t >  GetICCProfileSpan()          const;
             
             void SetColourType( const std::string & value );
             void SetColourPrimaries( uint16_t value );
@@ -68,6 +71,7 @@ namespace ISOBMFF
             void SetMatrixCoefficients( uint16_t value );
             void SetFullRangeFlag( bool value );
             void SetICCProfile( const std::vector< uint8_t > & value );
+            void SetICCProfile( std::vector< uint8_t > && value );
             
             ISOBMFF_EXPORT friend void swap( COLR & o1, COLR & o2 );
             
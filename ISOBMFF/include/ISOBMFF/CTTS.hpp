@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      CTTS.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_CTTS_HPP
+#define ISOBMFF_CTTS_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <string>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       CTTS
+     * @abstract    Composition time to sample box.
+     * @discussion  Sample offsets are signed, as allowed by version 1.
+     *              Version 0 offsets are read the same way, as writers
+     *              commonly store negative offsets in version 0 boxes.
+     */
+    class ISOBMFF_EXPORT CTTS: public FullBox
+    {
+        public:
+
+            CTTS();
+            CTTS( const CTTS & o );
+            CTTS( CTTS && o ) noexcept;
+            virtual ~CTTS() override;
+
+            CTTS & operator =( CTTS o );
+
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+
+            size_t   GetEntryCount()                 const;
+            uint32_t GetSampleCount(  size_t index ) const;
+            int32_t  GetSampleOffset( size_t index ) const;
+
+            ISOBMFF_EXPORT friend void swap( CTTS & o1, CTTS & o2 );
+
+        private:
+
+            class IMPL;
+
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_CTTS_HPP */
@@ -33,6 +33,7 @@
 
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/Box.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <vector>
 #include <memory>
 
@@ -49,6 +50,14 @@ namespace ISOBMFF
             virtual void                                  AddBox( std::shared_ptr< Box > box ) = 0;
             virtual std::vector< std::shared_ptr< Box > > GetBoxes()                     const = 0;
             
+            /*
+             * Returns a view over the boxes stored in the container, without
+             * copying them. The view is invalidated when boxes are added.
+             * The default implementation returns an empty span, in which case
+             * lookups fall back to GetBoxes().
+             */
+            virtual Span< const std::shared_ptr< Box > > GetBoxesSpan() const;
+            
             void WriteBoxes( std::ostream & os, std::size_t indentLevel ) const;
             
             std::vector< std::shared_ptr< Box > > GetBoxes( const std::string & name ) const;
@@ -59,6 +68,31 @@ namespace ISOBMFF
             {
                 return std::dynamic_pointer_cast< _T_ >( this->GetBox( name ) );
             }
+            
+            /*
+             * Invokes fn( const std::shared_ptr< Box > & ) for each box of
+             * the specified type, without allocating.
+             */
+            template< class _F_ >
+            void ForEachBox( const std::string & name, _F_ fn ) const
+            {
+                Span< const std::shared_ptr< Box > > boxes( this->GetBoxesSpan() );
+                std::vector< std::shared_ptr< Box > > copy;
+                
+                if( boxes.data() == nullptr )
+                {
+                    copy  = this->GetBoxes();
+                    boxes = Span< const std::shared_ptr< Box > >( copy );
+                }
+                
+                for( const auto & box: boxes )
+                {
+                    if( box->GetName() == name )
+                    {
+                        fn( box );
+                    }
+                }
+            }
     };
 }
 
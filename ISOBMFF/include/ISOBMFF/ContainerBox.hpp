@@ -52,11 +52,24 @@ namespace ISOBMFF
             
             ContainerBox & operator =( ContainerBox o );
             
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
             
             void                                  AddBox( std::shared_ptr< Box > box ) override;
             std::vector< std::shared_ptr< Box > > GetBoxes() const override;
+            Span< const std::shared_ptr< Box > >  GetBoxesSpan() const override;
+            std::vector< uint8_t >                GetPadding() const;
+            
+            /*!
+             * @function    ReplaceBox
+             * @abstract    Replaces a box, keeping its position.
+             * @param       box         The box to replace.
+             * @param       replacement The new box.
+             * @result      true if the box was found, otherwise false.
+             */
+            bool ReplaceBox( const std::shared_ptr< Box > & box, std::shared_ptr< Box > replacement );
             
             ISOBMFF_EXPORT friend void swap( ContainerBox & o1, ContainerBox & o2 );
             
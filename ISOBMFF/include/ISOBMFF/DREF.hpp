@@ -51,11 +51,14 @@ namespace ISOBMFF
             
             DREF & operator =( DREF o );
             
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
             
             void                                  AddBox( std::shared_ptr< Box > box ) override;
             std::vector< std::shared_ptr< Box > > GetBoxes() const override;
+            Span< const std::shared_ptr< Box > >  GetBoxesSpan() const override;
             
             ISOBMFF_EXPORT friend void swap( DREF & o1, DREF & o2 );
             
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Defragmenter.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_DEFRAGMENTER_HPP
+#define ISOBMFF_DEFRAGMENTER_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Defragmenter
+     * @abstract    Converts a fragmented MP4 file to a progressive MP4 file.
+     * @discussion  The output starts with a FTYP box and a single MDAT box,
+     *              followed by the MOOV box of the input file, without the
+     *              MVEX box, and with complete sample tables and durations.
+     *              Each track run (see TRUN) becomes a chunk, so samples
+     *              of each track are grouped, and tracks are interleaved
+     *              in the order of the input fragments.
+     *              Decode times follow the TFDT boxes: a track starting
+     *              after the others is delayed with an empty edit, and a
+     *              jump between fragments extends the previous sample.
+     *              Edit lists of the input are rebased accordingly.
+     *              Fragments are read one at a time. Only the run-length
+     *              compressed sample tables are kept in memory (see
+     *              SampleTableBuilder), and sample data is copied from
+     *              the input file by the output stream (see
+     *              BinaryOutputStream::WriteSourceRange), without being
+     *              buffered.
+     *              Use Faststart to move the MOOV box before the MDAT box.
+     */
+    class ISOBMFF_EXPORT Defragmenter
+    {
+        public:
+            
+            /*!
+             * @function    Defragmenter
+             * @abstract    Prepares a file for defragmentation.
+             * @param       path    The input file path.
+             * @discussion  Only top-level box headers and the MOOV box are
+             *              read. Throws if the file is not fragmented.
+             */
+            Defragmenter( const std::string & path );
+            
+            Defragmenter( const Defragmenter & o );
+            Defragmenter( Defragmenter && o ) noexcept;
+            ~Defragmenter();
+            
+            Defragmenter & operator =( Defragmenter o );
+            
+            /*!
+             * @function    GetFragmentCount
+             * @abstract    Gets the number of fragments (MOOF boxes) of the input file.
+             * @result      The number of fragments.
+             */
+            size_t GetFragmentCount() const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the progressive file.
+             * @param       stream  The output stream, which must support seeking, and be able to copy ranges of the input file.
+             */
+            void Write( BinaryOutputStream & stream ) const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the progressive file.
+             * @param       path    The output file path, which must differ from the input path.
+             */
+            void Write( const std::string & path ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Defragmenter & o1, Defragmenter & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_DEFRAGMENTER_HPP */
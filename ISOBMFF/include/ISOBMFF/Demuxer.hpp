@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Demuxer.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_DEMUXER_HPP
+#define ISOBMFF_DEMUXER_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Track.hpp>
+#include <ostream>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Demuxer
+     * @abstract    Extracts an H.264 or H.265 track as an Annex-B elementary stream.
+     * @discussion  Samples are read with large coalesced reads, following
+     *              the chunk offsets, converted from length-prefixed NAL
+     *              units to start codes, and written in decoding order.
+     *              Reading, conversion and writing run concurrently, as a
+     *              three stages pipeline connected by bounded queues.
+     *              Unlike other parallel operations, the pipeline does not
+     *              go through an Executor: each Demux call runs the reading
+     *              and conversion stages on two dedicated threads, for its
+     *              whole duration. These stages block on their queues, and
+     *              would deadlock on an executor with fewer free workers,
+     *              like a SerialExecutor. Writing runs on the calling
+     *              thread.
+     *              The parameter sets of the AVCC or HVCC box are written
+     *              before the first sample and before each sync sample.
+     */
+    class ISOBMFF_EXPORT Demuxer
+    {
+        public:
+            
+            /*!
+             * @var         DefaultReadSize
+             * @abstract    Default maximum size of a coalesced read.
+             */
+            static constexpr size_t DefaultReadSize = 8 * 1024 * 1024;
+            
+            /*!
+             * @var         DefaultQueueDepth
+             * @abstract    Default number of blocks that can wait between two stages.
+             */
+            static constexpr size_t DefaultQueueDepth = 4;
+            
+            /*!
+             * @function    Demuxer
+             * @abstract    Creates a demuxer for a file.
+             * @param       path    The path of the file.
+             * @param       trackID The ID of the track to extract, or 0 for the first AVC or HEVC video track.
+             * @discussion  Throws if the track is not found, or if it has
+             *              no AVCC or HVCC box.
+             */
+            Demuxer( const std::string & path, uint32_t trackID = 0 );
+            
+            Demuxer( const Demuxer & o ) = delete;
+            Demuxer( Demuxer && o ) noexcept;
+            ~Demuxer();
+            
+            Demuxer & operator =( Demuxer o );
+            
+            /*!
+             * @function    GetTrack
+             * @abstract    Gets the extracted track.
+             * @result      The extracted track.
+             */
+            const Track & GetTrack() const;
+            
+            size_t GetReadSize()   const;
+            size_t GetQueueDepth() const;
+            
+            void SetReadSize( size_t value );
+            void SetQueueDepth( size_t value );
+            
+            /*!
+             * @function    Demux
+             * @abstract    Writes the elementary stream.
+             * @param       output  The output stream.
+             * @discussion  Throws if a sample cannot be read or converted,
+             *              or if writing fails.
+             */
+            void Demux( std::ostream & output ) const;
+            
+            /*!
+             * @function    Demux
+             * @abstract    Writes the elementary stream to a file.
+             * @param       path    The path of the output file.
+             */
+            void Demux( const std::string & path ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Demuxer & o1, Demuxer & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_DEMUXER_HPP */
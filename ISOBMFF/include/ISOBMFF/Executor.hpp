@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Executor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_EXECUTOR_HPP
+#define ISOBMFF_EXECUTOR_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Executor
+     * @abstract    Abstract task scheduler.
+     * @discussion  Every parallel operation of the library goes through an
+     *              executor, so applications can run it on their own thread
+     *              pool by subclassing this class, and passing an instance
+     *              to the library, or by setting it as the default executor.
+     * @see         ThreadPoolExecutor
+     * @see         SerialExecutor
+     */
+    class ISOBMFF_EXPORT Executor
+    {
+        public:
+            
+            /*!
+             * @function    GetDefault
+             * @abstract    Gets the default executor.
+             * @discussion  Unless another executor was set, this is a shared
+             *              ThreadPoolExecutor, created on first use, with one
+             *              worker per hardware thread.
+             * @result      The default executor.
+             * @see         SetDefault
+             */
+            static std::shared_ptr< Executor > GetDefault();
+            
+            /*!
+             * @function    SetDefault
+             * @abstract    Sets the default executor.
+             * @param       executor    The executor to use by default, or nullptr to restore the library's own thread pool.
+             * @see         GetDefault
+             */
+            static void SetDefault( const std::shared_ptr< Executor > & executor );
+            
+            virtual ~Executor() = default;
+            
+            /*!
+             * @function    Submit
+             * @abstract    Schedules a task for execution.
+             * @discussion  The task may run on any thread, including the
+             *              calling one. Tasks should not throw.
+             * @param       task    The task to run.
+             */
+            virtual void Submit( const std::function< void() > & task ) = 0;
+            
+            /*!
+             * @function    GetConcurrency
+             * @abstract    Gets the number of tasks that may run simultaneously.
+             * @result      The maximum number of concurrent tasks (at least 1).
+             */
+            virtual size_t GetConcurrency() const = 0;
+            
+            /*!
+             * @function    ParallelFor
+             * @abstract    Runs a function over a range of indices, in parallel.
+             * @discussion  The range is split in chunks of at most grain
+             *              indices, and the body is invoked once for each
+             *              chunk, with the chunk bounds.
+             *              The calling thread also executes chunks, so this
+             *              method can safely be called from a task running
+             *              on the executor itself.
+             *              It returns once all chunks are done. If the body
+             *              throws, no new chunk is started and the first
+             *              exception is rethrown.
+             *              The default implementation is based on Submit.
+             * @param       begin   The first index of the range.
+             * @param       end     The end of the range (not included).
+             * @param       grain   The maximum number of indices per chunk (0 is treated as 1).
+             * @param       body    The function invoked for each chunk, with the chunk's begin and end indices.
+             */
+            virtual void ParallelFor( size_t begin, size_t end, size_t grain, const std::function< void( size_t, size_t ) > & body );
+    };
+}
+
+#endif /* ISOBMFF_EXECUTOR_HPP */
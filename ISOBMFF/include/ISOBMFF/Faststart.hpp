@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Faststart.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_FASTSTART_HPP
+#define ISOBMFF_FASTSTART_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/File.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Faststart
+     * @abstract    Moves the MOOV box of a MP4 or QuickTime file ahead of
+     *              its MDAT boxes, for progressive playback.
+     * @discussion  The file is parsed without MDAT data. Every STCO and
+     *              CO64 entry is relocated to the new position of the
+     *              box it points into, and STCO boxes are promoted to
+     *              CO64 when an offset no longer fits in 32 bits.
+     *              The output is streamed box by box: MDAT boxes are
+     *              copied from the input file by the output stream
+     *              (see BinaryOutputStream::WriteSourceRange), so memory
+     *              usage does not depend on the size of the media data.
+     *              Item locations (ILOC) are not relocated, so files with
+     *              a top-level META box are rejected if any box moves.
+     */
+    class ISOBMFF_EXPORT Faststart
+    {
+        public:
+            
+            /*!
+             * @function    Faststart
+             * @abstract    Prepares a file for rewriting.
+             * @param       path    The input file path.
+             */
+            Faststart( const std::string & path );
+            
+            /*!
+             * @function    Faststart
+             * @abstract    Prepares a parsed file for rewriting.
+             * @param       file    The file, parsed from path. Its chunk offset boxes are updated.
+             * @param       path    The path of the file the boxes were read from.
+             * @discussion  Boxes of the file may have been modified since
+             *              it was parsed. Chunk offsets must still refer
+             *              to the source file.
+             */
+            Faststart( const std::shared_ptr< File > & file, const std::string & path );
+            
+            Faststart( const Faststart & o );
+            Faststart( Faststart && o ) noexcept;
+            ~Faststart();
+            
+            Faststart & operator =( Faststart o );
+            
+            /*!
+             * @function    IsFaststart
+             * @abstract    Checks if the input file already has its MOOV box before its MDAT boxes.
+             * @result      true if no box needs to be moved, otherwise false.
+             */
+            bool IsFaststart() const;
+            
+            /*!
+             * @function    GetFile
+             * @abstract    Gets the rewritten box tree, with relocated chunk offsets.
+             * @result      The file, whose top-level boxes are in output order.
+             */
+            std::shared_ptr< File > GetFile() const;
+            
+            /*!
+             * @function    GetSize
+             * @abstract    Gets the size of the output file.
+             * @result      The output size, in bytes.
+             */
+            uint64_t GetSize() const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the output file.
+             * @param       path    The output file path, which must differ from the input path.
+             */
+            void Write( const std::string & path ) const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the output file to a stream.
+             * @param       stream  The output stream, which must be able to copy ranges of the input file.
+             */
+            void Write( BinaryOutputStream & stream ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Faststart & o1, Faststart & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_FASTSTART_HPP */
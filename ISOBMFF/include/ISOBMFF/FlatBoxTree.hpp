@@ -0,0 +1,220 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      FlatBoxTree.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_FLAT_BOX_TREE_HPP
+#define ISOBMFF_FLAT_BOX_TREE_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Box.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    class Parser;
+    
+    /*!
+     * @class       FlatBoxTree
+     * @abstract    Compact, read-only representation of the box hierarchy of a stream.
+     * @discussion  The tree is built by reading box headers only. Payloads
+     *              are skipped, and every box is stored as a 24 bytes node in
+     *              a single contiguous array, in depth-first order, so the
+     *              first child of a node, if any, immediately follows it.
+     *              Typed box objects are only created on demand, by decoding
+     *              the corresponding bytes with a parser, and are cached
+     *              using the node index as handle.
+     *              This class is not thread-safe.
+     */
+    class ISOBMFF_EXPORT FlatBoxTree
+    {
+        public:
+            
+            /*!
+             * @struct      Node
+             * @abstract    A box in the tree.
+             * @field       offset  The box offset in the stream, including the box header.
+             * @field       size    The box size, including the box header.
+             * @field       type    The box type, as a big-endian four character code.
+             * @field       next    The index of the next sibling, or NoNode.
+             */
+            struct Node
+            {
+                uint64_t offset;
+                uint64_t size;
+                uint32_t type;
+                uint32_t next;
+            };
+            
+            /*!
+             * @constant    NoNode
+             * @abstract    Invalid node index.
+             */
+            static constexpr uint32_t NoNode = 0xFFFFFFFF;
+            
+            /*!
+             * @function    FourCC
+             * @abstract    Converts a four character string to a box type.
+             * @param       type    The four character string.
+             * @result      The box type.
+             */
+            static uint32_t FourCC( const std::string & type );
+            
+            /*!
+             * @function    FlatBoxTree
+             * @abstract    Creates an empty tree.
+             */
+            FlatBoxTree();
+            
+            /*!
+             * @function    FlatBoxTree
+             * @abstract    Creates a tree for the boxes of a stream.
+             * @param       stream  The stream object.
+             * @see         Build
+             */
+            FlatBoxTree( BinaryStream & stream );
+            
+            FlatBoxTree( const FlatBoxTree & o );
+            FlatBoxTree( FlatBoxTree && o ) noexcept;
+            ~FlatBoxTree();
+            
+            FlatBoxTree & operator =( FlatBoxTree o );
+            
+            /*!
+             * @function    Build
+             * @abstract    Builds the tree for the boxes of a stream.
+             * @discussion  Any previously built tree is discarded. Known
+             *              container boxes (including full boxes and sample
+             *              entries with children) are traversed, by seeking
+             *              over their payload.
+             * @param       stream  The stream object.
+             */
+            void Build( BinaryStream & stream ) noexcept( false );
+            
+            /*!
+             * @function    GetNodes
+             * @abstract    Gets all the nodes of the tree, in depth-first order.
+             * @result      The nodes.
+             */
+            const std::vector< Node > & GetNodes() const;
+            
+            /*!
+             * @function    GetNode
+             * @abstract    Gets a node of the tree.
+             * @param       index   The node index.
+             * @result      The node.
+             */
+            const Node & GetNode( uint32_t index ) const;
+            
+            /*!
+             * @function    GetType
+             * @abstract    Gets the box type of a node, as a string.
+             * @param       index   The node index.
+             * @result      The box type.
+             */
+            std::string GetType( uint32_t index ) const;
+            
+            /*!
+             * @function    GetFirstChild
+             * @abstract    Gets the first child of a node.
+             * @param       index   The node index.
+             * @result      The index of the first child, or NoNode.
+             */
+            uint32_t GetFirstChild( uint32_t index ) const;
+            
+            /*!
+             * @function    GetNextSibling
+             * @abstract    Gets the next sibling of a node.
+             * @param       index   The node index.
+             * @result      The index of the next sibling, or NoNode.
+             */
+            uint32_t GetNextSibling( uint32_t index ) const;
+            
+            /*!
+             * @function    FindChild
+             * @abstract    Finds the first child of a node with a specific type.
+             * @param       parent  The parent node index, or NoNode for top-level boxes.
+             * @param       type    The box type (four character string).
+             * @result      The index of the child, or NoNode.
+             */
+            uint32_t FindChild( uint32_t parent, const std::string & type ) const;
+            
+            /*!
+             * @function    Find
+             * @abstract    Finds the first box matching a path.
+             * @param       path    Box types separated by slashes, starting from the top level (eg: "moov/trak/tkhd").
+             * @result      The node index, or NoNode.
+             */
+            uint32_t Find( const std::string & path ) const;
+            
+            /*!
+             * @function    GetBox
+             * @abstract    Gets a typed box object for a node.
+             * @discussion  The box is decoded from the stream, using the
+             *              parser's registered boxes and options, the first
+             *              time it is requested.
+             *              Boxes whose decoding depends on their parent (like
+             *              item references) should be accessed through their
+             *              parent.
+             * @param       index   The node index.
+             * @param       parser  The parser used to decode the box.
+             * @param       stream  The stream the tree was built from.
+             * @result      The box object.
+             */
+            std::shared_ptr< Box > GetBox( uint32_t index, Parser & parser, BinaryStream & stream ) const noexcept( false );
+            
+            /*!
+             * @function    GetTypedBox
+             * @abstract    Gets a typed box object for a node.
+             * @param       index   The node index.
+             * @param       parser  The parser used to decode the box.
+             * @param       stream  The stream the tree was built from.
+             * @result      The box object, or nullptr if the box is not of the requested type.
+             * @see         GetBox
+             */
+            template< class _T_ >
+            std::shared_ptr< _T_ > GetTypedBox( uint32_t index, Parser & parser, BinaryStream & stream ) const noexcept( false )
+            {
+                return std::dynamic_pointer_cast< _T_ >( this->GetBox( index, parser, stream ) );
+            }
+            
+            ISOBMFF_EXPORT friend void swap( FlatBoxTree & o1, FlatBoxTree & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_FLAT_BOX_TREE_HPP */
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Fragmenter.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_FRAGMENTER_HPP
+#define ISOBMFF_FRAGMENTER_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Fragmenter
+     * @abstract    Converts a progressive MP4 file to a fragmented MP4 file.
+     * @discussion  The output starts with an initialization segment: a
+     *              FTYP box and a MOOV box with empty sample tables and a
+     *              MVEX box. It is followed by one MOOF and MDAT box pair
+     *              per fragment.
+     *              Each fragment holds samples of a single track, and
+     *              starts with a sync sample (see STSS) once the previous
+     *              fragment is at least as long as the target duration.
+     *              Fragments of all tracks are ordered by decoding time.
+     *              Only the fragment boundaries are computed up front.
+     *              Fragment headers are built one at a time, and sample
+     *              data is copied from the input file by the output
+     *              stream (see BinaryOutputStream::WriteSourceRange),
+     *              without being buffered.
+     */
+    class ISOBMFF_EXPORT Fragmenter
+    {
+        public:
+            
+            /*!
+             * @var         DefaultFragmentDuration
+             * @abstract    Default target duration of a fragment, in milliseconds.
+             */
+            static constexpr uint32_t DefaultFragmentDuration = 2000;
+            
+            /*!
+             * @function    Fragmenter
+             * @abstract    Prepares a file for fragmentation.
+             * @param       path                The input file path.
+             * @param       fragmentDuration    The target duration of a fragment, in milliseconds.
+             */
+            Fragmenter( const std::string & path, uint32_t fragmentDuration = DefaultFragmentDuration );
+            
+            Fragmenter( const Fragmenter & o );
+            Fragmenter( Fragmenter && o ) noexcept;
+            ~Fragmenter();
+            
+            Fragmenter & operator =( Fragmenter o );
+            
+            /*!
+             * @function    GetFragmentCount
+             * @abstract    Gets the number of fragments.
+             * @result      The number of fragments, for all tracks.
+             */
+            size_t GetFragmentCount() const;
+            
+            /*!
+             * @function    WriteInitSegment
+             * @abstract    Writes the initialization segment.
+             * @param       stream  The output stream.
+             */
+            void WriteInitSegment( BinaryOutputStream & stream ) const;
+            
+            /*!
+             * @function    WriteFragment
+             * @abstract    Writes a fragment.
+             * @param       stream  The output stream, which must be able to copy ranges of the input file.
+             * @param       index   The fragment index, from zero. The sequence number is index + 1.
+             */
+            void WriteFragment( BinaryOutputStream & stream, size_t index ) const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the fragmented file.
+             * @param       path    The output file path, which must differ from the input path.
+             */
+            void Write( const std::string & path ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Fragmenter & o1, Fragmenter & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_FRAGMENTER_HPP */
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      FrameTypeIndex.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_FRAME_TYPE_INDEX_HPP
+#define ISOBMFF_FRAME_TYPE_INDEX_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Track.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Executor.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       FrameTypeIndex
+     * @abstract    Per-sample frame types of an AVC or HEVC track.
+     * @discussion  Each sample's NAL units are walked using the length
+     *              size of the AVCC or HVCC box, and only the start of
+     *              each slice header is decoded, up to the slice type.
+     *              A frame is classified by its least restrictive slice
+     *              (B over P over I), and IDR pictures are reported
+     *              separately.
+     *              Samples are analyzed in parallel, chunk by chunk.
+     *              The result is stored as one byte per sample: the
+     *              frame type in the low 4 bits, and the HEVC temporal
+     *              ID in the high 4 bits.
+     */
+    class ISOBMFF_EXPORT FrameTypeIndex
+    {
+        public:
+            
+            /*!
+             * @enum        FrameType
+             * @abstract    Frame types.
+             * @constant    Unknown No slice could be classified (no VCL NAL unit, or only dependent slice segments).
+             * @constant    IDR     Instantaneous decoding refresh picture.
+             * @constant    I       Intra picture, including HEVC CRA and BLA pictures.
+             * @constant    P       Predicted picture.
+             * @constant    B       Bi-predicted picture.
+             */
+            enum class FrameType: uint8_t
+            {
+                Unknown = 0,
+                IDR     = 1,
+                I       = 2,
+                P       = 3,
+                B       = 4
+            };
+            
+            /*!
+             * @function    FrameTypeIndex
+             * @abstract    Creates the index of a track, from a file in memory, using the default executor.
+             * @param       track   The track, which must have an AVCC or HVCC box.
+             * @param       file    The whole file data.
+             */
+            FrameTypeIndex( const Track & track, Span< const uint8_t > file );
+            
+            /*!
+             * @function    FrameTypeIndex
+             * @abstract    Creates the index of a track, from a file in memory.
+             * @param       track       The track, which must have an AVCC or HVCC box.
+             * @param       file        The whole file data.
+             * @param       executor    The executor to use.
+             */
+            FrameTypeIndex( const Track & track, Span< const uint8_t > file, Executor & executor );
+            
+            /*!
+             * @function    FrameTypeIndex
+             * @abstract    Creates the index of a track, from a stream, using the default executor.
+             * @param       track   The track, which must have an AVCC or HVCC box.
+             * @param       stream  The stream of the whole file.
+             */
+            FrameTypeIndex( const Track & track, BinaryStream & stream );
+            
+            /*!
+             * @function    FrameTypeIndex
+             * @abstract    Creates the index of a track, from a stream.
+             * @discussion  Each chunk is read at once. Reads are serialized,
+             *              while the analysis of the chunks runs in
+             *              parallel.
+             * @param       track       The track, which must have an AVCC or HVCC box.
+             * @param       stream      The stream of the whole file.
+             * @param       executor    The executor to use.
+             */
+            FrameTypeIndex( const Track & track, BinaryStream & stream, Executor & executor );
+            
+            FrameTypeIndex( const FrameTypeIndex & o );
+            FrameTypeIndex( FrameTypeIndex && o ) noexcept;
+            ~FrameTypeIndex();
+            
+            FrameTypeIndex & operator =( FrameTypeIndex o );
+            
+            /*!
+             * @function    GetFrameType
+             * @abstract    Gets the frame type of an index entry.
+             * @param       entry   The index entry.
+             * @result      The frame type.
+             */
+            static FrameType GetFrameType( uint8_t entry );
+            
+            /*!
+             * @function    GetTemporalID
+             * @abstract    Gets the temporal ID of an index entry.
+             * @param       entry   The index entry.
+             * @result      The temporal ID (always 0 for AVC).
+             */
+            static uint8_t GetTemporalID( uint8_t entry );
+            
+            size_t                         GetSampleCount()                const;
+            FrameType                      GetFrameType( size_t sample )   const;
+            uint8_t                        GetTemporalID( size_t sample )  const;
+            const std::vector< uint8_t > & GetEntries()                    const;
+            
+            ISOBMFF_EXPORT friend void swap( FrameTypeIndex & o1, FrameTypeIndex & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_FRAME_TYPE_INDEX_HPP */
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      GridExtractor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_GRID_EXTRACTOR_HPP
+#define ISOBMFF_GRID_EXTRACTOR_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/META.hpp>
+#include <ISOBMFF/ImageGrid.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Executor.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       GridExtractor
+     * @abstract    Extracts the tiles of a HEIF grid item as HEVC bitstreams.
+     * @discussion  The grid descriptor is read from the grid item data,
+     *              and tiles are resolved from its dimg references, in
+     *              row-major order.
+     *              Each tile is converted to a decoder-ready Annex-B byte
+     *              stream, prefixed by the parameter sets of its HVCC
+     *              property.
+     *              Extraction is done in two phases: tile sizes are known
+     *              once the extractor is created, so callers can allocate
+     *              the output buffers, which are then filled in parallel.
+     */
+    class ISOBMFF_EXPORT GridExtractor
+    {
+        public:
+            
+            /*!
+             * @function    GridExtractor
+             * @abstract    Creates an extractor for a grid item, from a file in memory.
+             * @param       meta    The META box.
+             * @param       itemID  The grid item ID.
+             * @param       file    The whole file data, which must stay valid for the lifetime of the extractor.
+             */
+            GridExtractor( const META & meta, uint32_t itemID, Span< const uint8_t > file );
+            
+            /*!
+             * @function    GridExtractor
+             * @abstract    Creates an extractor for a grid item, from a stream.
+             * @discussion  The data of all tiles is read at once, with
+             *              coalesced reads.
+             * @param       meta    The META box.
+             * @param       itemID  The grid item ID.
+             * @param       stream  The stream of the whole file.
+             */
+            GridExtractor( const META & meta, uint32_t itemID, BinaryStream & stream );
+            
+            GridExtractor( const GridExtractor & o ) = delete;
+            GridExtractor( GridExtractor && o ) noexcept;
+            ~GridExtractor();
+            
+            GridExtractor & operator =( GridExtractor o );
+            
+            /*!
+             * @function    GetGrid
+             * @abstract    Gets the grid descriptor.
+             * @result      The grid descriptor.
+             */
+            const ImageGrid & GetGrid() const;
+            
+            /*!
+             * @function    GetTileCount
+             * @abstract    Gets the number of tiles.
+             * @result      The number of tiles (rows * columns).
+             */
+            size_t GetTileCount() const;
+            
+            /*!
+             * @function    GetTileItemID
+             * @abstract    Gets the item ID of a tile.
+             * @param       index   The tile index, in row-major order.
+             * @result      The tile item ID.
+             */
+            uint32_t GetTileItemID( size_t index ) const;
+            
+            /*!
+             * @function    GetTileSize
+             * @abstract    Gets the size of the bitstream of a tile.
+             * @param       index   The tile index, in row-major order.
+             * @result      The size of the Annex-B bitstream, including parameter sets.
+             */
+            size_t GetTileSize( size_t index ) const;
+            
+            /*!
+             * @function    ExtractTile
+             * @abstract    Writes the bitstream of a tile.
+             * @param       index   The tile index, in row-major order.
+             * @param       buffer  The output buffer, of at least GetTileSize() bytes.
+             * @result      The number of bytes written.
+             */
+            size_t ExtractTile( size_t index, Span< uint8_t > buffer ) const;
+            
+            /*!
+             * @function    ExtractTiles
+             * @abstract    Writes the bitstreams of all tiles in parallel, using the default executor.
+             * @param       buffers The output buffers, one per tile, in row-major order.
+             */
+            void ExtractTiles( const std::vector< Span< uint8_t > > & buffers ) const;
+            
+            /*!
+             * @function    ExtractTiles
+             * @abstract    Writes the bitstreams of all tiles in parallel.
+             * @param       buffers     The output buffers, one per tile, in row-major order.
+             * @param       executor    The executor to use.
+             */
+            void ExtractTiles( const std::vector< Span< uint8_t > > & buffers, Executor & executor ) const;
+            
+            ISOBMFF_EXPORT friend void swap( GridExtractor & o1, GridExtractor & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_GRID_EXTRACTOR_HPP */
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      HEIFSummary.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_HEIF_SUMMARY_HPP
+#define ISOBMFF_HEIF_SUMMARY_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @struct      HEIFSummary
+     * @abstract    Summary of the primary image of a HEIF file.
+     * @discussion  The summary is read directly from the bytes of the META
+     *              box, without creating box objects, and without any heap
+     *              allocation.
+     *              For grid images, the codec (and the bit depth, if there
+     *              is no PIXI property) is taken from the first tile, as
+     *              well as the colour information (ICC profile and NCLX
+     *              values) if the grid item has no COLR property.
+     */
+    struct ISOBMFF_EXPORT HEIFSummary
+    {
+        /*!
+         * @enum        Codec
+         * @abstract    The codec of the primary image.
+         */
+        enum class Codec: uint8_t
+        {
+            Unknown,
+            HEVC,
+            AVC
+        };
+        
+        uint32_t primaryItemID;
+        bool     isGrid;
+        Codec    codec;
+        uint32_t width;
+        uint32_t height;
+        uint8_t  rotation;
+        uint8_t  bitDepth;
+        bool     hasNCLX;
+        uint16_t colourPrimaries;
+        uint16_t transferCharacteristics;
+        uint16_t matrixCoefficients;
+        bool     fullRange;
+        bool     hasICCProfile;
+        uint32_t thumbnailCount;
+        uint32_t auxiliaryImageCount;
+        
+        /*!
+         * @function    Read
+         * @abstract    Reads the summary from the bytes of a META box.
+         * @param       meta    The META box bytes, including the box header.
+         * @result      The summary.
+         * @discussion  Throws if the META box is malformed.
+         */
+        static HEIFSummary Read( Span< const uint8_t > meta );
+        
+        /*!
+         * @function    Read
+         * @abstract    Reads the summary of a HEIF file.
+         * @param       stream  The stream of the whole file.
+         * @result      The summary.
+         * @discussion  Only the top-level box headers, up to the first META
+         *              box, and the META box are read.
+         */
+        static HEIFSummary Read( BinaryStream & stream );
+        
+        /*!
+         * @function    FindMETA
+         * @abstract    Locates the first top-level META box of a file.
+         * @param       stream  The stream of the whole file.
+         * @param       offset  On return, the offset of the META box.
+         * @param       size    On return, the size of the META box, including its header.
+         * @result      true if a META box was found, otherwise false.
+         * @discussion  Only top-level box headers are read.
+         */
+        static bool FindMETA( BinaryStream & stream, uint64_t & offset, uint64_t & size );
+    };
+}
+
+#endif /* ISOBMFF_HEIF_SUMMARY_HPP */
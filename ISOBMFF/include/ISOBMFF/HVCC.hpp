@@ -53,8 +53,10 @@ namespace ISOBMFF
             
             HVCC & operator =( HVCC o );
             
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
             
             virtual std::vector< std::shared_ptr< DisplayableObject > >  GetDisplayableObjects()    const override;
             virtual std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
@@ -134,8 +136,10 @@ namespace ISOBMFF
                             
                             std::string GetName() const override;
                             
-                            std::vector< uint8_t > GetData() const;
+                            std::vector< uint8_t > GetData()     const;
+                            Span< const uint8_t >  GetDataSpan() const;
                             void                   SetData( const std::vector< uint8_t > & value );
+                            void                   SetData( std::vector< uint8_t > && value );
                             
                             virtual std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
                             
@@ -36,6 +36,7 @@
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/Container.hpp>
 #include <ISOBMFF/FullBox.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <ISOBMFF/INFE.hpp>
 #include <vector>
 
@@ -52,11 +53,14 @@ namespace ISOBMFF
             
             IINF & operator =( IINF o );
             
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
             
             void                                   AddEntry( std::shared_ptr< INFE > entry );
             std::vector< std::shared_ptr< INFE > > GetEntries()                   const;
+            Span< const std::shared_ptr< INFE > >  GetEntriesSpan()               const;
             std::shared_ptr< INFE >                GetItemInfo( uint32_t itemID ) const;
             
             void                                  AddBox( std::shared_ptr< Box > box ) override;
@@ -36,6 +36,7 @@
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/FullBox.hpp>
 #include <ISOBMFF/DisplayableObjectContainer.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <cstdint>
 #include <vector>
 
@@ -52,8 +53,10 @@ namespace ISOBMFF
             
             ILOC & operator =( ILOC o );
             
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
             
             virtual std::vector< std::shared_ptr< DisplayableObject > >  GetDisplayableObjects()    const override;
             virtual std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
@@ -125,27 +128,79 @@ namespace ISOBMFF
                             
                         private:
                             
+                            friend class Item;
+                            
+                            void SetModifiedFlag( const std::shared_ptr< bool > & flag );
+                            
                             class IMPL;
                             
                             std::unique_ptr< IMPL > impl;
                     };
                     
-                    std::vector< std::shared_ptr< Extent > > GetExtents() const;
+                    std::vector< std::shared_ptr< Extent > > GetExtents()     const;
+                    Span< const std::shared_ptr< Extent > >  GetExtentsSpan() const;
                     void                                     AddExtent( std::shared_ptr< Extent > extent );
                     
                     ISOBMFF_EXPORT friend void swap( Item & o1, Item & o2 );
                     
                 private:
                     
+                    friend class ILOC;
+                    
+                    void SetModifiedFlag( const std::shared_ptr< bool > & flag );
+                    
                     class IMPL;
                     
                     std::unique_ptr< IMPL > impl;
             };
             
+            /*!
+             * @struct      Table
+             * @abstract    Columnar storage of the ILOC items.
+             * @discussion  Item fields are stored in parallel arrays, indexed
+             *              by item. The extents of item i are stored in the
+             *              extent arrays, from extentStarts[ i ] to
+             *              extentStarts[ i + 1 ].
+             *              Item objects are only created when accessed, from
+             *              the table, one at a time with GetItemAtIndex.
+             *              Once created, they are the reference: changes made
+             *              through their setters mark the table as modified,
+             *              and it is rebuilt from the items the next time it
+             *              is read or written. Otherwise, reading the table
+             *              is free.
+             *              Like other boxes, an ILOC box is not thread-safe,
+             *              and the table returned by GetTable is only valid
+             *              until the box or its items are changed.
+             */
+            struct Table
+            {
+                std::vector< uint32_t > itemIDs;
+                std::vector< uint8_t >  constructionMethods;
+                std::vector< uint16_t > dataReferenceIndices;
+                std::vector< uint64_t > baseOffsets;
+                std::vector< uint32_t > extentStarts;
+                std::vector< uint64_t > extentIndices;
+                std::vector< uint64_t > extentOffsets;
+                std::vector< uint64_t > extentLengths;
+            };
+            
+            const Table & GetTable() const;
+            
             std::vector< std::shared_ptr< Item > > GetItems()                 const;
+            Span< const std::shared_ptr< Item > >  GetItemsSpan()             const;
             std::shared_ptr< Item >                GetItem( uint32_t itemID ) const;
             void                                   AddItem( std::shared_ptr< Item > item );
             
+            /*!
+             * @function    GetItemAtIndex
+             * @abstract    Gets the item at a specific index of the table.
+             * @discussion  Only this item is created, if it was not already.
+             *              The same object is returned by GetItems.
+             * @param       index   The index of the item in the table.
+             * @result      The item, or nullptr if the index is out of bounds.
+             */
+            std::shared_ptr< Item > GetItemAtIndex( size_t index ) const;
+            
             ISOBMFF_EXPORT friend void swap( ILOC & o1, ILOC & o2 );
             
         private:
@@ -52,6 +52,8 @@ namespace ISOBMFF
             INFE & operator =( INFE o );
             
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
             uint32_t    GetItemID()              const;
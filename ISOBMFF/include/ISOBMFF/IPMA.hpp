@@ -37,6 +37,7 @@
 #include <ISOBMFF/FullBox.hpp>
 #include <ISOBMFF/DisplayableObject.hpp>
 #include <ISOBMFF/DisplayableObjectContainer.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <vector>
 #include <cstdint>
 
@@ -53,8 +54,10 @@ namespace ISOBMFF
             
             IPMA & operator =( IPMA o );
             
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
             
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             std::vector< std::shared_ptr< DisplayableObject > >  GetDisplayableObjects()    const override;
@@ -107,24 +110,60 @@ namespace ISOBMFF
                             
                         private:
                             
+                            friend class Entry;
+                            
+                            void SetModifiedFlag( const std::shared_ptr< bool > & flag );
+                            
                             class IMPL;
                             
                             std::unique_ptr< IMPL > impl;
                     };
                     
-                    std::vector< std::shared_ptr< Association > > GetAssociations() const;
+                    std::vector< std::shared_ptr< Association > > GetAssociations()     const;
+                    Span< const std::shared_ptr< Association > >  GetAssociationsSpan() const;
                     void                                          AddAssociation( std::shared_ptr< Association > association );
                     
                     ISOBMFF_EXPORT friend void swap( Entry & o1, Entry & o2 );
                     
                 private:
                     
+                    friend class IPMA;
+                    
+                    void SetModifiedFlag( const std::shared_ptr< bool > & flag );
+                    
                     class IMPL;
                     
                     std::unique_ptr< IMPL > impl;
             };
             
+            /*!
+             * @struct      Table
+             * @abstract    Columnar storage of the IPMA entries.
+             * @discussion  The associations of entry i are stored in the
+             *              association arrays, from associationStarts[ i ] to
+             *              associationStarts[ i + 1 ]. Property indices are
+             *              1-based, 0 meaning no property.
+             *              Entry objects are only created when accessed, from
+             *              the table. Once created, they are the reference:
+             *              changes made through their setters mark the table
+             *              as modified, and it is rebuilt from the entries the
+             *              next time it is read or written.
+             *              Like other boxes, an IPMA box is not thread-safe,
+             *              and the table returned by GetTable is only valid
+             *              until the box or its entries are changed.
+             */
+            struct Table
+            {
+                std::vector< uint32_t > itemIDs;
+                std::vector< uint32_t > associationStarts;
+                std::vector< uint16_t > propertyIndices;
+                std::vector< uint8_t >  essentials;
+            };
+            
+            const Table & GetTable() const;
+            
             std::vector< std::shared_ptr< Entry > > GetEntries()                const;
+            Span< const std::shared_ptr< Entry > >  GetEntriesSpan()            const;
             std::shared_ptr< Entry >                GetEntry( uint32_t itemID ) const;
             void                                    AddEntry( std::shared_ptr< Entry > entry );
             
@@ -36,6 +36,8 @@
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/Container.hpp>
 #include <ISOBMFF/FullBox.hpp>
+#include <vector>
+#include <cstdint>
 
 namespace ISOBMFF
 {
@@ -50,11 +52,44 @@ namespace ISOBMFF
             
             IREF & operator =( IREF o );
             
-            void ReadData( Parser & parser, BinaryStream & stream ) override;
-            void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            void     ReadData( Parser & parser, BinaryStream & stream ) override;
+            void     WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
+            uint64_t GetDataSize() const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
             
             void                                  AddBox( std::shared_ptr< Box > box ) override;
             std::vector< std::shared_ptr< Box > > GetBoxes() const override;
+            Span< const std::shared_ptr< Box > >  GetBoxesSpan() const override;
+            
+            /*!
+             * @struct      Table
+             * @abstract    Columnar storage of the item references.
+             * @discussion  Each reference box is stored as a reference type
+             *              (four character code) and a referencing item ID.
+             *              The referenced item IDs of reference i are stored
+             *              from toStarts[ i ] to toStarts[ i + 1 ].
+             *              Reference boxes are only created when accessed,
+             *              from the table, with the classes registered in
+             *              the parser (like DIMG or THMB). Types whose class
+             *              is not a SingleItemTypeReferenceBox are parsed as
+             *              usual.
+             *              Once created, the boxes are the reference: changes
+             *              made through their setters mark the table as
+             *              modified, and it is rebuilt from the boxes the next
+             *              time it is read or written.
+             *              Like other boxes, an IREF box is not thread-safe,
+             *              and the table returned by GetTable is only valid
+             *              until the box or its references are changed.
+             */
+            struct Table
+            {
+                std::vector< uint32_t > types;
+                std::vector< uint32_t > fromItemIDs;
+                std::vector< uint32_t > toStarts;
+                std::vector< uint32_t > toItemIDs;
+            };
+            
+            const Table & GetTable() const;
             
             ISOBMFF_EXPORT friend void swap( IREF & o1, IREF & o2 );
             
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      InPlaceEditor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_IN_PLACE_EDITOR_HPP
+#define ISOBMFF_IN_PLACE_EDITOR_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/File.hpp>
+#include <ISOBMFF/Box.hpp>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       InPlaceEditor
+     * @abstract    Replaces metadata boxes (moov, meta, udta, ilst, etc.)
+     *              of a file without rewriting its media data.
+     * @discussion  The file is parsed without MDAT data.
+     *              A replacement box is written in place, with a single
+     *              positioned write, when it fits in the extent of the
+     *              original box plus the FREE or SKIP boxes adjacent to
+     *              it. The remaining space is written as a FREE box.
+     *              A top-level box at the end of the file may also grow.
+     *              Otherwise, the whole file is rewritten through a
+     *              temporary file, which then replaces the original file.
+     *              Top-level boxes keep their order, and the chunk offsets
+     *              (STCO/CO64) and item locations (ILOC, construction
+     *              method 0) are updated for the boxes that move. If the
+     *              rewrite fails, the boxes of the file are left as they
+     *              were before the call.
+     *              The file is parsed again after each replacement, so
+     *              boxes obtained before must not be used anymore.
+     */
+    class ISOBMFF_EXPORT InPlaceEditor
+    {
+        public:
+            
+            /*!
+             * @function    InPlaceEditor
+             * @abstract    Opens a file for editing.
+             * @param       path    The file path.
+             */
+            InPlaceEditor( const std::string & path );
+            
+            InPlaceEditor( const InPlaceEditor & o );
+            InPlaceEditor( InPlaceEditor && o ) noexcept;
+            ~InPlaceEditor();
+            
+            InPlaceEditor & operator =( InPlaceEditor o );
+            
+            /*!
+             * @function    GetFile
+             * @abstract    Gets the boxes of the file.
+             * @result      The file, as parsed after the last replacement.
+             */
+            std::shared_ptr< File > GetFile() const;
+            
+            /*!
+             * @function    CanReplaceInPlace
+             * @abstract    Checks if a box can be replaced without rewriting the file.
+             * @param       box         A box of the file.
+             * @param       replacement The new box.
+             * @result      true if the replacement fits in place, otherwise false.
+             */
+            bool CanReplaceInPlace( const std::shared_ptr< Box > & box, const Box & replacement ) const;
+            
+            /*!
+             * @function    Replace
+             * @abstract    Replaces a box in the file.
+             * @param       box         A box of the file.
+             * @param       replacement The new box, which may be box itself after modification.
+             * @result      true if the box was replaced in place, false if the file was rewritten.
+             */
+            bool Replace( const std::shared_ptr< Box > & box, std::shared_ptr< Box > replacement );
+            
+            ISOBMFF_EXPORT friend void swap( InPlaceEditor & o1, InPlaceEditor & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_IN_PLACE_EDITOR_HPP */
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ItemGraph.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ITEM_GRAPH_HPP
+#define ISOBMFF_ITEM_GRAPH_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/META.hpp>
+#include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/INFE.hpp>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ItemGraph
+     * @abstract    Index of the items of a META box.
+     * @discussion  The graph is built once, from the ILOC, IINF, IREF, IPCO
+     *              and IPMA boxes of a META box, and provides constant time
+     *              lookups of an item's location, info entry, properties and
+     *              references.
+     *              The graph keeps references to the boxes it was built
+     *              from, which should not be modified afterwards.
+     */
+    class ISOBMFF_EXPORT ItemGraph
+    {
+        public:
+            
+            /*!
+             * @function    ItemGraph
+             * @abstract    Creates an empty graph.
+             */
+            ItemGraph();
+            
+            /*!
+             * @function    ItemGraph
+             * @abstract    Creates a graph for the items of a META box.
+             * @param       meta    The META box.
+             */
+            ItemGraph( const META & meta );
+            
+            ItemGraph( const ItemGraph & o );
+            ItemGraph( ItemGraph && o ) noexcept;
+            ~ItemGraph();
+            
+            ItemGraph & operator =( ItemGraph o );
+            
+            /*!
+             * @function    GetPrimaryItemID
+             * @abstract    Gets the primary item ID, from the PITM box.
+             * @result      The primary item ID, or 0 if there is no PITM box.
+             */
+            uint32_t GetPrimaryItemID() const;
+            
+            /*!
+             * @function    GetItemIDs
+             * @abstract    Gets the IDs of all the items.
+             * @discussion  Items are listed in IINF order, followed by items
+             *              only found in the ILOC or IPMA boxes.
+             * @result      The item IDs.
+             */
+            const std::vector< uint32_t > & GetItemIDs() const;
+            
+            /*!
+             * @function    HasItem
+             * @abstract    Checks if an item exists.
+             * @param       itemID  The item ID.
+             * @result      true if the item has an info entry or a location, otherwise false.
+             */
+            bool HasItem( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetItemType
+             * @abstract    Gets the type of an item (eg: hvc1, grid, Exif).
+             * @param       itemID  The item ID.
+             * @result      The item type, or an empty string.
+             */
+            std::string GetItemType( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetInfo
+             * @abstract    Gets the info entry of an item.
+             * @param       itemID  The item ID.
+             * @result      The INFE entry, or nullptr.
+             */
+            std::shared_ptr< INFE > GetInfo( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetLocation
+             * @abstract    Gets the location of an item.
+             * @param       itemID  The item ID.
+             * @result      The ILOC item, or nullptr.
+             */
+            std::shared_ptr< ILOC::Item > GetLocation( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetProperties
+             * @abstract    Gets the properties associated to an item.
+             * @discussion  Properties are resolved from the IPMA associations
+             *              through the IPCO box, in association order.
+             * @param       itemID  The item ID.
+             * @result      The property boxes.
+             */
+            const std::vector< std::shared_ptr< Box > > & GetProperties( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetProperty
+             * @abstract    Gets the first property of a specific type associated to an item.
+             * @param       itemID  The item ID.
+             * @param       type    The property type (eg: ispe, hvcC).
+             * @result      The property box, or nullptr.
+             */
+            std::shared_ptr< Box > GetProperty( uint32_t itemID, const std::string & type ) const;
+            
+            /*!
+             * @function    GetTypedProperty
+             * @abstract    Gets the first property of a specific type associated to an item.
+             * @param       itemID  The item ID.
+             * @param       type    The property type (eg: ispe, hvcC).
+             * @result      The property box, or nullptr if not found, or not of the requested class.
+             */
+            template< class _T_ >
+            std::shared_ptr< _T_ > GetTypedProperty( uint32_t itemID, const std::string & type ) const
+            {
+                return std::dynamic_pointer_cast< _T_ >( this->GetProperty( itemID, type ) );
+            }
+            
+            /*!
+             * @function    GetReferences
+             * @abstract    Gets the items referenced by an item.
+             * @discussion  Eg: the tiles of a grid item, for dimg.
+             * @param       fromItemID  The referencing item ID.
+             * @param       type        The reference type (eg: dimg, thmb, cdsc).
+             * @result      The referenced item IDs, in IREF order.
+             */
+            const std::vector< uint32_t > & GetReferences( uint32_t fromItemID, const std::string & type ) const;
+            
+            /*!
+             * @function    GetReferencingItems
+             * @abstract    Gets the items referencing an item.
+             * @discussion  Eg: the thumbnails of an image, for thmb.
+             * @param       toItemID    The referenced item ID.
+             * @param       type        The reference type (eg: dimg, thmb, cdsc).
+             * @result      The referencing item IDs, in IREF order.
+             */
+            const std::vector< uint32_t > & GetReferencingItems( uint32_t toItemID, const std::string & type ) const;
+            
+            ISOBMFF_EXPORT friend void swap( ItemGraph & o1, ItemGraph & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_ITEM_GRAPH_HPP */
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ItemReader.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ITEM_READER_HPP
+#define ISOBMFF_ITEM_READER_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/META.hpp>
+#include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ItemReader
+     * @abstract    Resolves and reads the data of the items of a META box.
+     * @discussion  Item extents are resolved from the ILOC box, for
+     *              construction methods 0 (file offset) and 1 (IDAT box).
+     *              Construction method 2 (item offset) and items stored in
+     *              external files (non-zero data reference index) are not
+     *              supported, and will throw when accessed.
+     *              The IDAT box data is copied once, when the reader is
+     *              created.
+     */
+    class ISOBMFF_EXPORT ItemReader
+    {
+        public:
+            
+            /*!
+             * @enum        Source
+             * @abstract    The source of an item extent.
+             */
+            enum class Source
+            {
+                File,
+                IDAT
+            };
+            
+            /*!
+             * @struct      Range
+             * @abstract    A resolved item extent.
+             * @field       source  The source of the extent data.
+             * @field       offset  The absolute offset of the extent data, in the source.
+             * @field       length  The length of the extent data, or 0 for all the remaining data of the source.
+             */
+            struct Range
+            {
+                Source   source;
+                uint64_t offset;
+                uint64_t length;
+            };
+            
+            /*!
+             * @function    ItemReader
+             * @abstract    Creates an empty reader.
+             */
+            ItemReader();
+            
+            /*!
+             * @function    ItemReader
+             * @abstract    Creates a reader for the items of a META box.
+             * @param       meta    The META box.
+             */
+            ItemReader( const META & meta );
+            
+            ItemReader( const ItemReader & o );
+            ItemReader( ItemReader && o ) noexcept;
+            ~ItemReader();
+            
+            ItemReader & operator =( ItemReader o );
+            
+            /*!
+             * @function    HasItem
+             * @abstract    Checks if an item has a location.
+             * @param       itemID  The item ID.
+             * @result      true if the item is listed in the ILOC box, otherwise false.
+             */
+            bool HasItem( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetRanges
+             * @abstract    Gets the resolved extents of an item.
+             * @param       itemID  The item ID.
+             * @result      The item extents, in ILOC order.
+             */
+            const std::vector< Range > & GetRanges( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetIDATData
+             * @abstract    Gets the data of the IDAT box.
+             * @result      The IDAT box data, or an empty span.
+             */
+            Span< const uint8_t > GetIDATData() const;
+            
+            /*!
+             * @function    GetItemSpans
+             * @abstract    Gets the data of an item, from a file in memory.
+             * @discussion  No data is copied. Spans point either to the file
+             *              data or to the IDAT data owned by the reader.
+             * @param       itemID  The item ID.
+             * @param       file    The whole file data.
+             * @result      The data of each extent of the item, in ILOC order.
+             */
+            std::vector< Span< const uint8_t > > GetItemSpans( uint32_t itemID, Span< const uint8_t > file ) const;
+            
+            /*!
+             * @function    ReadItem
+             * @abstract    Reads the data of an item from a stream.
+             * @discussion  The stream position is undefined afterwards.
+             * @param       itemID  The item ID.
+             * @param       stream  The stream of the whole file.
+             * @result      The item data, with all extents concatenated.
+             */
+            std::vector< uint8_t > ReadItem( uint32_t itemID, BinaryStream & stream ) const;
+            
+            /*!
+             * @function    ReadItems
+             * @abstract    Reads the data of multiple items from a stream.
+             * @discussion  The file extents of all items are sorted, and
+             *              adjacent or overlapping extents are merged, so the
+             *              stream is read with the least possible number of
+             *              reads, in increasing offset order.
+             *              The stream position is undefined afterwards.
+             * @param       itemIDs The item IDs.
+             * @param       stream  The stream of the whole file.
+             * @result      The data of each item, in the order of the item IDs.
+             */
+            std::vector< std::vector< uint8_t > > ReadItems( const std::vector< uint32_t > & itemIDs, BinaryStream & stream ) const;
+            
+            ISOBMFF_EXPORT friend void swap( ItemReader & o1, ItemReader & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_ITEM_READER_HPP */
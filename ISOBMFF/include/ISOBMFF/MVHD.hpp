@@ -51,6 +51,8 @@ namespace ISOBMFF
             MVHD & operator =( MVHD o );
             
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
             uint64_t GetCreationTime()     const;
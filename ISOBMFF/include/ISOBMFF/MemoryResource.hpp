@@ -0,0 +1,264 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      MemoryResource.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_MEMORY_RESOURCE_HPP
+#define ISOBMFF_MEMORY_RESOURCE_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       MemoryResource
+     * @abstract    Abstract memory resource.
+     * @discussion  Equivalent to std::pmr::memory_resource, which is not
+     *              available in C++14.
+     *              While parsing, the library allocates shared objects (boxes
+     *              and their entries) from the current memory resource of the
+     *              calling thread, if any.
+     * @see         MonotonicBufferResource
+     * @see         MakeShared
+     */
+    class ISOBMFF_EXPORT MemoryResource
+    {
+        public:
+            
+            /*!
+             * @class       Scope
+             * @abstract    Sets the current memory resource of the calling thread, for the lifetime of the object.
+             */
+            class Scope
+            {
+                public:
+                    
+                    Scope( const std::shared_ptr< MemoryResource > & resource ):
+                        _previous( MemoryResource::GetCurrent() )
+                    {
+                        MemoryResource::SetCurrent( resource );
+                    }
+                    
+                    ~Scope()
+                    {
+                        MemoryResource::SetCurrent( this->_previous );
+                    }
+                    
+                    Scope( const Scope & o )              = delete;
+                    Scope & operator =( const Scope & o ) = delete;
+                    
+                private:
+                    
+                    std::shared_ptr< MemoryResource > _previous;
+            };
+            
+            /*!
+             * @function    GetCurrent
+             * @abstract    Gets the current memory resource of the calling thread.
+             * @result      The current memory resource, or nullptr if the default allocator is used.
+             */
+            static const std::shared_ptr< MemoryResource > & GetCurrent();
+            
+            /*!
+             * @function    SetCurrent
+             * @abstract    Sets the current memory resource of the calling thread.
+             * @param       resource    The memory resource, or nullptr to use the default allocator.
+             * @see         Scope
+             */
+            static void SetCurrent( const std::shared_ptr< MemoryResource > & resource );
+            
+            virtual ~MemoryResource() = default;
+            
+            /*!
+             * @function    Allocate
+             * @abstract    Allocates memory.
+             * @param       size        The number of bytes to allocate.
+             * @param       alignment   The required alignment.
+             * @result      The allocated memory.
+             */
+            virtual void * Allocate( size_t size, size_t alignment ) = 0;
+            
+            /*!
+             * @function    Deallocate
+             * @abstract    Deallocates memory.
+             * @param       p           The memory to deallocate.
+             * @param       size        The size passed to Allocate.
+             * @param       alignment   The alignment passed to Allocate.
+             */
+            virtual void Deallocate( void * p, size_t size, size_t alignment ) = 0;
+    };
+    
+    /*!
+     * @class       MonotonicBufferResource
+     * @abstract    Memory resource allocating from large blocks, and only releasing memory when destroyed.
+     * @discussion  Equivalent to std::pmr::monotonic_buffer_resource.
+     *              Deallocate does nothing, so tearing down objects allocated
+     *              from this resource does not involve the system allocator.
+     *              This class is not thread-safe.
+     */
+    class ISOBMFF_EXPORT MonotonicBufferResource: public MemoryResource
+    {
+        public:
+            
+            /*!
+             * @function    MonotonicBufferResource
+             * @abstract    Creates a monotonic buffer resource.
+             * @param       blockSize   The size of the first block. Subsequent blocks grow geometrically.
+             */
+            MonotonicBufferResource( size_t blockSize = 4096 );
+            
+            virtual ~MonotonicBufferResource() override;
+            
+            MonotonicBufferResource( const MonotonicBufferResource & o )              = delete;
+            MonotonicBufferResource( MonotonicBufferResource && o )                   = delete;
+            MonotonicBufferResource & operator =( const MonotonicBufferResource & o ) = delete;
+            MonotonicBufferResource & operator =( MonotonicBufferResource && o )      = delete;
+            
+            void * Allocate( size_t size, size_t alignment )             override;
+            void   Deallocate( void * p, size_t size, size_t alignment ) override;
+            
+            /*!
+             * @function    GetAllocatedBytes
+             * @abstract    Gets the total size of the blocks allocated by this resource.
+             * @result      The number of bytes.
+             */
+            size_t GetAllocatedBytes() const;
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+    
+    /*!
+     * @class       PolymorphicAllocator
+     * @abstract    Standard allocator using a memory resource.
+     * @discussion  The allocator keeps a reference to the memory resource, so
+     *              the resource lives as long as objects allocated from it.
+     */
+    template< class _T_ >
+    class PolymorphicAllocator
+    {
+        public:
+            
+            typedef _T_ value_type;
+            
+            PolymorphicAllocator( const std::shared_ptr< MemoryResource > & resource ):
+                _resource( resource )
+            {}
+            
+            template< class _U_ >
+            PolymorphicAllocator( const PolymorphicAllocator< _U_ > & o ):
+                _resource( o.GetResource() )
+            {}
+            
+            _T_ * allocate( size_t n )
+            {
+                return static_cast< _T_ * >( this->_resource->Allocate( n * sizeof( _T_ ), alignof( _T_ ) ) );
+            }
+            
+            void deallocate( _T_ * p, size_t n )
+            {
+                this->_resource->Deallocate( p, n * sizeof( _T_ ), alignof( _T_ ) );
+            }
+            
+            const std::shared_ptr< MemoryResource > & GetResource() const
+            {
+                return this->_resource;
+            }
+            
+            template< class _U_ >
+            bool operator ==( const PolymorphicAllocator< _U_ > & o ) const
+            {
+                return this->_resource == o.GetResource();
+            }
+            
+            template< class _U_ >
+            bool operator !=( const PolymorphicAllocator< _U_ > & o ) const
+            {
+                return this->_resource != o.GetResource();
+            }
+            
+        private:
+            
+            std::shared_ptr< MemoryResource > _resource;
+    };
+    
+    /*!
+     * @class       ResourceAllocated
+     * @abstract    Base class for objects allocated from the current memory resource.
+     * @discussion  The class-specific allocation functions use the current
+     *              memory resource of the calling thread, if any, and the
+     *              global allocator otherwise.
+     *              Each object keeps a reference to its memory resource, so
+     *              it is released to the right resource, from any thread,
+     *              and the resource lives as long as the object.
+     *              Only the private implementation classes of boxes, and of
+     *              their entries, derive from this class, so they are
+     *              allocated along with their boxes while parsing. Other
+     *              classes (streams, writers, executors) are not created
+     *              per box, and use the global allocator.
+     * @see         MemoryResource::GetCurrent
+     */
+    class ISOBMFF_EXPORT ResourceAllocated
+    {
+        public:
+            
+            static void * operator new( size_t size );
+            static void   operator delete( void * p, size_t size ) noexcept;
+    };
+    
+    /*!
+     * @function    MakeShared
+     * @abstract    Creates a shared object, using the current memory resource of the calling thread, if any.
+     * @discussion  Without a current memory resource, this is equivalent to
+     *              std::make_shared.
+     * @param       args    The constructor arguments.
+     * @result      The new object.
+     * @see         MemoryResource::GetCurrent
+     */
+    template< class _T_, class ... _A_ >
+    std::shared_ptr< _T_ > MakeShared( _A_ && ... args )
+    {
+        const std::shared_ptr< MemoryResource > & resource = MemoryResource::GetCurrent();
+        
+        if( resource == nullptr )
+        {
+            return std::make_shared< _T_ >( std::forward< _A_ >( args ) ... );
+        }
+        
+        return std::allocate_shared< _T_ >( PolymorphicAllocator< _T_ >( resource ), std::forward< _A_ >( args ) ... );
+    }
+}
+
+#endif /* ISOBMFF_MEMORY_RESOURCE_HPP */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      MovieSummary.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_MOVIE_SUMMARY_HPP
+#define ISOBMFF_MOVIE_SUMMARY_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace ISOBMFF
+{
+    /*!
+     * @struct      MovieSummary
+     * @abstract    Summary of the tracks of a movie file.
+     * @discussion  The summary is read by seeking through box headers,
+     *              wherever the MOOV box is located. Only the first bytes of
+     *              the MVHD, TKHD, MDHD, HDLR, STSD and STSZ (or STZ2) boxes
+     *              are read; sample tables are never decoded.
+     *              No heap allocation is done, apart from the stream itself.
+     */
+    struct ISOBMFF_EXPORT MovieSummary
+    {
+        /*!
+         * @constant    MaxTracks
+         * @abstract    The maximum number of tracks described by a summary.
+         */
+        static constexpr size_t MaxTracks = 16;
+        
+        /*!
+         * @struct      Track
+         * @abstract    Summary of a track.
+         * @field       trackID     The track ID, from TKHD.
+         * @field       width       The track width, in pixels, from TKHD.
+         * @field       height      The track height, in pixels, from TKHD.
+         * @field       timescale   The media timescale, from MDHD.
+         * @field       duration    The media duration, in timescale units, from MDHD.
+         * @field       language    The ISO-639-2/T language code, from MDHD, or an empty string for QuickTime language codes.
+         * @field       handlerType The handler type (eg: vide, soun), from HDLR.
+         * @field       codec       The type of the first sample entry (eg: avc1, hvc1), from STSD.
+         * @field       sampleCount The number of samples, from STSZ or STZ2.
+         */
+        struct Track
+        {
+            uint32_t trackID;
+            uint32_t width;
+            uint32_t height;
+            uint32_t timescale;
+            uint64_t duration;
+            char     language[ 4 ];
+            char     handlerType[ 5 ];
+            char     codec[ 5 ];
+            uint32_t sampleCount;
+        };
+        
+        uint32_t timescale;
+        uint64_t duration;
+        uint32_t trackCount;
+        Track    tracks[ MaxTracks ];
+        
+        /*!
+         * @function    Read
+         * @abstract    Reads the summary of a movie file.
+         * @param       stream  The stream of the whole file.
+         * @result      The summary.
+         * @discussion  Throws if there is no MOOV box. If the movie has
+         *              more than MaxTracks tracks, trackCount is the total
+         *              number of tracks, but only the first MaxTracks are
+         *              described.
+         */
+        static MovieSummary Read( BinaryStream & stream );
+        
+        /*!
+         * @function    Read
+         * @abstract    Reads the summary of a movie file.
+         * @param       path    The file path.
+         * @result      The summary.
+         */
+        static MovieSummary Read( const std::string & path );
+    };
+}
+
+#endif /* ISOBMFF_MOVIE_SUMMARY_HPP */
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Muxer.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_MUXER_HPP
+#define ISOBMFF_MUXER_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Muxer
+     * @abstract    Writes encoded samples to a MP4 or QuickTime file.
+     * @discussion  Sample data is written to the MDAT box as soon as it is
+     *              received, and consecutive samples of a track are
+     *              grouped in chunks. Only the run-length compressed
+     *              sample tables are kept in memory, until the MOOV box
+     *              is written by Finish().
+     *              The MOOV box is either written after the MDAT box, or
+     *              in space reserved before it. If the reserved space is
+     *              too small, the MOOV box is written at the end, and the
+     *              reserved space is left as a FREE box.
+     *              The output stream must support seeking, as box sizes
+     *              are written once known.
+     */
+    class ISOBMFF_EXPORT Muxer
+    {
+        public:
+            
+            /*!
+             * @enum        Layout
+             * @abstract    Position of the MOOV box.
+             * @constant    MoovAtEnd   The MOOV box is written after the MDAT box.
+             * @constant    MoovAtFront The MOOV box is written in space reserved before the MDAT box.
+             */
+            enum class Layout
+            {
+                MoovAtEnd,
+                MoovAtFront
+            };
+            
+            /*!
+             * @var         DefaultMaxChunkSize
+             * @abstract    Default maximum size of a chunk, in bytes.
+             */
+            static constexpr size_t DefaultMaxChunkSize = 1024 * 1024;
+            
+            /*!
+             * @function    Muxer
+             * @abstract    Creates a muxer.
+             * @param       stream          The output stream, which must outlive the muxer.
+             * @param       layout          The position of the MOOV box.
+             * @param       reservedSize    The space reserved for the MOOV box with Layout::MoovAtFront, in bytes.
+             * @see         EstimateMoovSize
+             */
+            Muxer( BinaryOutputStream & stream, Layout layout = Layout::MoovAtEnd, uint64_t reservedSize = 0 );
+            
+            Muxer( const Muxer & o ) = delete;
+            Muxer( Muxer && o ) noexcept;
+            ~Muxer();
+            
+            Muxer & operator =( Muxer o );
+            
+            /*!
+             * @function    EstimateMoovSize
+             * @abstract    Gets an upper bound of the size of the MOOV box.
+             * @param       tracks  The number of tracks.
+             * @param       samples The total number of samples.
+             * @result      The estimated size, in bytes, assuming sample entries of less than 1KB.
+             */
+            static uint64_t EstimateMoovSize( size_t tracks, size_t samples );
+            
+            void SetBrands( const std::string & majorBrand, uint32_t minorVersion, const std::vector< std::string > & compatibleBrands );
+            void SetTimescale( uint32_t value );
+            void SetMaxChunkSize( size_t value );
+            
+            /*!
+             * @function    AddTrack
+             * @abstract    Adds a track.
+             * @param       handlerType The handler type (vide, soun, etc).
+             * @param       timescale   The media timescale.
+             * @param       sampleEntry The serialized sample entry box (avc1, mp4a, etc).
+             * @result      The track ID.
+             * @discussion  For video tracks, the dimensions of the track are
+             *              read from the visual sample entry.
+             */
+            uint32_t AddTrack( const std::string & handlerType, uint32_t timescale, Span< const uint8_t > sampleEntry );
+            
+            /*!
+             * @function    WriteSample
+             * @abstract    Writes a sample.
+             * @param       trackID             The track ID.
+             * @param       data                The sample data.
+             * @param       duration            The duration of the sample, in media timescale units.
+             * @param       compositionOffset   The composition time offset of the sample.
+             * @param       sync                Whether the sample is a sync sample.
+             */
+            void WriteSample( uint32_t trackID, Span< const uint8_t > data, uint32_t duration, int32_t compositionOffset, bool sync );
+            
+            /*!
+             * @function    Finish
+             * @abstract    Writes the MOOV box and completes the file.
+             * @discussion  No sample can be written after this call.
+             */
+            void Finish();
+            
+            ISOBMFF_EXPORT friend void swap( Muxer & o1, Muxer & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_MUXER_HPP */
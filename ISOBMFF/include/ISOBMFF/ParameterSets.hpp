@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ParameterSets.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_PARAMETER_SETS_HPP
+#define ISOBMFF_PARAMETER_SETS_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/AVCC.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @struct      VideoParameterSet
+     * @abstract    Fields of an H.265 video parameter set.
+     */
+    struct ISOBMFF_EXPORT VideoParameterSet
+    {
+        uint8_t  id;
+        uint8_t  maxLayers;
+        uint8_t  maxSubLayers;
+        bool     temporalIDNesting;
+        uint8_t  profileIDC;
+        uint8_t  levelIDC;
+        bool     hasTiming;
+        uint32_t numUnitsInTick;
+        uint32_t timeScale;
+        
+        /*!
+         * @function    ReadHEVC
+         * @abstract    Reads an H.265 video parameter set.
+         * @param       nal     The NAL unit, including its header.
+         * @result      The parameter set.
+         * @discussion  Throws if the NAL unit is not a VPS, or if it is truncated.
+         */
+        static VideoParameterSet ReadHEVC( Span< const uint8_t > nal );
+    };
+    
+    /*!
+     * @struct      SequenceParameterSet
+     * @abstract    Fields of an H.264 or H.265 sequence parameter set.
+     * @discussion  Sizes are in luma samples. The cropped size (width and
+     *              height) is the coded size minus the cropping (H.264) or
+     *              conformance (H.265) window.
+     *              Fields that only exist in one of the standards are left
+     *              to zero for the other one.
+     */
+    struct ISOBMFF_EXPORT SequenceParameterSet
+    {
+        uint8_t  id;
+        uint8_t  profileIDC;
+        uint8_t  levelIDC;
+        uint8_t  chromaFormat;
+        bool     separateColourPlane;
+        uint8_t  bitDepthLuma;
+        uint8_t  bitDepthChroma;
+        uint32_t codedWidth;
+        uint32_t codedHeight;
+        uint32_t cropLeft;
+        uint32_t cropRight;
+        uint32_t cropTop;
+        uint32_t cropBottom;
+        uint32_t width;
+        uint32_t height;
+        bool     frameMBsOnly;
+        uint8_t  maxSubLayers;
+        uint8_t  log2MinCodingBlockSize;
+        uint8_t  log2CodingTreeBlockSize;
+        bool     hasVideoSignalType;
+        uint8_t  videoFormat;
+        bool     fullRange;
+        bool     hasColourDescription;
+        uint8_t  colourPrimaries;
+        uint8_t  transferCharacteristics;
+        uint8_t  matrixCoefficients;
+        bool     hasTiming;
+        uint32_t numUnitsInTick;
+        uint32_t timeScale;
+        
+        /*!
+         * @function    ReadAVC
+         * @abstract    Reads an H.264 sequence parameter set.
+         * @param       nal     The NAL unit, including its header.
+         * @result      The parameter set.
+         * @discussion  Throws if the NAL unit is not a SPS, or if it is truncated.
+         */
+        static SequenceParameterSet ReadAVC( Span< const uint8_t > nal );
+        
+        /*!
+         * @function    ReadHEVC
+         * @abstract    Reads an H.265 sequence parameter set.
+         * @param       nal     The NAL unit, including its header.
+         * @result      The parameter set.
+         * @discussion  Throws if the NAL unit is not a SPS, or if it is truncated.
+         */
+        static SequenceParameterSet ReadHEVC( Span< const uint8_t > nal );
+        
+        /*!
+         * @function    Read
+         * @abstract    Reads the first sequence parameter set of an AVCC box.
+         * @param       avcc    The AVCC box.
+         * @result      The parameter set.
+         * @discussion  Throws if the box has no SPS.
+         */
+        static SequenceParameterSet Read( const AVCC & avcc );
+        
+        /*!
+         * @function    Read
+         * @abstract    Reads the first sequence parameter set of an HVCC box.
+         * @param       hvcc    The HVCC box.
+         * @result      The parameter set.
+         * @discussion  Throws if the box has no SPS.
+         */
+        static SequenceParameterSet Read( const HVCC & hvcc );
+    };
+    
+    /*!
+     * @struct      PictureParameterSet
+     * @abstract    Fields of an H.264 or H.265 picture parameter set.
+     * @discussion  Only the leading fields, needed to parse slice headers,
+     *              are read.
+     */
+    struct ISOBMFF_EXPORT PictureParameterSet
+    {
+        uint8_t id;
+        uint8_t spsID;
+        bool    entropyCodingMode;
+        bool    dependentSliceSegmentsEnabled;
+        bool    outputFlagPresent;
+        uint8_t numExtraSliceHeaderBits;
+        bool    tilesEnabled;
+        bool    entropyCodingSyncEnabled;
+        
+        /*!
+         * @function    ReadAVC
+         * @abstract    Reads an H.264 picture parameter set.
+         * @param       nal     The NAL unit, including its header.
+         * @result      The parameter set.
+         * @discussion  Throws if the NAL unit is not a PPS, or if it is truncated.
+         */
+        static PictureParameterSet ReadAVC( Span< const uint8_t > nal );
+        
+        /*!
+         * @function    ReadHEVC
+         * @abstract    Reads an H.265 picture parameter set.
+         * @param       nal     The NAL unit, including its header.
+         * @result      The parameter set.
+         * @discussion  Throws if the NAL unit is not a PPS, or if it is truncated.
+         */
+        static PictureParameterSet ReadHEVC( Span< const uint8_t > nal );
+    };
+}
+
+#endif /* ISOBMFF_PARAMETER_SETS_HPP */
@@ -37,8 +37,11 @@
 #include <string>
 #include <functional>
 #include <cstdint>
+#include <vector>
+#include <exception>
 #include <ISOBMFF/Box.hpp>
 #include <ISOBMFF/File.hpp>
+#include <ISOBMFF/Executor.hpp>
 
 namespace ISOBMFF
 {
@@ -69,12 +72,32 @@ namespace ISOBMFF
              * @enum        Options
              * @abstract    Parser options.
              * @constant    SkipMDATData    Do not keep data found in MDAT boxes.
+             * @constant    UseArena        Allocate the boxes of each parsed file from a dedicated MonotonicBufferResource.
+             * @discussion  With UseArena, boxes and their entries are created
+             *              with MakeShared while parsing, so each of them only
+             *              costs a bump-pointer allocation, and the memory is
+             *              released at once when the last object of the file
+             *              is destroyed.
              */
             enum class Options: uint64_t
             {
-                SkipMDATData = 1 << 0
+                SkipMDATData = 1 << 0,
+                UseArena     = 1 << 1
             };
             
+            /*!
+             * @typedef     ParseManyCallback
+             * @abstract    Callback invoked for each file parsed by ParseMany.
+             * @discussion  The callback receives the index of the file in the
+             *              input list, its path, the parsed file object (or
+             *              nullptr) and the error that occured while parsing
+             *              (or nullptr).
+             *              It is invoked from the worker threads, so it may
+             *              run concurrently for different files.
+             * @see         ParseMany
+             */
+            typedef std::function< void( size_t index, const std::string & path, const std::shared_ptr< File > & file, std::exception_ptr error ) > ParseManyCallback;
+            
             /*!
              * @function    Parser
              * @abstract    Default constructor.
@@ -155,6 +178,17 @@ namespace ISOBMFF
              */
             std::shared_ptr< Box > CreateBox( const std::string & type ) const;
             
+            /*!
+             * @function    GetBoxFactory
+             * @abstract    Gets the function creating boxes of a specific type.
+             * @discussion  Boxes created later, without the parser, can use
+             *              the function to get the same class as CreateBox.
+             * @param       type    The box type (four character string).
+             * @result      The registered function, or nullptr if boxes of this type are generic Box objects.
+             * @see         CreateBox
+             */
+            std::function< std::shared_ptr< Box >() > GetBoxFactory( const std::string & type ) const;
+            
             /*!
              * @function    Parse
              * @abstract    Parses a file.
@@ -179,6 +213,44 @@ namespace ISOBMFF
              */
             void Parse( BinaryStream & stream ) noexcept( false );
             
+            /*!
+             * @function    ParseMany
+             * @abstract    Parses multiple files in parallel, using the default executor.
+             * @param       paths       The paths of the files to parse.
+             * @param       options     The parser options to use for each file.
+             * @param       callback    The callback invoked for each file.
+             * @see         ParseManyCallback
+             * @see         Executor::GetDefault
+             */
+            void ParseMany( const std::vector< std::string > & paths, uint64_t options, const ParseManyCallback & callback ) const noexcept( false );
+            
+            /*!
+             * @function    ParseMany
+             * @abstract    Parses multiple files in parallel.
+             * @discussion  One worker is started per concurrent task allowed
+             *              by the executor. Each worker uses its own copy of
+             *              this parser, so registered boxes and the preferred
+             *              string type are preserved, while the parser state
+             *              (including the info map) is never shared between
+             *              threads.
+             *              Each parsed file is handed to the callback as soon
+             *              as it is available, and released by the worker
+             *              afterwards unless the callback keeps a reference
+             *              to it, so memory usage does not grow with the
+             *              number of files.
+             *              Parsing errors are reported to the callback. If the
+             *              callback throws, no new file is parsed and the
+             *              exception is rethrown once all workers are done.
+             *              This parser object itself is not modified.
+             * @param       paths       The paths of the files to parse.
+             * @param       options     The parser options to use for each file.
+             * @param       callback    The callback invoked for each file.
+             * @param       executor    The executor running the workers.
+             * @see         ParseManyCallback
+             * @see         Options
+             */
+            void ParseMany( const std::vector< std::string > & paths, uint64_t options, const ParseManyCallback & callback, Executor & executor ) const noexcept( false );
+            
             /*!
              * @function    GetFile
              * @abstract    Upon successful parsing, gets the file object.
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      RBSP.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_RBSP_HPP
+#define ISOBMFF_RBSP_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @namespace   RBSP
+     * @abstract    Extraction of raw byte sequence payloads from NAL units.
+     * @discussion  H.264 and H.265 encoders insert an emulation prevention
+     *              byte (0x03) after any two consecutive zero bytes that
+     *              would otherwise be followed by a byte lower than or
+     *              equal to 0x03. These bytes need to be removed before
+     *              the payload can be parsed.
+     */
+    namespace RBSP
+    {
+        /*!
+         * @function    Extract
+         * @abstract    Removes the emulation prevention bytes from a NAL unit.
+         * @param       data    The NAL unit.
+         * @param       buffer  The output buffer, of at least data.size() bytes.
+         * @result      The number of bytes written to the output buffer.
+         * @discussion  The input is scanned a word at a time, and runs of
+         *              bytes without emulation prevention bytes are copied
+         *              at once.
+         *              Throws if the output buffer is too small.
+         */
+        ISOBMFF_EXPORT size_t Extract( Span< const uint8_t > data, Span< uint8_t > buffer );
+        
+        /*!
+         * @function    Extract
+         * @abstract    Removes the emulation prevention bytes from a NAL unit.
+         * @param       data    The NAL unit.
+         * @result      The raw byte sequence payload.
+         */
+        ISOBMFF_EXPORT std::vector< uint8_t > Extract( Span< const uint8_t > data );
+    }
+}
+
+#endif /* ISOBMFF_RBSP_HPP */
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ROIPlanner.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ROI_PLANNER_HPP
+#define ISOBMFF_ROI_PLANNER_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/META.hpp>
+#include <ISOBMFF/ImageGrid.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ROIPlanner
+     * @abstract    Plans the tiles needed to display a region of a HEIF grid item.
+     * @discussion  Regions are expressed in display coordinates, that is
+     *              after the IROT rotation of the grid item is applied.
+     *              They are mapped back to the grid canvas, whose size is
+     *              given by the ISPE property of the grid item (or the grid
+     *              output size), and intersected with the tiles, whose
+     *              size is given by the ISPE property of the first tile.
+     *              Mirroring (IMIR) and clean aperture (CLAP) properties
+     *              are not taken into account.
+     */
+    class ISOBMFF_EXPORT ROIPlanner
+    {
+        public:
+            
+            /*!
+             * @struct      Rectangle
+             * @abstract    A pixel rectangle.
+             */
+            struct Rectangle
+            {
+                uint64_t x;
+                uint64_t y;
+                uint64_t width;
+                uint64_t height;
+            };
+            
+            /*!
+             * @struct      Tile
+             * @abstract    A tile needed by a plan.
+             * @field       itemID  The tile item ID.
+             * @field       row     The tile row in the grid.
+             * @field       column  The tile column in the grid.
+             * @field       area    The tile area, in grid canvas coordinates.
+             * @field       ranges  The byte ranges of the tile data.
+             */
+            struct Tile
+            {
+                uint32_t                         itemID;
+                uint32_t                         row;
+                uint32_t                         column;
+                Rectangle                        area;
+                std::vector< ItemReader::Range > ranges;
+            };
+            
+            /*!
+             * @struct      Plan
+             * @abstract    The tiles needed to display a region.
+             * @field       region  The requested region, clipped, in grid canvas coordinates (before rotation).
+             * @field       tiles   The tiles intersecting the region, in row-major order.
+             */
+            struct Plan
+            {
+                Rectangle           region;
+                std::vector< Tile > tiles;
+            };
+            
+            /*!
+             * @function    ROIPlanner
+             * @abstract    Creates a planner for a grid item, from a file in memory.
+             * @param       meta    The META box.
+             * @param       itemID  The grid item ID.
+             * @param       file    The whole file data.
+             */
+            ROIPlanner( const META & meta, uint32_t itemID, Span< const uint8_t > file );
+            
+            /*!
+             * @function    ROIPlanner
+             * @abstract    Creates a planner for a grid item, from a stream.
+             * @discussion  Only the grid descriptor is read from the stream.
+             * @param       meta    The META box.
+             * @param       itemID  The grid item ID.
+             * @param       stream  The stream of the whole file.
+             */
+            ROIPlanner( const META & meta, uint32_t itemID, BinaryStream & stream );
+            
+            ROIPlanner( const ROIPlanner & o );
+            ROIPlanner( ROIPlanner && o ) noexcept;
+            ~ROIPlanner();
+            
+            ROIPlanner & operator =( ROIPlanner o );
+            
+            /*!
+             * @function    GetGrid
+             * @abstract    Gets the grid descriptor.
+             * @result      The grid descriptor.
+             */
+            const ImageGrid & GetGrid() const;
+            
+            /*!
+             * @function    GetRotation
+             * @abstract    Gets the rotation of the grid item.
+             * @result      The IROT angle, in anti-clockwise steps of 90 degrees.
+             */
+            uint8_t GetRotation() const;
+            
+            /*!
+             * @function    GetDisplayWidth
+             * @abstract    Gets the image width, after rotation.
+             * @result      The display width.
+             */
+            uint64_t GetDisplayWidth() const;
+            
+            /*!
+             * @function    GetDisplayHeight
+             * @abstract    Gets the image height, after rotation.
+             * @result      The display height.
+             */
+            uint64_t GetDisplayHeight() const;
+            
+            /*!
+             * @function    GetTileWidth
+             * @abstract    Gets the width of the tiles.
+             * @result      The tile width.
+             */
+            uint64_t GetTileWidth() const;
+            
+            /*!
+             * @function    GetTileHeight
+             * @abstract    Gets the height of the tiles.
+             * @result      The tile height.
+             */
+            uint64_t GetTileHeight() const;
+            
+            /*!
+             * @function    GetPlan
+             * @abstract    Gets the tiles needed to display a region.
+             * @param       region  The region, in display coordinates.
+             * @result      The plan, with no tiles if the region is outside the image.
+             */
+            Plan GetPlan( const Rectangle & region ) const;
+            
+            ISOBMFF_EXPORT friend void swap( ROIPlanner & o1, ROIPlanner & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_ROI_PLANNER_HPP */
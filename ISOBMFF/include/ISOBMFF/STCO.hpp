@@ -50,11 +50,16 @@ namespace ISOBMFF
             STCO & operator =( STCO o );
 
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
 
             size_t   GetEntryCount()                 const;
             uint32_t GetChunkOffset(  size_t index ) const;
 
+            void SetChunkOffset( size_t index, uint32_t value );
+            void AddChunkOffset( uint32_t value );
+
             ISOBMFF_EXPORT friend void swap( STCO & o1, STCO & o2 );
 
         private:
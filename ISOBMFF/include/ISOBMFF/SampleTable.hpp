@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SampleTable.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SAMPLE_TABLE_HPP
+#define ISOBMFF_SAMPLE_TABLE_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SampleTable
+     * @abstract    Location of the samples of a track.
+     * @discussion  Resolves the STSZ, STSC, STCO/CO64, STSS, STTS and CTTS
+     *              boxes of a sample table into per-sample file offsets,
+     *              sizes, sync flags and times, and per-chunk sample
+     *              ranges.
+     *              Samples and chunks are indexed from zero.
+     */
+    class ISOBMFF_EXPORT SampleTable
+    {
+        public:
+            
+            /*!
+             * @function    SampleTable
+             * @abstract    Creates an empty sample table.
+             */
+            SampleTable();
+            
+            /*!
+             * @function    SampleTable
+             * @abstract    Creates a sample table from a STBL box.
+             * @param       stbl    The STBL box.
+             * @discussion  Throws if a required box is missing, or if the
+             *              boxes are inconsistent.
+             */
+            SampleTable( const Container & stbl );
+            
+            SampleTable( const SampleTable & o );
+            SampleTable( SampleTable && o ) noexcept;
+            ~SampleTable();
+            
+            SampleTable & operator =( SampleTable o );
+            
+            /*!
+             * @function    GetSampleCount
+             * @abstract    Gets the number of samples.
+             * @result      The number of samples.
+             */
+            size_t GetSampleCount() const;
+            
+            /*!
+             * @function    GetSampleOffset
+             * @abstract    Gets the file offset of a sample.
+             * @param       sample  The sample index.
+             * @result      The file offset of the sample.
+             */
+            uint64_t GetSampleOffset( size_t sample ) const;
+            
+            /*!
+             * @function    GetSampleSize
+             * @abstract    Gets the size of a sample.
+             * @param       sample  The sample index.
+             * @result      The size of the sample, in bytes.
+             */
+            uint32_t GetSampleSize( size_t sample ) const;
+            
+            /*!
+             * @function    IsSyncSample
+             * @abstract    Checks whether a sample is a sync sample.
+             * @param       sample  The sample index.
+             * @result      true if the sample is a sync sample, otherwise false.
+             * @discussion  All samples are sync samples if there is no STSS box.
+             */
+            bool IsSyncSample( size_t sample ) const;
+            
+            /*!
+             * @function    GetSampleTime
+             * @abstract    Gets the decoding time of a sample.
+             * @param       sample  The sample index.
+             * @result      The decoding time, in media timescale units.
+             * @discussion  All times are zero if there is no STTS box.
+             */
+            uint64_t GetSampleTime( size_t sample ) const;
+            
+            /*!
+             * @function    GetSampleDuration
+             * @abstract    Gets the duration of a sample.
+             * @param       sample  The sample index.
+             * @result      The duration, in media timescale units.
+             */
+            uint32_t GetSampleDuration( size_t sample ) const;
+            
+            /*!
+             * @function    HasCompositionOffsets
+             * @abstract    Checks whether the track has a CTTS box.
+             * @result      true if samples have composition offsets, otherwise false.
+             */
+            bool HasCompositionOffsets() const;
+            
+            /*!
+             * @function    GetCompositionOffset
+             * @abstract    Gets the composition time offset of a sample.
+             * @param       sample  The sample index.
+             * @result      The composition offset, in media timescale units, or 0 if there is no CTTS box.
+             */
+            int32_t GetCompositionOffset( size_t sample ) const;
+            
+            /*!
+             * @function    GetDuration
+             * @abstract    Gets the total duration of the samples.
+             * @result      The sum of the sample durations, in media timescale units.
+             */
+            uint64_t GetDuration() const;
+            
+            /*!
+             * @function    GetChunkCount
+             * @abstract    Gets the number of chunks.
+             * @result      The number of chunks.
+             */
+            size_t GetChunkCount() const;
+            
+            /*!
+             * @function    GetChunkOffset
+             * @abstract    Gets the file offset of a chunk.
+             * @param       chunk   The chunk index.
+             * @result      The file offset of the chunk.
+             */
+            uint64_t GetChunkOffset( size_t chunk ) const;
+            
+            /*!
+             * @function    GetChunkFirstSample
+             * @abstract    Gets the index of the first sample of a chunk.
+             * @param       chunk   The chunk index.
+             * @result      The index of the first sample of the chunk.
+             */
+            size_t GetChunkFirstSample( size_t chunk ) const;
+            
+            /*!
+             * @function    GetChunkSampleCount
+             * @abstract    Gets the number of samples in a chunk.
+             * @param       chunk   The chunk index.
+             * @result      The number of samples in the chunk.
+             */
+            size_t GetChunkSampleCount( size_t chunk ) const;
+            
+            /*!
+             * @function    GetChunkSampleDescriptionIndex
+             * @abstract    Gets the sample entry used by the samples of a chunk.
+             * @param       chunk   The chunk index.
+             * @result      The index of the sample entry in the STSD box, from 1.
+             */
+            uint32_t GetChunkSampleDescriptionIndex( size_t chunk ) const;
+            
+            ISOBMFF_EXPORT friend void swap( SampleTable & o1, SampleTable & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SAMPLE_TABLE_HPP */
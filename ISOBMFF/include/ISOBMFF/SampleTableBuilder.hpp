@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SampleTableBuilder.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SAMPLE_TABLE_BUILDER_HPP
+#define ISOBMFF_SAMPLE_TABLE_BUILDER_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SampleTableBuilder
+     * @abstract    Builds the sample table of a track, one sample at a time.
+     * @discussion  Tables are run-length compressed as samples are added:
+     *              STTS and CTTS store runs of equal values, STSC stores
+     *              runs of chunks with the same number of samples, and
+     *              sizes and sync flags are only stored per sample once
+     *              they stop being all equal.
+     *              Chunk offsets are written as STCO, or CO64 when needed.
+     */
+    class ISOBMFF_EXPORT SampleTableBuilder
+    {
+        public:
+            
+            SampleTableBuilder();
+            SampleTableBuilder( const SampleTableBuilder & o );
+            SampleTableBuilder( SampleTableBuilder && o ) noexcept;
+            ~SampleTableBuilder();
+            
+            SampleTableBuilder & operator =( SampleTableBuilder o );
+            
+            /*!
+             * @function    AddChunk
+             * @abstract    Starts a new chunk.
+             * @param       offset                  The file offset of the chunk.
+             * @param       sampleDescriptionIndex  The index of the chunk's sample entry, from 1.
+             * @discussion  Following samples are added to this chunk. A
+             *              chunk left without samples is replaced.
+             */
+            void AddChunk( uint64_t offset, uint32_t sampleDescriptionIndex = 1 );
+            
+            /*!
+             * @function    AddSample
+             * @abstract    Adds a sample to the current chunk.
+             * @param       size                The size of the sample, in bytes.
+             * @param       duration            The duration of the sample, in media timescale units.
+             * @param       compositionOffset   The composition time offset of the sample.
+             * @param       sync                Whether the sample is a sync sample.
+             * @discussion  Throws if no chunk was started.
+             */
+            void AddSample( uint32_t size, uint32_t duration, int32_t compositionOffset, bool sync );
+            
+            /*!
+             * @function    SetLastSampleDuration
+             * @abstract    Changes the duration of the last added sample.
+             * @param       duration    The new duration, in media timescale units.
+             * @discussion  Used when the decode time of the next sample is
+             *              known, like after a gap. Throws if no sample was
+             *              added.
+             */
+            void SetLastSampleDuration( uint32_t duration );
+            
+            size_t   GetSampleCount() const;
+            size_t   GetChunkCount()  const;
+            uint64_t GetDuration()    const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the STBL box.
+             * @param       stream          The output stream, which must support seeking.
+             * @param       sampleEntries   The serialized sample entry boxes, written in the STSD box.
+             */
+            void Write( BinaryOutputStream & stream, const std::vector< Span< const uint8_t > > & sampleEntries ) const;
+            
+            ISOBMFF_EXPORT friend void swap( SampleTableBuilder & o1, SampleTableBuilder & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SAMPLE_TABLE_BUILDER_HPP */
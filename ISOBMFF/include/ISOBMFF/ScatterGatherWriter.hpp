@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ScatterGatherWriter.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SCATTER_GATHER_WRITER_HPP
+#define ISOBMFF_SCATTER_GATHER_WRITER_HPP
+
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <string>
+#include <cstdint>
+#include <memory>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ScatterGatherWriter
+     * @abstract    File output stream for writing boxes.
+     * @discussion  Small writes, like box headers and small boxes, are
+     *              batched in a buffer. Large writes are passed as-is,
+     *              together with the buffered bytes, in a single vectored
+     *              write, without being copied.
+     *              Ranges of the source file, like an untouched MDAT, are
+     *              copied by the kernel when possible (copy_file_range or
+     *              sendfile on Linux), without going through user space.
+     */
+    class ISOBMFF_EXPORT ScatterGatherWriter: public BinaryOutputStream
+    {
+        public:
+            
+            /*!
+             * @var         BufferSize
+             * @abstract    Size of the buffer for small writes.
+             */
+            static constexpr size_t BufferSize = 64 * 1024;
+            
+            /*!
+             * @var         LargeWriteSize
+             * @abstract    Writes of at least this size are not buffered.
+             */
+            static constexpr size_t LargeWriteSize = 16 * 1024;
+            
+            /*!
+             * @enum        Mode
+             * @abstract    How the output file is opened.
+             * @constant    Truncate    The file is created, or truncated if it exists.
+             * @constant    Update      The file must exist, and is not truncated.
+             */
+            enum class Mode
+            {
+                Truncate,
+                Update
+            };
+            
+            /*!
+             * @function    ScatterGatherWriter
+             * @abstract    Creates a writer for a file.
+             * @param       path    The path of the output file.
+             * @discussion  The file is truncated.
+             */
+            ScatterGatherWriter( const std::string & path );
+            
+            /*!
+             * @function    ScatterGatherWriter
+             * @abstract    Creates a writer for a file, with a source file.
+             * @param       path        The path of the output file.
+             * @param       sourcePath  The path of the file the boxes were read from.
+             * @discussion  The source file is used by WriteSourceRange.
+             *              It must not be the output file.
+             */
+            ScatterGatherWriter( const std::string & path, const std::string & sourcePath );
+            
+            /*!
+             * @function    ScatterGatherWriter
+             * @abstract    Creates a writer for a file, with an open mode.
+             * @param       path    The path of the output file.
+             * @param       mode    How the file is opened.
+             * @discussion  With Mode::Update, the file is written in place,
+             *              starting at offset 0. Use Seek() to write boxes
+             *              at a given position.
+             */
+            ScatterGatherWriter( const std::string & path, Mode mode );
+            
+            /*!
+             * @function    ~ScatterGatherWriter
+             * @abstract    Destructor.
+             * @discussion  Buffered data is written, but errors are ignored.
+             *              Call Flush() to get them.
+             */
+            virtual ~ScatterGatherWriter() override;
+            
+            ScatterGatherWriter( const ScatterGatherWriter & o )              = delete;
+            ScatterGatherWriter( ScatterGatherWriter && o )                   = delete;
+            ScatterGatherWriter & operator =( const ScatterGatherWriter & o ) = delete;
+            ScatterGatherWriter & operator =( ScatterGatherWriter && o )      = delete;
+            
+            using BinaryOutputStream::Write;
+            
+            void   Write( const uint8_t * buf, size_t size )        override;
+            void   Seek( std::streamoff offset, SeekDirection dir ) override;
+            size_t Tell()                                     const override;
+            void   WriteSourceRange( uint64_t offset, uint64_t size ) override;
+            
+            /*!
+             * @function    SetSourceFile
+             * @abstract    Changes the source file.
+             * @param       sourcePath  The path of the file used by following calls to WriteSourceRange.
+             * @discussion  Allows copying ranges of several files, like
+             *              when concatenating them. The source file must
+             *              not be the output file.
+             */
+            void SetSourceFile( const std::string & sourcePath );
+            
+            /*!
+             * @function    Flush
+             * @abstract    Writes the buffered data to the file.
+             */
+            void Flush();
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SCATTER_GATHER_WRITER_HPP */
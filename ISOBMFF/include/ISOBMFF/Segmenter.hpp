@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Segmenter.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SEGMENTER_HPP
+#define ISOBMFF_SEGMENTER_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Segmenter
+     * @abstract    Generates fragmented MP4 (CMAF) segments of a track of a
+     *              progressive MP4 file, on demand.
+     * @discussion  Segment boundaries are computed once, from the STSS and
+     *              STTS boxes: a segment starts with a sync sample once
+     *              the previous segment is at least as long as the target
+     *              duration. They are kept as a compact table of first
+     *              sample numbers, which can be saved and given back to
+     *              avoid computing them again.
+     *              A segment is made of a header (MOOF box and MDAT box
+     *              header), generated in memory, and of ranges of the
+     *              source file holding the sample data. The ranges can be
+     *              sent as-is, for instance with writev() and sendfile(),
+     *              so no fragmented copy of the file needs to be stored.
+     */
+    class ISOBMFF_EXPORT Segmenter
+    {
+        public:
+            
+            /*!
+             * @var         DefaultSegmentDuration
+             * @abstract    Default target duration of a segment, in milliseconds.
+             */
+            static constexpr uint32_t DefaultSegmentDuration = 2000;
+            
+            /*!
+             * @enum        Source
+             * @abstract    Location of the bytes of a segment range.
+             * @constant    Header  The bytes are in the segment header.
+             * @constant    File    The bytes are in the source file.
+             */
+            enum class Source
+            {
+                Header,
+                File
+            };
+            
+            /*!
+             * @struct      Range
+             * @abstract    A part of a segment.
+             * @field       source  The location of the bytes.
+             * @field       offset  The offset of the bytes, in the header or in the source file.
+             * @field       length  The number of bytes.
+             */
+            struct Range
+            {
+                Source   source;
+                uint64_t offset;
+                uint64_t length;
+            };
+            
+            /*!
+             * @struct      Segment
+             * @abstract    A generated segment.
+             * @field       header  The MOOF box and the MDAT box header.
+             * @field       ranges  The parts of the segment, in order.
+             */
+            struct Segment
+            {
+                std::vector< uint8_t > header;
+                std::vector< Range >   ranges;
+            };
+            
+            /*!
+             * @function    Segmenter
+             * @abstract    Computes the segments of a track.
+             * @param       moov            The MOOV box of the source file.
+             * @param       trackID         The track ID.
+             * @param       segmentDuration The target duration of a segment, in milliseconds.
+             */
+            Segmenter( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID, uint32_t segmentDuration = DefaultSegmentDuration );
+            
+            /*!
+             * @function    Segmenter
+             * @abstract    Creates a segmenter with known segment boundaries.
+             * @param       moov        The MOOV box of the source file.
+             * @param       trackID     The track ID.
+             * @param       table       A table returned by GetSegmentTable(), for the same file.
+             */
+            Segmenter( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID, const std::vector< uint32_t > & table );
+            
+            Segmenter( const Segmenter & o );
+            Segmenter( Segmenter && o ) noexcept;
+            ~Segmenter();
+            
+            Segmenter & operator =( Segmenter o );
+            
+            /*!
+             * @function    WriteInitSegment
+             * @abstract    Writes an initialization segment.
+             * @param       stream      The output stream.
+             * @param       moov        The MOOV box of the source file.
+             * @param       trackIDs    The IDs of the tracks to include.
+             * @discussion  The initialization segment is a FTYP box and a
+             *              MOOV box with empty sample tables and a MVEX
+             *              box.
+             */
+            static void WriteInitSegment( BinaryOutputStream & stream, const ContainerBox & moov, const std::vector< uint32_t > & trackIDs );
+            
+            /*!
+             * @function    GetTrackID
+             * @abstract    Gets the track ID.
+             * @result      The track ID.
+             */
+            uint32_t GetTrackID() const;
+            
+            /*!
+             * @function    GetTimescale
+             * @abstract    Gets the media timescale of the track.
+             * @result      The timescale.
+             */
+            uint32_t GetTimescale() const;
+            
+            /*!
+             * @function    GetSegmentTable
+             * @abstract    Gets the segment boundaries.
+             * @result      The first sample index of each segment, followed by the sample count.
+             */
+            const std::vector< uint32_t > & GetSegmentTable() const;
+            
+            /*!
+             * @function    GetSegmentCount
+             * @abstract    Gets the number of segments.
+             * @result      The number of segments.
+             */
+            size_t GetSegmentCount() const;
+            
+            /*!
+             * @function    GetSegmentTime
+             * @abstract    Gets the decoding time of the first sample of a segment.
+             * @param       number  The segment number, from zero.
+             * @result      The time, in media timescale units.
+             */
+            uint64_t GetSegmentTime( size_t number ) const;
+            
+            /*!
+             * @function    GetSegmentDuration
+             * @abstract    Gets the duration of a segment.
+             * @param       number  The segment number, from zero.
+             * @result      The duration, in media timescale units.
+             */
+            uint64_t GetSegmentDuration( size_t number ) const;
+            
+            /*!
+             * @function    GetInitSegment
+             * @abstract    Gets the initialization segment of the track.
+             * @result      The initialization segment.
+             */
+            std::vector< uint8_t > GetInitSegment() const;
+            
+            /*!
+             * @function    GetSegment
+             * @abstract    Generates a segment.
+             * @param       number          The segment number, from zero.
+             * @param       sequenceNumber  The sequence number of the MOOF box, or 0 to use number + 1.
+             * @result      The segment.
+             */
+            Segment GetSegment( size_t number, uint32_t sequenceNumber = 0 ) const;
+            
+            /*!
+             * @function    WriteSegment
+             * @abstract    Writes a segment.
+             * @param       stream          The output stream, which must be able to copy ranges of the source file.
+             * @param       number          The segment number, from zero.
+             * @param       sequenceNumber  The sequence number of the MOOF box, or 0 to use number + 1.
+             */
+            void WriteSegment( BinaryOutputStream & stream, size_t number, uint32_t sequenceNumber = 0 ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Segmenter & o1, Segmenter & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SEGMENTER_HPP */
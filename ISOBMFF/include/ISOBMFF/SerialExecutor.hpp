@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SerialExecutor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SERIAL_EXECUTOR_HPP
+#define ISOBMFF_SERIAL_EXECUTOR_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Executor.hpp>
+#include <functional>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SerialExecutor
+     * @abstract    Executor running every task inline, on the calling thread.
+     * @discussion  Useful to disable the library's parallelism, or when the
+     *              caller already parallelizes at a higher level.
+     */
+    class ISOBMFF_EXPORT SerialExecutor: public Executor
+    {
+        public:
+            
+            void   Submit( const std::function< void() > & task ) override;
+            size_t GetConcurrency()                         const override;
+            void   ParallelFor( size_t begin, size_t end, size_t grain, const std::function< void( size_t, size_t ) > & body ) override;
+    };
+}
+
+#endif /* ISOBMFF_SERIAL_EXECUTOR_HPP */
@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/Box.hpp>
+#include <ISOBMFF/Span.hpp>
 #include <cstdint>
 
 namespace ISOBMFF
@@ -51,10 +52,13 @@ namespace ISOBMFF
             SingleItemTypeReferenceBox & operator =( SingleItemTypeReferenceBox o );
             
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
-            uint32_t                GetFromItemID() const;
-            std::vector< uint32_t > GetToItemIDs()  const;
+            uint32_t                GetFromItemID()    const;
+            std::vector< uint32_t > GetToItemIDs()     const;
+            Span< const uint32_t >  GetToItemIDsSpan() const;
             
             void SetFromItemID( uint32_t value );
             void AddToItemID( uint32_t value );
@@ -63,6 +67,10 @@ namespace ISOBMFF
             
         private:
             
+            friend class IREF;
+            
+            void SetModifiedFlag( const std::shared_ptr< bool > & flag );
+            
             class IMPL;
             
             std::unique_ptr< IMPL > impl;
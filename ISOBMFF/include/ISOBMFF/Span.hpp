@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Span.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SPAN_HPP
+#define ISOBMFF_SPAN_HPP
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Span
+     * @abstract    Non-owning view over contiguous objects.
+     * @discussion  Equivalent to std::span, which is not available in C++14.
+     *              A span is only valid as long as the storage it refers to
+     *              is not modified or destroyed.
+     */
+    template< class _T_ >
+    class Span
+    {
+        public:
+            
+            typedef _T_   value_type;
+            typedef _T_ * iterator;
+            typedef _T_ * pointer;
+            typedef _T_ & reference;
+            
+            Span():
+                _data( nullptr ),
+                _size( 0 )
+            {}
+            
+            Span( _T_ * data, size_t size ):
+                _data( data ),
+                _size( size )
+            {}
+            
+            Span( std::vector< typename std::remove_const< _T_ >::type > & v ):
+                _data( v.data() ),
+                _size( v.size() )
+            {}
+            
+            template< class _U_ = _T_, typename std::enable_if< std::is_const< _U_ >::value >::type * = nullptr >
+            Span( const std::vector< typename std::remove_const< _T_ >::type > & v ):
+                _data( v.data() ),
+                _size( v.size() )
+            {}
+            
+            template< class _U_, typename std::enable_if< std::is_convertible< _U_ *, _T_ * >::value && std::is_same< typename std::remove_cv< _U_ >::type, typename std::remove_cv< _T_ >::type >::value >::type * = nullptr >
+            Span( const Span< _U_ > & o ):
+                _data( o.data() ),
+                _size( o.size() )
+            {}
+            
+            _T_ * data() const
+            {
+                return this->_data;
+            }
+            
+            size_t size() const
+            {
+                return this->_size;
+            }
+            
+            bool empty() const
+            {
+                return this->_size == 0;
+            }
+            
+            _T_ * begin() const
+            {
+                return this->_data;
+            }
+            
+            _T_ * end() const
+            {
+                return this->_data + this->_size;
+            }
+            
+            _T_ & operator []( size_t index ) const
+            {
+                return this->_data[ index ];
+            }
+            
+            _T_ & at( size_t index ) const
+            {
+                if( index >= this->_size )
+                {
+                    throw std::runtime_error( "Invalid span index" );
+                }
+                
+                return this->_data[ index ];
+            }
+            
+            Span subspan( size_t offset, size_t count ) const
+            {
+                if( offset > this->_size || count > this->_size - offset )
+                {
+                    throw std::runtime_error( "Invalid span range" );
+                }
+                
+                return Span( this->_data + offset, count );
+            }
+            
+        private:
+            
+            _T_  * _data;
+            size_t _size;
+    };
+}
+
+#endif /* ISOBMFF_SPAN_HPP */
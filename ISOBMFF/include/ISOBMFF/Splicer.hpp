@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Splicer.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SPLICER_HPP
+#define ISOBMFF_SPLICER_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <string>
+#include <limits>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Splicer
+     * @abstract    Trims and concatenates MP4 files, without re-encoding.
+     * @discussion  The output is made of clips, each one being a time
+     *              range of an input file. A single clip trims a file,
+     *              and several clips are concatenated.
+     *              All inputs must have the same tracks, in the same
+     *              order, with the same handler types and timescales.
+     *              Tracks are merged, and sample entries (see STSD) are
+     *              shared when identical, or added otherwise.
+     *              Sample tables and chunk offsets are rebuilt, and only
+     *              the sample data of the clips is copied from the input
+     *              files, by the kernel when possible (see
+     *              ScatterGatherWriter). The MOOV box is written before
+     *              the MDAT box.
+     *              Clip times are presentation times: they are mapped
+     *              through the edit list and composition offsets of each
+     *              input track before samples are selected. Edit lists of
+     *              the input files are not copied, but their media time
+     *              and initial empty edits are combined into the output
+     *              edit list. With StartMode::SyncSample, no edit list is
+     *              written, and the last sample of each track in a clip
+     *              is extended to the end of the clip instead, so tracks
+     *              stay synchronized in the following clips.
+     */
+    class ISOBMFF_EXPORT Splicer
+    {
+        public:
+            
+            /*!
+             * @enum        StartMode
+             * @abstract    How a clip starting between sync samples is handled.
+             * @constant    SyncSample  The clip starts at the last sync sample before the start time. Tracks are cut at the same time.
+             * @constant    EditList    Decoding starts at the last sync sample before the start time, and an edit list starts the presentation exactly at the start time.
+             */
+            enum class StartMode
+            {
+                SyncSample,
+                EditList
+            };
+            
+            /*!
+             * @function    Splicer
+             * @abstract    Creates a splicer without clips.
+             * @param       mode    How clip start times are handled.
+             */
+            Splicer( StartMode mode = StartMode::SyncSample );
+            
+            Splicer( const Splicer & o );
+            Splicer( Splicer && o ) noexcept;
+            ~Splicer();
+            
+            Splicer & operator =( Splicer o );
+            
+            /*!
+             * @function    AddClip
+             * @abstract    Adds a time range of a file.
+             * @param       path    The input file path.
+             * @param       start   The start time, in seconds, included.
+             * @param       end     The end time, in seconds, excluded.
+             * @discussion  Samples are selected by decoding time.
+             */
+            void AddClip( const std::string & path, double start = 0, double end = std::numeric_limits< double >::infinity() );
+            
+            /*!
+             * @function    GetClipCount
+             * @abstract    Gets the number of clips.
+             * @result      The number of clips.
+             */
+            size_t GetClipCount() const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the clips to a file.
+             * @param       path    The output file path, which must differ from the input paths.
+             */
+            void Write( const std::string & path ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Splicer & o1, Splicer & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SPLICER_HPP */
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ThreadPoolExecutor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_THREAD_POOL_EXECUTOR_HPP
+#define ISOBMFF_THREAD_POOL_EXECUTOR_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Executor.hpp>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ThreadPoolExecutor
+     * @abstract    Work-stealing thread pool.
+     * @discussion  Each worker thread has its own task queue. Tasks submitted
+     *              from a worker are queued on the worker's own queue and
+     *              processed in LIFO order, while idle workers steal the
+     *              oldest tasks from the other queues.
+     *              Pending tasks are processed before the pool is destroyed.
+     */
+    class ISOBMFF_EXPORT ThreadPoolExecutor: public Executor
+    {
+        public:
+            
+            /*!
+             * @function    ThreadPoolExecutor
+             * @abstract    Creates a thread pool.
+             * @param       threads     The number of worker threads, or 0 to use the number of hardware threads.
+             */
+            ThreadPoolExecutor( size_t threads = 0 );
+            
+            virtual ~ThreadPoolExecutor() override;
+            
+            ThreadPoolExecutor( const ThreadPoolExecutor & o )              = delete;
+            ThreadPoolExecutor( ThreadPoolExecutor && o )                   = delete;
+            ThreadPoolExecutor & operator =( const ThreadPoolExecutor & o ) = delete;
+            ThreadPoolExecutor & operator =( ThreadPoolExecutor && o )      = delete;
+            
+            void   Submit( const std::function< void() > & task ) override;
+            size_t GetConcurrency()                         const override;
+            
+            /*!
+             * @function    SetExceptionHandler
+             * @abstract    Sets the function called when a task throws.
+             * @discussion  The handler is called on the worker thread that
+             *              ran the task, with the exception thrown by the
+             *              task. Exceptions thrown by ParallelFor bodies are
+             *              rethrown by ParallelFor, and never reach it.
+             * @param       handler     The exception handler, or nullptr to keep exceptions for TakeException.
+             * @see         TakeException
+             */
+            void SetExceptionHandler( const std::function< void( std::exception_ptr ) > & handler );
+            
+            /*!
+             * @function    TakeException
+             * @abstract    Gets and clears the first exception thrown by a task.
+             * @discussion  Exceptions are kept while no exception handler is
+             *              set, or when the handler itself throws.
+             *              Later exceptions are discarded until this method
+             *              is called.
+             * @result      The first exception thrown by a task, or nullptr.
+             * @see         SetExceptionHandler
+             */
+            std::exception_ptr TakeException();
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_THREAD_POOL_EXECUTOR_HPP */
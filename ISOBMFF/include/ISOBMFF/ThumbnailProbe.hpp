@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ThumbnailProbe.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_THUMBNAIL_PROBE_HPP
+#define ISOBMFF_THUMBNAIL_PROBE_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/META.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/ISPE.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ThumbnailProbe
+     * @abstract    Locates the thumbnail of the primary item of a HEIF file.
+     * @discussion  Only the top-level box headers, up to the first META box,
+     *              and the META box itself are read. The file is not
+     *              parsed any further.
+     *              The thumbnail is the first item with a thmb reference
+     *              to the primary item.
+     */
+    class ISOBMFF_EXPORT ThumbnailProbe
+    {
+        public:
+            
+            /*!
+             * @function    ThumbnailProbe
+             * @abstract    Probes a file.
+             * @param       path    The file path.
+             */
+            ThumbnailProbe( const std::string & path );
+            
+            /*!
+             * @function    ThumbnailProbe
+             * @abstract    Probes a stream.
+             * @param       stream  The stream of the whole file.
+             */
+            ThumbnailProbe( BinaryStream & stream );
+            
+            ThumbnailProbe( const ThumbnailProbe & o );
+            ThumbnailProbe( ThumbnailProbe && o ) noexcept;
+            ~ThumbnailProbe();
+            
+            ThumbnailProbe & operator =( ThumbnailProbe o );
+            
+            /*!
+             * @function    GetMETA
+             * @abstract    Gets the META box.
+             * @result      The META box.
+             */
+            std::shared_ptr< META > GetMETA() const;
+            
+            /*!
+             * @function    GetPrimaryItemID
+             * @abstract    Gets the primary item ID.
+             * @result      The primary item ID.
+             */
+            uint32_t GetPrimaryItemID() const;
+            
+            /*!
+             * @function    HasThumbnail
+             * @abstract    Checks if the primary item has a thumbnail.
+             * @result      true if a thumbnail was found, otherwise false.
+             */
+            bool HasThumbnail() const;
+            
+            /*!
+             * @function    GetItemID
+             * @abstract    Gets the thumbnail item ID.
+             * @result      The thumbnail item ID, or 0.
+             */
+            uint32_t GetItemID() const;
+            
+            /*!
+             * @function    GetItemType
+             * @abstract    Gets the thumbnail item type (eg: hvc1).
+             * @result      The thumbnail item type, or an empty string.
+             */
+            std::string GetItemType() const;
+            
+            /*!
+             * @function    GetHVCC
+             * @abstract    Gets the HEVC configuration of the thumbnail.
+             * @result      The HVCC property, or nullptr.
+             */
+            std::shared_ptr< HVCC > GetHVCC() const;
+            
+            /*!
+             * @function    GetISPE
+             * @abstract    Gets the size of the thumbnail.
+             * @result      The ISPE property, or nullptr.
+             */
+            std::shared_ptr< ISPE > GetISPE() const;
+            
+            /*!
+             * @function    GetRanges
+             * @abstract    Gets the data extents of the thumbnail.
+             * @result      The resolved thumbnail extents.
+             */
+            const std::vector< ItemReader::Range > & GetRanges() const;
+            
+            /*!
+             * @function    ReadData
+             * @abstract    Reads the thumbnail data.
+             * @param       stream  The stream of the whole file.
+             * @result      The thumbnail data, as length-prefixed NAL units.
+             */
+            std::vector< uint8_t > ReadData( BinaryStream & stream ) const;
+            
+            ISOBMFF_EXPORT friend void swap( ThumbnailProbe & o1, ThumbnailProbe & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_THUMBNAIL_PROBE_HPP */
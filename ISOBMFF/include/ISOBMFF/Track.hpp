@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Track.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_TRACK_HPP
+#define ISOBMFF_TRACK_HPP
+
+#include <memory>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/AVCC.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Track
+     * @abstract    Summary of a TRAK box.
+     * @discussion  Gathers the track header, media header, handler, first
+     *              sample entry and sample table of a track.
+     */
+    class ISOBMFF_EXPORT Track
+    {
+        public:
+            
+            /*!
+             * @function    Track
+             * @abstract    Creates a track from a TRAK box.
+             * @param       trak    The TRAK box.
+             * @discussion  Throws if the TKHD, MDHD, HDLR or STBL box is
+             *              missing, or if the sample table is invalid.
+             */
+            Track( std::shared_ptr< ContainerBox > trak );
+            
+            Track( const Track & o );
+            Track( Track && o ) noexcept;
+            ~Track();
+            
+            Track & operator =( Track o );
+            
+            /*!
+             * @function    GetTracks
+             * @abstract    Gets all tracks of a MOOV box.
+             * @param       moov    The MOOV box.
+             * @result      The tracks, in box order.
+             */
+            static std::vector< Track > GetTracks( const Container & moov );
+            
+            std::shared_ptr< ContainerBox > GetTRAK()         const;
+            uint32_t                        GetTrackID()      const;
+            std::string                     GetHandlerType()  const;
+            uint32_t                        GetTimescale()    const;
+            uint64_t                        GetDuration()     const;
+            std::shared_ptr< Box >          GetSampleEntry()  const;
+            std::string                     GetCodec()        const;
+            std::shared_ptr< AVCC >         GetAVCC()         const;
+            std::shared_ptr< HVCC >         GetHVCC()         const;
+            const SampleTable             & GetSampleTable()  const;
+            
+            /*!
+             * @function    GetNALUnitLengthSize
+             * @abstract    Gets the size of the NAL unit length fields of the samples.
+             * @result      The length size (1, 2 or 4), or 0 if the track has no AVCC or HVCC box.
+             */
+            uint8_t GetNALUnitLengthSize() const;
+            
+            ISOBMFF_EXPORT friend void swap( Track & o1, Track & o2 );
+            
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_TRACK_HPP */
@@ -30,10 +30,11 @@
 
 #include <ISOBMFF/AVC1.hpp>
 #include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class AVC1::IMPL
+    class AVC1::IMPL: public ResourceAllocated
     {
         public:
 
@@ -42,15 +43,21 @@ namespace ISOBMFF
             ~IMPL();
 
             uint16_t _data_reference_index;
+            uint16_t _predefined1;
+            uint16_t _reserved1;
+            uint32_t _predefined2[ 3 ];
             uint16_t _width;
             uint16_t _height;
             uint32_t _horizresolution;
             uint32_t _vertresolution;
+            uint32_t _reserved2;
             uint16_t _frame_count;
             std::string _compressorname;
             uint16_t _depth;
+            uint16_t _predefined3;
 
             std::vector< std::shared_ptr< Box > > _boxes;
+            std::vector< uint8_t >                _padding;
     };
 
     AVC1::AVC1():
@@ -105,28 +112,78 @@ namespace ISOBMFF
         this->SetDataReferenceIndex( stream.ReadBigEndianUInt16() );
         // VisualSampleEntry
         // pre_defined1
-        stream.ReadBigEndianUInt16();
+        this->impl->_predefined1 = stream.ReadBigEndianUInt16();
         // reserved1
-        stream.ReadBigEndianUInt16();
+        this->impl->_reserved1 = stream.ReadBigEndianUInt16();
         // pre_defined2
-        stream.ReadBigEndianUInt32();
-        stream.ReadBigEndianUInt32();
-        stream.ReadBigEndianUInt32();
+        this->impl->_predefined2[ 0 ] = stream.ReadBigEndianUInt32();
+        this->impl->_predefined2[ 1 ] = stream.ReadBigEndianUInt32();
+        this->impl->_predefined2[ 2 ] = stream.ReadBigEndianUInt32();
         this->SetWidth( stream.ReadBigEndianUInt16() );
         this->SetHeight( stream.ReadBigEndianUInt16() );
         this->SetHorizResolution( stream.ReadBigEndianUInt32() );
         this->SetVertResolution( stream.ReadBigEndianUInt32() );
         // reserved2
-        stream.ReadBigEndianUInt32();
+        this->impl->_reserved2 = stream.ReadBigEndianUInt32();
         this->SetFrameCount( stream.ReadBigEndianUInt16() );
         this->SetCompressorName( stream.ReadString(32) );
         this->SetDepth( stream.ReadBigEndianUInt16() );
         // pre_defined3
-        stream.ReadBigEndianUInt16();
+        this->impl->_predefined3 = stream.ReadBigEndianUInt16();
 
+        container.SetSourceRange( this->GetSourceOffset(), this->GetSourceSize(), this->GetSourceHeaderSize() );
         container.ReadData( parser, stream );
 
-        this->impl->_boxes = container.GetBoxes();
+        this->impl->_boxes   = container.GetBoxes();
+        this->impl->_padding = container.GetPadding();
+    }
+
+    uint64_t AVC1::GetDataSize() const
+    {
+        uint64_t size( 78 );
+
+        for( const auto & box: this->impl->_boxes )
+        {
+            size += box->GetSize();
+        }
+
+        size += this->impl->_padding.size();
+        
+        return size;
+    }
+
+    void AVC1::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::string name( this->GetCompressorName().substr( 0, 32 ) );
+
+        // SampleEntry
+        // reserved[]
+        stream.WriteZeros( 6 );
+        // data_reference_index
+        stream.WriteBigEndianUInt16( this->GetDataReferenceIndex() );
+        // VisualSampleEntry
+        stream.WriteBigEndianUInt16( this->impl->_predefined1 );
+        stream.WriteBigEndianUInt16( this->impl->_reserved1 );
+        stream.WriteBigEndianUInt32( this->impl->_predefined2[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_predefined2[ 1 ] );
+        stream.WriteBigEndianUInt32( this->impl->_predefined2[ 2 ] );
+        stream.WriteBigEndianUInt16( this->GetWidth() );
+        stream.WriteBigEndianUInt16( this->GetHeight() );
+        stream.WriteBigEndianUInt32( this->GetHorizResolution() );
+        stream.WriteBigEndianUInt32( this->GetVertResolution() );
+        stream.WriteBigEndianUInt32( this->impl->_reserved2 );
+        stream.WriteBigEndianUInt16( this->GetFrameCount() );
+        stream.WriteString( name );
+        stream.WriteZeros( 32 - name.size() );
+        stream.WriteBigEndianUInt16( this->GetDepth() );
+        stream.WriteBigEndianUInt16( this->impl->_predefined3 );
+
+        for( const auto & box: this->impl->_boxes )
+        {
+            box->Write( stream );
+        }
+        
+        stream.Write( this->impl->_padding );
     }
 
     std::vector< std::pair< std::string, std::string > > AVC1::GetDisplayableProperties() const
@@ -245,27 +302,43 @@ namespace ISOBMFF
         return this->impl->_boxes;
     }
 
+    Span< const std::shared_ptr< Box > > AVC1::GetBoxesSpan() const
+    {
+        return this->impl->_boxes;
+    }
+
     AVC1::IMPL::IMPL():
         _data_reference_index( 0 ),
+        _predefined1( 0 ),
+        _reserved1( 0 ),
+        _predefined2{ 0, 0, 0 },
         _width( 0 ),
         _height( 0 ),
         _horizresolution( 0 ),
         _vertresolution( 0 ),
+        _reserved2( 0 ),
         _frame_count( 0 ),
         _compressorname( "" ),
-        _depth( 0 )
+        _depth( 0 ),
+        _predefined3( 0xFFFF )
     {}
 
     AVC1::IMPL::IMPL( const IMPL & o ):
         _data_reference_index( o._data_reference_index ),
+        _predefined1( o._predefined1 ),
+        _reserved1( o._reserved1 ),
+        _predefined2{ o._predefined2[ 0 ], o._predefined2[ 1 ], o._predefined2[ 2 ] },
         _width( o._width ),
         _height( o._height ),
         _horizresolution( o._horizresolution ),
         _vertresolution( o._vertresolution ),
+        _reserved2( o._reserved2 ),
         _frame_count( o._frame_count ),
         _compressorname( o._compressorname ),
         _depth( o._depth ),
-        _boxes( o._boxes )
+        _predefined3( o._predefined3 ),
+        _boxes( o._boxes ),
+        _padding( o._padding )
     {}
 
     AVC1::IMPL::~IMPL()
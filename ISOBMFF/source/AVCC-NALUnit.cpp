@@ -29,12 +29,13 @@
  */
 
 #include <ISOBMFF/AVCC.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <sstream>
 #include <iomanip>
 
 namespace ISOBMFF
 {
-    class AVCC::NALUnit::IMPL
+    class AVCC::NALUnit::IMPL: public ResourceAllocated
     {
         public:
 
@@ -64,7 +65,7 @@ namespace ISOBMFF
             stream.Read( &( data[ 0 ] ), nal_unit_length );
         }
 
-        this->SetData( data );
+        this->SetData( std::move( data ) );
     }
 
     AVCC::NALUnit::NALUnit( const AVCC::NALUnit & o ):
@@ -104,18 +105,26 @@ namespace ISOBMFF
         return this->impl->_data;
     }
 
+    Span< const uint8_t > AVCC::NALUnit::GetDataSpan() const
+    {
+        return this->impl->_data;
+    }
+
     void AVCC::NALUnit::SetData( const std::vector< uint8_t > & value )
     {
         this->impl->_data = value;
     }
 
-    std::vector< std::pair< std::string, std::string > > AVCC::NALUnit::GetDisplayableProperties() const
+    void AVCC::NALUnit::SetData( std::vector< uint8_t > && value )
     {
-        std::vector< uint8_t > data;
-        std::stringstream      ss;
-        std::string            s;
+        this->impl->_data = std::move( value );
+    }
 
-        data = this->GetData();
+    std::vector< std::pair< std::string, std::string > > AVCC::NALUnit::GetDisplayableProperties() const
+    {
+        Span< const uint8_t > data( this->GetDataSpan() );
+        std::stringstream     ss;
+        std::string           s;
 
         if( data.size() > 0 )
         {
@@ -31,10 +31,11 @@
 #include <ISOBMFF/AVCC.hpp>
 #include <ISOBMFF/Utils.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class AVCC::IMPL
+    class AVCC::IMPL: public ResourceAllocated
     {
         public:
 
@@ -96,8 +97,6 @@ namespace ISOBMFF
         uint8_t  count;
         uint8_t  i;
 
-        ( void )parser;
-
         this->SetConfigurationVersion( stream.ReadUInt8() );
         this->SetAVCProfileIndication( stream.ReadUInt8() );
         this->SetProfileCompatibility( stream.ReadUInt8() );
@@ -120,7 +119,7 @@ namespace ISOBMFF
                 break;
             }
 
-            this->AddSequenceParameterSetNALUnit( std::make_shared< NALUnit >( stream ) );
+            this->AddSequenceParameterSetNALUnit( MakeShared< NALUnit >( stream ) );
         }
 
         this->SetNumOfPictureParameterSets( stream.ReadUInt8() );
@@ -137,8 +136,54 @@ namespace ISOBMFF
                 break;
             }
 
-            this->AddPictureParameterSetNALUnit( std::make_shared< NALUnit >( stream ) );
+            this->AddPictureParameterSetNALUnit( MakeShared< NALUnit >( stream ) );
+        }
+
+        Box::ReadData( parser, stream );
+    }
+
+    uint64_t AVCC::GetDataSize() const
+    {
+        uint64_t size( 7 );
+
+        for( const auto & unit: this->impl->_sequence_parameter_set_nal_units )
+        {
+            size += 2 + unit->GetDataSpan().size();
+        }
+
+        for( const auto & unit: this->impl->_picture_parameter_set_nal_units )
+        {
+            size += 2 + unit->GetDataSpan().size();
+        }
+
+        return size + Box::GetDataSize();
+    }
+
+    void AVCC::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteUInt8( this->GetConfigurationVersion() );
+        stream.WriteUInt8( this->GetAVCProfileIndication() );
+        stream.WriteUInt8( this->GetProfileCompatibility() );
+        stream.WriteUInt8( this->GetAVCLevelIndication() );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xFC | ( this->GetLengthSizeMinusOne() & 0x3 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xE0 | ( this->impl->_sequence_parameter_set_nal_units.size() & 0x1f ) ) );
+
+        for( const auto & unit: this->impl->_sequence_parameter_set_nal_units )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( unit->GetDataSpan().size() ) );
+            stream.Write( unit->GetDataSpan() );
         }
+
+        stream.WriteUInt8( static_cast< uint8_t >( this->impl->_picture_parameter_set_nal_units.size() ) );
+
+        for( const auto & unit: this->impl->_picture_parameter_set_nal_units )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( unit->GetDataSpan().size() ) );
+            stream.Write( unit->GetDataSpan() );
+        }
+
+        // Trailing bytes, like the High profile chroma and bit depth fields
+        Box::WriteData( stream );
     }
 
     void AVCC::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
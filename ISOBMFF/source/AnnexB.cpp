@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        AnnexB.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/AnnexB.hpp>
+#include <stdexcept>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    namespace AnnexB
+    {
+        static const uint8_t StartCode[] = { 0x00, 0x00, 0x00, 0x01 };
+        
+        static size_t ReadLength( const uint8_t * data, uint8_t lengthSize );
+        
+        std::vector< uint8_t > GetParameterSets( const HVCC & hvcc )
+        {
+            std::vector< uint8_t > data;
+            
+            for( const auto & array: hvcc.GetArrays() )
+            {
+                for( const auto & unit: array->GetNALUnits() )
+                {
+                    Span< const uint8_t > nal( unit->GetDataSpan() );
+                    
+                    data.insert( data.end(), StartCode, StartCode + sizeof( StartCode ) );
+                    data.insert( data.end(), nal.begin(), nal.end() );
+                }
+            }
+            
+            return data;
+        }
+        
+        std::vector< uint8_t > GetParameterSets( const AVCC & avcc )
+        {
+            std::vector< uint8_t > data;
+            
+            for( const auto & units: { avcc.GetSequenceParameterSetNALUnits(), avcc.GetPictureParameterSetNALUnits() } )
+            {
+                for( const auto & unit: units )
+                {
+                    Span< const uint8_t > nal( unit->GetDataSpan() );
+                    
+                    data.insert( data.end(), StartCode, StartCode + sizeof( StartCode ) );
+                    data.insert( data.end(), nal.begin(), nal.end() );
+                }
+            }
+            
+            return data;
+        }
+        
+        size_t GetSize( Span< const uint8_t > data, uint8_t lengthSize )
+        {
+            size_t size( 0 );
+            size_t pos( 0 );
+            
+            while( pos < data.size() )
+            {
+                size_t length;
+                
+                if( lengthSize > data.size() - pos )
+                {
+                    throw std::runtime_error( "Invalid NAL unit - Truncated length" );
+                }
+                
+                length = ReadLength( data.data() + pos, lengthSize );
+                pos   += lengthSize;
+                
+                if( length > data.size() - pos )
+                {
+                    throw std::runtime_error( "Invalid NAL unit - Truncated data" );
+                }
+                
+                if( length > 0 )
+                {
+                    size += sizeof( StartCode ) + length;
+                }
+                
+                pos += length;
+            }
+            
+            return size;
+        }
+        
+        size_t Convert( Span< const uint8_t > data, uint8_t lengthSize, Span< uint8_t > buffer )
+        {
+            size_t size( GetSize( data, lengthSize ) );
+            size_t pos( 0 );
+            size_t out( 0 );
+            
+            if( size > buffer.size() )
+            {
+                throw std::runtime_error( "Invalid buffer - Not enough space for Annex-B data" );
+            }
+            
+            while( pos < data.size() )
+            {
+                size_t length( ReadLength( data.data() + pos, lengthSize ) );
+                
+                pos += lengthSize;
+                
+                if( length > 0 )
+                {
+                    memcpy( buffer.data() + out, StartCode, sizeof( StartCode ) );
+                    memcpy( buffer.data() + out + sizeof( StartCode ), data.data() + pos, length );
+                    
+                    out += sizeof( StartCode ) + length;
+                }
+                
+                pos += length;
+            }
+            
+            return out;
+        }
+        
+        bool ConvertInPlace( Span< uint8_t > data, uint8_t lengthSize )
+        {
+            size_t pos( 0 );
+            
+            if( lengthSize != sizeof( StartCode ) || GetSize( data, lengthSize ) != data.size() )
+            {
+                return false;
+            }
+            
+            while( pos < data.size() )
+            {
+                size_t length( ReadLength( data.data() + pos, lengthSize ) );
+                
+                memcpy( data.data() + pos, StartCode, sizeof( StartCode ) );
+                
+                pos += sizeof( StartCode ) + length;
+            }
+            
+            return true;
+        }
+        
+        static size_t ReadLength( const uint8_t * data, uint8_t lengthSize )
+        {
+            size_t length( 0 );
+            
+            if( lengthSize != 1 && lengthSize != 2 && lengthSize != 4 )
+            {
+                throw std::runtime_error( "Invalid NAL unit - Unsupported length size" );
+            }
+            
+            for( uint8_t i = 0; i < lengthSize; i++ )
+            {
+                length = ( length << 8 ) | data[ i ];
+            }
+            
+            return length;
+        }
+    }
+}
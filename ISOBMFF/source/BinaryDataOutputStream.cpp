@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryDataOutputStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/Casts.hpp>
+
+namespace ISOBMFF
+{
+    class BinaryDataOutputStream::IMPL
+    {
+        public:
+            
+            IMPL();
+            ~IMPL();
+            
+            std::vector< uint8_t > _data;
+            size_t                 _pos;
+    };
+    
+    BinaryDataOutputStream::BinaryDataOutputStream():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    BinaryDataOutputStream::~BinaryDataOutputStream()
+    {}
+    
+    void BinaryDataOutputStream::Write( const uint8_t * buf, size_t size )
+    {
+        if( size == 0 )
+        {
+            return;
+        }
+        
+        if( size > this->impl->_data.size() - this->impl->_pos )
+        {
+            this->impl->_data.resize( this->impl->_pos + size );
+        }
+        
+        memcpy( this->impl->_data.data() + this->impl->_pos, buf, size );
+        
+        this->impl->_pos += size;
+    }
+    
+    void BinaryDataOutputStream::Seek( std::streamoff offset, SeekDirection dir )
+    {
+        size_t pos;
+        
+        if( dir == SeekDirection::Begin )
+        {
+            if( offset < 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = numeric_cast< size_t >( offset );
+        }
+        else if( dir == SeekDirection::End )
+        {
+            if( offset > 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = this->impl->_data.size() - numeric_cast< size_t >( abs( offset ) );
+        }
+        else if( offset < 0 )
+        {
+            pos = this->impl->_pos - numeric_cast< size_t >( abs( offset ) );
+        }
+        else
+        {
+            pos = this->impl->_pos + numeric_cast< size_t >( offset );
+        }
+        
+        if( pos > this->impl->_data.size() )
+        {
+            throw std::runtime_error( "Invalid seek offset" );
+        }
+        
+        this->impl->_pos = pos;
+    }
+    
+    size_t BinaryDataOutputStream::Tell() const
+    {
+        return this->impl->_pos;
+    }
+    
+    const std::vector< uint8_t > & BinaryDataOutputStream::GetData() const
+    {
+        return this->impl->_data;
+    }
+    
+    std::vector< uint8_t > BinaryDataOutputStream::TakeData()
+    {
+        std::vector< uint8_t > data( std::move( this->impl->_data ) );
+        
+        this->impl->_data.clear();
+        
+        this->impl->_pos = 0;
+        
+        return data;
+    }
+    
+    BinaryDataOutputStream::IMPL::IMPL():
+        _pos( 0 )
+    {}
+    
+    BinaryDataOutputStream::IMPL::~IMPL()
+    {}
+}
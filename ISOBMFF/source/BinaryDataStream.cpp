@@ -42,12 +42,16 @@ namespace ISOBMFF
         public:
             
             IMPL();
-            IMPL( const std::vector< uint8_t > & data );
+            IMPL( std::shared_ptr< const std::vector< uint8_t > > buffer, size_t offset, size_t size );
             IMPL( const IMPL & o );
             ~IMPL();
             
-            std::vector< uint8_t > _data;
-            size_t                 _pos;
+            static const std::shared_ptr< const std::vector< uint8_t > > & GetEmptyBuffer();
+            
+            std::shared_ptr< const std::vector< uint8_t > > _buffer;
+            size_t                                          _offset;
+            size_t                                          _size;
+            size_t                                          _pos;
     };
     
     BinaryDataStream::BinaryDataStream():
@@ -55,9 +59,15 @@ namespace ISOBMFF
     {}
     
     BinaryDataStream::BinaryDataStream( const std::vector< uint8_t > & data ):
-        impl( std::make_unique< IMPL >( data ) )
+        impl( std::make_unique< IMPL >( std::make_shared< const std::vector< uint8_t > >( data ), 0, data.size() ) )
     {}
     
+    BinaryDataStream::BinaryDataStream( std::vector< uint8_t > && data ):
+        impl( std::make_unique< IMPL >( nullptr, 0, data.size() ) )
+    {
+        this->impl->_buffer = std::make_shared< const std::vector< uint8_t > >( std::move( data ) );
+    }
+    
     BinaryDataStream::BinaryDataStream( const BinaryDataStream & o ):
         impl( std::make_unique< IMPL >( *( o.impl ) ) )
     {}
@@ -78,12 +88,15 @@ namespace ISOBMFF
     
     void BinaryDataStream::Read( uint8_t * buf, size_t size )
     {
-        if( size > this->impl->_data.size() - this->impl->_pos )
+        if( size > this->impl->_size - this->impl->_pos )
         {
             throw std::runtime_error( "Invalid read - Not enough data available" );
         }
         
-        memcpy( buf, &( this->impl->_data[ 0 ] ) + this->impl->_pos, size );
+        if( size > 0 )
+        {
+            memcpy( buf, this->impl->_buffer->data() + this->impl->_offset + this->impl->_pos, size );
+        }
         
         this->impl->_pos += size;
     }
@@ -108,7 +121,7 @@ namespace ISOBMFF
                 throw std::runtime_error( "Invalid seek offset" );
             }
             
-            pos = this->impl->_data.size() - numeric_cast< size_t >( abs( offset ) );
+            pos = this->impl->_size - numeric_cast< size_t >( abs( offset ) );
         }
         else if( offset < 0 )
         {
@@ -119,7 +132,7 @@ namespace ISOBMFF
             pos = this->impl->_pos + numeric_cast< size_t >( offset );
         }
         
-        if( pos > this->impl->_data.size() )
+        if( pos > this->impl->_size )
         {
             throw std::runtime_error( "Invalid seek offset" );
         }
@@ -132,6 +145,55 @@ namespace ISOBMFF
         return this->impl->_pos;
     }
     
+    BinaryDataStream BinaryDataStream::Slice( size_t size )
+    {
+        BinaryDataStream slice;
+        
+        if( size > this->impl->_size - this->impl->_pos )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        slice.impl = std::make_unique< IMPL >( this->impl->_buffer, this->impl->_offset + this->impl->_pos, size );
+        
+        this->impl->_pos += size;
+        
+        return slice;
+    }
+    
+    Span< const uint8_t > BinaryDataStream::GetDataSpan() const
+    {
+        return Span< const uint8_t >( this->impl->_buffer->data() + this->impl->_offset, this->impl->_size );
+    }
+    
+    BinaryDataStream BinaryDataStream::ReadSlice( BinaryStream & stream, size_t size )
+    {
+        BinaryDataStream * data( dynamic_cast< BinaryDataStream * >( &stream ) );
+        
+        if( data != nullptr )
+        {
+            return data->Slice( size );
+        }
+        
+        return BinaryDataStream( stream.Read( size ) );
+    }
+    
+    BinaryDataStream BinaryDataStream::ReadCompactSlice( BinaryStream & stream, size_t size )
+    {
+        BinaryDataStream * data( dynamic_cast< BinaryDataStream * >( &stream ) );
+        
+        /*
+         * Data kept for a long time only shares the buffer if it covers at
+         * least half of it, so a small box never keeps a large parent alive.
+         */
+        if( data != nullptr && size < data->impl->_buffer->size() / 2 )
+        {
+            return BinaryDataStream( stream.Read( size ) );
+        }
+        
+        return ReadSlice( stream, size );
+    }
+    
     void swap( BinaryDataStream & o1, BinaryDataStream & o2 )
     {
         using std::swap;
@@ -139,20 +201,35 @@ namespace ISOBMFF
         swap( o1.impl, o2.impl );
     }
     
+    /* Empty streams share a single buffer, so creating one only allocates the implementation */
     BinaryDataStream::IMPL::IMPL():
-        _pos( 0 )
+        _buffer( GetEmptyBuffer() ),
+        _offset( 0 ),
+        _size(   0 ),
+        _pos(    0 )
     {}
     
-    BinaryDataStream::IMPL::IMPL( const std::vector< uint8_t > & data ):
-        _data( data ),
-        _pos(  0 )
+    BinaryDataStream::IMPL::IMPL( std::shared_ptr< const std::vector< uint8_t > > buffer, size_t offset, size_t size ):
+        _buffer( std::move( buffer ) ),
+        _offset( offset ),
+        _size(   size ),
+        _pos(    0 )
     {}
     
     BinaryDataStream::IMPL::IMPL( const IMPL & o ):
-        _data( o._data ),
-        _pos(  o._pos )
+        _buffer( o._buffer ),
+        _offset( o._offset ),
+        _size(   o._size ),
+        _pos(    o._pos )
     {}
     
     BinaryDataStream::IMPL::~IMPL()
     {}
+    
+    const std::shared_ptr< const std::vector< uint8_t > > & BinaryDataStream::IMPL::GetEmptyBuffer()
+    {
+        static const std::shared_ptr< const std::vector< uint8_t > > buffer( std::make_shared< const std::vector< uint8_t > >() );
+        
+        return buffer;
+    }
 }
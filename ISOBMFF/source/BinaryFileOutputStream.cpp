@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryFileOutputStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <fstream>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <ISOBMFF/BinaryFileOutputStream.hpp>
+#include <ISOBMFF/Casts.hpp>
+
+#ifdef _WIN32
+#include <ISOBMFF/WIN32.hpp>
+#endif
+
+namespace ISOBMFF
+{
+    class BinaryFileOutputStream::IMPL
+    {
+        public:
+            
+            IMPL( const std::string & path );
+            ~IMPL();
+            
+            std::ofstream _stream;
+            std::string   _path;
+            size_t        _size;
+            size_t        _pos;
+    };
+    
+    BinaryFileOutputStream::BinaryFileOutputStream( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    BinaryFileOutputStream::~BinaryFileOutputStream()
+    {}
+    
+    void BinaryFileOutputStream::Write( const uint8_t * buf, size_t size )
+    {
+        if( this->impl->_stream.is_open() == false )
+        {
+            throw std::runtime_error( "Invalid file stream" );
+        }
+        
+        this->impl->_stream.write( reinterpret_cast< const char * >( buf ), numeric_cast< std::streamsize >( size ) );
+        
+        if( this->impl->_stream.good() == false )
+        {
+            throw std::runtime_error( "Invalid write - Cannot write to file: " + this->impl->_path );
+        }
+        
+        this->impl->_pos += size;
+        this->impl->_size = std::max( this->impl->_size, this->impl->_pos );
+    }
+    
+    void BinaryFileOutputStream::Seek( std::streamoff offset, SeekDirection dir )
+    {
+        size_t pos;
+        
+        if( dir == SeekDirection::Begin )
+        {
+            if( offset < 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = numeric_cast< size_t >( offset );
+        }
+        else if( dir == SeekDirection::End )
+        {
+            if( offset > 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = this->impl->_size - numeric_cast< size_t >( abs( offset ) );
+        }
+        else if( offset < 0 )
+        {
+            pos = this->impl->_pos - numeric_cast< size_t >( abs( offset ) );
+        }
+        else
+        {
+            pos = this->impl->_pos + numeric_cast< size_t >( offset );
+        }
+        
+        if( pos > this->impl->_size )
+        {
+            throw std::runtime_error( "Invalid seek offset" );
+        }
+        
+        this->impl->_pos = pos;
+        
+        this->impl->_stream.seekp( numeric_cast< std::streamoff >( pos ), std::ios_base::beg );
+    }
+    
+    size_t BinaryFileOutputStream::Tell() const
+    {
+        if( this->impl->_stream.is_open() == false )
+        {
+            throw std::runtime_error( "Invalid file stream" );
+        }
+        
+        return this->impl->_pos;
+    }
+    
+    BinaryFileOutputStream::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _size( 0 ),
+        _pos(  0 )
+    {
+        #ifdef _WIN32
+        this->_stream.open( ISOBMFF::StringToWideString( path ), std::ios::binary | std::ios::trunc );
+        #else
+        this->_stream.open( path, std::ios::binary | std::ios::trunc );
+        #endif
+        
+        if( this->_stream.good() == false )
+        {
+            throw std::runtime_error( "Cannot open file for writing: " + path );
+        }
+    }
+    
+    BinaryFileOutputStream::IMPL::~IMPL()
+    {
+        if( this->_stream.is_open() )
+        {
+            this->_stream.close();
+        }
+    }
+}
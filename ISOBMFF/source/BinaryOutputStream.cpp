@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryOutputStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+
+namespace ISOBMFF
+{
+    void BinaryOutputStream::Write( Span< const uint8_t > data )
+    {
+        if( data.size() > 0 )
+        {
+            this->Write( data.data(), data.size() );
+        }
+    }
+    
+    void BinaryOutputStream::Write( const std::vector< uint8_t > & data )
+    {
+        if( data.size() > 0 )
+        {
+            this->Write( data.data(), data.size() );
+        }
+    }
+    
+    void BinaryOutputStream::WriteZeros( size_t size )
+    {
+        uint8_t zeros[ 256 ] = {};
+        
+        while( size > 0 )
+        {
+            size_t n( std::min( size, sizeof( zeros ) ) );
+            
+            this->Write( zeros, n );
+            
+            size -= n;
+        }
+    }
+    
+    void BinaryOutputStream::WriteUInt8( uint8_t value )
+    {
+        this->Write( &value, 1 );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt16( uint16_t value )
+    {
+        uint8_t c[ 2 ];
+        
+        c[ 0 ] = static_cast< uint8_t >( value >> 8 );
+        c[ 1 ] = static_cast< uint8_t >( value );
+        
+        this->Write( c, 2 );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt32( uint32_t value )
+    {
+        uint8_t c[ 4 ];
+        
+        c[ 0 ] = static_cast< uint8_t >( value >> 24 );
+        c[ 1 ] = static_cast< uint8_t >( value >> 16 );
+        c[ 2 ] = static_cast< uint8_t >( value >> 8 );
+        c[ 3 ] = static_cast< uint8_t >( value );
+        
+        this->Write( c, 4 );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt64( uint64_t value )
+    {
+        this->WriteBigEndianUInt32( static_cast< uint32_t >( value >> 32 ) );
+        this->WriteBigEndianUInt32( static_cast< uint32_t >( value ) );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianFixedPoint( float value, unsigned int integerLength, unsigned int fractionalLength )
+    {
+        uint32_t n;
+        
+        n = static_cast< uint32_t >( std::lround( static_cast< double >( value ) * static_cast< double >( 1 << fractionalLength ) ) );
+        
+        if( integerLength + fractionalLength == 16 )
+        {
+            this->WriteBigEndianUInt16( static_cast< uint16_t >( n ) );
+        }
+        else
+        {
+            this->WriteBigEndianUInt32( n );
+        }
+    }
+    
+    void BinaryOutputStream::WriteFourCC( const std::string & value )
+    {
+        if( value.size() != 4 )
+        {
+            throw std::runtime_error( "Invalid four character code: " + value );
+        }
+        
+        this->WriteString( value );
+    }
+    
+    void BinaryOutputStream::WriteString( const std::string & value )
+    {
+        this->Write( reinterpret_cast< const uint8_t * >( value.data() ), value.size() );
+    }
+    
+    void BinaryOutputStream::WriteNULLTerminatedString( const std::string & value )
+    {
+        this->WriteString( value );
+        this->WriteUInt8( 0 );
+    }
+    
+    void BinaryOutputStream::WritePascalString( const std::string & value )
+    {
+        if( value.size() > 0xFF )
+        {
+            throw std::runtime_error( "Invalid Pascal string - String is too long" );
+        }
+        
+        this->WriteUInt8( static_cast< uint8_t >( value.size() ) );
+        this->WriteString( value );
+    }
+    
+    void BinaryOutputStream::WriteMatrix( const Matrix & value )
+    {
+        this->WriteBigEndianUInt32( value.GetA() );
+        this->WriteBigEndianUInt32( value.GetB() );
+        this->WriteBigEndianUInt32( value.GetU() );
+        this->WriteBigEndianUInt32( value.GetC() );
+        this->WriteBigEndianUInt32( value.GetD() );
+        this->WriteBigEndianUInt32( value.GetV() );
+        this->WriteBigEndianUInt32( value.GetX() );
+        this->WriteBigEndianUInt32( value.GetY() );
+        this->WriteBigEndianUInt32( value.GetW() );
+    }
+    
+    void BinaryOutputStream::WriteSourceRange( uint64_t offset, uint64_t size )
+    {
+        ( void )offset;
+        ( void )size;
+        
+        throw std::runtime_error( "Invalid write - Stream has no source file" );
+    }
+    
+    size_t BinaryOutputStream::BeginBox( const std::string & type )
+    {
+        size_t offset( this->Tell() );
+        
+        this->WriteBigEndianUInt32( 0 );
+        this->WriteFourCC( type );
+        
+        return offset;
+    }
+    
+    size_t BinaryOutputStream::BeginFullBox( const std::string & type, uint8_t version, uint32_t flags )
+    {
+        size_t offset( this->BeginBox( type ) );
+        
+        this->WriteBigEndianUInt32( ( static_cast< uint32_t >( version ) << 24 ) | ( flags & 0x00FFFFFF ) );
+        
+        return offset;
+    }
+    
+    void BinaryOutputStream::EndBox( size_t offset )
+    {
+        size_t end( this->Tell() );
+        
+        if( end - offset > UINT32_MAX )
+        {
+            throw std::runtime_error( "Invalid box - Box is too large" );
+        }
+        
+        this->Seek( numeric_cast< std::streamoff >( offset ), SeekDirection::Begin );
+        this->WriteBigEndianUInt32( static_cast< uint32_t >( end - offset ) );
+        this->Seek( numeric_cast< std::streamoff >( end ), SeekDirection::Begin );
+    }
+}
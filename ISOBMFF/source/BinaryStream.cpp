@@ -437,17 +437,16 @@ namespace ISOBMFF
     
     Matrix BinaryStream::ReadMatrix()
     {
-        return Matrix
-        (
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32()
-        );
+        uint32_t a = this->ReadBigEndianUInt32();
+        uint32_t b = this->ReadBigEndianUInt32();
+        uint32_t u = this->ReadBigEndianUInt32();
+        uint32_t c = this->ReadBigEndianUInt32();
+        uint32_t d = this->ReadBigEndianUInt32();
+        uint32_t v = this->ReadBigEndianUInt32();
+        uint32_t x = this->ReadBigEndianUInt32();
+        uint32_t y = this->ReadBigEndianUInt32();
+        uint32_t w = this->ReadBigEndianUInt32();
+        
+        return Matrix( a, b, u, c, d, v, x, y, w );
     }
 }
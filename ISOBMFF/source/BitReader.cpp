@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BitReader.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/BitReader.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    BitReader::BitReader( Span< const uint8_t > data ):
+        _data( data ),
+        _position( 0 )
+    {}
+    
+    bool BitReader::ReadBit()
+    {
+        bool bit;
+        
+        if( this->_position >= this->_data.size() * 8 )
+        {
+            throw std::runtime_error( "Invalid read - Not enough bits available" );
+        }
+        
+        bit = ( ( this->_data[ this->_position / 8 ] >> ( 7 - ( this->_position % 8 ) ) ) & 1 ) != 0;
+        
+        this->_position++;
+        
+        return bit;
+    }
+    
+    uint32_t BitReader::ReadBits( unsigned int count )
+    {
+        uint64_t value( 0 );
+        size_t   byte( this->_position / 8 );
+        size_t   shift( this->_position % 8 );
+        size_t   bytes;
+        
+        if( count > 32 )
+        {
+            throw std::runtime_error( "Invalid read - Cannot read more than 32 bits at once" );
+        }
+        
+        if( count > this->GetBitsAvailable() )
+        {
+            throw std::runtime_error( "Invalid read - Not enough bits available" );
+        }
+        
+        if( count == 0 )
+        {
+            return 0;
+        }
+        
+        bytes = ( shift + count + 7 ) / 8;
+        
+        for( size_t i = 0; i < bytes; i++ )
+        {
+            value = ( value << 8 ) | this->_data[ byte + i ];
+        }
+        
+        value >>= ( bytes * 8 ) - shift - count;
+        
+        this->_position += count;
+        
+        return static_cast< uint32_t >( value & ( ( static_cast< uint64_t >( 1 ) << count ) - 1 ) );
+    }
+    
+    uint32_t BitReader::ReadUE()
+    {
+        unsigned int zeros( 0 );
+        
+        while( this->ReadBit() == false )
+        {
+            if( ++zeros > 31 )
+            {
+                throw std::runtime_error( "Invalid Exp-Golomb code - Value is too large" );
+            }
+        }
+        
+        if( zeros == 0 )
+        {
+            return 0;
+        }
+        
+        return static_cast< uint32_t >( ( ( static_cast< uint64_t >( 1 ) << zeros ) - 1 ) + this->ReadBits( zeros ) );
+    }
+    
+    int32_t BitReader::ReadSE()
+    {
+        uint32_t value( this->ReadUE() );
+        
+        if( value & 1 )
+        {
+            return static_cast< int32_t >( ( value >> 1 ) + 1 );
+        }
+        
+        return -static_cast< int32_t >( value >> 1 );
+    }
+    
+    void BitReader::SkipBits( size_t count )
+    {
+        if( count > this->GetBitsAvailable() )
+        {
+            throw std::runtime_error( "Invalid read - Not enough bits available" );
+        }
+        
+        this->_position += count;
+    }
+    
+    size_t BitReader::GetPosition() const
+    {
+        return this->_position;
+    }
+    
+    size_t BitReader::GetBitsAvailable() const
+    {
+        return ( this->_data.size() * 8 ) - this->_position;
+    }
+}
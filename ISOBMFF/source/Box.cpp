@@ -32,10 +32,12 @@
 #include <ISOBMFF/Utils.hpp>
 #include <ISOBMFF/DisplayableObjectContainer.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class Box::IMPL
+    class Box::IMPL: public ResourceAllocated
     {
         public:
             
@@ -43,9 +45,12 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
-            std::string            _name;
-            std::vector< uint8_t > _data;
-            bool                   _hasData;
+            std::string                         _name;
+            std::unique_ptr< BinaryDataStream > _data;
+            bool                                _hasSourceRange;
+            uint64_t                            _sourceOffset;
+            uint64_t                            _sourceSize;
+            uint64_t                            _sourceHeaderSize;
     };
     
     Box::Box( const std::string & name ):
@@ -88,13 +93,106 @@ namespace ISOBMFF
     {
         ( void )parser;
         
-        this->impl->_data    = stream.ReadAllData();
-        this->impl->_hasData = true;
+        /* The data stream is only created for boxes read from a file, so created boxes need a single allocation */
+        this->impl->_data = std::make_unique< BinaryDataStream >( BinaryDataStream::ReadCompactSlice( stream, stream.AvailableBytes() ) );
     }
     
     std::vector< uint8_t > Box::GetData() const
     {
-        return this->impl->_data;
+        Span< const uint8_t > data( this->GetDataSpan() );
+        
+        return std::vector< uint8_t >( data.begin(), data.end() );
+    }
+    
+    Span< const uint8_t > Box::GetDataSpan() const
+    {
+        if( this->impl->_data == nullptr )
+        {
+            return {};
+        }
+        
+        return this->impl->_data->GetDataSpan();
+    }
+    
+    uint64_t Box::GetSize() const
+    {
+        uint64_t size( this->GetDataSize() );
+        
+        if( size + 8 > UINT32_MAX || ( this->impl->_hasSourceRange && this->impl->_sourceHeaderSize == 16 ) )
+        {
+            return size + 16;
+        }
+        
+        return size + 8;
+    }
+    
+    uint64_t Box::GetDataSize() const
+    {
+        if( this->impl->_data == nullptr && this->impl->_hasSourceRange )
+        {
+            return this->impl->_sourceSize - this->impl->_sourceHeaderSize;
+        }
+        
+        return this->GetDataSpan().size();
+    }
+    
+    void Box::Write( BinaryOutputStream & stream ) const
+    {
+        uint64_t size( this->GetSize() );
+        
+        if( size - this->GetDataSize() == 16 )
+        {
+            stream.WriteBigEndianUInt32( 1 );
+            stream.WriteFourCC( this->GetName() );
+            stream.WriteBigEndianUInt64( size );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( size ) );
+            stream.WriteFourCC( this->GetName() );
+        }
+        
+        this->WriteData( stream );
+    }
+    
+    void Box::WriteData( BinaryOutputStream & stream ) const
+    {
+        if( this->impl->_data == nullptr && this->impl->_hasSourceRange )
+        {
+            stream.WriteSourceRange( this->impl->_sourceOffset + this->impl->_sourceHeaderSize, this->impl->_sourceSize - this->impl->_sourceHeaderSize );
+        }
+        else
+        {
+            stream.Write( this->GetDataSpan() );
+        }
+    }
+    
+    bool Box::HasSourceRange() const
+    {
+        return this->impl->_hasSourceRange;
+    }
+    
+    uint64_t Box::GetSourceOffset() const
+    {
+        return this->impl->_sourceOffset;
+    }
+    
+    uint64_t Box::GetSourceSize() const
+    {
+        return this->impl->_sourceSize;
+    }
+    
+    uint64_t Box::GetSourceHeaderSize() const
+    {
+        return this->impl->_sourceHeaderSize;
+    }
+    
+    void Box::SetSourceRange( uint64_t offset, uint64_t size, uint64_t headerSize )
+    {
+        this->impl->_hasSourceRange   = true;
+        this->impl->_sourceOffset     = offset;
+        this->impl->_sourceSize       = size;
+        this->impl->_sourceHeaderSize = headerSize;
     }
     
     std::vector< std::pair< std::string, std::string > > Box::GetDisplayableProperties() const
@@ -104,13 +202,19 @@ namespace ISOBMFF
     
     Box::IMPL::IMPL( const std::string & name ):
         _name( name ),
-        _hasData( false )
+        _hasSourceRange( false ),
+        _sourceOffset( 0 ),
+        _sourceSize( 0 ),
+        _sourceHeaderSize( 0 )
     {}
 
     Box::IMPL::IMPL( const IMPL & o ):
         _name( o._name ),
-        _data( o._data ),
-        _hasData( o._hasData )
+        _data( ( o._data != nullptr ) ? std::make_unique< BinaryDataStream >( *( o._data ) ) : nullptr ),
+        _hasSourceRange( o._hasSourceRange ),
+        _sourceOffset( o._sourceOffset ),
+        _sourceSize( o._sourceSize ),
+        _sourceHeaderSize( o._sourceHeaderSize )
     {}
 
     Box::IMPL::~IMPL()
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/CDSC.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class CDSC::IMPL
+    class CDSC::IMPL: public ResourceAllocated
     {
         public:
             
@@ -30,12 +30,13 @@
 
 #include <ISOBMFF/CO64.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class CO64::IMPL
+    class CO64::IMPL: public ResourceAllocated
     {
         public:
 
@@ -94,6 +95,23 @@ namespace ISOBMFF
         }
     }
 
+    uint64_t CO64::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + 8 * static_cast< uint64_t >( this->impl->_chunk_offset_table.size() );
+    }
+
+    void CO64::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_chunk_offset_table.size() ) );
+
+        for( uint64_t offset: this->impl->_chunk_offset_table )
+        {
+            stream.WriteBigEndianUInt64( offset );
+        }
+    }
+
     std::vector< std::pair< std::string, std::string > > CO64::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -116,6 +134,16 @@ namespace ISOBMFF
         return this->impl->_chunk_offset_table[ index ];
     }
 
+    void CO64::SetChunkOffset( size_t index, uint64_t value )
+    {
+        this->impl->_chunk_offset_table[ index ] = value;
+    }
+
+    void CO64::AddChunkOffset( uint64_t value )
+    {
+        this->impl->_chunk_offset_table.push_back( value );
+    }
+
     CO64::IMPL::IMPL()
     {}
 
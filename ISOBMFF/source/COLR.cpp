@@ -29,12 +29,13 @@
  */
 
 #include <ISOBMFF/COLR.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <sstream>
 #include <iomanip>
 
 namespace ISOBMFF
 {
-    class COLR::IMPL
+    class COLR::IMPL: public ResourceAllocated
     {
         public:
             
@@ -107,6 +108,41 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t COLR::GetDataSize() const
+    {
+        if( this->GetColourType() == "nclx" )
+        {
+            return 11;
+        }
+        else if( this->GetColourType() == "rICC" || this->GetColourType() == "prof" )
+        {
+            return 4 + this->impl->_iccProfile.size();
+        }
+        
+        return 4 + Box::GetDataSize();
+    }
+    
+    void COLR::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteFourCC( this->GetColourType() );
+        
+        if( this->GetColourType() == "nclx" )
+        {
+            stream.WriteBigEndianUInt16( this->GetColourPrimaries() );
+            stream.WriteBigEndianUInt16( this->GetTransferCharacteristics() );
+            stream.WriteBigEndianUInt16( this->GetMatrixCoefficients() );
+            stream.WriteUInt8( ( this->GetFullRangeFlag() ) ? 0x80 : 0x00 );
+        }
+        else if( this->GetColourType() == "rICC" || this->GetColourType() == "prof" )
+        {
+            stream.Write( this->impl->_iccProfile );
+        }
+        else
+        {
+            Box::WriteData( stream );
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > COLR::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -123,11 +159,9 @@ namespace ISOBMFF
         else if( this->GetColourType() == "rICC" || this->GetColourType() == "prof" )
         {
             {
-                std::vector< uint8_t > data;
-                std::stringstream      ss;
-                std::string            s;
-                
-                data = this->GetICCProfile();
+                Span< const uint8_t > data( this->GetICCProfileSpan() );
+                std::stringstream     ss;
+                std::string           s;
                 
                 if( data.size() > 0 )
                 {
@@ -182,6 +216,11 @@ namespace ISOBMFF
         return this->impl->_iccProfile;
     }
     
+    Span< const uint8_t > COLR::GetICCProfileSpan() const
+    {
+        return this->impl->_iccProfile;
+    }
+    
     void COLR::SetColourType( const std::string & value )
     {
         this->impl->_colourType = value;
@@ -211,6 +250,11 @@ namespace ISOBMFF
     {
         this->impl->_iccProfile = value;
     }
+    
+    void COLR::SetICCProfile( std::vector< uint8_t > && value )
+    {
+        this->impl->_iccProfile = std::move( value );
+    }
 
     COLR::IMPL::IMPL():
         _colourPrimaries( 0 ),
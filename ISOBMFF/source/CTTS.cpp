@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        CTTS.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/CTTS.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    class CTTS::IMPL: public ResourceAllocated
+    {
+        public:
+
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+
+            std::vector< uint32_t > _sample_count;
+            std::vector< int32_t >  _sample_offset;
+    };
+
+    CTTS::CTTS():
+        FullBox( "ctts" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+
+    CTTS::CTTS( const CTTS & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+
+    CTTS::CTTS( CTTS && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+
+    CTTS::~CTTS()
+    {}
+
+    CTTS & CTTS::operator =( CTTS o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+
+        return *( this );
+    }
+
+    void swap( CTTS & o1, CTTS & o2 )
+    {
+        using std::swap;
+
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+
+    void CTTS::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+
+        uint32_t entry_count = stream.ReadBigEndianUInt32();
+
+        for( uint32_t i = 0; i < entry_count; i++ )
+        {
+            this->impl->_sample_count.push_back(  stream.ReadBigEndianUInt32() );
+            this->impl->_sample_offset.push_back( static_cast< int32_t >( stream.ReadBigEndianUInt32() ) );
+        }
+    }
+
+    uint64_t CTTS::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + 8 * static_cast< uint64_t >( this->impl->_sample_count.size() );
+    }
+
+    void CTTS::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sample_count.size() ) );
+
+        for( size_t i = 0; i < this->impl->_sample_count.size(); i++ )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_sample_count[ i ] );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sample_offset[ i ] ) );
+        }
+    }
+
+    std::vector< std::pair< std::string, std::string > > CTTS::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+
+        for( unsigned int index = 0; index < this->GetEntryCount(); index++ )
+        {
+            props.push_back( { "Sample Count",  std::to_string( this->GetSampleCount(  index) ) } );
+            props.push_back( { "Sample Offset", std::to_string( this->GetSampleOffset( index) ) } );
+        }
+
+        return props;
+    }
+
+    size_t CTTS::GetEntryCount() const
+    {
+        return this->impl->_sample_count.size();
+    }
+
+    uint32_t CTTS::GetSampleCount( size_t index ) const
+    {
+        return this->impl->_sample_count[ index ];
+    }
+
+    int32_t CTTS::GetSampleOffset( size_t index ) const
+    {
+        return this->impl->_sample_offset[ index ];
+    }
+
+    CTTS::IMPL::IMPL()
+    {}
+
+    CTTS::IMPL::IMPL( const IMPL & o )
+    {
+        this->_sample_count  = o._sample_count;
+        this->_sample_offset = o._sample_offset;
+    }
+
+    CTTS::IMPL::~IMPL()
+    {}
+}
@@ -58,6 +58,11 @@ namespace ISOBMFF
         }
     }
     
+    Span< const std::shared_ptr< Box > > Container::GetBoxesSpan() const
+    {
+        return {};
+    }
+    
     void Container::WriteBoxes( std::ostream & os, std::size_t indentLevel ) const
     {
         Container::WriteBoxes( this->GetBoxes(), os, indentLevel );
@@ -67,20 +72,36 @@ namespace ISOBMFF
     {
         std::vector< std::shared_ptr< Box > > boxes;
         
-        for( const auto & box: this->GetBoxes() )
-        {
-            if( box->GetName() == name )
+        this->ForEachBox
+        (
+            name,
+            [ & ]( const std::shared_ptr< Box > & box )
             {
                 boxes.push_back( box );
             }
-        }
+        );
         
         return boxes;
     }
     
     std::shared_ptr< Box > Container::GetBox( const std::string & name ) const
     {
-        for( const auto & box: this->GetBoxes() )
+        Span< const std::shared_ptr< Box > > boxes( this->GetBoxesSpan() );
+        
+        if( boxes.data() == nullptr )
+        {
+            for( const auto & box: this->GetBoxes() )
+            {
+                if( box->GetName() == name )
+                {
+                    return box;
+                }
+            }
+            
+            return nullptr;
+        }
+        
+        for( const auto & box: boxes )
         {
             if( box->GetName() == name )
             {
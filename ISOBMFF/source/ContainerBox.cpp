@@ -31,10 +31,12 @@
 #include <ISOBMFF/ContainerBox.hpp>
 #include <ISOBMFF/Parser.hpp>
 #include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
+#include <algorithm>
 
 namespace ISOBMFF
 {
-    class ContainerBox::IMPL
+    class ContainerBox::IMPL: public ResourceAllocated
     {
         public:
             
@@ -43,6 +45,7 @@ namespace ISOBMFF
             ~IMPL();
             
             std::vector< std::shared_ptr< Box > > _boxes;
+            std::vector< uint8_t >                _padding;
     };
     
     ContainerBox::ContainerBox( const std::string & name ):
@@ -83,24 +86,38 @@ namespace ISOBMFF
 
     void ContainerBox::ReadData( Parser & parser, BinaryStream & stream )
     {
+        uint64_t               offset;
         uint64_t               length;
+        uint64_t               header;
         std::string            name;
         std::shared_ptr< Box > box;
         BinaryDataStream     * content;
         
         this->impl->_boxes.clear();
+        this->impl->_padding.clear();
         
         while( stream.HasBytesAvailable() )
         {
             ( void )parser;
             
+            /* QuickTime allows a 32-bit zero terminator after the last box */
+            if( stream.AvailableBytes() < 8 )
+            {
+                this->impl->_padding = stream.ReadAllData();
+                
+                break;
+            }
+            
+            offset   = this->GetSourceOffset() + this->GetSourceHeaderSize() + stream.Tell();
             length   = stream.ReadBigEndianUInt32();
             name     = stream.ReadFourCC();
+            header   = 8;
             content  = nullptr;
             
             if( length == 1 )
             {
                 length = stream.ReadBigEndianUInt64();
+                header = 16;
                 
                 if
                 (
@@ -112,7 +129,7 @@ namespace ISOBMFF
                 }
                 else
                 {
-                    content = new BinaryDataStream( stream.Read( static_cast< size_t >( length ) - 16 ) );
+                    content = new BinaryDataStream( BinaryDataStream::ReadSlice( stream, static_cast< size_t >( length ) - 16 ) );
                 }
             }
             else
@@ -123,7 +140,7 @@ namespace ISOBMFF
                 }
                 else
                 {
-                    content = new BinaryDataStream( stream.Read( static_cast< uint32_t >( length ) - 8 ) );
+                    content = new BinaryDataStream( BinaryDataStream::ReadSlice( stream, static_cast< uint32_t >( length ) - 8 ) );
                 }
             }
             
@@ -131,6 +148,8 @@ namespace ISOBMFF
             
             if( box != nullptr )
             {
+                box->SetSourceRange( offset, length, header );
+                
                 if( content )
                 {
                     box->ReadData( parser, *content );
@@ -145,6 +164,28 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t ContainerBox::GetDataSize() const
+    {
+        uint64_t size( this->impl->_padding.size() );
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            size += box->GetSize();
+        }
+        
+        return size;
+    }
+    
+    void ContainerBox::WriteData( BinaryOutputStream & stream ) const
+    {
+        for( const auto & box: this->impl->_boxes )
+        {
+            box->Write( stream );
+        }
+        
+        stream.Write( this->impl->_padding );
+    }
+    
     void ContainerBox::AddBox( std::shared_ptr< Box > box )
     {
         if( box != nullptr )
@@ -158,6 +199,30 @@ namespace ISOBMFF
         return this->impl->_boxes;
     }
     
+    Span< const std::shared_ptr< Box > > ContainerBox::GetBoxesSpan() const
+    {
+        return this->impl->_boxes;
+    }
+    
+    std::vector< uint8_t > ContainerBox::GetPadding() const
+    {
+        return this->impl->_padding;
+    }
+    
+    bool ContainerBox::ReplaceBox( const std::shared_ptr< Box > & box, std::shared_ptr< Box > replacement )
+    {
+        auto it( std::find( this->impl->_boxes.begin(), this->impl->_boxes.end(), box ) );
+        
+        if( it == this->impl->_boxes.end() || replacement == nullptr )
+        {
+            return false;
+        }
+        
+        *( it ) = replacement;
+        
+        return true;
+    }
+    
     void ContainerBox::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         Box::WriteDescription( os, indentLevel );
@@ -168,7 +233,8 @@ namespace ISOBMFF
     {}
 
     ContainerBox::IMPL::IMPL( const IMPL & o ):
-        _boxes( o._boxes )
+        _boxes( o._boxes ),
+        _padding( o._padding )
     {}
 
     ContainerBox::IMPL::~IMPL()
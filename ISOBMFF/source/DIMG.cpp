@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/DIMG.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class DIMG::IMPL
+    class DIMG::IMPL: public ResourceAllocated
     {
         public:
             
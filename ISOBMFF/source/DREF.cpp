@@ -30,10 +30,11 @@
 
 #include <ISOBMFF/DREF.hpp>
 #include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class DREF::IMPL
+    class DREF::IMPL: public ResourceAllocated
     {
         public:
             
@@ -42,6 +43,7 @@ namespace ISOBMFF
             ~IMPL();
             
             std::vector< std::shared_ptr< Box > > _boxes;
+            std::vector< uint8_t >                _padding;
     };
     
     DREF::DREF():
@@ -86,9 +88,39 @@ namespace ISOBMFF
         
         FullBox::ReadData( parser, stream );
         stream.ReadBigEndianUInt32();
+        container.SetSourceRange( this->GetSourceOffset(), this->GetSourceSize(), this->GetSourceHeaderSize() );
         container.ReadData( parser, stream );
         
-        this->impl->_boxes = container.GetBoxes();
+        this->impl->_boxes   = container.GetBoxes();
+        this->impl->_padding = container.GetPadding();
+    }
+    
+    uint64_t DREF::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() + 4 );
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            size += box->GetSize();
+        }
+        
+        size += this->impl->_padding.size();
+        
+        return size;
+    }
+    
+    void DREF::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_boxes.size() ) );
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            box->Write( stream );
+        }
+        
+        stream.Write( this->impl->_padding );
     }
     
     void DREF::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
@@ -110,11 +142,17 @@ namespace ISOBMFF
         return this->impl->_boxes;
     }
     
+    Span< const std::shared_ptr< Box > > DREF::GetBoxesSpan() const
+    {
+        return this->impl->_boxes;
+    }
+    
     DREF::IMPL::IMPL()
     {}
 
     DREF::IMPL::IMPL( const IMPL & o ):
-        _boxes( o._boxes )
+        _boxes( o._boxes ),
+        _padding( o._padding )
     {}
 
     DREF::IMPL::~IMPL()
@@ -0,0 +1,800 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Defragmenter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Defragmenter.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/ScatterGatherWriter.hpp>
+#include <ISOBMFF/SampleTableBuilder.hpp>
+#include <ISOBMFF/MVHD.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/STSD.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Defragmenter::IMPL
+    {
+        public:
+            
+            /*
+             * Position of a top-level box in the input file.
+             */
+            struct Extent
+            {
+                uint64_t offset;
+                uint64_t size;
+                uint64_t header;
+            };
+            
+            /*
+             * Entry of an edit list. A media time of -1 is an empty edit.
+             */
+            struct Edit
+            {
+                uint64_t segmentDuration;
+                int64_t  mediaTime;
+            };
+            
+            /*
+             * Sample table of a track, built from its track runs.
+             * Decode times start at the first TFDT of the track, and the
+             * edit list of the track is rebased on it.
+             */
+            struct Output
+            {
+                uint32_t                trackID;
+                uint32_t                timescale;
+                std::shared_ptr< TREX > trex;
+                SampleTableBuilder      table;
+                uint64_t                startTime;
+                uint32_t                lastDuration;
+                std::vector< Edit >     sourceEdits;
+                std::vector< Edit >     edits;
+                uint64_t                duration;
+            };
+            
+            IMPL( const std::string & path );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void ReadTRAF( BinaryOutputStream & stream, std::vector< Output > & outputs, const ContainerBox & traf, uint64_t base, uint64_t & dataEnd ) const;
+            void BuildEdits( std::vector< Output > & outputs ) const;
+            void WriteMOOV( BinaryOutputStream & stream, const std::vector< Output > & outputs ) const;
+            void WriteBox( BinaryOutputStream & stream, const std::vector< Output > & outputs, const Output * output, const std::shared_ptr< Box > & box ) const;
+            
+            static std::shared_ptr< Box > ReadBox( Parser & parser, BinaryStream & stream, const Extent & extent );
+            static Output               * FindOutput( std::vector< Output > & outputs, uint32_t trackID );
+            static const Output         * FindOutput( const std::vector< Output > & outputs, uint32_t trackID );
+            static uint32_t               GetTrackID( const ContainerBox & trak );
+            static std::vector< Edit >    ReadEdits( const ContainerBox & trak );
+            static void                   SetDecodeTime( Output & output, uint64_t time );
+            static void                   WriteEDTS( BinaryOutputStream & stream, const std::vector< Edit > & edits );
+            
+            std::string                     _path;
+            uint64_t                        _size;
+            std::shared_ptr< ContainerBox > _moov;
+            std::vector< Extent >           _fragments;
+            std::vector< Output >           _outputs;
+    };
+    
+    static uint64_t Rescale( uint64_t value, uint32_t from, uint32_t to );
+    
+    Defragmenter::Defragmenter( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    Defragmenter::Defragmenter( const Defragmenter & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Defragmenter::Defragmenter( Defragmenter && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Defragmenter::~Defragmenter()
+    {}
+    
+    Defragmenter & Defragmenter::operator =( Defragmenter o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Defragmenter & o1, Defragmenter & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    size_t Defragmenter::GetFragmentCount() const
+    {
+        return this->impl->_fragments.size();
+    }
+    
+    void Defragmenter::Write( BinaryOutputStream & stream ) const
+    {
+        BinaryFileStream            input( this->impl->_path );
+        Parser                      parser;
+        std::vector< IMPL::Output > outputs( this->impl->_outputs );
+        size_t                      box;
+        size_t                      mdat;
+        size_t                      end;
+        
+        box = stream.BeginBox( "ftyp" );
+        
+        stream.WriteFourCC( "isom" );
+        stream.WriteBigEndianUInt32( 512 );
+        stream.WriteFourCC( "isom" );
+        stream.WriteFourCC( "iso2" );
+        stream.WriteFourCC( "mp41" );
+        stream.EndBox( box );
+        
+        /* The MDAT size is written once all fragments are copied, as a 64-bit size */
+        mdat = stream.Tell();
+        
+        stream.WriteBigEndianUInt32( 1 );
+        stream.WriteFourCC( "mdat" );
+        stream.WriteBigEndianUInt64( 0 );
+        
+        for( const auto & fragment: this->impl->_fragments )
+        {
+            std::shared_ptr< ContainerBox > moof( std::dynamic_pointer_cast< ContainerBox >( IMPL::ReadBox( parser, input, fragment ) ) );
+            uint64_t                        dataEnd( fragment.offset );
+            
+            if( moof == nullptr )
+            {
+                throw std::runtime_error( "Invalid fragment - Cannot read MOOF box" );
+            }
+            
+            for( const auto & child: static_cast< const Container & >( *( moof ) ).GetBoxes( "traf" ) )
+            {
+                std::shared_ptr< ContainerBox > traf( std::dynamic_pointer_cast< ContainerBox >( child ) );
+                
+                if( traf != nullptr )
+                {
+                    this->impl->ReadTRAF( stream, outputs, *( traf ), fragment.offset, dataEnd );
+                }
+            }
+        }
+        
+        end = stream.Tell();
+        
+        stream.Seek( numeric_cast< std::streamoff >( mdat + 8 ), BinaryOutputStream::SeekDirection::Begin );
+        stream.WriteBigEndianUInt64( end - mdat );
+        stream.Seek( 0, BinaryOutputStream::SeekDirection::End );
+        
+        this->impl->BuildEdits( outputs );
+        this->impl->WriteMOOV( stream, outputs );
+    }
+    
+    void Defragmenter::Write( const std::string & path ) const
+    {
+        if( path == this->impl->_path )
+        {
+            throw std::runtime_error( "Invalid output path - Cannot rewrite a file in place" );
+        }
+        
+        ScatterGatherWriter stream( path, this->impl->_path );
+        
+        this->Write( stream );
+        stream.Flush();
+    }
+    
+    Defragmenter::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _size( 0 )
+    {
+        BinaryFileStream stream( path );
+        Parser           parser;
+        uint64_t         offset( 0 );
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::End );
+        
+        this->_size = stream.Tell();
+        
+        /* Only box headers are read, except for the MOOV box. An incomplete trailing box, as left by an interrupted recording, is ignored. */
+        while( offset + 8 <= this->_size )
+        {
+            Extent      extent{ offset, 0, 8 };
+            std::string type;
+            
+            stream.Seek( numeric_cast< std::streamoff >( offset ), BinaryStream::SeekDirection::Begin );
+            
+            extent.size = stream.ReadBigEndianUInt32();
+            type        = stream.ReadFourCC();
+            
+            if( extent.size == 1 )
+            {
+                if( offset + 16 > this->_size )
+                {
+                    break;
+                }
+                
+                extent.size   = stream.ReadBigEndianUInt64();
+                extent.header = 16;
+            }
+            else if( extent.size == 0 )
+            {
+                extent.size = this->_size - offset;
+            }
+            
+            if( extent.size < extent.header )
+            {
+                throw std::runtime_error( "Invalid file - Invalid box size" );
+            }
+            
+            if( extent.size > this->_size - offset )
+            {
+                break;
+            }
+            
+            if( type == "moov" )
+            {
+                this->_moov = std::dynamic_pointer_cast< ContainerBox >( ReadBox( parser, stream, extent ) );
+            }
+            else if( type == "moof" )
+            {
+                this->_fragments.push_back( extent );
+            }
+            
+            offset += extent.size;
+        }
+        
+        if( this->_moov == nullptr || this->_moov->GetTypedBox< MVHD >( "mvhd" ) == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No MOOV or MVHD box" );
+        }
+        
+        std::shared_ptr< ContainerBox > mvex( this->_moov->GetTypedBox< ContainerBox >( "mvex" ) );
+        
+        if( mvex == nullptr )
+        {
+            throw std::runtime_error( "Unsupported file - The file is not fragmented" );
+        }
+        
+        for( const auto & box: static_cast< const Container & >( *( this->_moov ) ).GetBoxes( "trak" ) )
+        {
+            std::shared_ptr< ContainerBox > trak( std::dynamic_pointer_cast< ContainerBox >( box ) );
+            std::shared_ptr< ContainerBox > mdia( ( trak != nullptr ) ? trak->GetTypedBox< ContainerBox >( "mdia" ) : nullptr );
+            std::shared_ptr< ContainerBox > minf( ( mdia != nullptr ) ? mdia->GetTypedBox< ContainerBox >( "minf" ) : nullptr );
+            std::shared_ptr< ContainerBox > stbl( ( minf != nullptr ) ? minf->GetTypedBox< ContainerBox >( "stbl" ) : nullptr );
+            std::shared_ptr< MDHD >         mdhd( ( mdia != nullptr ) ? mdia->GetTypedBox< MDHD >( "mdhd" ) : nullptr );
+            std::shared_ptr< STSZ >         stsz( ( stbl != nullptr ) ? stbl->GetTypedBox< STSZ >( "stsz" ) : nullptr );
+            Output                          output;
+            
+            if( mdhd == nullptr || stbl == nullptr || stbl->GetTypedBox< STSD >( "stsd" ) == nullptr || GetTrackID( *( trak ) ) == 0 )
+            {
+                throw std::runtime_error( "Invalid track - Missing TKHD, MDHD, STBL or STSD box" );
+            }
+            
+            if( mdhd->GetTimescale() == 0 )
+            {
+                throw std::runtime_error( "Invalid track - Invalid timescale" );
+            }
+            
+            if( stsz != nullptr && stsz->GetSampleCount() > 0 )
+            {
+                throw std::runtime_error( "Unsupported file - Samples are stored in the MOOV box" );
+            }
+            
+            output.trackID      = GetTrackID( *( trak ) );
+            output.timescale    = mdhd->GetTimescale();
+            output.startTime    = 0;
+            output.lastDuration = 0;
+            output.sourceEdits  = ReadEdits( *( trak ) );
+            output.duration     = 0;
+            
+            for( const auto & trex: static_cast< const Container & >( *( mvex ) ).GetBoxes( "trex" ) )
+            {
+                std::shared_ptr< TREX > p( std::dynamic_pointer_cast< TREX >( trex ) );
+                
+                if( p != nullptr && p->GetTrackID() == output.trackID )
+                {
+                    output.trex = p;
+                }
+            }
+            
+            this->_outputs.push_back( std::move( output ) );
+        }
+    }
+    
+    Defragmenter::IMPL::IMPL( const IMPL & o ):
+        _path( o._path ),
+        _size( o._size ),
+        _moov( o._moov ),
+        _fragments( o._fragments ),
+        _outputs( o._outputs )
+    {}
+    
+    Defragmenter::IMPL::~IMPL()
+    {}
+    
+    void Defragmenter::IMPL::ReadTRAF( BinaryOutputStream & stream, std::vector< Output > & outputs, const ContainerBox & traf, uint64_t base, uint64_t & dataEnd ) const
+    {
+        std::shared_ptr< TFHD > tfhd( traf.GetTypedBox< TFHD >( "tfhd" ) );
+        std::shared_ptr< TFDT > tfdt( traf.GetTypedBox< TFDT >( "tfdt" ) );
+        Output                * output;
+        uint32_t                sampleDescriptionIndex;
+        uint32_t                defaultDuration;
+        uint32_t                defaultSize;
+        uint32_t                defaultFlags;
+        
+        if( tfhd == nullptr )
+        {
+            throw std::runtime_error( "Invalid track fragment - No TFHD box" );
+        }
+        
+        output = FindOutput( outputs, tfhd->GetTrackID() );
+        
+        if( output == nullptr )
+        {
+            throw std::runtime_error( "Invalid track fragment - Unknown track ID" );
+        }
+        
+        sampleDescriptionIndex = ( tfhd->HasSampleDescriptionIndex() ) ? tfhd->GetSampleDescriptionIndex() : ( ( output->trex != nullptr ) ? output->trex->GetDefaultSampleDescriptionIndex() : 1 );
+        defaultDuration        = ( tfhd->HasDefaultSampleDuration() )  ? tfhd->GetDefaultSampleDuration()  : ( ( output->trex != nullptr ) ? output->trex->GetDefaultSampleDuration()         : 0 );
+        defaultSize            = ( tfhd->HasDefaultSampleSize() )      ? tfhd->GetDefaultSampleSize()      : ( ( output->trex != nullptr ) ? output->trex->GetDefaultSampleSize()             : 0 );
+        defaultFlags           = ( tfhd->HasDefaultSampleFlags() )     ? tfhd->GetDefaultSampleFlags()     : ( ( output->trex != nullptr ) ? output->trex->GetDefaultSampleFlags()            : 0 );
+        
+        if( tfdt != nullptr )
+        {
+            SetDecodeTime( *( output ), tfdt->GetBaseMediaDecodeTime() );
+        }
+        
+        /*
+         * Without an explicit base, the data of the first track fragment
+         * starts at the MOOF box, and the data of the following ones
+         * immediately after the data of the previous one.
+         */
+        if( tfhd->HasBaseDataOffset() )
+        {
+            base = tfhd->GetBaseDataOffset();
+        }
+        else if( tfhd->IsDefaultBaseMOOF() == false )
+        {
+            base = dataEnd;
+        }
+        
+        dataEnd = base;
+        
+        for( const auto & box: static_cast< const Container & >( traf ).GetBoxes( "trun" ) )
+        {
+            std::shared_ptr< TRUN > trun( std::dynamic_pointer_cast< TRUN >( box ) );
+            uint64_t                offset;
+            uint64_t                size( 0 );
+            
+            if( trun == nullptr || trun->GetSampleCount() == 0 )
+            {
+                continue;
+            }
+            
+            offset = ( trun->HasDataOffset() ) ? static_cast< uint64_t >( static_cast< int64_t >( base ) + trun->GetDataOffset() ) : dataEnd;
+            
+            output->table.AddChunk( stream.Tell(), sampleDescriptionIndex );
+            
+            for( uint32_t i = 0; i < trun->GetSampleCount(); i++ )
+            {
+                uint32_t flags( defaultFlags );
+                
+                if( i == 0 && trun->HasFirstSampleFlags() )
+                {
+                    flags = trun->GetFirstSampleFlags();
+                }
+                else if( trun->HasSampleFlags() )
+                {
+                    flags = trun->GetSampleFlags( i );
+                }
+                
+                output->lastDuration = ( trun->HasSampleDurations() ) ? trun->GetSampleDuration( i ) : defaultDuration;
+                
+                output->table.AddSample
+                (
+                    ( trun->HasSampleSizes() ) ? trun->GetSampleSize( i ) : defaultSize,
+                    output->lastDuration,
+                    trun->GetSampleCompositionTimeOffset( i ),
+                    ( flags & 0x00010000 ) == 0 /* sample_is_non_sync_sample */
+                );
+                
+                size += ( trun->HasSampleSizes() ) ? trun->GetSampleSize( i ) : defaultSize;
+            }
+            
+            if( offset > this->_size || size > this->_size - offset )
+            {
+                throw std::runtime_error( "Invalid track run - Sample data is outside of the file" );
+            }
+            
+            stream.WriteSourceRange( offset, size );
+            
+            dataEnd = offset + size;
+        }
+    }
+    
+    void Defragmenter::IMPL::BuildEdits( std::vector< Output > & outputs ) const
+    {
+        uint32_t timescale( this->_moov->GetTypedBox< MVHD >( "mvhd" )->GetTimescale() );
+        uint64_t start( UINT64_MAX );
+        
+        /* The earliest track starts the presentation, and later ones are delayed with an empty edit */
+        for( const auto & output: outputs )
+        {
+            if( output.table.GetSampleCount() > 0 )
+            {
+                start = std::min( start, Rescale( output.startTime, output.timescale, timescale ) );
+            }
+        }
+        
+        for( auto & output: outputs )
+        {
+            uint64_t delay( ( output.table.GetSampleCount() > 0 ) ? Rescale( output.startTime, output.timescale, timescale ) - start : 0 );
+            
+            output.edits.clear();
+            
+            if( delay > 0 )
+            {
+                output.edits.push_back( { delay, -1 } );
+            }
+            
+            for( const auto & edit: output.sourceEdits )
+            {
+                Edit rebased( edit );
+                
+                if( edit.mediaTime >= 0 )
+                {
+                    uint64_t time( static_cast< uint64_t >( edit.mediaTime ) );
+                    
+                    time = ( time > output.startTime ) ? time - output.startTime : 0;
+                    
+                    /* Edits of fragmented files may have no duration, as it is not known yet */
+                    if( rebased.segmentDuration == 0 )
+                    {
+                        rebased.segmentDuration = Rescale( output.table.GetDuration() - std::min( time, output.table.GetDuration() ), output.timescale, timescale );
+                    }
+                    
+                    rebased.mediaTime = numeric_cast< int64_t >( time );
+                }
+                
+                output.edits.push_back( rebased );
+            }
+            
+            if( delay > 0 && output.sourceEdits.empty() )
+            {
+                output.edits.push_back( { Rescale( output.table.GetDuration(), output.timescale, timescale ), 0 } );
+            }
+            
+            output.duration = 0;
+            
+            if( output.edits.empty() )
+            {
+                output.duration = Rescale( output.table.GetDuration(), output.timescale, timescale );
+            }
+            
+            for( const auto & edit: output.edits )
+            {
+                output.duration += edit.segmentDuration;
+            }
+        }
+    }
+    
+    void Defragmenter::IMPL::WriteMOOV( BinaryOutputStream & stream, const std::vector< Output > & outputs ) const
+    {
+        size_t moov( stream.BeginBox( "moov" ) );
+        
+        for( const auto & box: this->_moov->GetBoxesSpan() )
+        {
+            this->WriteBox( stream, outputs, nullptr, box );
+        }
+        
+        stream.EndBox( moov );
+    }
+    
+    void Defragmenter::IMPL::WriteBox( BinaryOutputStream & stream, const std::vector< Output > & outputs, const Output * output, const std::shared_ptr< Box > & box ) const
+    {
+        std::shared_ptr< ContainerBox > container( std::dynamic_pointer_cast< ContainerBox >( box ) );
+        std::string                     name( box->GetName() );
+        
+        if( name == "mvex" || ( name == "edts" && output != nullptr ) )
+        {
+            return;
+        }
+        
+        if( name == "mvhd" )
+        {
+            MVHD     mvhd( *( std::dynamic_pointer_cast< MVHD >( box ) ) );
+            uint64_t duration( 0 );
+            
+            for( const auto & o: outputs )
+            {
+                duration = std::max( duration, o.duration );
+            }
+            
+            mvhd.SetDuration( duration );
+            mvhd.SetVersion( ( duration > UINT32_MAX || mvhd.GetVersion() == 1 ) ? 1 : 0 );
+            mvhd.Write( stream );
+        }
+        else if( name == "tkhd" && output != nullptr )
+        {
+            TKHD     tkhd( *( std::dynamic_pointer_cast< TKHD >( box ) ) );
+            uint64_t duration( output->duration );
+            
+            tkhd.SetDuration( duration );
+            tkhd.SetVersion( ( duration > UINT32_MAX || tkhd.GetVersion() == 1 ) ? 1 : 0 );
+            tkhd.Write( stream );
+            
+            if( output->edits.size() > 0 )
+            {
+                WriteEDTS( stream, output->edits );
+            }
+        }
+        else if( name == "mdhd" && output != nullptr )
+        {
+            MDHD     mdhd( *( std::dynamic_pointer_cast< MDHD >( box ) ) );
+            uint64_t duration( output->table.GetDuration() );
+            
+            mdhd.SetDuration( duration );
+            mdhd.SetVersion( ( duration > UINT32_MAX || mdhd.GetVersion() == 1 ) ? 1 : 0 );
+            mdhd.Write( stream );
+        }
+        else if( name == "stbl" && output != nullptr && container != nullptr )
+        {
+            std::vector< std::vector< uint8_t > > entries;
+            std::vector< Span< const uint8_t > >  spans;
+            
+            for( const auto & entry: container->GetTypedBox< STSD >( "stsd" )->GetBoxesSpan() )
+            {
+                BinaryDataOutputStream data;
+                
+                entry->Write( data );
+                entries.push_back( data.TakeData() );
+            }
+            
+            for( const auto & entry: entries )
+            {
+                spans.push_back( entry );
+            }
+            
+            output->table.Write( stream, spans );
+        }
+        else if( container != nullptr && ( name == "trak" || name == "mdia" || name == "minf" ) )
+        {
+            size_t offset( stream.BeginBox( name ) );
+            
+            if( name == "trak" )
+            {
+                output = FindOutput( outputs, GetTrackID( *( container ) ) );
+            }
+            
+            for( const auto & child: container->GetBoxesSpan() )
+            {
+                this->WriteBox( stream, outputs, output, child );
+            }
+            
+            stream.EndBox( offset );
+        }
+        else
+        {
+            box->Write( stream );
+        }
+    }
+    
+    std::shared_ptr< Box > Defragmenter::IMPL::ReadBox( Parser & parser, BinaryStream & stream, const Extent & extent )
+    {
+        std::shared_ptr< Box > box;
+        
+        stream.Seek( numeric_cast< std::streamoff >( extent.offset + 4 ), BinaryStream::SeekDirection::Begin );
+        
+        box = parser.CreateBox( stream.ReadFourCC() );
+        
+        if( box == nullptr )
+        {
+            return nullptr;
+        }
+        
+        stream.Seek( numeric_cast< std::streamoff >( extent.offset + extent.header ), BinaryStream::SeekDirection::Begin );
+        
+        {
+            BinaryDataStream content( BinaryDataStream::ReadSlice( stream, numeric_cast< size_t >( extent.size - extent.header ) ) );
+            
+            box->ReadData( parser, content );
+        }
+        
+        return box;
+    }
+    
+    Defragmenter::IMPL::Output * Defragmenter::IMPL::FindOutput( std::vector< Output > & outputs, uint32_t trackID )
+    {
+        for( auto & output: outputs )
+        {
+            if( output.trackID == trackID )
+            {
+                return &output;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    const Defragmenter::IMPL::Output * Defragmenter::IMPL::FindOutput( const std::vector< Output > & outputs, uint32_t trackID )
+    {
+        for( const auto & output: outputs )
+        {
+            if( output.trackID == trackID )
+            {
+                return &output;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    uint32_t Defragmenter::IMPL::GetTrackID( const ContainerBox & trak )
+    {
+        std::shared_ptr< TKHD > tkhd( trak.GetTypedBox< TKHD >( "tkhd" ) );
+        
+        return ( tkhd != nullptr ) ? tkhd->GetTrackID() : 0;
+    }
+    
+    std::vector< Defragmenter::IMPL::Edit > Defragmenter::IMPL::ReadEdits( const ContainerBox & trak )
+    {
+        std::shared_ptr< ContainerBox > edts( trak.GetTypedBox< ContainerBox >( "edts" ) );
+        std::shared_ptr< Box >          elst( ( edts != nullptr ) ? edts->GetBox( "elst" ) : nullptr );
+        std::vector< Edit >             edits;
+        
+        if( elst == nullptr )
+        {
+            return edits;
+        }
+        
+        {
+            BinaryDataStream stream( elst->GetData() );
+            uint8_t          version( static_cast< uint8_t >( stream.ReadBigEndianUInt32() >> 24 ) );
+            uint32_t         count( stream.ReadBigEndianUInt32() );
+            
+            for( uint32_t i = 0; i < count; i++ )
+            {
+                Edit edit;
+                
+                if( version == 1 )
+                {
+                    edit.segmentDuration = stream.ReadBigEndianUInt64();
+                    edit.mediaTime       = static_cast< int64_t >( stream.ReadBigEndianUInt64() );
+                }
+                else
+                {
+                    edit.segmentDuration = stream.ReadBigEndianUInt32();
+                    edit.mediaTime       = static_cast< int32_t >( stream.ReadBigEndianUInt32() );
+                }
+                
+                /* Media rate */
+                stream.ReadBigEndianUInt32();
+                
+                edits.push_back( edit );
+            }
+        }
+        
+        return edits;
+    }
+    
+    void Defragmenter::IMPL::SetDecodeTime( Output & output, uint64_t time )
+    {
+        uint64_t expected( output.startTime + output.table.GetDuration() );
+        uint64_t last;
+        
+        if( output.table.GetSampleCount() == 0 )
+        {
+            output.startTime = time;
+            
+            return;
+        }
+        
+        if( time == expected )
+        {
+            return;
+        }
+        
+        /*
+         * A jump in decode time between fragments, like a gap in a live
+         * recording: the previous sample lasts until the decode time of
+         * the fragment. Decode times are kept contiguous if the jump goes
+         * back before the previous sample.
+         */
+        last = expected - output.lastDuration;
+        
+        if( time < last || time - last > UINT32_MAX )
+        {
+            return;
+        }
+        
+        output.lastDuration = static_cast< uint32_t >( time - last );
+        
+        output.table.SetLastSampleDuration( output.lastDuration );
+    }
+    
+    void Defragmenter::IMPL::WriteEDTS( BinaryOutputStream & stream, const std::vector< Edit > & edits )
+    {
+        uint8_t version( 0 );
+        size_t  edts;
+        size_t  elst;
+        
+        for( const auto & edit: edits )
+        {
+            if( edit.segmentDuration > UINT32_MAX || edit.mediaTime > INT32_MAX )
+            {
+                version = 1;
+            }
+        }
+        
+        edts = stream.BeginBox( "edts" );
+        elst = stream.BeginFullBox( "elst", version, 0 );
+        
+        stream.WriteBigEndianUInt32( numeric_cast< uint32_t >( edits.size() ) );
+        
+        for( const auto & edit: edits )
+        {
+            if( version == 1 )
+            {
+                stream.WriteBigEndianUInt64( edit.segmentDuration );
+                stream.WriteBigEndianUInt64( static_cast< uint64_t >( edit.mediaTime ) );
+            }
+            else
+            {
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( edit.segmentDuration ) );
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( edit.mediaTime ) );
+            }
+            
+            stream.WriteBigEndianUInt16( 1 );
+            stream.WriteBigEndianUInt16( 0 );
+        }
+        
+        stream.EndBox( elst );
+        stream.EndBox( edts );
+    }
+    
+    uint64_t Rescale( uint64_t value, uint32_t from, uint32_t to )
+    {
+        return ( ( value / from ) * to ) + ( ( ( value % from ) * to ) / from );
+    }
+}
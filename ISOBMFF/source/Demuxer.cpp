@@ -0,0 +1,501 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Demuxer.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Demuxer.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/AnnexB.hpp>
+#include <ISOBMFF/Span.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <deque>
+#include <list>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Demuxer::IMPL
+    {
+        public:
+            
+            class Block
+            {
+                public:
+                    
+                    uint64_t                              _offset;
+                    size_t                                _firstSample;
+                    size_t                                _lastSample;
+                    std::vector< uint8_t >                _data;
+                    std::list< std::vector< uint8_t > >   _converted;
+                    std::vector< Span< const uint8_t > >  _pieces;
+            };
+            
+            template< typename _T_ >
+            class Queue
+            {
+                public:
+                    
+                    Queue( size_t depth ):
+                        _depth( depth ),
+                        _closed( false )
+                    {}
+                    
+                    bool Push( _T_ value )
+                    {
+                        std::unique_lock< std::mutex > l( this->_mutex );
+                        
+                        this->_cv.wait( l, [ & ] { return this->_closed || this->_values.size() < this->_depth; } );
+                        
+                        if( this->_closed )
+                        {
+                            return false;
+                        }
+                        
+                        this->_values.push_back( std::move( value ) );
+                        this->_cv.notify_all();
+                        
+                        return true;
+                    }
+                    
+                    bool Pop( _T_ & value )
+                    {
+                        std::unique_lock< std::mutex > l( this->_mutex );
+                        
+                        this->_cv.wait( l, [ & ] { return this->_closed || this->_values.empty() == false; } );
+                        
+                        if( this->_values.empty() )
+                        {
+                            return false;
+                        }
+                        
+                        value = std::move( this->_values.front() );
+                        
+                        this->_values.pop_front();
+                        this->_cv.notify_all();
+                        
+                        return true;
+                    }
+                    
+                    void Close()
+                    {
+                        std::lock_guard< std::mutex > l( this->_mutex );
+                        
+                        this->_closed = true;
+                        
+                        this->_cv.notify_all();
+                    }
+                    
+                private:
+                    
+                    size_t                  _depth;
+                    bool                    _closed;
+                    std::mutex              _mutex;
+                    std::condition_variable _cv;
+                    std::deque< _T_ >       _values;
+            };
+            
+            typedef std::unique_ptr< Block > BlockPtr;
+            
+            IMPL( const std::string & path, uint32_t trackID );
+            ~IMPL();
+            
+            void Read( Queue< BlockPtr > & output ) const;
+            void Convert( Queue< BlockPtr > & input, Queue< BlockPtr > & output ) const;
+            void Write( Queue< BlockPtr > & input, std::ostream & output ) const;
+            
+            std::string            _path;
+            Track                  _track;
+            std::vector< uint8_t > _parameterSets;
+            uint8_t                _lengthSize;
+            size_t                 _readSize;
+            size_t                 _queueDepth;
+    };
+    
+    static Track FindTrack( const std::string & path, uint32_t trackID );
+    static void  AddPiece( std::vector< Span< const uint8_t > > & pieces, Span< const uint8_t > piece );
+    
+    /* Chunks separated by less than this are read together, with the gap */
+    static const uint64_t MaxGap = 64 * 1024;
+    
+    Demuxer::Demuxer( const std::string & path, uint32_t trackID ):
+        impl( std::make_unique< IMPL >( path, trackID ) )
+    {}
+    
+    Demuxer::Demuxer( Demuxer && o ) noexcept: impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Demuxer::~Demuxer()
+    {}
+    
+    Demuxer & Demuxer::operator =( Demuxer o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    const Track & Demuxer::GetTrack() const
+    {
+        return this->impl->_track;
+    }
+    
+    size_t Demuxer::GetReadSize() const
+    {
+        return this->impl->_readSize;
+    }
+    
+    size_t Demuxer::GetQueueDepth() const
+    {
+        return this->impl->_queueDepth;
+    }
+    
+    void Demuxer::SetReadSize( size_t value )
+    {
+        this->impl->_readSize = value;
+    }
+    
+    void Demuxer::SetQueueDepth( size_t value )
+    {
+        this->impl->_queueDepth = ( value == 0 ) ? 1 : value;
+    }
+    
+    void Demuxer::Demux( std::ostream & output ) const
+    {
+        IMPL::Queue< IMPL::BlockPtr > read( this->impl->_queueDepth );
+        IMPL::Queue< IMPL::BlockPtr > converted( this->impl->_queueDepth );
+        std::exception_ptr            readError;
+        std::exception_ptr            convertError;
+        std::exception_ptr            writeError;
+        
+        /* The stages block on their queues, so they get their own threads instead of executor tasks */
+        std::thread reader
+        (
+            [ & ]
+            {
+                try
+                {
+                    this->impl->Read( read );
+                }
+                catch( ... )
+                {
+                    readError = std::current_exception();
+                }
+                
+                read.Close();
+            }
+        );
+        
+        std::thread converter
+        (
+            [ & ]
+            {
+                try
+                {
+                    this->impl->Convert( read, converted );
+                }
+                catch( ... )
+                {
+                    convertError = std::current_exception();
+                    
+                    read.Close();
+                }
+                
+                converted.Close();
+            }
+        );
+        
+        try
+        {
+            this->impl->Write( converted, output );
+        }
+        catch( ... )
+        {
+            writeError = std::current_exception();
+        }
+        
+        converted.Close();
+        read.Close();
+        reader.join();
+        converter.join();
+        
+        if( readError != nullptr )
+        {
+            std::rethrow_exception( readError );
+        }
+        
+        if( convertError != nullptr )
+        {
+            std::rethrow_exception( convertError );
+        }
+        
+        if( writeError != nullptr )
+        {
+            std::rethrow_exception( writeError );
+        }
+    }
+    
+    void Demuxer::Demux( const std::string & path ) const
+    {
+        std::ofstream output( path, std::ios::binary | std::ios::trunc );
+        
+        if( output.good() == false )
+        {
+            throw std::runtime_error( "Cannot open output file: " + path );
+        }
+        
+        this->Demux( output );
+    }
+    
+    void swap( Demuxer & o1, Demuxer & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    Demuxer::IMPL::IMPL( const std::string & path, uint32_t trackID ):
+        _path( path ),
+        _track( FindTrack( path, trackID ) ),
+        _lengthSize( this->_track.GetNALUnitLengthSize() ),
+        _readSize( DefaultReadSize ),
+        _queueDepth( DefaultQueueDepth )
+    {
+        if( this->_track.GetAVCC() != nullptr )
+        {
+            this->_parameterSets = AnnexB::GetParameterSets( *( this->_track.GetAVCC() ) );
+        }
+        else if( this->_track.GetHVCC() != nullptr )
+        {
+            this->_parameterSets = AnnexB::GetParameterSets( *( this->_track.GetHVCC() ) );
+        }
+        else
+        {
+            throw std::runtime_error( "Unsupported track - No AVCC or HVCC box" );
+        }
+    }
+    
+    Demuxer::IMPL::~IMPL()
+    {}
+    
+    void Demuxer::IMPL::Read( Queue< BlockPtr > & output ) const
+    {
+        const SampleTable & samples( this->_track.GetSampleTable() );
+        BinaryFileStream    stream( this->_path );
+        size_t              chunk;
+        size_t              chunks;
+        
+        chunks = samples.GetChunkCount();
+        chunk  = 0;
+        
+        while( chunk < chunks )
+        {
+            BlockPtr block( new Block() );
+            uint64_t end;
+            
+            block->_offset      = samples.GetChunkOffset( chunk );
+            block->_firstSample = samples.GetChunkFirstSample( chunk );
+            block->_lastSample  = block->_firstSample;
+            end                 = block->_offset;
+            
+            /*
+             * Consecutive chunks are coalesced into a single read, as long as
+             * they are stored in ascending order, close to each other, and the
+             * read stays under the maximum size.
+             * A chunk larger than the maximum size is read on its own.
+             */
+            while( chunk < chunks )
+            {
+                uint64_t offset;
+                uint64_t chunkEnd;
+                size_t   first;
+                size_t   count;
+                
+                offset   = samples.GetChunkOffset( chunk );
+                first    = samples.GetChunkFirstSample( chunk );
+                count    = samples.GetChunkSampleCount( chunk );
+                chunkEnd = offset;
+                
+                for( size_t i = first; i < first + count; i++ )
+                {
+                    chunkEnd = std::max( chunkEnd, samples.GetSampleOffset( i ) + samples.GetSampleSize( i ) );
+                }
+                
+                if( block->_lastSample != block->_firstSample )
+                {
+                    if( offset < end || offset - end > MaxGap || chunkEnd - block->_offset > this->_readSize )
+                    {
+                        break;
+                    }
+                }
+                
+                end                = std::max( end, chunkEnd );
+                block->_lastSample = first + count;
+                
+                chunk++;
+                
+                if( count == 0 && block->_lastSample == block->_firstSample )
+                {
+                    break;
+                }
+            }
+            
+            if( end > block->_offset )
+            {
+                block->_data.resize( static_cast< size_t >( end - block->_offset ) );
+                stream.Seek( static_cast< std::streamoff >( block->_offset ), BinaryStream::SeekDirection::Begin );
+                stream.Read( block->_data.data(), block->_data.size() );
+            }
+            
+            if( output.Push( std::move( block ) ) == false )
+            {
+                break;
+            }
+        }
+    }
+    
+    void Demuxer::IMPL::Convert( Queue< BlockPtr > & input, Queue< BlockPtr > & output ) const
+    {
+        const SampleTable & samples( this->_track.GetSampleTable() );
+        BlockPtr            block;
+        Span< uint8_t >     data;
+        
+        while( input.Pop( block ) )
+        {
+            data = Span< uint8_t >( block->_data );
+            
+            for( size_t i = block->_firstSample; i < block->_lastSample; i++ )
+            {
+                Span< uint8_t > sample;
+                
+                sample = data.subspan( static_cast< size_t >( samples.GetSampleOffset( i ) - block->_offset ), samples.GetSampleSize( i ) );
+                
+                if( i == 0 || samples.IsSyncSample( i ) )
+                {
+                    AddPiece( block->_pieces, Span< const uint8_t >( this->_parameterSets ) );
+                }
+                
+                if( AnnexB::ConvertInPlace( sample, this->_lengthSize ) )
+                {
+                    AddPiece( block->_pieces, Span< const uint8_t >( sample.data(), sample.size() ) );
+                }
+                else
+                {
+                    Span< const uint8_t > in( sample.data(), sample.size() );
+                    
+                    block->_converted.emplace_back( AnnexB::GetSize( in, this->_lengthSize ) );
+                    AnnexB::Convert( in, this->_lengthSize, Span< uint8_t >( block->_converted.back() ) );
+                    AddPiece( block->_pieces, Span< const uint8_t >( block->_converted.back() ) );
+                }
+            }
+            
+            if( output.Push( std::move( block ) ) == false )
+            {
+                break;
+            }
+        }
+    }
+    
+    void Demuxer::IMPL::Write( Queue< BlockPtr > & input, std::ostream & output ) const
+    {
+        BlockPtr block;
+        
+        while( input.Pop( block ) )
+        {
+            for( const auto & piece: block->_pieces )
+            {
+                output.write( reinterpret_cast< const char * >( piece.data() ), static_cast< std::streamsize >( piece.size() ) );
+            }
+            
+            if( output.good() == false )
+            {
+                throw std::runtime_error( "Cannot write elementary stream" );
+            }
+        }
+        
+        output.flush();
+    }
+    
+    Track FindTrack( const std::string & path, uint32_t trackID )
+    {
+        Parser                          parser;
+        std::shared_ptr< ContainerBox > moov;
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( path );
+        
+        moov = parser.GetFile()->GetTypedBox< ContainerBox >( "moov" );
+        
+        if( moov == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No MOOV box" );
+        }
+        
+        for( const auto & track: Track::GetTracks( *( moov ) ) )
+        {
+            if( trackID != 0 )
+            {
+                if( track.GetTrackID() == trackID )
+                {
+                    return track;
+                }
+            }
+            else if( track.GetHandlerType() == "vide" && ( track.GetAVCC() != nullptr || track.GetHVCC() != nullptr ) )
+            {
+                return track;
+            }
+        }
+        
+        throw std::runtime_error( "Invalid track - No matching AVC or HEVC track" );
+    }
+    
+    void AddPiece( std::vector< Span< const uint8_t > > & pieces, Span< const uint8_t > piece )
+    {
+        if( piece.size() == 0 )
+        {
+            return;
+        }
+        
+        if( pieces.empty() == false && pieces.back().data() + pieces.back().size() == piece.data() )
+        {
+            pieces.back() = Span< const uint8_t >( pieces.back().data(), pieces.back().size() + piece.size() );
+            
+            return;
+        }
+        
+        pieces.push_back( piece );
+    }
+}
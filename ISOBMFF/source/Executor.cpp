@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Executor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Executor.hpp>
+#include <ISOBMFF/ThreadPoolExecutor.hpp>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
+namespace ISOBMFF
+{
+    static std::mutex                  DefaultMutex;
+    static std::shared_ptr< Executor > DefaultExecutor;
+    
+    std::shared_ptr< Executor > Executor::GetDefault()
+    {
+        std::lock_guard< std::mutex > l( DefaultMutex );
+        
+        if( DefaultExecutor == nullptr )
+        {
+            DefaultExecutor = std::make_shared< ThreadPoolExecutor >();
+        }
+        
+        return DefaultExecutor;
+    }
+    
+    void Executor::SetDefault( const std::shared_ptr< Executor > & executor )
+    {
+        std::lock_guard< std::mutex > l( DefaultMutex );
+        
+        DefaultExecutor = executor;
+    }
+    
+    void Executor::ParallelFor( size_t begin, size_t end, size_t grain, const std::function< void( size_t, size_t ) > & body )
+    {
+        struct State
+        {
+            std::atomic< size_t >   next;
+            std::atomic< bool >     stop;
+            size_t                  done;
+            std::exception_ptr      error;
+            std::mutex              mutex;
+            std::condition_variable cv;
+        };
+        
+        std::shared_ptr< State > state;
+        std::function< void() >  work;
+        size_t                   chunks;
+        size_t                   helpers;
+        
+        if( end <= begin )
+        {
+            return;
+        }
+        
+        grain   = std::max( grain, static_cast< size_t >( 1 ) );
+        chunks  = ( end - begin + grain - 1 ) / grain;
+        helpers = std::min( this->GetConcurrency(), chunks ) - 1;
+        
+        if( helpers == 0 )
+        {
+            for( size_t i = begin; i < end; i += std::min( grain, end - i ) )
+            {
+                body( i, i + std::min( grain, end - i ) );
+            }
+            
+            return;
+        }
+        
+        state       = std::make_shared< State >();
+        state->next = 0;
+        state->stop = false;
+        state->done = 0;
+        
+        /*
+         * Helpers only reference the shared state and the body while chunks
+         * are left to claim. A helper starting after all chunks were claimed
+         * returns immediately, so this method never waits for helpers to be
+         * scheduled, but only for the chunks being processed.
+         */
+        work = [ = ]
+        {
+            size_t chunk;
+            
+            while( ( chunk = state->next++ ) < chunks )
+            {
+                if( state->stop == false )
+                {
+                    size_t b = begin + chunk * grain;
+                    size_t e = b + std::min( grain, end - b );
+                    
+                    try
+                    {
+                        body( b, e );
+                    }
+                    catch( ... )
+                    {
+                        std::lock_guard< std::mutex > l( state->mutex );
+                        
+                        if( state->error == nullptr )
+                        {
+                            state->error = std::current_exception();
+                        }
+                        
+                        state->stop = true;
+                    }
+                }
+                
+                {
+                    std::lock_guard< std::mutex > l( state->mutex );
+                    
+                    if( ++( state->done ) == chunks )
+                    {
+                        state->cv.notify_all();
+                    }
+                }
+            }
+        };
+        
+        for( size_t i = 0; i < helpers; i++ )
+        {
+            this->Submit( work );
+        }
+        
+        work();
+        
+        {
+            std::unique_lock< std::mutex > l( state->mutex );
+            
+            state->cv.wait( l, [ & ] { return state->done == chunks; } );
+            
+            if( state->error != nullptr )
+            {
+                std::rethrow_exception( state->error );
+            }
+        }
+    }
+}
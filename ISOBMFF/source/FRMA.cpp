@@ -31,10 +31,11 @@
 #include <ISOBMFF/FRMA.hpp>
 #include <ISOBMFF/Parser.hpp>
 #include <ISOBMFF/Utils.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class FRMA::IMPL
+    class FRMA::IMPL: public ResourceAllocated
     {
         public:
             
@@ -88,6 +89,16 @@ namespace ISOBMFF
         this->SetDataFormat( stream.ReadFourCC() );
     }
     
+    uint64_t FRMA::GetDataSize() const
+    {
+        return 4;
+    }
+    
+    void FRMA::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteFourCC( this->GetDataFormat() );
+    }
+    
     std::vector< std::pair< std::string, std::string > > FRMA::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
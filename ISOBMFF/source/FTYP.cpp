@@ -31,10 +31,11 @@
 #include <ISOBMFF/FTYP.hpp>
 #include <ISOBMFF/Parser.hpp>
 #include <ISOBMFF/Utils.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class FTYP::IMPL
+    class FTYP::IMPL: public ResourceAllocated
     {
         public:
             
@@ -103,6 +104,22 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t FTYP::GetDataSize() const
+    {
+        return 8 + 4 * static_cast< uint64_t >( this->impl->_compatibleBrands.size() );
+    }
+    
+    void FTYP::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteFourCC( this->GetMajorBrand() );
+        stream.WriteBigEndianUInt32( this->GetMinorVersion() );
+        
+        for( const auto & brand: this->impl->_compatibleBrands )
+        {
+            stream.WriteFourCC( brand );
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > FTYP::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -0,0 +1,452 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Faststart.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Faststart.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/ScatterGatherWriter.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/CO64.hpp>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Faststart::IMPL
+    {
+        public:
+            
+            /*
+             * Source extent of a top-level box, and the distance it moves
+             * by in the output file (modulo 2^64).
+             */
+            struct Extent
+            {
+                uint64_t offset;
+                uint64_t size;
+                uint64_t delta;
+            };
+            
+            struct ChunkOffsets
+            {
+                std::shared_ptr< ContainerBox > stbl;
+                std::shared_ptr< Box >          box;
+                std::vector< uint64_t >         source;
+            };
+            
+            IMPL( const std::string & path );
+            IMPL( const std::shared_ptr< File > & file, const std::string & path );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void Prepare( const std::shared_ptr< File > & file );
+            void Relocate( const ChunkOffsets & table, std::vector< uint64_t > & offsets ) const;
+            
+            const Extent * FindExtent( uint64_t offset ) const;
+            
+            std::string             _path;
+            std::shared_ptr< File > _file;
+            bool                    _isFaststart;
+            uint64_t                _size;
+            std::vector< Extent >   _extents;
+    };
+    
+    Faststart::Faststart( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    Faststart::Faststart( const std::shared_ptr< File > & file, const std::string & path ):
+        impl( std::make_unique< IMPL >( file, path ) )
+    {}
+    
+    Faststart::Faststart( const Faststart & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Faststart::Faststart( Faststart && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Faststart::~Faststart()
+    {}
+    
+    Faststart & Faststart::operator =( Faststart o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Faststart & o1, Faststart & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    bool Faststart::IsFaststart() const
+    {
+        return this->impl->_isFaststart;
+    }
+    
+    std::shared_ptr< File > Faststart::GetFile() const
+    {
+        return this->impl->_file;
+    }
+    
+    uint64_t Faststart::GetSize() const
+    {
+        return this->impl->_size;
+    }
+    
+    void Faststart::Write( const std::string & path ) const
+    {
+        if( path == this->impl->_path )
+        {
+            throw std::runtime_error( "Invalid output path - Cannot rewrite a file in place" );
+        }
+        
+        ScatterGatherWriter stream( path, this->impl->_path );
+        
+        this->Write( stream );
+        stream.Flush();
+    }
+    
+    void Faststart::Write( BinaryOutputStream & stream ) const
+    {
+        for( const auto & box: this->impl->_file->GetBoxesSpan() )
+        {
+            box->Write( stream );
+        }
+    }
+    
+    Faststart::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _file( std::make_shared< File >() ),
+        _isFaststart( true ),
+        _size( 0 )
+    {
+        Parser parser;
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( path );
+        
+        this->Prepare( parser.GetFile() );
+    }
+    
+    Faststart::IMPL::IMPL( const std::shared_ptr< File > & file, const std::string & path ):
+        _path( path ),
+        _file( std::make_shared< File >() ),
+        _isFaststart( true ),
+        _size( 0 )
+    {
+        if( file == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No file" );
+        }
+        
+        this->Prepare( file );
+    }
+    
+    Faststart::IMPL::IMPL( const IMPL & o ):
+        _path( o._path ),
+        _file( o._file ),
+        _isFaststart( o._isFaststart ),
+        _size( o._size ),
+        _extents( o._extents )
+    {}
+    
+    Faststart::IMPL::~IMPL()
+    {}
+    
+    void Faststart::IMPL::Prepare( const std::shared_ptr< File > & file )
+    {
+        std::vector< std::shared_ptr< Box > > boxes( file->GetBoxes() );
+        std::shared_ptr< ContainerBox >       moov;
+        std::vector< ChunkOffsets >           tables;
+        std::vector< uint64_t >               offsets;
+        
+        for( const auto & box: boxes )
+        {
+            if( box->GetName() == "mdat" && moov == nullptr )
+            {
+                this->_isFaststart = false;
+            }
+            else if( box->GetName() == "moov" && moov == nullptr )
+            {
+                moov = std::dynamic_pointer_cast< ContainerBox >( box );
+            }
+        }
+        
+        if( moov == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No MOOV box" );
+        }
+        
+        if( this->_isFaststart )
+        {
+            for( const auto & box: boxes )
+            {
+                this->_file->AddBox( box );
+            }
+        }
+        else
+        {
+            for( const auto & box: boxes )
+            {
+                if( box == moov )
+                {
+                    continue;
+                }
+                
+                if( box->GetName() == "mdat" && this->_file->GetBox( "moov" ) == nullptr )
+                {
+                    this->_file->AddBox( moov );
+                }
+                
+                this->_file->AddBox( box );
+            }
+        }
+        
+        for( const auto & box: static_cast< const Container & >( *( moov ) ).GetBoxes( "trak" ) )
+        {
+            std::shared_ptr< ContainerBox > trak( std::dynamic_pointer_cast< ContainerBox >( box ) );
+            std::shared_ptr< ContainerBox > mdia( ( trak != nullptr ) ? trak->GetTypedBox< ContainerBox >( "mdia" ) : nullptr );
+            std::shared_ptr< ContainerBox > minf( ( mdia != nullptr ) ? mdia->GetTypedBox< ContainerBox >( "minf" ) : nullptr );
+            std::shared_ptr< ContainerBox > stbl( ( minf != nullptr ) ? minf->GetTypedBox< ContainerBox >( "stbl" ) : nullptr );
+            std::shared_ptr< STCO >         stco( ( stbl != nullptr ) ? stbl->GetTypedBox< STCO >( "stco" ) : nullptr );
+            std::shared_ptr< CO64 >         co64( ( stbl != nullptr ) ? stbl->GetTypedBox< CO64 >( "co64" ) : nullptr );
+            ChunkOffsets                    table;
+            
+            table.stbl = stbl;
+            
+            if( stco != nullptr )
+            {
+                table.box = stco;
+                
+                table.source.reserve( stco->GetEntryCount() );
+                
+                for( size_t i = 0; i < stco->GetEntryCount(); i++ )
+                {
+                    table.source.push_back( stco->GetChunkOffset( i ) );
+                }
+            }
+            else if( co64 != nullptr )
+            {
+                table.box = co64;
+                
+                table.source.reserve( co64->GetEntryCount() );
+                
+                for( size_t i = 0; i < co64->GetEntryCount(); i++ )
+                {
+                    table.source.push_back( co64->GetChunkOffset( i ) );
+                }
+            }
+            else
+            {
+                continue;
+            }
+            
+            tables.push_back( std::move( table ) );
+        }
+        
+        /*
+         * Promoting a STCO box to CO64 grows the MOOV box, which moves
+         * the following boxes again, so the layout is computed until no
+         * more promotion is needed.
+         */
+        while( true )
+        {
+            bool promoted( false );
+            
+            this->_extents.clear();
+            this->_size = 0;
+            
+            for( const auto & box: this->_file->GetBoxesSpan() )
+            {
+                if( box != moov )
+                {
+                    this->_extents.push_back( { box->GetSourceOffset(), box->GetSourceSize(), this->_size - box->GetSourceOffset() } );
+                }
+                
+                this->_size += box->GetSize();
+            }
+            
+            std::sort
+            (
+                this->_extents.begin(),
+                this->_extents.end(),
+                []( const Extent & e1, const Extent & e2 )
+                {
+                    return e1.offset < e2.offset;
+                }
+            );
+            
+            for( auto & table: tables )
+            {
+                std::shared_ptr< STCO > stco( std::dynamic_pointer_cast< STCO >( table.box ) );
+                
+                if( stco == nullptr || table.source.empty() )
+                {
+                    continue;
+                }
+                
+                this->Relocate( table, offsets );
+                
+                if( *( std::max_element( offsets.begin(), offsets.end() ) ) > ( std::numeric_limits< uint32_t >::max )() )
+                {
+                    std::shared_ptr< CO64 > co64( std::make_shared< CO64 >() );
+                    
+                    co64->SetVersion( stco->GetVersion() );
+                    co64->SetFlags( stco->GetFlags() );
+                    
+                    for( uint64_t offset: offsets )
+                    {
+                        co64->AddChunkOffset( offset );
+                    }
+                    
+                    table.stbl->ReplaceBox( table.box, co64 );
+                    
+                    table.box = co64;
+                    promoted  = true;
+                }
+            }
+            
+            if( promoted == false )
+            {
+                break;
+            }
+        }
+        
+        if( file->GetBox( "meta" ) != nullptr )
+        {
+            for( const auto & extent: this->_extents )
+            {
+                if( extent.delta != 0 )
+                {
+                    throw std::runtime_error( "Unsupported file - Item locations cannot be relocated" );
+                }
+            }
+        }
+        
+        for( const auto & table: tables )
+        {
+            std::shared_ptr< STCO > stco( std::dynamic_pointer_cast< STCO >( table.box ) );
+            std::shared_ptr< CO64 > co64( std::dynamic_pointer_cast< CO64 >( table.box ) );
+            
+            this->Relocate( table, offsets );
+            
+            for( size_t i = 0; i < offsets.size(); i++ )
+            {
+                if( stco != nullptr )
+                {
+                    stco->SetChunkOffset( i, static_cast< uint32_t >( offsets[ i ] ) );
+                }
+                else
+                {
+                    co64->SetChunkOffset( i, offsets[ i ] );
+                }
+            }
+        }
+    }
+    
+    void Faststart::IMPL::Relocate( const ChunkOffsets & table, std::vector< uint64_t > & offsets ) const
+    {
+        offsets = table.source;
+        
+        if( offsets.empty() )
+        {
+            return;
+        }
+        
+        auto           range( std::minmax_element( offsets.begin(), offsets.end() ) );
+        const Extent * extent( this->FindExtent( *( range.first ) ) );
+        
+        if( extent != nullptr && *( range.second ) - extent->offset < extent->size )
+        {
+            /* Usual case: every chunk is in the same MDAT box */
+            uint64_t delta( extent->delta );
+            
+            for( uint64_t & offset: offsets )
+            {
+                offset += delta;
+            }
+            
+            return;
+        }
+        
+        for( uint64_t & offset: offsets )
+        {
+            extent = this->FindExtent( offset );
+            
+            if( extent == nullptr )
+            {
+                throw std::runtime_error( "Invalid chunk offset - Not inside a top-level box" );
+            }
+            
+            offset += extent->delta;
+        }
+    }
+    
+    const Faststart::IMPL::Extent * Faststart::IMPL::FindExtent( uint64_t offset ) const
+    {
+        auto it
+        (
+            std::upper_bound
+            (
+                this->_extents.begin(),
+                this->_extents.end(),
+                offset,
+                []( uint64_t value, const Extent & extent )
+                {
+                    return value < extent.offset;
+                }
+            )
+        );
+        
+        if( it == this->_extents.begin() )
+        {
+            return nullptr;
+        }
+        
+        --it;
+        
+        if( offset - it->offset >= it->size )
+        {
+            return nullptr;
+        }
+        
+        return &( *( it ) );
+    }
+}
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/File.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class File::IMPL
+    class File::IMPL: public ResourceAllocated
     {
         public:
             
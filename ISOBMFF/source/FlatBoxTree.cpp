@@ -0,0 +1,441 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        FlatBoxTree.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/FlatBoxTree.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    class FlatBoxTree::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void     Scan( BinaryStream & stream, uint64_t begin, uint64_t end, unsigned int depth );
+            uint64_t GetChildrenOffset( BinaryStream & stream, uint32_t type, uint64_t content, uint64_t end ) const;
+            
+            std::vector< Node >                                            _nodes;
+            mutable std::unordered_map< uint32_t, std::shared_ptr< Box > > _boxes;
+    };
+    
+    constexpr uint32_t FlatBoxTree::NoNode;
+    
+    uint32_t FlatBoxTree::FourCC( const std::string & type )
+    {
+        if( type.size() != 4 )
+        {
+            throw std::runtime_error( "Box name should be 4 characters long" );
+        }
+        
+        return ( static_cast< uint32_t >( static_cast< uint8_t >( type[ 0 ] ) ) << 24 )
+             | ( static_cast< uint32_t >( static_cast< uint8_t >( type[ 1 ] ) ) << 16 )
+             | ( static_cast< uint32_t >( static_cast< uint8_t >( type[ 2 ] ) ) <<  8 )
+             |   static_cast< uint32_t >( static_cast< uint8_t >( type[ 3 ] ) );
+    }
+    
+    FlatBoxTree::FlatBoxTree():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    FlatBoxTree::FlatBoxTree( BinaryStream & stream ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->Build( stream );
+    }
+    
+    FlatBoxTree::FlatBoxTree( const FlatBoxTree & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    FlatBoxTree::FlatBoxTree( FlatBoxTree && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    FlatBoxTree::~FlatBoxTree()
+    {}
+    
+    FlatBoxTree & FlatBoxTree::operator =( FlatBoxTree o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( FlatBoxTree & o1, FlatBoxTree & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    void FlatBoxTree::Build( BinaryStream & stream ) noexcept( false )
+    {
+        size_t pos;
+        size_t end;
+        
+        this->impl->_nodes.clear();
+        this->impl->_boxes.clear();
+        
+        pos = stream.Tell();
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::End );
+        
+        end = stream.Tell();
+        
+        this->impl->Scan( stream, pos, end, 0 );
+        this->impl->_nodes.shrink_to_fit();
+        
+        stream.Seek( pos, BinaryStream::SeekDirection::Begin );
+    }
+    
+    const std::vector< FlatBoxTree::Node > & FlatBoxTree::GetNodes() const
+    {
+        return this->impl->_nodes;
+    }
+    
+    const FlatBoxTree::Node & FlatBoxTree::GetNode( uint32_t index ) const
+    {
+        if( index >= this->impl->_nodes.size() )
+        {
+            throw std::runtime_error( "Invalid node index" );
+        }
+        
+        return this->impl->_nodes[ index ];
+    }
+    
+    std::string FlatBoxTree::GetType( uint32_t index ) const
+    {
+        uint32_t type( this->GetNode( index ).type );
+        char     s[ 4 ];
+        
+        s[ 0 ] = static_cast< char >( ( type >> 24 ) & 0xFF );
+        s[ 1 ] = static_cast< char >( ( type >> 16 ) & 0xFF );
+        s[ 2 ] = static_cast< char >( ( type >>  8 ) & 0xFF );
+        s[ 3 ] = static_cast< char >(   type         & 0xFF );
+        
+        return std::string( s, 4 );
+    }
+    
+    uint32_t FlatBoxTree::GetFirstChild( uint32_t index ) const
+    {
+        const Node & node( this->GetNode( index ) );
+        
+        /*
+         * Nodes are stored in depth-first order, and children are located
+         * within the bytes of their parent, while the following siblings of
+         * a node (or of its ancestors) are located after them.
+         */
+        if
+        (
+               static_cast< size_t >( index ) + 1 < this->impl->_nodes.size()
+            && this->impl->_nodes[ index + 1 ].offset < node.offset + node.size
+        )
+        {
+            return index + 1;
+        }
+        
+        return NoNode;
+    }
+    
+    uint32_t FlatBoxTree::GetNextSibling( uint32_t index ) const
+    {
+        return this->GetNode( index ).next;
+    }
+    
+    uint32_t FlatBoxTree::FindChild( uint32_t parent, const std::string & type ) const
+    {
+        uint32_t t( FourCC( type ) );
+        uint32_t i;
+        
+        if( parent == NoNode )
+        {
+            i = ( this->impl->_nodes.size() > 0 ) ? 0 : NoNode;
+        }
+        else
+        {
+            i = this->GetFirstChild( parent );
+        }
+        
+        for( ; i != NoNode; i = this->impl->_nodes[ i ].next )
+        {
+            if( this->impl->_nodes[ i ].type == t )
+            {
+                return i;
+            }
+        }
+        
+        return NoNode;
+    }
+    
+    uint32_t FlatBoxTree::Find( const std::string & path ) const
+    {
+        uint32_t index( NoNode );
+        size_t   pos( 0 );
+        
+        while( pos <= path.size() )
+        {
+            size_t next( path.find( '/', pos ) );
+            
+            if( next == std::string::npos )
+            {
+                next = path.size();
+            }
+            
+            index = this->FindChild( index, path.substr( pos, next - pos ) );
+            
+            if( index == NoNode )
+            {
+                return NoNode;
+            }
+            
+            pos = next + 1;
+        }
+        
+        return index;
+    }
+    
+    std::shared_ptr< Box > FlatBoxTree::GetBox( uint32_t index, Parser & parser, BinaryStream & stream ) const noexcept( false )
+    {
+        const Node           & node( this->GetNode( index ) );
+        std::shared_ptr< Box > box;
+        std::string            type;
+        uint64_t               header;
+        size_t                 pos;
+        
+        {
+            auto it = this->impl->_boxes.find( index );
+            
+            if( it != this->impl->_boxes.end() )
+            {
+                return it->second;
+            }
+        }
+        
+        pos    = stream.Tell();
+        header = 8;
+        
+        stream.Seek( node.offset, BinaryStream::SeekDirection::Begin );
+        
+        if( stream.ReadBigEndianUInt32() == 1 )
+        {
+            header = 16;
+        }
+        
+        type = stream.ReadFourCC();
+        box  = parser.CreateBox( type );
+        
+        if( box != nullptr )
+        {
+            box->SetSourceRange( node.offset, node.size, header );
+        }
+        
+        if( box != nullptr && ( type != "mdat" || parser.HasOption( Parser::Options::SkipMDATData ) == false ) )
+        {
+            stream.Seek( node.offset + header, BinaryStream::SeekDirection::Begin );
+            
+            {
+                BinaryDataStream content( BinaryDataStream::ReadSlice( stream, numeric_cast< size_t >( node.size - header ) ) );
+                
+                box->ReadData( parser, content );
+            }
+        }
+        
+        stream.Seek( pos, BinaryStream::SeekDirection::Begin );
+        
+        this->impl->_boxes[ index ] = box;
+        
+        return box;
+    }
+    
+    FlatBoxTree::IMPL::IMPL()
+    {}
+    
+    FlatBoxTree::IMPL::IMPL( const IMPL & o ):
+        _nodes( o._nodes ),
+        _boxes( o._boxes )
+    {}
+    
+    FlatBoxTree::IMPL::~IMPL()
+    {}
+    
+    void FlatBoxTree::IMPL::Scan( BinaryStream & stream, uint64_t begin, uint64_t end, unsigned int depth )
+    {
+        uint64_t pos( begin );
+        uint32_t previous( NoNode );
+        
+        if( depth > 64 )
+        {
+            return;
+        }
+        
+        while( end - pos >= 8 )
+        {
+            uint64_t size;
+            uint64_t header;
+            uint64_t children;
+            uint32_t type;
+            uint32_t index;
+            
+            stream.Seek( pos, BinaryStream::SeekDirection::Begin );
+            
+            size   = stream.ReadBigEndianUInt32();
+            type   = stream.ReadBigEndianUInt32();
+            header = 8;
+            
+            if( size == 1 )
+            {
+                if( end - pos < 16 )
+                {
+                    throw std::runtime_error( "Invalid box size" );
+                }
+                
+                size   = stream.ReadBigEndianUInt64();
+                header = 16;
+            }
+            else if( size == 0 )
+            {
+                size = end - pos;
+            }
+            
+            if( size < header || size > end - pos )
+            {
+                throw std::runtime_error( "Invalid box size" );
+            }
+            
+            if( this->_nodes.size() >= NoNode )
+            {
+                throw std::runtime_error( "Too many boxes" );
+            }
+            
+            index = static_cast< uint32_t >( this->_nodes.size() );
+            
+            this->_nodes.push_back( { pos, size, type, NoNode } );
+            
+            if( previous != NoNode )
+            {
+                this->_nodes[ previous ].next = index;
+            }
+            
+            children = this->GetChildrenOffset( stream, type, pos + header, pos + size );
+            
+            if( children < size - header )
+            {
+                this->Scan( stream, pos + header + children, pos + size, depth + 1 );
+            }
+            
+            previous  = index;
+            pos      += size;
+        }
+    }
+    
+    uint64_t FlatBoxTree::IMPL::GetChildrenOffset( BinaryStream & stream, uint32_t type, uint64_t content, uint64_t end ) const
+    {
+        static const uint32_t containers[] =
+        {
+            FourCC( "moov" ), FourCC( "trak" ), FourCC( "edts" ), FourCC( "mdia" ),
+            FourCC( "minf" ), FourCC( "stbl" ), FourCC( "mvex" ), FourCC( "moof" ),
+            FourCC( "traf" ), FourCC( "mfra" ), FourCC( "meco" ), FourCC( "mere" ),
+            FourCC( "dinf" ), FourCC( "ipro" ), FourCC( "sinf" ), FourCC( "iprp" ),
+            FourCC( "fiin" ), FourCC( "paen" ), FourCC( "strk" ), FourCC( "tapt" ),
+            FourCC( "schi" ), FourCC( "ipco" )
+        };
+        
+        static const uint32_t meta = FourCC( "meta" );
+        static const uint32_t hdlr = FourCC( "hdlr" );
+        static const uint32_t iref = FourCC( "iref" );
+        static const uint32_t iinf = FourCC( "iinf" );
+        static const uint32_t stsd = FourCC( "stsd" );
+        static const uint32_t dref = FourCC( "dref" );
+        static const uint32_t hvc1 = FourCC( "hvc1" );
+        static const uint32_t avc1 = FourCC( "avc1" );
+        
+        for( uint32_t container: containers )
+        {
+            if( type == container )
+            {
+                return 0;
+            }
+        }
+        
+        if( type == meta )
+        {
+            /* QuickTime meta boxes are not full boxes */
+            if( end - content >= 8 )
+            {
+                stream.Seek( content + 4, BinaryStream::SeekDirection::Begin );
+                
+                if( stream.ReadBigEndianUInt32() == hdlr )
+                {
+                    return 0;
+                }
+            }
+            
+            return 4;
+        }
+        
+        if( type == iref )
+        {
+            return 4;
+        }
+        
+        if( type == iinf )
+        {
+            if( end - content < 1 )
+            {
+                return end - content;
+            }
+            
+            stream.Seek( content, BinaryStream::SeekDirection::Begin );
+            
+            return ( stream.ReadUInt8() == 0 ) ? 6 : 8;
+        }
+        
+        if( type == stsd || type == dref )
+        {
+            return 8;
+        }
+        
+        if( type == hvc1 || type == avc1 )
+        {
+            return 78;
+        }
+        
+        return end - content;
+    }
+}
@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Fragmenter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Fragmenter.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/ScatterGatherWriter.hpp>
+#include <ISOBMFF/Segmenter.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MVHD.hpp>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Fragmenter::IMPL
+    {
+        public:
+            
+            /*
+             * A segment of a track.
+             */
+            struct Fragment
+            {
+                size_t track;
+                size_t segment;
+            };
+            
+            IMPL( const std::string & path, uint32_t fragmentDuration );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            double GetStartTime( const Fragment & fragment ) const;
+            
+            std::string                     _path;
+            std::shared_ptr< ContainerBox > _moov;
+            std::vector< Segmenter >        _segmenters;
+            std::vector< uint32_t >         _trackIDs;
+            std::vector< Fragment >         _fragments;
+    };
+    
+    Fragmenter::Fragmenter( const std::string & path, uint32_t fragmentDuration ):
+        impl( std::make_unique< IMPL >( path, fragmentDuration ) )
+    {}
+    
+    Fragmenter::Fragmenter( const Fragmenter & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Fragmenter::Fragmenter( Fragmenter && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Fragmenter::~Fragmenter()
+    {}
+    
+    Fragmenter & Fragmenter::operator =( Fragmenter o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Fragmenter & o1, Fragmenter & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    size_t Fragmenter::GetFragmentCount() const
+    {
+        return this->impl->_fragments.size();
+    }
+    
+    void Fragmenter::WriteInitSegment( BinaryOutputStream & stream ) const
+    {
+        Segmenter::WriteInitSegment( stream, *( this->impl->_moov ), this->impl->_trackIDs );
+    }
+    
+    void Fragmenter::WriteFragment( BinaryOutputStream & stream, size_t index ) const
+    {
+        if( index >= this->impl->_fragments.size() )
+        {
+            throw std::runtime_error( "Invalid fragment index" );
+        }
+        
+        const IMPL::Fragment & fragment( this->impl->_fragments[ index ] );
+        
+        this->impl->_segmenters[ fragment.track ].WriteSegment( stream, fragment.segment, static_cast< uint32_t >( index + 1 ) );
+    }
+    
+    void Fragmenter::Write( const std::string & path ) const
+    {
+        if( path == this->impl->_path )
+        {
+            throw std::runtime_error( "Invalid output path - Cannot rewrite a file in place" );
+        }
+        
+        ScatterGatherWriter stream( path, this->impl->_path );
+        
+        this->WriteInitSegment( stream );
+        
+        for( size_t i = 0; i < this->impl->_fragments.size(); i++ )
+        {
+            this->WriteFragment( stream, i );
+        }
+        
+        stream.Flush();
+    }
+    
+    Fragmenter::IMPL::IMPL( const std::string & path, uint32_t fragmentDuration ):
+        _path( path )
+    {
+        Parser parser;
+        
+        if( fragmentDuration == 0 )
+        {
+            throw std::runtime_error( "Invalid fragment duration" );
+        }
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( path );
+        
+        this->_moov = parser.GetFile()->GetTypedBox< ContainerBox >( "moov" );
+        
+        if( this->_moov == nullptr || this->_moov->GetTypedBox< MVHD >( "mvhd" ) == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No MOOV or MVHD box" );
+        }
+        
+        if( this->_moov->GetBox( "mvex" ) != nullptr )
+        {
+            throw std::runtime_error( "Unsupported file - The file is already fragmented" );
+        }
+        
+        for( const auto & box: static_cast< const Container & >( *( this->_moov ) ).GetBoxes( "trak" ) )
+        {
+            std::shared_ptr< ContainerBox > trak( std::dynamic_pointer_cast< ContainerBox >( box ) );
+            std::shared_ptr< TKHD >         tkhd( ( trak != nullptr ) ? trak->GetTypedBox< TKHD >( "tkhd" ) : nullptr );
+            
+            if( tkhd == nullptr )
+            {
+                throw std::runtime_error( "Invalid track - No TKHD box" );
+            }
+            
+            this->_trackIDs.push_back( tkhd->GetTrackID() );
+            this->_segmenters.push_back( Segmenter( this->_moov, tkhd->GetTrackID(), fragmentDuration ) );
+            
+            for( size_t i = 0; i < this->_segmenters.back().GetSegmentCount(); i++ )
+            {
+                this->_fragments.push_back( { this->_segmenters.size() - 1, i } );
+            }
+        }
+        
+        std::stable_sort
+        (
+            this->_fragments.begin(),
+            this->_fragments.end(),
+            [ this ]( const Fragment & f1, const Fragment & f2 )
+            {
+                return this->GetStartTime( f1 ) < this->GetStartTime( f2 );
+            }
+        );
+    }
+    
+    Fragmenter::IMPL::IMPL( const IMPL & o ):
+        _path( o._path ),
+        _moov( o._moov ),
+        _segmenters( o._segmenters ),
+        _trackIDs( o._trackIDs ),
+        _fragments( o._fragments )
+    {}
+    
+    Fragmenter::IMPL::~IMPL()
+    {}
+    
+    double Fragmenter::IMPL::GetStartTime( const Fragment & fragment ) const
+    {
+        const Segmenter & segmenter( this->_segmenters[ fragment.track ] );
+        
+        if( segmenter.GetTimescale() == 0 )
+        {
+            return 0;
+        }
+        
+        return static_cast< double >( segmenter.GetSegmentTime( fragment.segment ) ) / segmenter.GetTimescale();
+    }
+}
@@ -0,0 +1,455 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        FrameTypeIndex.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/FrameTypeIndex.hpp>
+#include <ISOBMFF/ParameterSets.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <ISOBMFF/RBSP.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace ISOBMFF
+{
+    class FrameTypeIndex::IMPL
+    {
+        public:
+            
+            class ParameterSets
+            {
+                public:
+                    
+                    std::unordered_map< uint8_t, SequenceParameterSet > _sps;
+                    std::unordered_map< uint8_t, PictureParameterSet >  _pps;
+            };
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void      Load( const Track & track, const Span< const uint8_t > * file, BinaryStream * stream, Executor & executor );
+            uint8_t   ReadEntry( Span< const uint8_t > sample ) const;
+            FrameType ReadHEVCSlice( Span< const uint8_t > nal, const ParameterSets & local ) const;
+            
+            std::vector< uint8_t > _entries;
+            bool                   _hevc;
+            uint8_t                _lengthSize;
+            ParameterSets          _parameterSets;
+    };
+    
+    static FrameTypeIndex::FrameType ReadAVCSlice( Span< const uint8_t > nal );
+    static size_t                    ReadSliceHeader( Span< const uint8_t > nal, size_t headerSize, Span< uint8_t > buffer );
+    
+    /* Number of chunks analyzed by each parallel task */
+    static const size_t ChunkGrain = 8;
+    
+    FrameTypeIndex::FrameTypeIndex( const Track & track, Span< const uint8_t > file ):
+        FrameTypeIndex( track, file, *( Executor::GetDefault() ) )
+    {}
+    
+    FrameTypeIndex::FrameTypeIndex( const Track & track, Span< const uint8_t > file, Executor & executor ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->impl->Load( track, &file, nullptr, executor );
+    }
+    
+    FrameTypeIndex::FrameTypeIndex( const Track & track, BinaryStream & stream ):
+        FrameTypeIndex( track, stream, *( Executor::GetDefault() ) )
+    {}
+    
+    FrameTypeIndex::FrameTypeIndex( const Track & track, BinaryStream & stream, Executor & executor ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->impl->Load( track, nullptr, &stream, executor );
+    }
+    
+    FrameTypeIndex::FrameTypeIndex( const FrameTypeIndex & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    FrameTypeIndex::FrameTypeIndex( FrameTypeIndex && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    FrameTypeIndex::~FrameTypeIndex()
+    {}
+    
+    FrameTypeIndex & FrameTypeIndex::operator =( FrameTypeIndex o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    FrameTypeIndex::FrameType FrameTypeIndex::GetFrameType( uint8_t entry )
+    {
+        return static_cast< FrameType >( entry & 0x0F );
+    }
+    
+    uint8_t FrameTypeIndex::GetTemporalID( uint8_t entry )
+    {
+        return static_cast< uint8_t >( entry >> 4 );
+    }
+    
+    size_t FrameTypeIndex::GetSampleCount() const
+    {
+        return this->impl->_entries.size();
+    }
+    
+    FrameTypeIndex::FrameType FrameTypeIndex::GetFrameType( size_t sample ) const
+    {
+        return GetFrameType( this->impl->_entries.at( sample ) );
+    }
+    
+    uint8_t FrameTypeIndex::GetTemporalID( size_t sample ) const
+    {
+        return GetTemporalID( this->impl->_entries.at( sample ) );
+    }
+    
+    const std::vector< uint8_t > & FrameTypeIndex::GetEntries() const
+    {
+        return this->impl->_entries;
+    }
+    
+    void swap( FrameTypeIndex & o1, FrameTypeIndex & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    FrameTypeIndex::IMPL::IMPL():
+        _hevc( false ),
+        _lengthSize( 0 )
+    {}
+    
+    FrameTypeIndex::IMPL::IMPL( const IMPL & o ):
+        _entries( o._entries ),
+        _hevc( o._hevc ),
+        _lengthSize( o._lengthSize ),
+        _parameterSets( o._parameterSets )
+    {}
+    
+    FrameTypeIndex::IMPL::~IMPL()
+    {}
+    
+    void FrameTypeIndex::IMPL::Load( const Track & track, const Span< const uint8_t > * file, BinaryStream * stream, Executor & executor )
+    {
+        const SampleTable & samples( track.GetSampleTable() );
+        std::mutex          mutex;
+        
+        if( track.GetHVCC() != nullptr )
+        {
+            this->_hevc = true;
+            
+            for( const auto & array: track.GetHVCC()->GetArrays() )
+            {
+                for( const auto & unit: array->GetNALUnits() )
+                {
+                    if( array->GetNALUnitType() == 33 )
+                    {
+                        SequenceParameterSet sps( SequenceParameterSet::ReadHEVC( unit->GetDataSpan() ) );
+                        
+                        this->_parameterSets._sps[ sps.id ] = sps;
+                    }
+                    else if( array->GetNALUnitType() == 34 )
+                    {
+                        PictureParameterSet pps( PictureParameterSet::ReadHEVC( unit->GetDataSpan() ) );
+                        
+                        this->_parameterSets._pps[ pps.id ] = pps;
+                    }
+                }
+            }
+        }
+        else if( track.GetAVCC() == nullptr )
+        {
+            throw std::runtime_error( "Unsupported track - No AVCC or HVCC box" );
+        }
+        
+        this->_lengthSize = track.GetNALUnitLengthSize();
+        
+        this->_entries.resize( samples.GetSampleCount() );
+        
+        executor.ParallelFor
+        (
+            0,
+            samples.GetChunkCount(),
+            ChunkGrain,
+            [ & ]( size_t begin, size_t end )
+            {
+                std::vector< uint8_t > buffer;
+                
+                for( size_t chunk = begin; chunk < end; chunk++ )
+                {
+                    size_t                first( samples.GetChunkFirstSample( chunk ) );
+                    size_t                last( first + samples.GetChunkSampleCount( chunk ) );
+                    uint64_t              offset( samples.GetChunkOffset( chunk ) );
+                    uint64_t              size( 0 );
+                    Span< const uint8_t > data;
+                    
+                    for( size_t i = first; i < last; i++ )
+                    {
+                        size = std::max( size, samples.GetSampleOffset( i ) + samples.GetSampleSize( i ) - offset );
+                    }
+                    
+                    if( file != nullptr )
+                    {
+                        if( offset > file->size() || size > file->size() - offset )
+                        {
+                            throw std::runtime_error( "Invalid chunk - Out of file bounds" );
+                        }
+                        
+                        data = file->subspan( static_cast< size_t >( offset ), static_cast< size_t >( size ) );
+                    }
+                    else
+                    {
+                        buffer.resize( static_cast< size_t >( size ) );
+                        
+                        {
+                            std::lock_guard< std::mutex > l( mutex );
+                            
+                            stream->Seek( static_cast< std::streamoff >( offset ), BinaryStream::SeekDirection::Begin );
+                            stream->Read( buffer.data(), buffer.size() );
+                        }
+                        
+                        data = buffer;
+                    }
+                    
+                    for( size_t i = first; i < last; i++ )
+                    {
+                        this->_entries[ i ] = this->ReadEntry( data.subspan( static_cast< size_t >( samples.GetSampleOffset( i ) - offset ), samples.GetSampleSize( i ) ) );
+                    }
+                }
+            }
+        );
+    }
+    
+    uint8_t FrameTypeIndex::IMPL::ReadEntry( Span< const uint8_t > sample ) const
+    {
+        FrameType     type( FrameType::Unknown );
+        uint8_t       temporalID( 0 );
+        ParameterSets local;
+        size_t        pos( 0 );
+        
+        while( pos < sample.size() )
+        {
+            Span< const uint8_t > nal;
+            FrameType             slice( FrameType::Unknown );
+            size_t                length( 0 );
+            
+            if( sample.size() - pos < this->_lengthSize )
+            {
+                throw std::runtime_error( "Invalid NAL unit - Truncated length" );
+            }
+            
+            for( uint8_t i = 0; i < this->_lengthSize; i++ )
+            {
+                length = ( length << 8 ) | sample[ pos++ ];
+            }
+            
+            if( length > sample.size() - pos )
+            {
+                throw std::runtime_error( "Invalid NAL unit - Truncated data" );
+            }
+            
+            nal  = sample.subspan( pos, length );
+            pos += length;
+            
+            if( nal.size() == 0 )
+            {
+                continue;
+            }
+            
+            if( this->_hevc )
+            {
+                uint8_t nalType( ( nal[ 0 ] >> 1 ) & 0x3F );
+                
+                if( nal.size() < 2 || ( nal[ 1 ] & 0x07 ) == 0 )
+                {
+                    throw std::runtime_error( "Invalid NAL unit - Invalid header" );
+                }
+                
+                /* Parameter sets sent in-band apply to the following slices of the sample */
+                if( nalType == 33 )
+                {
+                    SequenceParameterSet sps( SequenceParameterSet::ReadHEVC( nal ) );
+                    
+                    local._sps[ sps.id ] = sps;
+                }
+                else if( nalType == 34 )
+                {
+                    PictureParameterSet pps( PictureParameterSet::ReadHEVC( nal ) );
+                    
+                    local._pps[ pps.id ] = pps;
+                }
+                else if( nalType <= 9 || ( nalType >= 16 && nalType <= 21 ) )
+                {
+                    slice      = this->ReadHEVCSlice( nal, local );
+                    temporalID = std::max< uint8_t >( temporalID, static_cast< uint8_t >( ( nal[ 1 ] & 0x07 ) - 1 ) );
+                    
+                    if( slice != FrameType::Unknown && ( nalType == 19 || nalType == 20 ) )
+                    {
+                        slice = FrameType::IDR;
+                    }
+                }
+            }
+            else
+            {
+                uint8_t nalType( nal[ 0 ] & 0x1F );
+                
+                if( nalType == 1 || nalType == 2 || nalType == 5 )
+                {
+                    slice = ( nalType == 5 ) ? FrameType::IDR : ReadAVCSlice( nal );
+                }
+            }
+            
+            /* The frame type is the least restrictive type of its slices */
+            if( slice != FrameType::Unknown && ( type == FrameType::Unknown || slice > type ) )
+            {
+                type = slice;
+            }
+        }
+        
+        return static_cast< uint8_t >( static_cast< uint8_t >( type ) | ( temporalID << 4 ) );
+    }
+    
+    FrameTypeIndex::FrameType ReadAVCSlice( Span< const uint8_t > nal )
+    {
+        uint8_t   buffer[ 32 ];
+        BitReader reader( Span< const uint8_t >( buffer, ReadSliceHeader( nal, 1, Span< uint8_t >( buffer, sizeof( buffer ) ) ) ) );
+        
+        reader.ReadUE();
+        
+        switch( reader.ReadUE() % 5 )
+        {
+            case 0:
+            case 3:  return FrameTypeIndex::FrameType::P;
+            case 1:  return FrameTypeIndex::FrameType::B;
+            default: return FrameTypeIndex::FrameType::I;
+        }
+    }
+    
+    FrameTypeIndex::FrameType FrameTypeIndex::IMPL::ReadHEVCSlice( Span< const uint8_t > nal, const ParameterSets & local ) const
+    {
+        uint8_t                     buffer[ 32 ];
+        BitReader                   reader( Span< const uint8_t >( buffer, ReadSliceHeader( nal, 2, Span< uint8_t >( buffer, sizeof( buffer ) ) ) ) );
+        uint8_t                     nalType( ( nal[ 0 ] >> 1 ) & 0x3F );
+        bool                        first( reader.ReadBit() );
+        uint32_t                    ppsID;
+        const PictureParameterSet * pps;
+        
+        if( nalType >= 16 )
+        {
+            reader.SkipBits( 1 );
+        }
+        
+        ppsID = reader.ReadUE();
+        
+        if( ppsID <= 63 && local._pps.count( static_cast< uint8_t >( ppsID ) ) > 0 )
+        {
+            pps = &( local._pps.at( static_cast< uint8_t >( ppsID ) ) );
+        }
+        else if( ppsID <= 63 && this->_parameterSets._pps.count( static_cast< uint8_t >( ppsID ) ) > 0 )
+        {
+            pps = &( this->_parameterSets._pps.at( static_cast< uint8_t >( ppsID ) ) );
+        }
+        else
+        {
+            throw std::runtime_error( "Invalid slice - Unknown PPS " + std::to_string( ppsID ) );
+        }
+        
+        if( first == false )
+        {
+            const SequenceParameterSet * sps;
+            uint64_t                     ctbSize;
+            uint64_t                     ctbs;
+            unsigned int                 bits;
+            
+            if( pps->dependentSliceSegmentsEnabled && reader.ReadBit() )
+            {
+                /* Dependent slice segments inherit the slice type of the previous segment */
+                return FrameTypeIndex::FrameType::Unknown;
+            }
+            
+            if( local._sps.count( pps->spsID ) > 0 )
+            {
+                sps = &( local._sps.at( pps->spsID ) );
+            }
+            else if( this->_parameterSets._sps.count( pps->spsID ) > 0 )
+            {
+                sps = &( this->_parameterSets._sps.at( pps->spsID ) );
+            }
+            else
+            {
+                throw std::runtime_error( "Invalid slice - Unknown SPS " + std::to_string( pps->spsID ) );
+            }
+            
+            ctbSize = uint64_t( 1 ) << sps->log2CodingTreeBlockSize;
+            ctbs    = ( ( sps->codedWidth + ctbSize - 1 ) / ctbSize ) * ( ( sps->codedHeight + ctbSize - 1 ) / ctbSize );
+            
+            for( bits = 0; ( uint64_t( 1 ) << bits ) < ctbs; bits++ )
+            {}
+            
+            reader.SkipBits( bits );
+        }
+        
+        reader.SkipBits( pps->numExtraSliceHeaderBits );
+        
+        switch( reader.ReadUE() )
+        {
+            case 0:  return FrameTypeIndex::FrameType::B;
+            case 1:  return FrameTypeIndex::FrameType::P;
+            case 2:  return FrameTypeIndex::FrameType::I;
+            default: throw std::runtime_error( "Invalid slice - Invalid slice type" );
+        }
+    }
+    
+    size_t ReadSliceHeader( Span< const uint8_t > nal, size_t headerSize, Span< uint8_t > buffer )
+    {
+        size_t size;
+        
+        if( nal.size() <= headerSize )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not enough data" );
+        }
+        
+        /*
+         * Only the start of the slice header is needed, so only a prefix of
+         * the NAL unit is unescaped.
+         */
+        size = std::min( nal.size() - headerSize, buffer.size() );
+        
+        return RBSP::Extract( nal.subspan( headerSize, size ), buffer );
+    }
+}
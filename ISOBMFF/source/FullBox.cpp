@@ -31,10 +31,11 @@
 #include <ISOBMFF/FullBox.hpp>
 #include <ISOBMFF/Utils.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class FullBox::IMPL
+    class FullBox::IMPL: public ResourceAllocated
     {
         public:
             
@@ -94,6 +95,16 @@ namespace ISOBMFF
         this->SetFlags( vf & 0x00FFFFFF );
     }
     
+    uint64_t FullBox::GetDataSize() const
+    {
+        return 4;
+    }
+    
+    void FullBox::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteBigEndianUInt32( ( static_cast< uint32_t >( this->GetVersion() ) << 24 ) | ( this->GetFlags() & 0x00FFFFFF ) );
+    }
+    
     std::vector< std::pair< std::string, std::string > > FullBox::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        GridExtractor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/GridExtractor.hpp>
+#include <ISOBMFF/ItemGraph.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/AnnexB.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    class GridExtractor::IMPL
+    {
+        public:
+            
+            class Tile
+            {
+                public:
+                    
+                    uint32_t                                        _itemID;
+                    Span< const uint8_t >                           _data;
+                    std::shared_ptr< const std::vector< uint8_t > > _parameterSets;
+                    uint8_t                                         _lengthSize;
+                    size_t                                          _size;
+            };
+            
+            IMPL();
+            ~IMPL();
+            
+            void Load( const META & meta, uint32_t itemID, const Span< const uint8_t > * file, BinaryStream * stream );
+            
+            ImageGrid                             _grid;
+            std::vector< Tile >                   _tiles;
+            std::vector< std::vector< uint8_t > > _storage;
+    };
+    
+    GridExtractor::GridExtractor( const META & meta, uint32_t itemID, Span< const uint8_t > file ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->impl->Load( meta, itemID, &file, nullptr );
+    }
+    
+    GridExtractor::GridExtractor( const META & meta, uint32_t itemID, BinaryStream & stream ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->impl->Load( meta, itemID, nullptr, &stream );
+    }
+    
+    GridExtractor::GridExtractor( GridExtractor && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    GridExtractor::~GridExtractor()
+    {}
+    
+    GridExtractor & GridExtractor::operator =( GridExtractor o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( GridExtractor & o1, GridExtractor & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    const ImageGrid & GridExtractor::GetGrid() const
+    {
+        return this->impl->_grid;
+    }
+    
+    size_t GridExtractor::GetTileCount() const
+    {
+        return this->impl->_tiles.size();
+    }
+    
+    uint32_t GridExtractor::GetTileItemID( size_t index ) const
+    {
+        return this->impl->_tiles.at( index )._itemID;
+    }
+    
+    size_t GridExtractor::GetTileSize( size_t index ) const
+    {
+        return this->impl->_tiles.at( index )._size;
+    }
+    
+    size_t GridExtractor::ExtractTile( size_t index, Span< uint8_t > buffer ) const
+    {
+        const IMPL::Tile & tile( this->impl->_tiles.at( index ) );
+        size_t             size( tile._parameterSets->size() );
+        
+        if( buffer.size() < tile._size )
+        {
+            throw std::runtime_error( "Invalid buffer - Not enough space for tile " + std::to_string( index ) );
+        }
+        
+        if( size > 0 )
+        {
+            memcpy( buffer.data(), tile._parameterSets->data(), size );
+        }
+        
+        return size + AnnexB::Convert( tile._data, tile._lengthSize, buffer.subspan( size, buffer.size() - size ) );
+    }
+    
+    void GridExtractor::ExtractTiles( const std::vector< Span< uint8_t > > & buffers ) const
+    {
+        this->ExtractTiles( buffers, *( Executor::GetDefault() ) );
+    }
+    
+    void GridExtractor::ExtractTiles( const std::vector< Span< uint8_t > > & buffers, Executor & executor ) const
+    {
+        if( buffers.size() != this->impl->_tiles.size() )
+        {
+            throw std::runtime_error( "Invalid buffers - Expected one buffer per tile" );
+        }
+        
+        executor.ParallelFor
+        (
+            0,
+            buffers.size(),
+            1,
+            [ & ]( size_t begin, size_t end )
+            {
+                for( size_t i = begin; i < end; i++ )
+                {
+                    this->ExtractTile( i, buffers[ i ] );
+                }
+            }
+        );
+    }
+    
+    GridExtractor::IMPL::IMPL()
+    {}
+    
+    GridExtractor::IMPL::~IMPL()
+    {}
+    
+    void GridExtractor::IMPL::Load( const META & meta, uint32_t itemID, const Span< const uint8_t > * file, BinaryStream * stream )
+    {
+        ItemGraph                                                                            graph( meta );
+        ItemReader                                                                           reader( meta );
+        std::vector< uint32_t >                                                              tileIDs( graph.GetReferences( itemID, "dimg" ) );
+        std::vector< Span< const uint8_t > >                                                 data;
+        std::unordered_map< const HVCC *, std::shared_ptr< const std::vector< uint8_t > > > parameterSets;
+        
+        if( graph.GetItemType( itemID ) != "grid" )
+        {
+            throw std::runtime_error( "Invalid item - Item " + std::to_string( itemID ) + " is not a grid" );
+        }
+        
+        if( stream != nullptr )
+        {
+            std::vector< uint32_t > ids( 1, itemID );
+            
+            ids.insert( ids.end(), tileIDs.begin(), tileIDs.end() );
+            
+            this->_storage = reader.ReadItems( ids, *( stream ) );
+            
+            for( const auto & item: this->_storage )
+            {
+                data.push_back( item );
+            }
+        }
+        else
+        {
+            this->_storage.reserve( tileIDs.size() + 1 );
+            
+            for( size_t i = 0; i <= tileIDs.size(); i++ )
+            {
+                std::vector< Span< const uint8_t > > spans( reader.GetItemSpans( ( i == 0 ) ? itemID : tileIDs[ i - 1 ], *( file ) ) );
+                
+                if( spans.size() == 1 )
+                {
+                    data.push_back( spans[ 0 ] );
+                    
+                    continue;
+                }
+                
+                this->_storage.emplace_back();
+                
+                for( const auto & span: spans )
+                {
+                    this->_storage.back().insert( this->_storage.back().end(), span.begin(), span.end() );
+                }
+                
+                data.push_back( this->_storage.back() );
+            }
+        }
+        
+        {
+            BinaryDataStream grid( std::vector< uint8_t >( data[ 0 ].begin(), data[ 0 ].end() ) );
+            
+            this->_grid = ImageGrid( grid );
+        }
+        
+        if( tileIDs.size() != ( static_cast< size_t >( this->_grid.GetRows() ) + 1 ) * ( static_cast< size_t >( this->_grid.GetColumns() ) + 1 ) )
+        {
+            throw std::runtime_error( "Invalid grid - Tile count does not match rows and columns" );
+        }
+        
+        for( size_t i = 0; i < tileIDs.size(); i++ )
+        {
+            Tile                    tile;
+            std::shared_ptr< HVCC > hvcc( graph.GetTypedProperty< HVCC >( tileIDs[ i ], "hvcC" ) );
+            
+            if( graph.GetItemType( tileIDs[ i ] ) != "hvc1" || hvcc == nullptr )
+            {
+                throw std::runtime_error( "Invalid tile - Item " + std::to_string( tileIDs[ i ] ) + " is not an HEVC image" );
+            }
+            
+            {
+                auto & sets( parameterSets[ hvcc.get() ] );
+                
+                if( sets == nullptr )
+                {
+                    sets = std::make_shared< const std::vector< uint8_t > >( AnnexB::GetParameterSets( *( hvcc ) ) );
+                }
+                
+                tile._parameterSets = sets;
+            }
+            
+            tile._itemID     = tileIDs[ i ];
+            tile._data       = data[ i + 1 ];
+            tile._lengthSize = static_cast< uint8_t >( hvcc->GetLengthSizeMinusOne() + 1 );
+            tile._size       = tile._parameterSets->size() + AnnexB::GetSize( tile._data, tile._lengthSize );
+            
+            this->_tiles.push_back( tile );
+        }
+    }
+}
@@ -30,12 +30,13 @@
 
 #include <ISOBMFF/HDLR.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class HDLR::IMPL
+    class HDLR::IMPL: public ResourceAllocated
     {
         public:
             
@@ -43,10 +44,12 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
-            uint32_t    _predefined;
-            std::string _handlerType;
-            uint32_t    _reserved[ 3 ];
-            std::string _handlerName;
+            uint32_t            _predefined;
+            std::string         _handlerType;
+            uint32_t            _reserved[ 3 ];
+            std::string         _handlerName;
+            bool                _hasHandlerName;
+            Parser::StringType  _stringType;
     };
     
     HDLR::HDLR():
@@ -107,16 +110,64 @@ namespace ISOBMFF
             )
             {
                 this->SetHandlerName( stream.ReadPascalString() );
+                
+                this->impl->_stringType = Parser::StringType::Pascal;
             }
             else
             {
                 this->SetHandlerName( stream.ReadNULLTerminatedString() );
+                
+                this->impl->_stringType = Parser::StringType::NULLTerminated;
             }
+            
+            this->impl->_hasHandlerName = true;
         }
         else
         {
             this->SetHandlerName( "" );
+            
+            this->impl->_hasHandlerName = false;
+        }
+        
+        // Some writers pad the handler name
+        Box::ReadData( parser, stream );
+    }
+    
+    uint64_t HDLR::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() + 20 );
+        
+        if( this->impl->_hasHandlerName )
+        {
+            size += this->impl->_handlerName.size() + 1;
         }
+        
+        return size + Box::GetDataSize();
+    }
+    
+    void HDLR::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->impl->_predefined );
+        stream.WriteFourCC( this->GetHandlerType() );
+        stream.WriteBigEndianUInt32( this->impl->_reserved[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved[ 1 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved[ 2 ] );
+        
+        if( this->impl->_hasHandlerName )
+        {
+            if( this->impl->_stringType == Parser::StringType::Pascal )
+            {
+                stream.WritePascalString( this->GetHandlerName() );
+            }
+            else
+            {
+                stream.WriteNULLTerminatedString( this->GetHandlerName() );
+            }
+        }
+        
+        Box::WriteData( stream );
     }
     
     std::vector< std::pair< std::string, std::string > > HDLR::GetDisplayableProperties() const
@@ -150,7 +201,9 @@ namespace ISOBMFF
     }
 
     HDLR::IMPL::IMPL():
-        _predefined( 0 )
+        _predefined( 0 ),
+        _hasHandlerName( true ),
+        _stringType( Parser::StringType::NULLTerminated )
     {
         memset( this->_reserved, 0, sizeof( this->_reserved ) );
     }
@@ -158,7 +211,9 @@ namespace ISOBMFF
     HDLR::IMPL::IMPL( const IMPL & o ):
         _predefined( o._predefined ),
         _handlerType( o._handlerType ),
-        _handlerName( o._handlerName )
+        _handlerName( o._handlerName ),
+        _hasHandlerName( o._hasHandlerName ),
+        _stringType( o._stringType )
     {
         memcpy( this->_reserved, o._reserved, sizeof( this->_reserved ) );
     }
@@ -0,0 +1,469 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        HEIFSummary.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/HEIFSummary.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ISOBMFF
+{
+    static constexpr uint32_t Type( const char * s )
+    {
+        return   ( static_cast< uint32_t >( static_cast< uint8_t >( s[ 0 ] ) ) << 24 )
+               | ( static_cast< uint32_t >( static_cast< uint8_t >( s[ 1 ] ) ) << 16 )
+               | ( static_cast< uint32_t >( static_cast< uint8_t >( s[ 2 ] ) ) <<  8 )
+               |   static_cast< uint32_t >( static_cast< uint8_t >( s[ 3 ] ) );
+    }
+    
+    static uint64_t ReadUInt( Span< const uint8_t > data, size_t pos, size_t length );
+    static bool     NextBox( Span< const uint8_t > data, size_t & pos, size_t end, uint32_t & type, size_t & begin, size_t & boxEnd );
+    static void     ReadColour( Span< const uint8_t > data, size_t begin, size_t end, HEIFSummary & summary );
+    
+    template< class _F_ >
+    static void ForEachProperty( Span< const uint8_t > data, size_t iprpBegin, size_t iprpEnd, uint32_t itemID, _F_ callback );
+    
+    HEIFSummary HEIFSummary::Read( Span< const uint8_t > meta )
+    {
+        HEIFSummary summary{};
+        size_t      pos( 0 );
+        uint32_t    type;
+        size_t      begin;
+        size_t      end;
+        size_t      pitm[ 2 ] = { 0, 0 };
+        size_t      iinf[ 2 ] = { 0, 0 };
+        size_t      iref[ 2 ] = { 0, 0 };
+        size_t      iprp[ 2 ] = { 0, 0 };
+        uint32_t    primaryType( 0 );
+        uint32_t    firstTileID( 0 );
+        uint8_t     codecBitDepth( 0 );
+        bool        hasColour( false );
+        
+        if( NextBox( meta, pos, meta.size(), type, begin, end ) == false || type != Type( "meta" ) )
+        {
+            throw std::runtime_error( "Invalid META box" );
+        }
+        
+        /* QuickTime META boxes are not full boxes */
+        pos = ( end - begin >= 8 && ReadUInt( meta, begin + 4, 4 ) == Type( "hdlr" ) ) ? begin : begin + 4;
+        
+        {
+            size_t childBegin;
+            size_t childEnd;
+            
+            while( NextBox( meta, pos, end, type, childBegin, childEnd ) )
+            {
+                size_t * range( nullptr );
+                
+                if(      type == Type( "pitm" ) ) { range = pitm; }
+                else if( type == Type( "iinf" ) ) { range = iinf; }
+                else if( type == Type( "iref" ) ) { range = iref; }
+                else if( type == Type( "iprp" ) ) { range = iprp; }
+                
+                if( range != nullptr && range[ 1 ] == 0 )
+                {
+                    range[ 0 ] = childBegin;
+                    range[ 1 ] = childEnd;
+                }
+            }
+        }
+        
+        if( pitm[ 1 ] != 0 )
+        {
+            summary.primaryItemID = static_cast< uint32_t >( ReadUInt( meta, pitm[ 0 ] + 4, ( meta[ pitm[ 0 ] ] == 0 ) ? 2 : 4 ) );
+        }
+        
+        if( iinf[ 1 ] != 0 )
+        {
+            size_t p( iinf[ 0 ] + ( ( ReadUInt( meta, iinf[ 0 ], 1 ) == 0 ) ? 6 : 8 ) );
+            
+            while( NextBox( meta, p, iinf[ 1 ], type, begin, end ) )
+            {
+                uint64_t version( ReadUInt( meta, begin, 1 ) );
+                size_t   idSize( ( version == 2 ) ? 2 : 4 );
+                
+                if( type != Type( "infe" ) || version < 2 )
+                {
+                    continue;
+                }
+                
+                if( ReadUInt( meta, begin + 4, idSize ) == summary.primaryItemID )
+                {
+                    primaryType = static_cast< uint32_t >( ReadUInt( meta, begin + 4 + idSize + 2, 4 ) );
+                    
+                    break;
+                }
+            }
+        }
+        
+        summary.isGrid = primaryType == Type( "grid" );
+        
+        if( iref[ 1 ] != 0 )
+        {
+            size_t idSize( ( ReadUInt( meta, iref[ 0 ], 1 ) == 0 ) ? 2 : 4 );
+            size_t p( iref[ 0 ] + 4 );
+            
+            while( NextBox( meta, p, iref[ 1 ], type, begin, end ) )
+            {
+                uint64_t from( ReadUInt( meta, begin, idSize ) );
+                uint64_t count( ReadUInt( meta, begin + idSize, 2 ) );
+                
+                for( uint64_t i = 0; i < count; i++ )
+                {
+                    uint64_t to( ReadUInt( meta, begin + idSize + 2 + i * idSize, idSize ) );
+                    
+                    if( type == Type( "dimg" ) && from == summary.primaryItemID )
+                    {
+                        firstTileID = ( firstTileID == 0 ) ? static_cast< uint32_t >( to ) : firstTileID;
+                    }
+                    else if( to == summary.primaryItemID && type == Type( "thmb" ) )
+                    {
+                        summary.thumbnailCount++;
+                        
+                        break;
+                    }
+                    else if( to == summary.primaryItemID && type == Type( "auxl" ) )
+                    {
+                        summary.auxiliaryImageCount++;
+                        
+                        break;
+                    }
+                }
+            }
+        }
+        
+        if( iprp[ 1 ] == 0 )
+        {
+            return summary;
+        }
+        
+        ForEachProperty
+        (
+            meta,
+            iprp[ 0 ],
+            iprp[ 1 ],
+            summary.primaryItemID,
+            [ & ]( uint32_t property, size_t b, size_t e )
+            {
+                if( property == Type( "ispe" ) )
+                {
+                    summary.width  = static_cast< uint32_t >( ReadUInt( meta, b + 4, 4 ) );
+                    summary.height = static_cast< uint32_t >( ReadUInt( meta, b + 8, 4 ) );
+                }
+                else if( property == Type( "irot" ) )
+                {
+                    summary.rotation = static_cast< uint8_t >( ReadUInt( meta, b, 1 ) & 3 );
+                }
+                else if( property == Type( "pixi" ) && ReadUInt( meta, b + 4, 1 ) > 0 )
+                {
+                    summary.bitDepth = static_cast< uint8_t >( ReadUInt( meta, b + 5, 1 ) );
+                }
+                else if( property == Type( "colr" ) )
+                {
+                    hasColour = true;
+                    
+                    ReadColour( meta, b, e, summary );
+                }
+                else if( property == Type( "hvcC" ) )
+                {
+                    summary.codec = Codec::HEVC;
+                    codecBitDepth = static_cast< uint8_t >( ( ReadUInt( meta, b + 17, 1 ) & 7 ) + 8 );
+                }
+                else if( property == Type( "avcC" ) )
+                {
+                    summary.codec = Codec::AVC;
+                    codecBitDepth = 8;
+                }
+            }
+        );
+        
+        /* Grid items usually only have ispe and irot, the codec and colour are those of the tiles */
+        if( ( summary.codec == Codec::Unknown || hasColour == false ) && firstTileID != 0 )
+        {
+            bool tileCodec( summary.codec == Codec::Unknown );
+            
+            ForEachProperty
+            (
+                meta,
+                iprp[ 0 ],
+                iprp[ 1 ],
+                firstTileID,
+                [ & ]( uint32_t property, size_t b, size_t e )
+                {
+                    if( property == Type( "hvcC" ) && tileCodec )
+                    {
+                        summary.codec = Codec::HEVC;
+                        codecBitDepth = static_cast< uint8_t >( ( ReadUInt( meta, b + 17, 1 ) & 7 ) + 8 );
+                    }
+                    else if( property == Type( "avcC" ) && tileCodec )
+                    {
+                        summary.codec = Codec::AVC;
+                        codecBitDepth = 8;
+                    }
+                    else if( property == Type( "colr" ) && hasColour == false )
+                    {
+                        ReadColour( meta, b, e, summary );
+                    }
+                }
+            );
+        }
+        
+        if( summary.bitDepth == 0 )
+        {
+            summary.bitDepth = codecBitDepth;
+        }
+        
+        return summary;
+    }
+    
+    HEIFSummary HEIFSummary::Read( BinaryStream & stream )
+    {
+        uint64_t               offset;
+        uint64_t               size;
+        std::vector< uint8_t > data;
+        
+        if( FindMETA( stream, offset, size ) == false )
+        {
+            throw std::runtime_error( "Invalid file - No META box" );
+        }
+        
+        stream.Seek( offset, BinaryStream::SeekDirection::Begin );
+        
+        data = stream.Read( static_cast< size_t >( size ) );
+        
+        return Read( data );
+    }
+    
+    bool HEIFSummary::FindMETA( BinaryStream & stream, uint64_t & offset, uint64_t & size )
+    {
+        uint64_t pos( 0 );
+        uint64_t end;
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::End );
+        
+        end = stream.Tell();
+        
+        while( end - pos >= 8 )
+        {
+            uint64_t    length;
+            uint64_t    header( 8 );
+            std::string name;
+            
+            stream.Seek( pos, BinaryStream::SeekDirection::Begin );
+            
+            length = stream.ReadBigEndianUInt32();
+            name   = stream.ReadFourCC();
+            
+            if( length == 1 )
+            {
+                length = stream.ReadBigEndianUInt64();
+                header = 16;
+            }
+            else if( length == 0 )
+            {
+                length = end - pos;
+            }
+            
+            if( length < header || length > end - pos )
+            {
+                throw std::runtime_error( "Invalid box size for " + name );
+            }
+            
+            if( name == "meta" )
+            {
+                offset = pos;
+                size   = length;
+                
+                return true;
+            }
+            
+            pos += length;
+        }
+        
+        return false;
+    }
+    
+    static uint64_t ReadUInt( Span< const uint8_t > data, size_t pos, size_t length )
+    {
+        uint64_t value( 0 );
+        
+        if( pos > data.size() || length > data.size() - pos )
+        {
+            throw std::runtime_error( "Invalid META box - Not enough data available" );
+        }
+        
+        for( size_t i = 0; i < length; i++ )
+        {
+            value = ( value << 8 ) | data[ pos + i ];
+        }
+        
+        return value;
+    }
+    
+    static bool NextBox( Span< const uint8_t > data, size_t & pos, size_t end, uint32_t & type, size_t & begin, size_t & boxEnd )
+    {
+        uint64_t size;
+        size_t   header( 8 );
+        
+        if( pos >= end || end - pos < 8 )
+        {
+            return false;
+        }
+        
+        size = ReadUInt( data, pos, 4 );
+        type = static_cast< uint32_t >( ReadUInt( data, pos + 4, 4 ) );
+        
+        if( size == 1 )
+        {
+            size   = ReadUInt( data, pos + 8, 8 );
+            header = 16;
+        }
+        else if( size == 0 )
+        {
+            size = end - pos;
+        }
+        
+        if( size < header || size > end - pos )
+        {
+            throw std::runtime_error( "Invalid META box - Invalid box size" );
+        }
+        
+        begin  = pos + header;
+        boxEnd = pos + static_cast< size_t >( size );
+        pos    = boxEnd;
+        
+        return true;
+    }
+    
+    static void ReadColour( Span< const uint8_t > data, size_t begin, size_t end, HEIFSummary & summary )
+    {
+        uint64_t colourType( ReadUInt( data, begin, 4 ) );
+        
+        if( colourType == Type( "nclx" ) )
+        {
+            summary.hasNCLX                 = true;
+            summary.colourPrimaries         = static_cast< uint16_t >( ReadUInt( data, begin + 4, 2 ) );
+            summary.transferCharacteristics = static_cast< uint16_t >( ReadUInt( data, begin + 6, 2 ) );
+            summary.matrixCoefficients      = static_cast< uint16_t >( ReadUInt( data, begin + 8, 2 ) );
+            summary.fullRange               = ( ReadUInt( data, begin + 10, 1 ) & 0x80 ) != 0;
+        }
+        else if( colourType == Type( "prof" ) || colourType == Type( "rICC" ) )
+        {
+            summary.hasICCProfile = end - begin > 4;
+        }
+    }
+    
+    template< class _F_ >
+    static void ForEachProperty( Span< const uint8_t > data, size_t iprpBegin, size_t iprpEnd, uint32_t itemID, _F_ callback )
+    {
+        size_t   pos( iprpBegin );
+        size_t   ipco[ 2 ] = { 0, 0 };
+        uint32_t type;
+        size_t   begin;
+        size_t   end;
+        
+        while( NextBox( data, pos, iprpEnd, type, begin, end ) )
+        {
+            if( type == Type( "ipco" ) && ipco[ 1 ] == 0 )
+            {
+                ipco[ 0 ] = begin;
+                ipco[ 1 ] = end;
+            }
+        }
+        
+        if( ipco[ 1 ] == 0 )
+        {
+            return;
+        }
+        
+        pos = iprpBegin;
+        
+        while( NextBox( data, pos, iprpEnd, type, begin, end ) )
+        {
+            uint64_t version;
+            uint64_t flags;
+            uint64_t count;
+            size_t   p;
+            
+            if( type != Type( "ipma" ) )
+            {
+                continue;
+            }
+            
+            version = ReadUInt( data, begin, 1 );
+            flags   = ReadUInt( data, begin + 1, 3 );
+            count   = ReadUInt( data, begin + 4, 4 );
+            p       = begin + 8;
+            
+            for( uint64_t i = 0; i < count; i++ )
+            {
+                size_t   idSize( ( version < 1 ) ? 2 : 4 );
+                size_t   indexSize( ( flags & 1 ) ? 2 : 1 );
+                uint64_t id( ReadUInt( data, p, idSize ) );
+                uint64_t associations( ReadUInt( data, p + idSize, 1 ) );
+                
+                p += idSize + 1;
+                
+                if( id != itemID )
+                {
+                    p += static_cast< size_t >( associations ) * indexSize;
+                    
+                    continue;
+                }
+                
+                for( uint64_t j = 0; j < associations; j++, p += indexSize )
+                {
+                    uint64_t index( ReadUInt( data, p, indexSize ) & ( ( indexSize == 2 ) ? 0x7FFF : 0x7F ) );
+                    size_t   q( ipco[ 0 ] );
+                    uint32_t propertyType;
+                    size_t   propertyBegin;
+                    size_t   propertyEnd;
+                    
+                    if( index == 0 )
+                    {
+                        continue;
+                    }
+                    
+                    while( NextBox( data, q, ipco[ 1 ], propertyType, propertyBegin, propertyEnd ) )
+                    {
+                        if( --index == 0 )
+                        {
+                            callback( propertyType, propertyBegin, propertyEnd );
+                            
+                            break;
+                        }
+                    }
+                }
+                
+                return;
+            }
+        }
+    }
+}
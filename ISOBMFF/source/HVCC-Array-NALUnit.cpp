@@ -29,12 +29,13 @@
  */
 
 #include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <sstream>
 #include <iomanip>
 
 namespace ISOBMFF
 {
-    class HVCC::Array::NALUnit::IMPL
+    class HVCC::Array::NALUnit::IMPL: public ResourceAllocated
     {
         public:
             
@@ -64,7 +65,7 @@ namespace ISOBMFF
             stream.Read( &( data[ 0 ] ), size );
         }
         
-        this->SetData( data );
+        this->SetData( std::move( data ) );
     }
     
     HVCC::Array::NALUnit::NALUnit( const HVCC::Array::NALUnit & o ):
@@ -104,18 +105,26 @@ namespace ISOBMFF
         return this->impl->_data;
     }
     
+    Span< const uint8_t > HVCC::Array::NALUnit::GetDataSpan() const
+    {
+        return this->impl->_data;
+    }
+    
     void HVCC::Array::NALUnit::SetData( const std::vector< uint8_t > & value )
     {
         this->impl->_data = value;
     }
     
+    void HVCC::Array::NALUnit::SetData( std::vector< uint8_t > && value )
+    {
+        this->impl->_data = std::move( value );
+    }
+    
     std::vector< std::pair< std::string, std::string > > HVCC::Array::NALUnit::GetDisplayableProperties() const
     {
-        std::vector< uint8_t > data;
-        std::stringstream      ss;
-        std::string            s;
-        
-        data = this->GetData();
+        Span< const uint8_t > data( this->GetDataSpan() );
+        std::stringstream     ss;
+        std::string           s;
         
         if( data.size() > 0 )
         {
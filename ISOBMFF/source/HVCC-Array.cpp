@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class HVCC::Array::IMPL
+    class HVCC::Array::IMPL: public ResourceAllocated
     {
         public:
             
@@ -65,7 +66,7 @@ namespace ISOBMFF
         
         for( i = 0; i < count; i++ )
         {
-            this->AddNALUnit( std::make_shared< NALUnit >( stream ) );
+            this->AddNALUnit( MakeShared< NALUnit >( stream ) );
         }
     }
     
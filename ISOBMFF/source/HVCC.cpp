@@ -31,10 +31,11 @@
 #include <ISOBMFF/HVCC.hpp>
 #include <ISOBMFF/Utils.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class HVCC::IMPL
+    class HVCC::IMPL: public ResourceAllocated
     {
         public:
             
@@ -106,8 +107,6 @@ namespace ISOBMFF
         uint8_t  count;
         uint8_t  i;
         
-        ( void )parser;
-        
         this->SetConfigurationVersion( stream.ReadUInt8() );
         
         u8 = stream.ReadUInt8();
@@ -165,8 +164,78 @@ namespace ISOBMFF
                 break;
             }
             
-            this->AddArray( std::make_shared< Array >( stream ) );
+            this->AddArray( MakeShared< Array >( stream ) );
+        }
+        
+        Box::ReadData( parser, stream );
+    }
+    
+    uint64_t HVCC::GetDataSize() const
+    {
+        uint64_t size( 23 );
+        
+        for( const auto & array: this->impl->_arrays )
+        {
+            size += 3;
+            
+            for( const auto & unit: array->GetNALUnits() )
+            {
+                size += 2 + unit->GetDataSpan().size();
+            }
+        }
+        
+        return size + Box::GetDataSize();
+    }
+    
+    void HVCC::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteUInt8( this->GetConfigurationVersion() );
+        stream.WriteUInt8
+        (
+            static_cast< uint8_t >
+            (
+                  ( ( this->GetGeneralProfileSpace() & 0x03 ) << 6 )
+                | ( ( this->GetGeneralTierFlag()     & 0x01 ) << 5 )
+                | ( ( this->GetGeneralProfileIDC()   & 0x1F ) )
+            )
+        );
+        stream.WriteBigEndianUInt32( this->GetGeneralProfileCompatibilityFlags() );
+        stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetGeneralConstraintIndicatorFlags() >> 32 ) );
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetGeneralConstraintIndicatorFlags() ) );
+        stream.WriteUInt8( this->GetGeneralLevelIDC() );
+        stream.WriteBigEndianUInt16( static_cast< uint16_t >( 0xF000 | ( this->GetMinSpatialSegmentationIDC() & 0x0FFF ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xFC | ( this->GetParallelismType()     & 0x03 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xFC | ( this->GetChromaFormat()        & 0x03 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xF8 | ( this->GetBitDepthLumaMinus8()   & 0x07 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xF8 | ( this->GetBitDepthChromaMinus8() & 0x07 ) ) );
+        stream.WriteBigEndianUInt16( this->GetAvgFrameRate() );
+        stream.WriteUInt8
+        (
+            static_cast< uint8_t >
+            (
+                  ( ( this->GetConstantFrameRate()  & 0x03 ) << 6 )
+                | ( ( this->GetNumTemporalLayers()  & 0x07 ) << 3 )
+                | ( ( this->GetTemporalIdNested()   & 0x01 ) << 2 )
+                | ( ( this->GetLengthSizeMinusOne() & 0x03 ) )
+            )
+        );
+        stream.WriteUInt8( static_cast< uint8_t >( this->impl->_arrays.size() ) );
+        
+        for( const auto & array: this->impl->_arrays )
+        {
+            std::vector< std::shared_ptr< Array::NALUnit > > units( array->GetNALUnits() );
+            
+            stream.WriteUInt8( static_cast< uint8_t >( ( ( array->GetArrayCompleteness() ) ? 0x80 : 0x00 ) | ( array->GetNALUnitType() & 0x3F ) ) );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( units.size() ) );
+            
+            for( const auto & unit: units )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( unit->GetDataSpan().size() ) );
+                stream.Write( unit->GetDataSpan() );
+            }
         }
+        
+        Box::WriteData( stream );
     }
     
     void HVCC::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
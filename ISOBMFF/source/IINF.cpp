@@ -30,10 +30,11 @@
 
 #include <ISOBMFF/IINF.hpp>
 #include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class IINF::IMPL
+    class IINF::IMPL: public ResourceAllocated
     {
         public:
             
@@ -95,6 +96,7 @@ namespace ISOBMFF
             stream.ReadBigEndianUInt32();
         }
         
+        container.SetSourceRange( this->GetSourceOffset(), this->GetSourceSize(), this->GetSourceHeaderSize() );
         container.ReadData( parser, stream );
         
         this->impl->_entries.clear();
@@ -108,6 +110,37 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t IINF::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() + ( ( this->GetVersion() == 0 ) ? 2 : 4 ) );
+        
+        for( const auto & entry: this->impl->_entries )
+        {
+            size += entry->GetSize();
+        }
+        
+        return size;
+    }
+    
+    void IINF::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 0 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_entries.size() ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_entries.size() ) );
+        }
+        
+        for( const auto & entry: this->impl->_entries )
+        {
+            entry->Write( stream );
+        }
+    }
+    
     void IINF::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -127,9 +160,14 @@ namespace ISOBMFF
         return this->impl->_entries;
     }
     
+    Span< const std::shared_ptr< INFE > > IINF::GetEntriesSpan() const
+    {
+        return this->impl->_entries;
+    }
+    
     std::shared_ptr< INFE > IINF::GetItemInfo( uint32_t itemID ) const
     {
-        for( const auto & infe: this->GetEntries() )
+        for( const auto & infe: this->impl->_entries )
         {
             if( infe->GetItemID() == itemID )
             {
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class ILOC::Item::Extent::IMPL
+    class ILOC::Item::Extent::IMPL: public ResourceAllocated
     {
         public:
             
@@ -40,9 +41,12 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
-            uint64_t _index;
-            uint64_t _offset;
-            uint64_t _length;
+            void SetModified();
+            
+            uint64_t                _index;
+            uint64_t                _offset;
+            uint64_t                _length;
+            std::shared_ptr< bool > _modified;
     };
     
     ILOC::Item::Extent::Extent():
@@ -145,16 +149,27 @@ namespace ISOBMFF
     void ILOC::Item::Extent::SetIndex( uint64_t value )
     {
         this->impl->_index = value;
+        
+        this->impl->SetModified();
     }
     
     void ILOC::Item::Extent::SetOffset( uint64_t value )
     {
         this->impl->_offset = value;
+        
+        this->impl->SetModified();
     }
     
     void ILOC::Item::Extent::SetLength( uint64_t value )
     {
         this->impl->_length = value;
+        
+        this->impl->SetModified();
+    }
+    
+    void ILOC::Item::Extent::SetModifiedFlag( const std::shared_ptr< bool > & flag )
+    {
+        this->impl->_modified = flag;
     }
     
     std::vector< std::pair< std::string, std::string > > ILOC::Item::Extent::GetDisplayableProperties() const
@@ -181,4 +196,12 @@ namespace ISOBMFF
 
     ILOC::Item::Extent::IMPL::~IMPL()
     {}
+    
+    void ILOC::Item::Extent::IMPL::SetModified()
+    {
+        if( this->_modified != nullptr )
+        {
+            *( this->_modified ) = true;
+        }
+    }
 }
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class ILOC::Item::IMPL
+    class ILOC::Item::IMPL: public ResourceAllocated
     {
         public:
             
@@ -40,11 +41,14 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
+            void SetModified();
+            
             uint32_t                                 _itemID;
             uint8_t                                  _constructionMethod;
             uint16_t                                 _dataReferenceIndex;
             uint64_t                                 _baseOffset;
             std::vector< std::shared_ptr< Extent > > _extents;
+            std::shared_ptr< bool >                  _modified;
     };
     
     ILOC::Item::Item():
@@ -92,7 +96,7 @@ namespace ISOBMFF
         
         for( i = 0; i < count; i++ )
         {
-            this->AddExtent( std::make_shared< Extent >( stream, iloc ) );
+            this->AddExtent( MakeShared< Extent >( stream, iloc ) );
         }
     }
     
@@ -151,21 +155,29 @@ namespace ISOBMFF
     void ILOC::Item::SetItemID( uint32_t value )
     {
         this->impl->_itemID = value;
+        
+        this->impl->SetModified();
     }
     
     void ILOC::Item::SetConstructionMethod( uint8_t value )
     {
         this->impl->_constructionMethod = value;
+        
+        this->impl->SetModified();
     }
     
     void ILOC::Item::SetDataReferenceIndex( uint16_t value )
     {
         this->impl->_dataReferenceIndex = value;
+        
+        this->impl->SetModified();
     }
     
     void ILOC::Item::SetBaseOffset( uint64_t value )
     {
         this->impl->_baseOffset = value;
+        
+        this->impl->SetModified();
     }
     
     std::vector< std::shared_ptr< ILOC::Item::Extent > > ILOC::Item::GetExtents() const
@@ -173,9 +185,34 @@ namespace ISOBMFF
         return this->impl->_extents;
     }
     
+    Span< const std::shared_ptr< ILOC::Item::Extent > > ILOC::Item::GetExtentsSpan() const
+    {
+        return this->impl->_extents;
+    }
+    
     void ILOC::Item::AddExtent( std::shared_ptr< Extent > extent )
     {
+        if( extent != nullptr )
+        {
+            extent->SetModifiedFlag( this->impl->_modified );
+        }
+        
         this->impl->_extents.push_back( extent );
+        
+        this->impl->SetModified();
+    }
+    
+    void ILOC::Item::SetModifiedFlag( const std::shared_ptr< bool > & flag )
+    {
+        this->impl->_modified = flag;
+        
+        for( const auto & extent: this->impl->_extents )
+        {
+            if( extent != nullptr )
+            {
+                extent->SetModifiedFlag( flag );
+            }
+        }
     }
     
     void ILOC::Item::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
@@ -214,10 +251,23 @@ namespace ISOBMFF
         _itemID( o._itemID ),
         _constructionMethod( o._constructionMethod ),
         _dataReferenceIndex( o._dataReferenceIndex ),
-        _baseOffset( o._baseOffset ),
-        _extents( o._extents )
-    {}
+        _baseOffset( o._baseOffset )
+    {
+        /* Extents are copied, as they report their changes to the ILOC box of their item */
+        for( const auto & extent: o._extents )
+        {
+            this->_extents.push_back( ( extent != nullptr ) ? MakeShared< Extent >( *( extent ) ) : nullptr );
+        }
+    }
 
     ILOC::Item::IMPL::~IMPL()
     {}
+    
+    void ILOC::Item::IMPL::SetModified()
+    {
+        if( this->_modified != nullptr )
+        {
+            *( this->_modified ) = true;
+        }
+    }
 }
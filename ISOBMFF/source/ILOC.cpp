@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class ILOC::IMPL
+    class ILOC::IMPL: public ResourceAllocated
     {
         public:
             
@@ -40,11 +41,24 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
+            void                    Materialize();
+            void                    Sync();
+            Table                   BuildTable() const;
+            std::shared_ptr< Item > GetItem( size_t index );
+            std::shared_ptr< Item > CreateItem( size_t index ) const;
+            
+            static uint64_t ReadValue( BinaryStream & stream, uint8_t size );
+            static void     WriteValue( BinaryOutputStream & stream, uint64_t value, uint8_t size );
+            static uint64_t ValueSize( uint8_t size );
+            
             uint8_t                                _offsetSize;
             uint8_t                                _lengthSize;
             uint8_t                                _baseOffsetSize;
             uint8_t                                _indexSize;
+            Table                                  _table;
             std::vector< std::shared_ptr< Item > > _items;
+            bool                                   _materialized;
+            std::shared_ptr< bool >                _modified;
     };
     
     ILOC::ILOC():
@@ -110,11 +124,144 @@ namespace ISOBMFF
             count = stream.ReadBigEndianUInt32();
         }
         
-        this->impl->_items.clear();
+        {
+            Table & table( this->impl->_table );
+            
+            table = Table();
+            
+            this->impl->_items.clear();
+            
+            /* Items created before are detached from the new table */
+            this->impl->_materialized = false;
+            this->impl->_modified     = std::make_shared< bool >( false );
+            
+            table.extentStarts.push_back( 0 );
+            
+            for( i = 0; i < count; i++ )
+            {
+                uint32_t itemID( 0 );
+                uint8_t  method( 0 );
+                uint16_t extents;
+                
+                if( this->GetVersion() < 2 )
+                {
+                    itemID = stream.ReadBigEndianUInt16();
+                }
+                else if( this->GetVersion() == 2 )
+                {
+                    itemID = stream.ReadBigEndianUInt32();
+                }
+                
+                if( this->GetVersion() == 1 || this->GetVersion() == 2 )
+                {
+                    method = static_cast< uint8_t >( stream.ReadBigEndianUInt16() & 0xF );
+                }
+                
+                table.itemIDs.push_back( itemID );
+                table.constructionMethods.push_back( method );
+                table.dataReferenceIndices.push_back( stream.ReadBigEndianUInt16() );
+                table.baseOffsets.push_back( IMPL::ReadValue( stream, this->GetBaseOffsetSize() ) );
+                
+                extents = stream.ReadBigEndianUInt16();
+                
+                for( uint16_t j = 0; j < extents; j++ )
+                {
+                    uint64_t index( 0 );
+                    
+                    if( this->GetVersion() == 1 || this->GetVersion() == 2 )
+                    {
+                        index = IMPL::ReadValue( stream, this->GetIndexSize() );
+                    }
+                    
+                    table.extentIndices.push_back( index );
+                    table.extentOffsets.push_back( IMPL::ReadValue( stream, this->GetOffsetSize() ) );
+                    table.extentLengths.push_back( IMPL::ReadValue( stream, this->GetLengthSize() ) );
+                }
+                
+                table.extentStarts.push_back( static_cast< uint32_t >( table.extentOffsets.size() ) );
+            }
+        }
+    }
+    
+    uint64_t ILOC::GetDataSize() const
+    {
+        const Table & table( this->impl->_table );
+        uint64_t      size( FullBox::GetDataSize() + 2 );
+        uint64_t      item( 4 + IMPL::ValueSize( this->GetBaseOffsetSize() ) );
+        uint64_t      extent( IMPL::ValueSize( this->GetOffsetSize() ) + IMPL::ValueSize( this->GetLengthSize() ) );
+        
+        this->impl->Sync();
+        
+        if( this->GetVersion() < 2 )
+        {
+            size += 2;
+            item += 2;
+        }
+        else
+        {
+            size += 4;
+            item += ( this->GetVersion() == 2 ) ? 4 : 0;
+        }
         
-        for( i = 0; i < count; i++ )
+        if( this->GetVersion() == 1 || this->GetVersion() == 2 )
         {
-            this->AddItem( std::make_shared< Item >( stream, *( this ) ) );
+            item   += 2;
+            extent += IMPL::ValueSize( this->GetIndexSize() );
+        }
+        
+        return size + item * table.itemIDs.size() + extent * table.extentOffsets.size();
+    }
+    
+    void ILOC::WriteData( BinaryOutputStream & stream ) const
+    {
+        const Table & table( this->impl->_table );
+        
+        this->impl->Sync();
+        
+        FullBox::WriteData( stream );
+        
+        stream.WriteUInt8( static_cast< uint8_t >( ( this->GetOffsetSize() << 4 ) | ( this->GetLengthSize() & 0xF ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( ( this->GetBaseOffsetSize() << 4 ) | ( this->GetIndexSize() & 0xF ) ) );
+        
+        if( this->GetVersion() < 2 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( table.itemIDs.size() ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( table.itemIDs.size() ) );
+        }
+        
+        for( size_t i = 0; i < table.itemIDs.size(); i++ )
+        {
+            if( this->GetVersion() < 2 )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( table.itemIDs[ i ] ) );
+            }
+            else if( this->GetVersion() == 2 )
+            {
+                stream.WriteBigEndianUInt32( table.itemIDs[ i ] );
+            }
+            
+            if( this->GetVersion() == 1 || this->GetVersion() == 2 )
+            {
+                stream.WriteBigEndianUInt16( table.constructionMethods[ i ] & 0xF );
+            }
+            
+            stream.WriteBigEndianUInt16( table.dataReferenceIndices[ i ] );
+            IMPL::WriteValue( stream, table.baseOffsets[ i ], this->GetBaseOffsetSize() );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( table.extentStarts[ i + 1 ] - table.extentStarts[ i ] ) );
+            
+            for( uint32_t j = table.extentStarts[ i ]; j < table.extentStarts[ i + 1 ]; j++ )
+            {
+                if( this->GetVersion() == 1 || this->GetVersion() == 2 )
+                {
+                    IMPL::WriteValue( stream, table.extentIndices[ j ], this->GetIndexSize() );
+                }
+                
+                IMPL::WriteValue( stream, table.extentOffsets[ j ], this->GetOffsetSize() );
+                IMPL::WriteValue( stream, table.extentLengths[ j ], this->GetLengthSize() );
+            }
         }
     }
     
@@ -144,7 +291,7 @@ namespace ISOBMFF
             props.push_back( { "Index size", std::to_string( this->GetIndexSize() ) } );
         }
         
-        props.push_back( { "Items", std::to_string( this->GetItems().size() ) } );
+        props.push_back( { "Items", std::to_string( this->impl->_table.itemIDs.size() ) } );
         
         return props;
     }
@@ -189,44 +336,267 @@ namespace ISOBMFF
         this->impl->_indexSize = value;
     }
     
+    const ILOC::Table & ILOC::GetTable() const
+    {
+        this->impl->Sync();
+        
+        return this->impl->_table;
+    }
+    
     std::vector< std::shared_ptr< ILOC::Item > > ILOC::GetItems() const
     {
+        this->impl->Materialize();
+        
+        return this->impl->_items;
+    }
+    
+    Span< const std::shared_ptr< ILOC::Item > > ILOC::GetItemsSpan() const
+    {
+        this->impl->Materialize();
+        
         return this->impl->_items;
     }
     
     std::shared_ptr< ILOC::Item > ILOC::GetItem( uint32_t itemID ) const
     {
-        for( const auto & item: this->GetItems() )
+        this->impl->Sync();
+        
+        for( size_t i = 0; i < this->impl->_table.itemIDs.size(); i++ )
         {
-            if( item->GetItemID() == itemID )
+            if( this->impl->_table.itemIDs[ i ] == itemID )
             {
-                return item;
+                return this->impl->GetItem( i );
             }
         }
         
         return nullptr;
     }
     
+    std::shared_ptr< ILOC::Item > ILOC::GetItemAtIndex( size_t index ) const
+    {
+        if( index >= this->impl->_table.itemIDs.size() )
+        {
+            return nullptr;
+        }
+        
+        return this->impl->GetItem( index );
+    }
+    
     void ILOC::AddItem( std::shared_ptr< Item > item )
     {
-        this->impl->_items.push_back( item );
+        if( item == nullptr )
+        {
+            return;
+        }
+        
+        this->impl->Materialize();
+        this->impl->Sync();
+        
+        {
+            Table & table( this->impl->_table );
+            
+            if( table.extentStarts.size() == 0 )
+            {
+                table.extentStarts.push_back( 0 );
+            }
+            
+            table.itemIDs.push_back( item->GetItemID() );
+            table.constructionMethods.push_back( item->GetConstructionMethod() );
+            table.dataReferenceIndices.push_back( item->GetDataReferenceIndex() );
+            table.baseOffsets.push_back( item->GetBaseOffset() );
+            
+            for( const auto & extent: item->GetExtentsSpan() )
+            {
+                table.extentIndices.push_back( extent->GetIndex() );
+                table.extentOffsets.push_back( extent->GetOffset() );
+                table.extentLengths.push_back( extent->GetLength() );
+            }
+            
+            table.extentStarts.push_back( static_cast< uint32_t >( table.extentOffsets.size() ) );
+            
+            item->SetModifiedFlag( this->impl->_modified );
+            
+            this->impl->_items.push_back( item );
+        }
     }
 
     ILOC::IMPL::IMPL():
         _offsetSize( 0 ),
         _lengthSize( 0 ),
         _baseOffsetSize( 0 ),
-        _indexSize( 0 )
+        _indexSize( 0 ),
+        _materialized( true ),
+        _modified( std::make_shared< bool >( false ) )
     {}
 
+    /* Items report their changes to a single box, so a copy only takes the table, and creates its own items */
     ILOC::IMPL::IMPL( const IMPL & o ):
         _offsetSize( o._offsetSize ),
         _lengthSize( o._lengthSize ),
         _baseOffsetSize( o._baseOffsetSize ),
         _indexSize( o._indexSize ),
-        _items( o._items )
+        _table( ( *( o._modified ) ) ? o.BuildTable() : o._table ),
+        _materialized( false ),
+        _modified( std::make_shared< bool >( false ) )
     {}
 
     ILOC::IMPL::~IMPL()
     {}
+    
+    void ILOC::IMPL::Materialize()
+    {
+        if( this->_materialized )
+        {
+            return;
+        }
+        
+        /* Items already created with GetItemAtIndex are kept */
+        this->_items.resize( this->_table.itemIDs.size() );
+        
+        for( size_t i = 0; i < this->_items.size(); i++ )
+        {
+            if( this->_items[ i ] == nullptr )
+            {
+                this->_items[ i ] = this->CreateItem( i );
+            }
+        }
+        
+        this->_materialized = true;
+    }
+    
+    void ILOC::IMPL::Sync()
+    {
+        /* The table is only rebuilt when created items were changed through their setters */
+        if( *( this->_modified ) == false )
+        {
+            return;
+        }
+        
+        this->_table         = this->BuildTable();
+        *( this->_modified ) = false;
+    }
+    
+    ILOC::Table ILOC::IMPL::BuildTable() const
+    {
+        Table table;
+        
+        table.extentStarts.push_back( 0 );
+        
+        for( size_t i = 0; i < this->_table.itemIDs.size(); i++ )
+        {
+            const Item * item( ( i < this->_items.size() ) ? this->_items[ i ].get() : nullptr );
+            
+            if( item == nullptr )
+            {
+                table.itemIDs.push_back( this->_table.itemIDs[ i ] );
+                table.constructionMethods.push_back( this->_table.constructionMethods[ i ] );
+                table.dataReferenceIndices.push_back( this->_table.dataReferenceIndices[ i ] );
+                table.baseOffsets.push_back( this->_table.baseOffsets[ i ] );
+                
+                for( uint32_t j = this->_table.extentStarts[ i ]; j < this->_table.extentStarts[ i + 1 ]; j++ )
+                {
+                    table.extentIndices.push_back( this->_table.extentIndices[ j ] );
+                    table.extentOffsets.push_back( this->_table.extentOffsets[ j ] );
+                    table.extentLengths.push_back( this->_table.extentLengths[ j ] );
+                }
+            }
+            else
+            {
+                table.itemIDs.push_back( item->GetItemID() );
+                table.constructionMethods.push_back( item->GetConstructionMethod() );
+                table.dataReferenceIndices.push_back( item->GetDataReferenceIndex() );
+                table.baseOffsets.push_back( item->GetBaseOffset() );
+                
+                for( const auto & extent: item->GetExtentsSpan() )
+                {
+                    table.extentIndices.push_back( extent->GetIndex() );
+                    table.extentOffsets.push_back( extent->GetOffset() );
+                    table.extentLengths.push_back( extent->GetLength() );
+                }
+            }
+            
+            table.extentStarts.push_back( static_cast< uint32_t >( table.extentOffsets.size() ) );
+        }
+        
+        return table;
+    }
+    
+    std::shared_ptr< ILOC::Item > ILOC::IMPL::GetItem( size_t index )
+    {
+        if( this->_items.size() < this->_table.itemIDs.size() )
+        {
+            this->_items.resize( this->_table.itemIDs.size() );
+        }
+        
+        if( this->_items[ index ] == nullptr )
+        {
+            this->_items[ index ] = this->CreateItem( index );
+        }
+        
+        return this->_items[ index ];
+    }
+    
+    std::shared_ptr< ILOC::Item > ILOC::IMPL::CreateItem( size_t index ) const
+    {
+        std::shared_ptr< Item > item( MakeShared< Item >() );
+        
+        item->SetItemID( this->_table.itemIDs[ index ] );
+        item->SetConstructionMethod( this->_table.constructionMethods[ index ] );
+        item->SetDataReferenceIndex( this->_table.dataReferenceIndices[ index ] );
+        item->SetBaseOffset( this->_table.baseOffsets[ index ] );
+        
+        for( uint32_t j = this->_table.extentStarts[ index ]; j < this->_table.extentStarts[ index + 1 ]; j++ )
+        {
+            std::shared_ptr< Item::Extent > extent( MakeShared< Item::Extent >() );
+            
+            extent->SetIndex( this->_table.extentIndices[ j ] );
+            extent->SetOffset( this->_table.extentOffsets[ j ] );
+            extent->SetLength( this->_table.extentLengths[ j ] );
+            
+            item->AddExtent( extent );
+        }
+        
+        item->SetModifiedFlag( this->_modified );
+        
+        return item;
+    }
+    
+    uint64_t ILOC::IMPL::ReadValue( BinaryStream & stream, uint8_t size )
+    {
+        if( size == 2 )
+        {
+            return stream.ReadBigEndianUInt16();
+        }
+        else if( size == 4 )
+        {
+            return stream.ReadBigEndianUInt32();
+        }
+        else if( size == 8 )
+        {
+            return stream.ReadBigEndianUInt64();
+        }
+        
+        return 0;
+    }
+    
+    void ILOC::IMPL::WriteValue( BinaryOutputStream & stream, uint64_t value, uint8_t size )
+    {
+        if( size == 2 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( value ) );
+        }
+        else if( size == 4 )
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( value ) );
+        }
+        else if( size == 8 )
+        {
+            stream.WriteBigEndianUInt64( value );
+        }
+    }
+    
+    uint64_t ILOC::IMPL::ValueSize( uint8_t size )
+    {
+        return ( size == 2 || size == 4 || size == 8 ) ? size : 0;
+    }
 }
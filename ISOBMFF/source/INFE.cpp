@@ -30,10 +30,11 @@
 
 #include <ISOBMFF/INFE.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class INFE::IMPL
+    class INFE::IMPL: public ResourceAllocated
     {
         public:
             
@@ -41,13 +42,17 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
-            uint32_t    _itemID;
-            uint16_t    _itemProtectionIndex;
-            std::string _itemType;
-            std::string _itemName;
-            std::string _contentType;
-            std::string _contentEncoding;
-            std::string _itemURIType;
+            void WriteString( BinaryOutputStream & stream, const std::string & value ) const;
+            
+            uint32_t           _itemID;
+            uint16_t           _itemProtectionIndex;
+            std::string        _itemType;
+            std::string        _itemName;
+            std::string        _contentType;
+            std::string        _contentEncoding;
+            std::string        _itemURIType;
+            bool               _hasContentEncoding;
+            Parser::StringType _stringType;
     };
     
     INFE::INFE():
@@ -90,6 +95,9 @@ namespace ISOBMFF
     {
         FullBox::ReadData( parser, stream );
         
+        this->impl->_stringType         = parser.GetPreferredStringType();
+        this->impl->_hasContentEncoding = true;
+        
         if( this->GetVersion() == 0 || this->GetVersion() == 1 )
         {
             this->SetItemID( stream.ReadBigEndianUInt16() );
@@ -150,10 +158,19 @@ namespace ISOBMFF
             
             if( parser.GetPreferredStringType() == Parser::StringType::Pascal )
             {
+                this->SetItemName( stream.ReadPascalString() );
+                
                 if( this->GetItemType() == "mime" )
                 {
                     this->SetContentType( stream.ReadPascalString() );
-                    this->SetContentEncoding( stream.ReadPascalString() );
+                    
+                    // content_encoding is optional
+                    this->impl->_hasContentEncoding = stream.HasBytesAvailable();
+                    
+                    if( this->impl->_hasContentEncoding )
+                    {
+                        this->SetContentEncoding( stream.ReadPascalString() );
+                    }
                 }
                 else if( this->GetItemType() == "uri " )
                 {
@@ -162,10 +179,19 @@ namespace ISOBMFF
             }
             else
             {
+                this->SetItemName( stream.ReadNULLTerminatedString() );
+                
                 if( this->GetItemType() == "mime" )
                 {
                     this->SetContentType( stream.ReadNULLTerminatedString() );
-                    this->SetContentEncoding( stream.ReadNULLTerminatedString() );
+                    
+                    // content_encoding is optional
+                    this->impl->_hasContentEncoding = stream.HasBytesAvailable();
+                    
+                    if( this->impl->_hasContentEncoding )
+                    {
+                        this->SetContentEncoding( stream.ReadNULLTerminatedString() );
+                    }
                 }
                 else if( this->GetItemType() == "uri " )
                 {
@@ -175,6 +201,86 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t INFE::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() );
+        
+        if( this->GetVersion() == 0 || this->GetVersion() == 1 )
+        {
+            size += 4;
+            size += this->GetItemName().size() + 1;
+            size += this->GetContentType().size() + 1;
+            size += this->GetContentEncoding().size() + 1;
+        }
+        else if( this->GetVersion() >= 2 )
+        {
+            size += ( this->GetVersion() == 3 ) ? 4 : ( ( this->GetVersion() == 2 ) ? 2 : 0 );
+            size += 6;
+            size += this->GetItemName().size() + 1;
+            
+            if( this->GetItemType() == "mime" )
+            {
+                size += this->GetContentType().size() + 1;
+                
+                if( this->impl->_hasContentEncoding )
+                {
+                    size += this->GetContentEncoding().size() + 1;
+                }
+            }
+            else if( this->GetItemType() == "uri " )
+            {
+                size += this->GetItemURIType().size() + 1;
+            }
+        }
+        
+        return size;
+    }
+    
+    void INFE::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 0 || this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetItemID() ) );
+            stream.WriteBigEndianUInt16( this->GetItemProtectionIndex() );
+            
+            this->impl->WriteString( stream, this->GetItemName() );
+            this->impl->WriteString( stream, this->GetContentType() );
+            this->impl->WriteString( stream, this->GetContentEncoding() );
+        }
+        else if( this->GetVersion() >= 2 )
+        {
+            if( this->GetVersion() == 2 )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetItemID() ) );
+            }
+            else if( this->GetVersion() == 3 )
+            {
+                stream.WriteBigEndianUInt32( this->GetItemID() );
+            }
+            
+            stream.WriteBigEndianUInt16( this->GetItemProtectionIndex() );
+            stream.WriteFourCC( this->GetItemType() );
+            
+            this->impl->WriteString( stream, this->GetItemName() );
+            
+            if( this->GetItemType() == "mime" )
+            {
+                this->impl->WriteString( stream, this->GetContentType() );
+                
+                if( this->impl->_hasContentEncoding )
+                {
+                    this->impl->WriteString( stream, this->GetContentEncoding() );
+                }
+            }
+            else if( this->GetItemType() == "uri " )
+            {
+                this->impl->WriteString( stream, this->GetItemURIType() );
+            }
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > INFE::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -262,7 +368,9 @@ namespace ISOBMFF
     
     INFE::IMPL::IMPL():
         _itemID( 0 ),
-        _itemProtectionIndex( 0 )
+        _itemProtectionIndex( 0 ),
+        _hasContentEncoding( true ),
+        _stringType( Parser::StringType::NULLTerminated )
     {}
 
     INFE::IMPL::IMPL( const IMPL & o ):
@@ -272,9 +380,23 @@ namespace ISOBMFF
         _itemName( o._itemName ),
         _contentType( o._contentType ),
         _contentEncoding( o._contentEncoding ),
-        _itemURIType( o._itemURIType )
+        _itemURIType( o._itemURIType ),
+        _hasContentEncoding( o._hasContentEncoding ),
+        _stringType( o._stringType )
     {}
 
     INFE::IMPL::~IMPL()
     {}
+
+    void INFE::IMPL::WriteString( BinaryOutputStream & stream, const std::string & value ) const
+    {
+        if( this->_stringType == Parser::StringType::Pascal )
+        {
+            stream.WritePascalString( value );
+        }
+        else
+        {
+            stream.WriteNULLTerminatedString( value );
+        }
+    }
 }
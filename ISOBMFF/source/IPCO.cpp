@@ -37,7 +37,7 @@ namespace ISOBMFF
     
     std::shared_ptr< Box > IPCO::GetPropertyAtIndex( size_t index ) const
     {
-        auto boxes( this->GetBoxes() );
+        auto boxes( this->GetBoxesSpan() );
         
         if( index >= boxes.size() )
         {
@@ -49,7 +49,7 @@ namespace ISOBMFF
     
     std::shared_ptr< Box > IPCO::GetProperty( const IPMA::Entry::Association & association ) const
     {
-        auto     boxes( this->GetBoxes() );
+        auto     boxes( this->GetBoxesSpan() );
         uint16_t index;
         
         index = association.GetPropertyIndex();
@@ -72,7 +72,9 @@ namespace ISOBMFF
         std::vector< std::shared_ptr< Box > > boxes;
         std::shared_ptr< Box >                box;
         
-        for( const auto & b: entry.GetAssociations() )
+        boxes.reserve( entry.GetAssociationsSpan().size() );
+        
+        for( const auto & b: entry.GetAssociationsSpan() )
         {
             box = this->GetProperty( *( b ) );
             
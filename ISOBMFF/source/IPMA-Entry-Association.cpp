@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/IPMA.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class IPMA::Entry::Association::IMPL
+    class IPMA::Entry::Association::IMPL: public ResourceAllocated
     {
         public:
             
@@ -40,8 +41,11 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
-            bool     _essential;
-            uint16_t _propertyIndex;
+            void SetModified();
+            
+            bool                    _essential;
+            uint16_t                _propertyIndex;
+            std::shared_ptr< bool > _modified;
     };
     
     IPMA::Entry::Association::Association():
@@ -129,11 +133,20 @@ namespace ISOBMFF
     void IPMA::Entry::Association::SetEssential( bool value )
     {
         this->impl->_essential = value;
+        
+        this->impl->SetModified();
     }
     
     void IPMA::Entry::Association::SetPropertyIndex( uint16_t value )
     {
         this->impl->_propertyIndex = value;
+        
+        this->impl->SetModified();
+    }
+    
+    void IPMA::Entry::Association::SetModifiedFlag( const std::shared_ptr< bool > & flag )
+    {
+        this->impl->_modified = flag;
     }
     
     IPMA::Entry::Association::IMPL::IMPL():
@@ -148,4 +161,12 @@ namespace ISOBMFF
 
     IPMA::Entry::Association::IMPL::~IMPL()
     {}
+    
+    void IPMA::Entry::Association::IMPL::SetModified()
+    {
+        if( this->_modified != nullptr )
+        {
+            *( this->_modified ) = true;
+        }
+    }
 }
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/IPMA.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class IPMA::Entry::IMPL
+    class IPMA::Entry::IMPL: public ResourceAllocated
     {
         public:
             
@@ -40,8 +41,11 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
+            void SetModified();
+            
             uint32_t                                      _itemID;
             std::vector< std::shared_ptr< Association > > _associations;
+            std::shared_ptr< bool >                       _modified;
     };
     
     IPMA::Entry::Entry():
@@ -67,7 +71,7 @@ namespace ISOBMFF
         
         for( i = 0; i < count; i++ )
         {
-            this->AddAssociation( std::make_shared< Association >( stream, ipma ) );
+            this->AddAssociation( MakeShared< Association >( stream, ipma ) );
         }
     }
     
@@ -133,6 +137,8 @@ namespace ISOBMFF
     void IPMA::Entry::SetItemID( uint32_t value )
     {
         this->impl->_itemID = value;
+        
+        this->impl->SetModified();
     }
     
     std::vector< std::shared_ptr< IPMA::Entry::Association > > IPMA::Entry::GetAssociations() const
@@ -140,9 +146,34 @@ namespace ISOBMFF
         return this->impl->_associations;
     }
     
+    Span< const std::shared_ptr< IPMA::Entry::Association > > IPMA::Entry::GetAssociationsSpan() const
+    {
+        return this->impl->_associations;
+    }
+    
     void IPMA::Entry::AddAssociation( std::shared_ptr< Association > association )
     {
+        if( association != nullptr )
+        {
+            association->SetModifiedFlag( this->impl->_modified );
+        }
+        
         this->impl->_associations.push_back( association );
+        
+        this->impl->SetModified();
+    }
+    
+    void IPMA::Entry::SetModifiedFlag( const std::shared_ptr< bool > & flag )
+    {
+        this->impl->_modified = flag;
+        
+        for( const auto & association: this->impl->_associations )
+        {
+            if( association != nullptr )
+            {
+                association->SetModifiedFlag( flag );
+            }
+        }
     }
 
     IPMA::Entry::IMPL::IMPL():
@@ -150,10 +181,23 @@ namespace ISOBMFF
     {}
 
     IPMA::Entry::IMPL::IMPL( const IMPL & o ):
-        _itemID( o._itemID ),
-        _associations( o._associations )
-    {}
+        _itemID( o._itemID )
+    {
+        /* Associations are copied, as they report their changes to the IPMA box of their entry */
+        for( const auto & association: o._associations )
+        {
+            this->_associations.push_back( ( association != nullptr ) ? MakeShared< Association >( *( association ) ) : nullptr );
+        }
+    }
 
     IPMA::Entry::IMPL::~IMPL()
     {}
+    
+    void IPMA::Entry::IMPL::SetModified()
+    {
+        if( this->_modified != nullptr )
+        {
+            *( this->_modified ) = true;
+        }
+    }
 }
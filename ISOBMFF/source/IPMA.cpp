@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/IPMA.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class IPMA::IMPL
+    class IPMA::IMPL: public ResourceAllocated
     {
         public:
             
@@ -40,7 +41,14 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
+            void  Materialize();
+            void  Sync();
+            Table BuildTable() const;
+            
+            Table                                   _table;
             std::vector< std::shared_ptr< Entry > > _entries;
+            bool                                    _materialized;
+            std::shared_ptr< bool >                 _modified;
     };
     
     IPMA::IPMA():
@@ -88,9 +96,102 @@ namespace ISOBMFF
         
         count = stream.ReadBigEndianUInt32();
         
-        for( i = 0; i < count; i++ )
         {
-            this->AddEntry( std::make_shared< Entry >( stream, *( this ) ) );
+            Table & table( this->impl->_table );
+            
+            table = Table();
+            
+            this->impl->_entries.clear();
+            
+            /* Entries created before are detached from the new table */
+            this->impl->_materialized = false;
+            this->impl->_modified     = std::make_shared< bool >( false );
+            
+            table.associationStarts.push_back( 0 );
+            
+            for( i = 0; i < count; i++ )
+            {
+                uint8_t associations;
+                
+                if( this->GetVersion() < 1 )
+                {
+                    table.itemIDs.push_back( stream.ReadBigEndianUInt16() );
+                }
+                else
+                {
+                    table.itemIDs.push_back( stream.ReadBigEndianUInt32() );
+                }
+                
+                associations = stream.ReadUInt8();
+                
+                for( uint8_t j = 0; j < associations; j++ )
+                {
+                    if( this->GetFlags() & 0x01 )
+                    {
+                        uint16_t u16( stream.ReadBigEndianUInt16() );
+                        
+                        table.essentials.push_back( static_cast< uint8_t >( u16 >> 15 ) );
+                        table.propertyIndices.push_back( u16 & 0x7FFF );
+                    }
+                    else
+                    {
+                        uint8_t u8( stream.ReadUInt8() );
+                        
+                        table.essentials.push_back( static_cast< uint8_t >( u8 >> 7 ) );
+                        table.propertyIndices.push_back( u8 & 0x7F );
+                    }
+                }
+                
+                table.associationStarts.push_back( static_cast< uint32_t >( table.propertyIndices.size() ) );
+            }
+        }
+    }
+    
+    uint64_t IPMA::GetDataSize() const
+    {
+        const Table & table( this->impl->_table );
+        uint64_t      item( ( this->GetVersion() < 1 ) ? 3 : 5 );
+        uint64_t      association( ( this->GetFlags() & 0x01 ) ? 2 : 1 );
+        
+        this->impl->Sync();
+        
+        return FullBox::GetDataSize() + 4 + item * table.itemIDs.size() + association * table.propertyIndices.size();
+    }
+    
+    void IPMA::WriteData( BinaryOutputStream & stream ) const
+    {
+        const Table & table( this->impl->_table );
+        
+        this->impl->Sync();
+        
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( table.itemIDs.size() ) );
+        
+        for( size_t i = 0; i < table.itemIDs.size(); i++ )
+        {
+            if( this->GetVersion() < 1 )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( table.itemIDs[ i ] ) );
+            }
+            else
+            {
+                stream.WriteBigEndianUInt32( table.itemIDs[ i ] );
+            }
+            
+            stream.WriteUInt8( static_cast< uint8_t >( table.associationStarts[ i + 1 ] - table.associationStarts[ i ] ) );
+            
+            for( uint32_t j = table.associationStarts[ i ]; j < table.associationStarts[ i + 1 ]; j++ )
+            {
+                if( this->GetFlags() & 0x01 )
+                {
+                    stream.WriteBigEndianUInt16( static_cast< uint16_t >( ( table.essentials[ j ] << 15 ) | ( table.propertyIndices[ j ] & 0x7FFF ) ) );
+                }
+                else
+                {
+                    stream.WriteUInt8( static_cast< uint8_t >( ( table.essentials[ j ] << 7 ) | ( table.propertyIndices[ j ] & 0x7F ) ) );
+                }
+            }
         }
     }
     
@@ -104,7 +205,7 @@ namespace ISOBMFF
     {
         return
         {
-            { "Entries", std::to_string( this->GetEntries().size() ) }
+            { "Entries", std::to_string( this->impl->_table.itemIDs.size() ) }
         };
     }
     
@@ -115,18 +216,38 @@ namespace ISOBMFF
         return std::vector< std::shared_ptr< DisplayableObject > >( v.begin(), v.end() );
     }
     
+    const IPMA::Table & IPMA::GetTable() const
+    {
+        this->impl->Sync();
+        
+        return this->impl->_table;
+    }
+    
     std::vector< std::shared_ptr< IPMA::Entry > > IPMA::GetEntries() const
     {
+        this->impl->Materialize();
+        
+        return this->impl->_entries;
+    }
+    
+    Span< const std::shared_ptr< IPMA::Entry > > IPMA::GetEntriesSpan() const
+    {
+        this->impl->Materialize();
+        
         return this->impl->_entries;
     }
     
     std::shared_ptr< IPMA::Entry > IPMA::GetEntry( uint32_t itemID ) const
     {
-        for( const auto & entry: this->GetEntries() )
+        this->impl->Sync();
+        
+        for( size_t i = 0; i < this->impl->_table.itemIDs.size(); i++ )
         {
-            if( entry->GetItemID() == itemID )
+            if( this->impl->_table.itemIDs[ i ] == itemID )
             {
-                return entry;
+                this->impl->Materialize();
+                
+                return this->impl->_entries[ i ];
             }
         }
         
@@ -135,16 +256,117 @@ namespace ISOBMFF
     
     void IPMA::AddEntry( std::shared_ptr< Entry > entry )
     {
-        this->impl->_entries.push_back( entry );
+        if( entry == nullptr )
+        {
+            return;
+        }
+        
+        this->impl->Materialize();
+        this->impl->Sync();
+        
+        {
+            Table & table( this->impl->_table );
+            
+            if( table.associationStarts.size() == 0 )
+            {
+                table.associationStarts.push_back( 0 );
+            }
+            
+            table.itemIDs.push_back( entry->GetItemID() );
+            
+            for( const auto & association: entry->GetAssociationsSpan() )
+            {
+                table.essentials.push_back( association->GetEssential() ? 1 : 0 );
+                table.propertyIndices.push_back( association->GetPropertyIndex() );
+            }
+            
+            table.associationStarts.push_back( static_cast< uint32_t >( table.propertyIndices.size() ) );
+            
+            entry->SetModifiedFlag( this->impl->_modified );
+            
+            this->impl->_entries.push_back( entry );
+        }
     }
-
-    IPMA::IMPL::IMPL()
+    
+    IPMA::IMPL::IMPL():
+        _materialized( true ),
+        _modified( std::make_shared< bool >( false ) )
     {}
-
+    
+    /* Entries report their changes to a single box, so a copy only takes the table, and creates its own entries */
     IPMA::IMPL::IMPL( const IMPL & o ):
-        _entries( o._entries )
+        _table( ( *( o._modified ) ) ? o.BuildTable() : o._table ),
+        _materialized( false ),
+        _modified( std::make_shared< bool >( false ) )
     {}
-
+    
     IPMA::IMPL::~IMPL()
     {}
+    
+    void IPMA::IMPL::Materialize()
+    {
+        if( this->_materialized )
+        {
+            return;
+        }
+        
+        this->_entries.reserve( this->_table.itemIDs.size() );
+        
+        for( size_t i = 0; i < this->_table.itemIDs.size(); i++ )
+        {
+            std::shared_ptr< Entry > entry( MakeShared< Entry >() );
+            
+            entry->SetItemID( this->_table.itemIDs[ i ] );
+            
+            for( uint32_t j = this->_table.associationStarts[ i ]; j < this->_table.associationStarts[ i + 1 ]; j++ )
+            {
+                std::shared_ptr< Entry::Association > association( MakeShared< Entry::Association >() );
+                
+                association->SetEssential( this->_table.essentials[ j ] != 0 );
+                association->SetPropertyIndex( this->_table.propertyIndices[ j ] );
+                
+                entry->AddAssociation( association );
+            }
+            
+            entry->SetModifiedFlag( this->_modified );
+            
+            this->_entries.push_back( entry );
+        }
+        
+        this->_materialized = true;
+    }
+    
+    void IPMA::IMPL::Sync()
+    {
+        /* The table is only rebuilt when created entries were changed through their setters */
+        if( *( this->_modified ) == false )
+        {
+            return;
+        }
+        
+        this->_table         = this->BuildTable();
+        *( this->_modified ) = false;
+    }
+    
+    IPMA::Table IPMA::IMPL::BuildTable() const
+    {
+        Table table;
+        
+        table.associationStarts.push_back( 0 );
+        
+        for( const auto & entry: this->_entries )
+        {
+            table.itemIDs.push_back( entry->GetItemID() );
+            
+            for( const auto & association: entry->GetAssociationsSpan() )
+            {
+                table.essentials.push_back( association->GetEssential() ? 1 : 0 );
+                table.propertyIndices.push_back( association->GetPropertyIndex() );
+            }
+            
+            table.associationStarts.push_back( static_cast< uint32_t >( table.propertyIndices.size() ) );
+        }
+        
+        return table;
+    }
 }
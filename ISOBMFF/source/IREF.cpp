@@ -29,12 +29,17 @@
  */
 
 #include <ISOBMFF/IREF.hpp>
-#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/SingleItemTypeReferenceBox.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/FlatBoxTree.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+#include <functional>
 
 namespace ISOBMFF
 {
-    class IREF::IMPL
+    class IREF::IMPL: public ResourceAllocated
     {
         public:
             
@@ -42,7 +47,34 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
-            std::vector< std::shared_ptr< Box > > _boxes;
+            /*
+             * How boxes of a reference type are created, as registered in
+             * the parser. Types not creating a SingleItemTypeReferenceBox
+             * cannot be built from the table, and are parsed right away.
+             * The position of these boxes among all references is kept
+             * with them, in _parsed.
+             */
+            struct Factory
+            {
+                uint32_t                                  type;
+                std::function< std::shared_ptr< Box >() > create;
+                bool                                      reference;
+            };
+            
+            const Factory & GetFactory( const Parser & parser, const std::string & name );
+            void            Materialize();
+            void            Build();
+            void            Sync();
+            Table           BuildTable() const;
+            uint64_t        GetReferenceSize( uint8_t version, size_t row ) const;
+            void            WriteReference( BinaryOutputStream & stream, uint8_t version, size_t row ) const;
+            
+            Table                                                      _table;
+            std::vector< Factory >                                     _factories;
+            std::vector< std::pair< size_t, std::shared_ptr< Box > > > _parsed;
+            std::vector< std::shared_ptr< Box > >                      _boxes;
+            bool                                                       _materialized;
+            std::shared_ptr< bool >                                    _modified;
     };
     
     IREF::IREF():
@@ -83,14 +115,148 @@ namespace ISOBMFF
     
     void IREF::ReadData( Parser & parser, BinaryStream & stream )
     {
-        ContainerBox container( "????" );
-        
         FullBox::ReadData( parser, stream );
-        parser.SetInfo( "iref", this );
-        container.ReadData( parser, stream );
-        parser.SetInfo( "iref", nullptr );
         
-        this->impl->_boxes = container.GetBoxes();
+        {
+            Table & table( this->impl->_table );
+            
+            table = Table();
+            
+            this->impl->_factories.clear();
+            this->impl->_parsed.clear();
+            this->impl->_boxes.clear();
+            
+            /* Boxes created before are detached from the new table */
+            this->impl->_materialized = false;
+            this->impl->_modified     = std::make_shared< bool >( false );
+            
+            table.toStarts.push_back( 0 );
+            
+            while( stream.HasBytesAvailable() )
+            {
+                uint64_t    length( stream.ReadBigEndianUInt32() );
+                std::string name( stream.ReadFourCC() );
+                uint64_t    header( 8 );
+                uint32_t    from( 0 );
+                
+                if( length == 1 )
+                {
+                    length = stream.ReadBigEndianUInt64();
+                    header = 16;
+                }
+                
+                if( length < header )
+                {
+                    throw std::runtime_error( "Invalid box size for " + name );
+                }
+                
+                {
+                    BinaryDataStream      content( BinaryDataStream::ReadSlice( stream, static_cast< size_t >( length - header ) ) );
+                    const IMPL::Factory & factory( this->impl->GetFactory( parser, name ) );
+                    
+                    if( factory.reference == false )
+                    {
+                        std::shared_ptr< Box > box( ( factory.create != nullptr ) ? factory.create() : MakeShared< Box >( name ) );
+                        BinaryDataStream       data( content );
+                        
+                        parser.SetInfo( "iref", this );
+                        box->ReadData( parser, data );
+                        parser.SetInfo( "iref", nullptr );
+                        
+                        this->impl->_parsed.push_back( { table.types.size() + this->impl->_parsed.size(), box } );
+                        
+                        continue;
+                    }
+                    
+                    if( this->GetVersion() == 0 )
+                    {
+                        from = content.ReadBigEndianUInt16();
+                        
+                        for( uint16_t i = 0, n = content.ReadBigEndianUInt16(); i < n; i++ )
+                        {
+                            table.toItemIDs.push_back( content.ReadBigEndianUInt16() );
+                        }
+                    }
+                    else if( this->GetVersion() == 1 )
+                    {
+                        from = content.ReadBigEndianUInt32();
+                        
+                        for( uint16_t i = 0, n = content.ReadBigEndianUInt16(); i < n; i++ )
+                        {
+                            table.toItemIDs.push_back( content.ReadBigEndianUInt32() );
+                        }
+                    }
+                }
+                
+                table.types.push_back( FlatBoxTree::FourCC( name ) );
+                table.fromItemIDs.push_back( from );
+                table.toStarts.push_back( static_cast< uint32_t >( table.toItemIDs.size() ) );
+            }
+        }
+    }
+    
+    uint64_t IREF::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() );
+        size_t   row( 0 );
+        
+        this->impl->Sync();
+        
+        if( this->impl->_materialized == false )
+        {
+            for( ; row < this->impl->_table.types.size(); row++ )
+            {
+                size += this->impl->GetReferenceSize( this->GetVersion(), row );
+            }
+            
+            return size;
+        }
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            if( dynamic_cast< const SingleItemTypeReferenceBox * >( box.get() ) != nullptr )
+            {
+                size += this->impl->GetReferenceSize( this->GetVersion(), row++ );
+            }
+            else
+            {
+                size += box->GetSize();
+            }
+        }
+        
+        return size;
+    }
+    
+    void IREF::WriteData( BinaryOutputStream & stream ) const
+    {
+        size_t row( 0 );
+        
+        this->impl->Sync();
+        
+        FullBox::WriteData( stream );
+        
+        if( this->impl->_materialized == false )
+        {
+            for( ; row < this->impl->_table.types.size(); row++ )
+            {
+                this->impl->WriteReference( stream, this->GetVersion(), row );
+            }
+            
+            return;
+        }
+        
+        /* References are written with the IREF version, whatever the ID size of the box objects */
+        for( const auto & box: this->impl->_boxes )
+        {
+            if( dynamic_cast< const SingleItemTypeReferenceBox * >( box.get() ) != nullptr )
+            {
+                this->impl->WriteReference( stream, this->GetVersion(), row++ );
+            }
+            else
+            {
+                box->Write( stream );
+            }
+        }
     }
     
     void IREF::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
@@ -101,24 +267,253 @@ namespace ISOBMFF
     
     void IREF::AddBox( std::shared_ptr< Box > box )
     {
-        if( box != nullptr )
+        SingleItemTypeReferenceBox * reference( dynamic_cast< SingleItemTypeReferenceBox * >( box.get() ) );
+        
+        if( box == nullptr )
         {
-            this->impl->_boxes.push_back( box );
+            return;
+        }
+        
+        /* The table is rebuilt from the boxes when needed */
+        this->impl->Build();
+        this->impl->_boxes.push_back( box );
+        
+        if( reference != nullptr )
+        {
+            reference->SetModifiedFlag( this->impl->_modified );
+            
+            *( this->impl->_modified ) = true;
         }
     }
     
     std::vector< std::shared_ptr< Box > > IREF::GetBoxes() const
     {
+        this->impl->Materialize();
+        
         return this->impl->_boxes;
     }
     
-    IREF::IMPL::IMPL()
+    Span< const std::shared_ptr< Box > > IREF::GetBoxesSpan() const
+    {
+        this->impl->Materialize();
+        
+        return this->impl->_boxes;
+    }
+    
+    const IREF::Table & IREF::GetTable() const
+    {
+        this->impl->Sync();
+        
+        return this->impl->_table;
+    }
+    
+    IREF::IMPL::IMPL():
+        _materialized( true ),
+        _modified( std::make_shared< bool >( false ) )
     {}
-
+    
+    /*
+     * References report their changes to a single box, so a copy only takes
+     * the table, and creates its own reference boxes. Other boxes are shared,
+     * at their position.
+     */
     IREF::IMPL::IMPL( const IMPL & o ):
-        _boxes( o._boxes )
-    {}
-
+        _table( ( *( o._modified ) ) ? o.BuildTable() : o._table ),
+        _factories( o._factories ),
+        _parsed( o._parsed ),
+        _materialized( false ),
+        _modified( std::make_shared< bool >( false ) )
+    {
+        if( o._materialized == false )
+        {
+            return;
+        }
+        
+        for( size_t i = 0; i < o._boxes.size(); i++ )
+        {
+            if( dynamic_cast< const SingleItemTypeReferenceBox * >( o._boxes[ i ].get() ) == nullptr )
+            {
+                this->_parsed.push_back( { i, o._boxes[ i ] } );
+            }
+        }
+    }
+    
     IREF::IMPL::~IMPL()
     {}
+    
+    void IREF::IMPL::Materialize()
+    {
+        this->Build();
+    }
+    
+    void IREF::IMPL::Build()
+    {
+        size_t parsed( 0 );
+        size_t row( 0 );
+        
+        if( this->_materialized )
+        {
+            return;
+        }
+        
+        this->_boxes.reserve( this->_table.types.size() + this->_parsed.size() );
+        
+        while( row < this->_table.types.size() || parsed < this->_parsed.size() )
+        {
+            uint32_t                                      type;
+            std::string                                   name;
+            std::shared_ptr< SingleItemTypeReferenceBox > box;
+            
+            if( parsed < this->_parsed.size() && this->_parsed[ parsed ].first == this->_boxes.size() )
+            {
+                this->_boxes.push_back( this->_parsed[ parsed++ ].second );
+                
+                continue;
+            }
+            
+            type = this->_table.types[ row ];
+            name = std::string( { static_cast< char >( type >> 24 ), static_cast< char >( type >> 16 ), static_cast< char >( type >> 8 ), static_cast< char >( type ) } );
+            
+            for( const auto & factory: this->_factories )
+            {
+                if( factory.type == type && factory.create != nullptr )
+                {
+                    box = std::dynamic_pointer_cast< SingleItemTypeReferenceBox >( factory.create() );
+                    
+                    break;
+                }
+            }
+            
+            if( box == nullptr )
+            {
+                box = MakeShared< SingleItemTypeReferenceBox >( name );
+            }
+            
+            box->SetFromItemID( this->_table.fromItemIDs[ row ] );
+            
+            for( uint32_t j = this->_table.toStarts[ row ]; j < this->_table.toStarts[ row + 1 ]; j++ )
+            {
+                box->AddToItemID( this->_table.toItemIDs[ j ] );
+            }
+            
+            box->SetModifiedFlag( this->_modified );
+            
+            this->_boxes.push_back( box );
+            
+            row++;
+        }
+        
+        this->_parsed.clear();
+        
+        this->_materialized = true;
+    }
+    
+    void IREF::IMPL::Sync()
+    {
+        /* Boxes parsed right away are only written from the objects */
+        if( this->_materialized == false && this->_parsed.size() > 0 )
+        {
+            this->Build();
+        }
+        
+        /* The table is only rebuilt when created references were changed through their setters */
+        if( *( this->_modified ) == false )
+        {
+            return;
+        }
+        
+        this->_table         = this->BuildTable();
+        *( this->_modified ) = false;
+    }
+    
+    IREF::Table IREF::IMPL::BuildTable() const
+    {
+        Table table;
+        
+        table.toStarts.push_back( 0 );
+        
+        for( const auto & box: this->_boxes )
+        {
+            const SingleItemTypeReferenceBox * reference( dynamic_cast< const SingleItemTypeReferenceBox * >( box.get() ) );
+            
+            if( reference != nullptr )
+            {
+                Span< const uint32_t > to( reference->GetToItemIDsSpan() );
+                
+                table.types.push_back( FlatBoxTree::FourCC( reference->GetName() ) );
+                table.fromItemIDs.push_back( reference->GetFromItemID() );
+                table.toItemIDs.insert( table.toItemIDs.end(), to.begin(), to.end() );
+                table.toStarts.push_back( static_cast< uint32_t >( table.toItemIDs.size() ) );
+            }
+        }
+        
+        return table;
+    }
+    
+    uint64_t IREF::IMPL::GetReferenceSize( uint8_t version, size_t row ) const
+    {
+        uint64_t count( this->_table.toStarts[ row + 1 ] - this->_table.toStarts[ row ] );
+        
+        if( version == 0 )
+        {
+            return 8 + 4 + 2 * count;
+        }
+        else if( version == 1 )
+        {
+            return 8 + 6 + 4 * count;
+        }
+        
+        return 8;
+    }
+    
+    void IREF::IMPL::WriteReference( BinaryOutputStream & stream, uint8_t version, size_t row ) const
+    {
+        uint32_t count( this->_table.toStarts[ row + 1 ] - this->_table.toStarts[ row ] );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetReferenceSize( version, row ) ) );
+        stream.WriteBigEndianUInt32( this->_table.types[ row ] );
+        
+        if( version == 0 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->_table.fromItemIDs[ row ] ) );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( count ) );
+            
+            for( uint32_t j = this->_table.toStarts[ row ]; j < this->_table.toStarts[ row + 1 ]; j++ )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->_table.toItemIDs[ j ] ) );
+            }
+        }
+        else if( version == 1 )
+        {
+            stream.WriteBigEndianUInt32( this->_table.fromItemIDs[ row ] );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( count ) );
+            
+            for( uint32_t j = this->_table.toStarts[ row ]; j < this->_table.toStarts[ row + 1 ]; j++ )
+            {
+                stream.WriteBigEndianUInt32( this->_table.toItemIDs[ j ] );
+            }
+        }
+    }
+    
+    const IREF::IMPL::Factory & IREF::IMPL::GetFactory( const Parser & parser, const std::string & name )
+    {
+        uint32_t type( FlatBoxTree::FourCC( name ) );
+        Factory  factory;
+        
+        for( const auto & f: this->_factories )
+        {
+            if( f.type == type )
+            {
+                return f;
+            }
+        }
+        
+        factory.type      = type;
+        factory.create    = parser.GetBoxFactory( name );
+        factory.reference = factory.create == nullptr || std::dynamic_pointer_cast< SingleItemTypeReferenceBox >( factory.create() ) != nullptr;
+        
+        this->_factories.push_back( factory );
+        
+        return this->_factories.back();
+    }
 }
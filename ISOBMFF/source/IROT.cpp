@@ -30,10 +30,11 @@
 
 #include <ISOBMFF/IROT.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class IROT::IMPL
+    class IROT::IMPL: public ResourceAllocated
     {
         public:
             
@@ -91,6 +92,16 @@ namespace ISOBMFF
         this->SetAngle( u8 & 0x3 );
     }
     
+    uint64_t IROT::GetDataSize() const
+    {
+        return 1;
+    }
+    
+    void IROT::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteUInt8( this->GetAngle() & 0x3 );
+    }
+    
     std::vector< std::pair< std::string, std::string > > IROT::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
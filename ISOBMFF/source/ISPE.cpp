@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/ISPE.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class ISPE::IMPL
+    class ISPE::IMPL: public ResourceAllocated
     {
         public:
             
@@ -88,6 +89,19 @@ namespace ISOBMFF
         this->SetDisplayHeight( stream.ReadBigEndianUInt32() );
     }
     
+    uint64_t ISPE::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 8;
+    }
+    
+    void ISPE::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->GetDisplayWidth() );
+        stream.WriteBigEndianUInt32( this->GetDisplayHeight() );
+    }
+    
     std::vector< std::pair< std::string, std::string > > ISPE::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -0,0 +1,743 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        InPlaceEditor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/InPlaceEditor.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/ScatterGatherWriter.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/CO64.hpp>
+#include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <cstdio>
+
+namespace ISOBMFF
+{
+    class InPlaceEditor::IMPL
+    {
+        public:
+            
+            /*
+             * Position of a box in the tree.
+             */
+            struct Location
+            {
+                Container                           * parent;
+                std::vector< std::shared_ptr< Box > > siblings;
+                size_t                                index;
+            };
+            
+            /*
+             * Bytes of the file a replacement may be written to.
+             */
+            struct Extent
+            {
+                uint64_t offset;
+                uint64_t size;
+                bool     growable;
+            };
+            
+            /*
+             * Source extent of a top-level box, and the distance it moves
+             * by in the rewritten file (modulo 2^64).
+             */
+            struct Move
+            {
+                uint64_t offset;
+                uint64_t size;
+                uint64_t delta;
+            };
+            
+            struct ChunkOffsets
+            {
+                std::shared_ptr< ContainerBox > stbl;
+                std::shared_ptr< Box >          box;
+                std::vector< uint64_t >         source;
+            };
+            
+            /*
+             * Location of an item stored in the file itself
+             * (construction method 0, data reference index 0).
+             */
+            struct ItemOffsets
+            {
+                std::shared_ptr< ILOC >       iloc;
+                std::shared_ptr< ILOC::Item > item;
+                uint64_t                      baseOffset;
+                std::vector< uint64_t >       extentOffsets;
+            };
+            
+            IMPL( const std::string & path );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void     Load();
+            Location Find( const std::shared_ptr< Box > & box ) const;
+            Extent   GetExtent( const Location & location ) const;
+            void     WriteInPlace( const Extent & extent, const Box & replacement ) const;
+            void     Rewrite( const Location & location, std::shared_ptr< Box > replacement );
+            
+            static bool Find( const Container & container, const std::shared_ptr< Box > & box, Location & location );
+            static bool IsFreeSpace( const std::shared_ptr< Box > & box );
+            static bool Fits( const Extent & extent, uint64_t size );
+            static void WriteFreeBox( BinaryOutputStream & stream, uint64_t size );
+            static void FindOffsets( const Container & container, std::vector< ChunkOffsets > & chunks, std::vector< ItemOffsets > & items );
+            static void Relocate( const std::vector< Move > & moves, const ItemOffsets & item, uint64_t & baseOffset, std::vector< uint64_t > & extentOffsets );
+            static bool Widen( uint8_t & size, uint64_t value );
+            
+            static const Move & FindMove( const std::vector< Move > & moves, uint64_t offset );
+            
+            std::string             _path;
+            std::shared_ptr< File > _file;
+    };
+    
+    InPlaceEditor::InPlaceEditor( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    InPlaceEditor::InPlaceEditor( const InPlaceEditor & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    InPlaceEditor::InPlaceEditor( InPlaceEditor && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    InPlaceEditor::~InPlaceEditor()
+    {}
+    
+    InPlaceEditor & InPlaceEditor::operator =( InPlaceEditor o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( InPlaceEditor & o1, InPlaceEditor & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::shared_ptr< File > InPlaceEditor::GetFile() const
+    {
+        return this->impl->_file;
+    }
+    
+    bool InPlaceEditor::CanReplaceInPlace( const std::shared_ptr< Box > & box, const Box & replacement ) const
+    {
+        return IMPL::Fits( this->impl->GetExtent( this->impl->Find( box ) ), replacement.GetSize() );
+    }
+    
+    bool InPlaceEditor::Replace( const std::shared_ptr< Box > & box, std::shared_ptr< Box > replacement )
+    {
+        IMPL::Location location;
+        IMPL::Extent   extent;
+        
+        if( replacement == nullptr )
+        {
+            throw std::runtime_error( "Invalid box - No replacement box" );
+        }
+        
+        location = this->impl->Find( box );
+        extent   = this->impl->GetExtent( location );
+        
+        if( IMPL::Fits( extent, replacement->GetSize() ) )
+        {
+            this->impl->WriteInPlace( extent, *( replacement ) );
+            this->impl->Load();
+            
+            return true;
+        }
+        
+        this->impl->Rewrite( location, replacement );
+        this->impl->Load();
+        
+        return false;
+    }
+    
+    InPlaceEditor::IMPL::IMPL( const std::string & path ):
+        _path( path )
+    {
+        this->Load();
+    }
+    
+    InPlaceEditor::IMPL::IMPL( const IMPL & o ):
+        _path( o._path ),
+        _file( o._file )
+    {}
+    
+    InPlaceEditor::IMPL::~IMPL()
+    {}
+    
+    void InPlaceEditor::IMPL::Load()
+    {
+        Parser parser;
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( this->_path );
+        
+        this->_file = parser.GetFile();
+    }
+    
+    InPlaceEditor::IMPL::Location InPlaceEditor::IMPL::Find( const std::shared_ptr< Box > & box ) const
+    {
+        Location location;
+        
+        if( box == nullptr || Find( *( this->_file ), box, location ) == false )
+        {
+            throw std::runtime_error( "Invalid box - Not a box of the file" );
+        }
+        
+        if( box->GetName() == "mdat" )
+        {
+            throw std::runtime_error( "Invalid box - MDAT boxes cannot be replaced" );
+        }
+        
+        if( box->HasSourceRange() == false )
+        {
+            throw std::runtime_error( "Invalid box - Box was not read from the file" );
+        }
+        
+        return location;
+    }
+    
+    InPlaceEditor::IMPL::Extent InPlaceEditor::IMPL::GetExtent( const Location & location ) const
+    {
+        const std::shared_ptr< Box > & box( location.siblings[ location.index ] );
+        Extent                         extent;
+        size_t                         first( location.index );
+        size_t                         last( location.index );
+        
+        extent.offset   = box->GetSourceOffset();
+        extent.size     = box->GetSourceSize();
+        
+        while( first > 0 && IsFreeSpace( location.siblings[ first - 1 ] ) )
+        {
+            const std::shared_ptr< Box > & free( location.siblings[ first - 1 ] );
+            
+            if( free->GetSourceOffset() + free->GetSourceSize() != extent.offset )
+            {
+                break;
+            }
+            
+            extent.offset  = free->GetSourceOffset();
+            extent.size   += free->GetSourceSize();
+            
+            first--;
+        }
+        
+        while( last + 1 < location.siblings.size() && IsFreeSpace( location.siblings[ last + 1 ] ) )
+        {
+            const std::shared_ptr< Box > & free( location.siblings[ last + 1 ] );
+            
+            if( free->GetSourceOffset() != extent.offset + extent.size )
+            {
+                break;
+            }
+            
+            extent.size += free->GetSourceSize();
+            
+            last++;
+        }
+        
+        /* Nothing follows the last top-level box, so it can grow */
+        extent.growable =    location.parent == this->_file.get()
+                          && last + 1 == location.siblings.size()
+                          && this->_file->GetPadding().empty();
+        
+        return extent;
+    }
+    
+    void InPlaceEditor::IMPL::WriteInPlace( const Extent & extent, const Box & replacement ) const
+    {
+        ScatterGatherWriter stream( this->_path, ScatterGatherWriter::Mode::Update );
+        uint64_t            size( replacement.GetSize() );
+        
+        stream.Seek( numeric_cast< std::streamoff >( extent.offset ), BinaryOutputStream::SeekDirection::Begin );
+        replacement.Write( stream );
+        
+        if( size < extent.size )
+        {
+            /* A FREE box needs at least 8 bytes, so a growable extent may grow a little */
+            WriteFreeBox( stream, std::max< uint64_t >( extent.size - size, 8 ) );
+        }
+        
+        stream.Flush();
+    }
+    
+    void InPlaceEditor::IMPL::Rewrite( const Location & location, std::shared_ptr< Box > replacement )
+    {
+        std::shared_ptr< Box >                 box( location.siblings[ location.index ] );
+        std::string                            path( this->_path + ".tmp" );
+        std::vector< std::function< void() > > undo;
+        std::vector< ChunkOffsets >            chunks;
+        std::vector< ItemOffsets >             items;
+        std::vector< Move >                    moves;
+        std::vector< uint64_t >                offsets;
+        uint64_t                               base;
+        
+        if( replacement != box )
+        {
+            ContainerBox * parent( dynamic_cast< ContainerBox * >( location.parent ) );
+            
+            if( parent == nullptr || parent->ReplaceBox( box, replacement ) == false )
+            {
+                throw std::runtime_error( "Unsupported replacement - The parent box is not a container box" );
+            }
+            
+            undo.push_back( [ = ]() { parent->ReplaceBox( replacement, box ); } );
+        }
+        
+        try
+        {
+            FindOffsets( *( this->_file ), chunks, items );
+            
+            /*
+             * Top-level boxes keep their order, but move by the size
+             * difference of the replacement. Promoting a STCO box to CO64,
+             * or widening ILOC offsets, grows a box again, so the layout
+             * is computed until nothing else grows.
+             */
+            while( true )
+            {
+                bool     grown( false );
+                uint64_t size( 0 );
+                
+                moves.clear();
+                
+                for( const auto & top: this->_file->GetBoxesSpan() )
+                {
+                    /* A replaced top-level box takes the place of the original one */
+                    const std::shared_ptr< Box > & source( ( top == replacement ) ? box : top );
+                    
+                    if( source->HasSourceRange() )
+                    {
+                        moves.push_back( { source->GetSourceOffset(), source->GetSourceSize(), size - source->GetSourceOffset() } );
+                    }
+                    
+                    size += top->GetSize();
+                }
+                
+                std::sort
+                (
+                    moves.begin(),
+                    moves.end(),
+                    []( const Move & m1, const Move & m2 )
+                    {
+                        return m1.offset < m2.offset;
+                    }
+                );
+                
+                for( auto & table: chunks )
+                {
+                    std::shared_ptr< STCO > stco( std::dynamic_pointer_cast< STCO >( table.box ) );
+                    std::shared_ptr< CO64 > co64;
+                    
+                    if( stco == nullptr )
+                    {
+                        continue;
+                    }
+                    
+                    offsets.clear();
+                    
+                    for( uint64_t offset: table.source )
+                    {
+                        offsets.push_back( offset + FindMove( moves, offset ).delta );
+                    }
+                    
+                    if( offsets.empty() || *( std::max_element( offsets.begin(), offsets.end() ) ) <= ( std::numeric_limits< uint32_t >::max )() )
+                    {
+                        continue;
+                    }
+                    
+                    co64 = std::make_shared< CO64 >();
+                    
+                    co64->SetVersion( stco->GetVersion() );
+                    co64->SetFlags( stco->GetFlags() );
+                    
+                    for( uint64_t offset: table.source )
+                    {
+                        co64->AddChunkOffset( offset );
+                    }
+                    
+                    table.stbl->ReplaceBox( stco, co64 );
+                    undo.push_back( [ = ]() { table.stbl->ReplaceBox( co64, stco ); } );
+                    
+                    table.box = co64;
+                    grown     = true;
+                }
+                
+                for( const auto & item: items )
+                {
+                    uint8_t baseOffsetSize( item.iloc->GetBaseOffsetSize() );
+                    uint8_t offsetSize( item.iloc->GetOffsetSize() );
+                    
+                    Relocate( moves, item, base, offsets );
+                    
+                    bool widened( Widen( baseOffsetSize, base ) );
+                    
+                    for( uint64_t offset: offsets )
+                    {
+                        widened = Widen( offsetSize, offset ) || widened;
+                    }
+                    
+                    if( widened )
+                    {
+                        std::shared_ptr< ILOC > iloc( item.iloc );
+                        uint8_t                 oldBaseOffsetSize( iloc->GetBaseOffsetSize() );
+                        uint8_t                 oldOffsetSize( iloc->GetOffsetSize() );
+                        
+                        iloc->SetBaseOffsetSize( baseOffsetSize );
+                        iloc->SetOffsetSize( offsetSize );
+                        undo.push_back( [ = ]() { iloc->SetBaseOffsetSize( oldBaseOffsetSize ); iloc->SetOffsetSize( oldOffsetSize ); } );
+                        
+                        grown = true;
+                    }
+                }
+                
+                if( grown == false )
+                {
+                    break;
+                }
+            }
+            
+            for( const auto & table: chunks )
+            {
+                std::shared_ptr< STCO > stco( std::dynamic_pointer_cast< STCO >( table.box ) );
+                std::shared_ptr< CO64 > co64( std::dynamic_pointer_cast< CO64 >( table.box ) );
+                
+                for( size_t i = 0; i < table.source.size(); i++ )
+                {
+                    uint64_t offset( table.source[ i ] + FindMove( moves, table.source[ i ] ).delta );
+                    
+                    if( stco != nullptr )
+                    {
+                        stco->SetChunkOffset( i, static_cast< uint32_t >( offset ) );
+                    }
+                    else
+                    {
+                        co64->SetChunkOffset( i, offset );
+                    }
+                }
+                
+                undo.push_back
+                (
+                    [ = ]()
+                    {
+                        for( size_t i = 0; i < table.source.size(); i++ )
+                        {
+                            if( stco != nullptr )
+                            {
+                                stco->SetChunkOffset( i, static_cast< uint32_t >( table.source[ i ] ) );
+                            }
+                            else
+                            {
+                                co64->SetChunkOffset( i, table.source[ i ] );
+                            }
+                        }
+                    }
+                );
+            }
+            
+            for( const auto & item: items )
+            {
+                std::vector< std::shared_ptr< ILOC::Item::Extent > > extents( item.item->GetExtents() );
+                
+                Relocate( moves, item, base, offsets );
+                
+                item.item->SetBaseOffset( base );
+                
+                for( size_t i = 0; i < extents.size(); i++ )
+                {
+                    extents[ i ]->SetOffset( offsets[ i ] );
+                }
+                
+                undo.push_back
+                (
+                    [ = ]()
+                    {
+                        item.item->SetBaseOffset( item.baseOffset );
+                        
+                        for( size_t i = 0; i < extents.size(); i++ )
+                        {
+                            extents[ i ]->SetOffset( item.extentOffsets[ i ] );
+                        }
+                    }
+                );
+            }
+            
+            {
+                ScatterGatherWriter stream( path, this->_path );
+                
+                for( const auto & top: this->_file->GetBoxesSpan() )
+                {
+                    top->Write( stream );
+                }
+                
+                stream.Flush();
+            }
+            
+            #ifdef _WIN32
+            std::remove( this->_path.c_str() );
+            #endif
+            
+            if( std::rename( path.c_str(), this->_path.c_str() ) != 0 )
+            {
+                throw std::runtime_error( "Cannot replace file: " + this->_path );
+            }
+        }
+        catch( ... )
+        {
+            std::remove( path.c_str() );
+            
+            /* The tree is restored, so the editor can still be used */
+            for( auto it = undo.rbegin(); it != undo.rend(); ++it )
+            {
+                ( *( it ) )();
+            }
+            
+            throw;
+        }
+    }
+    
+    bool InPlaceEditor::IMPL::Find( const Container & container, const std::shared_ptr< Box > & box, Location & location )
+    {
+        std::vector< std::shared_ptr< Box > > boxes( container.GetBoxes() );
+        
+        for( size_t i = 0; i < boxes.size(); i++ )
+        {
+            const Container * child( dynamic_cast< const Container * >( boxes[ i ].get() ) );
+            
+            if( boxes[ i ] == box )
+            {
+                location.parent   = const_cast< Container * >( &container );
+                location.siblings = std::move( boxes );
+                location.index    = i;
+                
+                return true;
+            }
+            
+            if( child != nullptr && Find( *( child ), box, location ) )
+            {
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    bool InPlaceEditor::IMPL::IsFreeSpace( const std::shared_ptr< Box > & box )
+    {
+        return box->HasSourceRange() && ( box->GetName() == "free" || box->GetName() == "skip" );
+    }
+    
+    bool InPlaceEditor::IMPL::Fits( const Extent & extent, uint64_t size )
+    {
+        return extent.growable || size == extent.size || size + 8 <= extent.size;
+    }
+    
+    void InPlaceEditor::IMPL::WriteFreeBox( BinaryOutputStream & stream, uint64_t size )
+    {
+        if( size > ( std::numeric_limits< uint32_t >::max )() )
+        {
+            stream.WriteBigEndianUInt32( 1 );
+            stream.WriteFourCC( "free" );
+            stream.WriteBigEndianUInt64( size );
+            
+            size -= 8;
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( size ) );
+            stream.WriteFourCC( "free" );
+        }
+        
+        stream.WriteZeros( numeric_cast< size_t >( size - 8 ) );
+    }
+    
+    void InPlaceEditor::IMPL::FindOffsets( const Container & container, std::vector< ChunkOffsets > & chunks, std::vector< ItemOffsets > & items )
+    {
+        for( const auto & box: container.GetBoxes() )
+        {
+            std::shared_ptr< ILOC >         iloc( std::dynamic_pointer_cast< ILOC >( box ) );
+            std::shared_ptr< ContainerBox > stbl( ( box->GetName() == "stbl" ) ? std::dynamic_pointer_cast< ContainerBox >( box ) : nullptr );
+            const Container               * child( dynamic_cast< const Container * >( box.get() ) );
+            
+            if( iloc != nullptr )
+            {
+                for( const auto & item: iloc->GetItemsSpan() )
+                {
+                    ItemOffsets offsets;
+                    
+                    if( item->GetConstructionMethod() != 0 || item->GetDataReferenceIndex() != 0 )
+                    {
+                        continue;
+                    }
+                    
+                    offsets.iloc       = iloc;
+                    offsets.item       = item;
+                    offsets.baseOffset = item->GetBaseOffset();
+                    
+                    for( const auto & extent: item->GetExtentsSpan() )
+                    {
+                        offsets.extentOffsets.push_back( extent->GetOffset() );
+                    }
+                    
+                    items.push_back( std::move( offsets ) );
+                }
+            }
+            
+            if( stbl != nullptr )
+            {
+                std::shared_ptr< STCO > stco( stbl->GetTypedBox< STCO >( "stco" ) );
+                std::shared_ptr< CO64 > co64( stbl->GetTypedBox< CO64 >( "co64" ) );
+                ChunkOffsets            table;
+                
+                table.stbl = stbl;
+                
+                if( stco != nullptr )
+                {
+                    table.box = stco;
+                    
+                    for( size_t i = 0; i < stco->GetEntryCount(); i++ )
+                    {
+                        table.source.push_back( stco->GetChunkOffset( i ) );
+                    }
+                    
+                    chunks.push_back( std::move( table ) );
+                }
+                else if( co64 != nullptr )
+                {
+                    table.box = co64;
+                    
+                    for( size_t i = 0; i < co64->GetEntryCount(); i++ )
+                    {
+                        table.source.push_back( co64->GetChunkOffset( i ) );
+                    }
+                    
+                    chunks.push_back( std::move( table ) );
+                }
+            }
+            
+            if( child != nullptr && box->GetName() != "mdat" )
+            {
+                FindOffsets( *( child ), chunks, items );
+            }
+        }
+    }
+    
+    void InPlaceEditor::IMPL::Relocate( const std::vector< Move > & moves, const ItemOffsets & item, uint64_t & baseOffset, std::vector< uint64_t > & extentOffsets )
+    {
+        std::vector< uint64_t > deltas;
+        
+        baseOffset    = item.baseOffset;
+        extentOffsets = item.extentOffsets;
+        
+        for( uint64_t offset: item.extentOffsets )
+        {
+            deltas.push_back( FindMove( moves, item.baseOffset + offset ).delta );
+        }
+        
+        if( deltas.empty() )
+        {
+            return;
+        }
+        
+        /* Extents usually share the same top-level box, so only the base offset moves */
+        if( item.baseOffset != 0 && std::all_of( deltas.begin(), deltas.end(), [ & ]( uint64_t delta ) { return delta == deltas[ 0 ]; } ) )
+        {
+            baseOffset += deltas[ 0 ];
+            
+            return;
+        }
+        
+        for( size_t i = 0; i < extentOffsets.size(); i++ )
+        {
+            extentOffsets[ i ] += deltas[ i ];
+        }
+    }
+    
+    bool InPlaceEditor::IMPL::Widen( uint8_t & size, uint64_t value )
+    {
+        if( value == 0 || size == 8 )
+        {
+            return false;
+        }
+        
+        if( value > ( std::numeric_limits< uint32_t >::max )() )
+        {
+            size = 8;
+            
+            return true;
+        }
+        
+        if( size == 0 )
+        {
+            size = 4;
+            
+            return true;
+        }
+        
+        return false;
+    }
+    
+    const InPlaceEditor::IMPL::Move & InPlaceEditor::IMPL::FindMove( const std::vector< Move > & moves, uint64_t offset )
+    {
+        auto it
+        (
+            std::upper_bound
+            (
+                moves.begin(),
+                moves.end(),
+                offset,
+                []( uint64_t value, const Move & move )
+                {
+                    return value < move.offset;
+                }
+            )
+        );
+        
+        if( it == moves.begin() || offset - ( it - 1 )->offset >= ( it - 1 )->size )
+        {
+            throw std::runtime_error( "Invalid offset - Not inside a top-level box" );
+        }
+        
+        return *( it - 1 );
+    }
+}
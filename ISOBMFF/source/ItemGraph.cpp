@@ -0,0 +1,348 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ItemGraph.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ItemGraph.hpp>
+#include <ISOBMFF/PITM.hpp>
+#include <ISOBMFF/IINF.hpp>
+#include <ISOBMFF/IREF.hpp>
+#include <ISOBMFF/IPCO.hpp>
+#include <ISOBMFF/IPMA.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/FlatBoxTree.hpp>
+#include <unordered_map>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    class ItemGraph::IMPL
+    {
+        public:
+            
+            class Item
+            {
+                public:
+                    
+                    std::shared_ptr< INFE >               _info;
+                    size_t                                _location = NoLocation;
+                    std::vector< std::shared_ptr< Box > > _properties;
+            };
+            
+            typedef std::unordered_map< uint32_t, std::vector< uint32_t > > Edges;
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            Item & GetItem( uint32_t itemID );
+            
+            uint32_t                              _primaryItemID;
+            std::vector< uint32_t >               _itemIDs;
+            std::unordered_map< uint32_t, Item >  _items;
+            std::shared_ptr< ILOC >               _iloc;
+            std::unordered_map< uint32_t, Edges > _forward;
+            std::unordered_map< uint32_t, Edges > _reverse;
+            
+            static constexpr size_t                            NoLocation = SIZE_MAX;
+            static const std::vector< uint32_t >               NoItems;
+            static const std::vector< std::shared_ptr< Box > > NoProperties;
+    };
+    
+    constexpr size_t                            ItemGraph::IMPL::NoLocation;
+    const std::vector< uint32_t >               ItemGraph::IMPL::NoItems;
+    const std::vector< std::shared_ptr< Box > > ItemGraph::IMPL::NoProperties;
+    
+    ItemGraph::ItemGraph():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    ItemGraph::ItemGraph( const META & meta ):
+        impl( std::make_unique< IMPL >() )
+    {
+        std::shared_ptr< PITM >         pitm( meta.GetTypedBox< PITM >( "pitm" ) );
+        std::shared_ptr< IINF >         iinf( meta.GetTypedBox< IINF >( "iinf" ) );
+        std::shared_ptr< ILOC >         iloc( meta.GetTypedBox< ILOC >( "iloc" ) );
+        std::shared_ptr< IREF >         iref( meta.GetTypedBox< IREF >( "iref" ) );
+        std::shared_ptr< ContainerBox > iprp( meta.GetTypedBox< ContainerBox >( "iprp" ) );
+        
+        if( pitm != nullptr )
+        {
+            this->impl->_primaryItemID = pitm->GetItemID();
+        }
+        
+        if( iinf != nullptr )
+        {
+            for( const auto & infe: iinf->GetEntriesSpan() )
+            {
+                this->impl->GetItem( infe->GetItemID() )._info = infe;
+            }
+        }
+        
+        if( iloc != nullptr )
+        {
+            this->impl->_iloc = iloc;
+            
+            const std::vector< uint32_t > & itemIDs( iloc->GetTable().itemIDs );
+            
+            /* Only the table row is kept, so ILOC items are created on demand, one at a time */
+            for( size_t i = 0; i < itemIDs.size(); i++ )
+            {
+                this->impl->GetItem( itemIDs[ i ] )._location = i;
+            }
+        }
+        
+        if( iref != nullptr )
+        {
+            const IREF::Table & table( iref->GetTable() );
+            
+            for( size_t i = 0; i < table.types.size(); i++ )
+            {
+                uint32_t      from( table.fromItemIDs[ i ] );
+                IMPL::Edges & forward( this->impl->_forward[ table.types[ i ] ] );
+                IMPL::Edges & reverse( this->impl->_reverse[ table.types[ i ] ] );
+                
+                for( uint32_t j = table.toStarts[ i ]; j < table.toStarts[ i + 1 ]; j++ )
+                {
+                    forward[ from ].push_back( table.toItemIDs[ j ] );
+                    reverse[ table.toItemIDs[ j ] ].push_back( from );
+                }
+            }
+        }
+        
+        if( iprp != nullptr )
+        {
+            std::shared_ptr< IPCO > ipco( iprp->GetTypedBox< IPCO >( "ipco" ) );
+            
+            if( ipco != nullptr )
+            {
+                iprp->ForEachBox
+                (
+                    "ipma",
+                    [ & ]( const std::shared_ptr< Box > & box )
+                    {
+                        const IPMA * ipma( dynamic_cast< const IPMA * >( box.get() ) );
+                        
+                        if( ipma == nullptr )
+                        {
+                            return;
+                        }
+                        
+                        {
+                            const IPMA::Table & table( ipma->GetTable() );
+                            
+                            for( size_t i = 0; i < table.itemIDs.size(); i++ )
+                            {
+                                auto & properties( this->impl->GetItem( table.itemIDs[ i ] )._properties );
+                                
+                                for( uint32_t j = table.associationStarts[ i ]; j < table.associationStarts[ i + 1 ]; j++ )
+                                {
+                                    std::shared_ptr< Box > property;
+                                    
+                                    if( table.propertyIndices[ j ] == 0 )
+                                    {
+                                        continue;
+                                    }
+                                    
+                                    property = ipco->GetPropertyAtIndex( table.propertyIndices[ j ] - 1U );
+                                    
+                                    if( property != nullptr )
+                                    {
+                                        properties.push_back( property );
+                                    }
+                                }
+                            }
+                        }
+                    }
+                );
+            }
+        }
+    }
+    
+    ItemGraph::ItemGraph( const ItemGraph & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ItemGraph::ItemGraph( ItemGraph && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ItemGraph::~ItemGraph()
+    {}
+    
+    ItemGraph & ItemGraph::operator =( ItemGraph o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ItemGraph & o1, ItemGraph & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t ItemGraph::GetPrimaryItemID() const
+    {
+        return this->impl->_primaryItemID;
+    }
+    
+    const std::vector< uint32_t > & ItemGraph::GetItemIDs() const
+    {
+        return this->impl->_itemIDs;
+    }
+    
+    bool ItemGraph::HasItem( uint32_t itemID ) const
+    {
+        return this->impl->_items.find( itemID ) != this->impl->_items.end();
+    }
+    
+    std::string ItemGraph::GetItemType( uint32_t itemID ) const
+    {
+        std::shared_ptr< INFE > info( this->GetInfo( itemID ) );
+        
+        return ( info != nullptr ) ? info->GetItemType() : "";
+    }
+    
+    std::shared_ptr< INFE > ItemGraph::GetInfo( uint32_t itemID ) const
+    {
+        auto it = this->impl->_items.find( itemID );
+        
+        return ( it != this->impl->_items.end() ) ? it->second._info : nullptr;
+    }
+    
+    std::shared_ptr< ILOC::Item > ItemGraph::GetLocation( uint32_t itemID ) const
+    {
+        auto it = this->impl->_items.find( itemID );
+        
+        if( it == this->impl->_items.end() || it->second._location == IMPL::NoLocation )
+        {
+            return nullptr;
+        }
+        
+        return this->impl->_iloc->GetItemAtIndex( it->second._location );
+    }
+    
+    const std::vector< std::shared_ptr< Box > > & ItemGraph::GetProperties( uint32_t itemID ) const
+    {
+        auto it = this->impl->_items.find( itemID );
+        
+        return ( it != this->impl->_items.end() ) ? it->second._properties : IMPL::NoProperties;
+    }
+    
+    std::shared_ptr< Box > ItemGraph::GetProperty( uint32_t itemID, const std::string & type ) const
+    {
+        for( const auto & property: this->GetProperties( itemID ) )
+        {
+            if( property->GetName() == type )
+            {
+                return property;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    const std::vector< uint32_t > & ItemGraph::GetReferences( uint32_t fromItemID, const std::string & type ) const
+    {
+        if( type.length() != 4 )
+        {
+            return IMPL::NoItems;
+        }
+        
+        auto edges = this->impl->_forward.find( FlatBoxTree::FourCC( type ) );
+        
+        if( edges != this->impl->_forward.end() )
+        {
+            auto it = edges->second.find( fromItemID );
+            
+            if( it != edges->second.end() )
+            {
+                return it->second;
+            }
+        }
+        
+        return IMPL::NoItems;
+    }
+    
+    const std::vector< uint32_t > & ItemGraph::GetReferencingItems( uint32_t toItemID, const std::string & type ) const
+    {
+        if( type.length() != 4 )
+        {
+            return IMPL::NoItems;
+        }
+        
+        auto edges = this->impl->_reverse.find( FlatBoxTree::FourCC( type ) );
+        
+        if( edges != this->impl->_reverse.end() )
+        {
+            auto it = edges->second.find( toItemID );
+            
+            if( it != edges->second.end() )
+            {
+                return it->second;
+            }
+        }
+        
+        return IMPL::NoItems;
+    }
+    
+    ItemGraph::IMPL::IMPL():
+        _primaryItemID( 0 )
+    {}
+    
+    ItemGraph::IMPL::IMPL( const IMPL & o ):
+        _primaryItemID( o._primaryItemID ),
+        _itemIDs( o._itemIDs ),
+        _items( o._items ),
+        _iloc( o._iloc ),
+        _forward( o._forward ),
+        _reverse( o._reverse )
+    {}
+    
+    ItemGraph::IMPL::~IMPL()
+    {}
+    
+    ItemGraph::IMPL::Item & ItemGraph::IMPL::GetItem( uint32_t itemID )
+    {
+        auto it = this->_items.find( itemID );
+        
+        if( it == this->_items.end() )
+        {
+            this->_itemIDs.push_back( itemID );
+            
+            it = this->_items.emplace( itemID, Item() ).first;
+        }
+        
+        return it->second;
+    }
+}
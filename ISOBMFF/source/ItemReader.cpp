@@ -0,0 +1,363 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ItemReader.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    class ItemReader::IMPL
+    {
+        public:
+            
+            class Item
+            {
+                public:
+                    
+                    std::vector< Range > _ranges;
+                    std::string          _error;
+            };
+            
+            class Piece
+            {
+                public:
+                    
+                    uint64_t  _offset;
+                    uint64_t  _length;
+                    uint8_t * _destination;
+            };
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            const Item & GetItem( uint32_t itemID ) const;
+            
+            static uint64_t GetLength( const Range & range, uint64_t sourceSize );
+            
+            std::unordered_map< uint32_t, Item > _items;
+            std::vector< uint8_t >               _idat;
+    };
+    
+    ItemReader::ItemReader():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    ItemReader::ItemReader( const META & meta ):
+        impl( std::make_unique< IMPL >() )
+    {
+        std::shared_ptr< ILOC > iloc( meta.GetTypedBox< ILOC >( "iloc" ) );
+        std::shared_ptr< Box >  idat( meta.GetBox( "idat" ) );
+        
+        if( idat != nullptr )
+        {
+            this->impl->_idat = idat->GetData();
+        }
+        
+        if( iloc == nullptr )
+        {
+            return;
+        }
+        
+        {
+            const ILOC::Table & table( iloc->GetTable() );
+            
+            for( size_t i = 0; i < table.itemIDs.size(); i++ )
+            {
+                IMPL::Item & entry( this->impl->_items[ table.itemIDs[ i ] ] );
+                uint8_t      method( table.constructionMethods[ i ] );
+                uint64_t     base( table.baseOffsets[ i ] );
+                
+                entry._ranges.clear();
+                entry._error.clear();
+                
+                if( table.dataReferenceIndices[ i ] != 0 )
+                {
+                    entry._error = "Unsupported item location - External data reference";
+                    
+                    continue;
+                }
+                
+                if( method > 1 )
+                {
+                    entry._error = "Unsupported item location - Construction method " + std::to_string( method );
+                    
+                    continue;
+                }
+                
+                entry._ranges.reserve( table.extentStarts[ i + 1 ] - table.extentStarts[ i ] );
+                
+                for( uint32_t j = table.extentStarts[ i ]; j < table.extentStarts[ i + 1 ]; j++ )
+                {
+                    if( table.extentOffsets[ j ] > UINT64_MAX - base )
+                    {
+                        entry._ranges.clear();
+                        
+                        entry._error = "Invalid item location - Extent offset overflow";
+                        
+                        break;
+                    }
+                    
+                    entry._ranges.push_back( { ( method == 1 ) ? Source::IDAT : Source::File, base + table.extentOffsets[ j ], table.extentLengths[ j ] } );
+                }
+            }
+        }
+    }
+    
+    ItemReader::ItemReader( const ItemReader & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ItemReader::ItemReader( ItemReader && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ItemReader::~ItemReader()
+    {}
+    
+    ItemReader & ItemReader::operator =( ItemReader o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ItemReader & o1, ItemReader & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    bool ItemReader::HasItem( uint32_t itemID ) const
+    {
+        return this->impl->_items.find( itemID ) != this->impl->_items.end();
+    }
+    
+    const std::vector< ItemReader::Range > & ItemReader::GetRanges( uint32_t itemID ) const
+    {
+        return this->impl->GetItem( itemID )._ranges;
+    }
+    
+    Span< const uint8_t > ItemReader::GetIDATData() const
+    {
+        return this->impl->_idat;
+    }
+    
+    std::vector< Span< const uint8_t > > ItemReader::GetItemSpans( uint32_t itemID, Span< const uint8_t > file ) const
+    {
+        const IMPL::Item                   & item( this->impl->GetItem( itemID ) );
+        std::vector< Span< const uint8_t > > spans;
+        
+        spans.reserve( item._ranges.size() );
+        
+        for( const auto & range: item._ranges )
+        {
+            Span< const uint8_t > source( ( range.source == Source::IDAT ) ? Span< const uint8_t >( this->impl->_idat ) : file );
+            uint64_t              length( IMPL::GetLength( range, source.size() ) );
+            
+            spans.push_back( source.subspan( numeric_cast< size_t >( range.offset ), numeric_cast< size_t >( length ) ) );
+        }
+        
+        return spans;
+    }
+    
+    std::vector< uint8_t > ItemReader::ReadItem( uint32_t itemID, BinaryStream & stream ) const
+    {
+        std::vector< std::vector< uint8_t > > data( this->ReadItems( { itemID }, stream ) );
+        
+        return std::move( data[ 0 ] );
+    }
+    
+    std::vector< std::vector< uint8_t > > ItemReader::ReadItems( const std::vector< uint32_t > & itemIDs, BinaryStream & stream ) const
+    {
+        std::vector< std::vector< uint8_t > > data( itemIDs.size() );
+        std::vector< IMPL::Piece >            pieces;
+        std::vector< uint8_t >                buffer;
+        uint64_t                              fileSize( UINT64_MAX );
+        
+        for( size_t i = 0; i < itemIDs.size(); i++ )
+        {
+            const IMPL::Item      & item( this->impl->GetItem( itemIDs[ i ] ) );
+            std::vector< uint64_t > lengths;
+            uint64_t                total( 0 );
+            
+            lengths.reserve( item._ranges.size() );
+            
+            for( const auto & range: item._ranges )
+            {
+                if( range.source == Source::IDAT )
+                {
+                    lengths.push_back( IMPL::GetLength( range, this->impl->_idat.size() ) );
+                }
+                else
+                {
+                    if( range.length == 0 && fileSize == UINT64_MAX )
+                    {
+                        stream.Seek( 0, BinaryStream::SeekDirection::End );
+                        
+                        fileSize = stream.Tell();
+                    }
+                    
+                    lengths.push_back( IMPL::GetLength( range, fileSize ) );
+                }
+                
+                total += lengths.back();
+            }
+            
+            data[ i ].resize( numeric_cast< size_t >( total ) );
+            
+            {
+                uint8_t * destination( data[ i ].data() );
+                
+                for( size_t j = 0; j < item._ranges.size(); j++ )
+                {
+                    const Range & range( item._ranges[ j ] );
+                    
+                    if( lengths[ j ] == 0 )
+                    {
+                        continue;
+                    }
+                    
+                    if( range.source == Source::IDAT )
+                    {
+                        memcpy( destination, this->impl->_idat.data() + range.offset, numeric_cast< size_t >( lengths[ j ] ) );
+                    }
+                    else
+                    {
+                        pieces.push_back( { range.offset, lengths[ j ], destination } );
+                    }
+                    
+                    destination += lengths[ j ];
+                }
+            }
+        }
+        
+        std::sort
+        (
+            pieces.begin(),
+            pieces.end(),
+            []( const IMPL::Piece & p1, const IMPL::Piece & p2 )
+            {
+                return p1._offset < p2._offset;
+            }
+        );
+        
+        for( size_t first = 0; first < pieces.size(); )
+        {
+            size_t   last( first + 1 );
+            uint64_t start( pieces[ first ]._offset );
+            uint64_t end( start + pieces[ first ]._length );
+            
+            while( last < pieces.size() && pieces[ last ]._offset <= end )
+            {
+                end = std::max( end, pieces[ last ]._offset + pieces[ last ]._length );
+                
+                last++;
+            }
+            
+            stream.Seek( start, BinaryStream::SeekDirection::Begin );
+            
+            if( last - first == 1 )
+            {
+                stream.Read( pieces[ first ]._destination, numeric_cast< size_t >( end - start ) );
+            }
+            else
+            {
+                buffer.resize( numeric_cast< size_t >( end - start ) );
+                stream.Read( buffer.data(), buffer.size() );
+                
+                for( size_t i = first; i < last; i++ )
+                {
+                    memcpy( pieces[ i ]._destination, buffer.data() + ( pieces[ i ]._offset - start ), numeric_cast< size_t >( pieces[ i ]._length ) );
+                }
+            }
+            
+            first = last;
+        }
+        
+        return data;
+    }
+    
+    ItemReader::IMPL::IMPL()
+    {}
+    
+    ItemReader::IMPL::IMPL( const IMPL & o ):
+        _items( o._items ),
+        _idat(  o._idat )
+    {}
+    
+    ItemReader::IMPL::~IMPL()
+    {}
+    
+    const ItemReader::IMPL::Item & ItemReader::IMPL::GetItem( uint32_t itemID ) const
+    {
+        auto it = this->_items.find( itemID );
+        
+        if( it == this->_items.end() )
+        {
+            throw std::runtime_error( "Invalid item ID - No location for item " + std::to_string( itemID ) );
+        }
+        
+        if( it->second._error.length() > 0 )
+        {
+            throw std::runtime_error( it->second._error );
+        }
+        
+        return it->second;
+    }
+    
+    uint64_t ItemReader::IMPL::GetLength( const Range & range, uint64_t sourceSize )
+    {
+        if( range.offset > sourceSize )
+        {
+            throw std::runtime_error( "Invalid item extent - Offset is out of bounds" );
+        }
+        
+        if( range.length == 0 )
+        {
+            return sourceSize - range.offset;
+        }
+        
+        if( range.length > sourceSize - range.offset )
+        {
+            throw std::runtime_error( "Invalid item extent - Length is out of bounds" );
+        }
+        
+        return range.length;
+    }
+}
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class MDHD::IMPL
+    class MDHD::IMPL: public ResourceAllocated
     {
         public:
 
@@ -144,6 +145,44 @@ namespace ISOBMFF
        this->SetPredefined( u16 );
     }
 
+    uint64_t MDHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 28 : 16 ) + 4;
+    }
+
+    void MDHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        uint16_t u16;
+
+        FullBox::WriteData( stream );
+
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->GetCreationTime() );
+            stream.WriteBigEndianUInt64( this->GetModificationTime() );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt64( this->GetDuration() );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetCreationTime() ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetModificationTime() ) );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetDuration() ) );
+        }
+
+        u16 = static_cast< uint16_t >
+        (
+              ( ( this->GetPad()       & 0x01 )    << 15 )
+            | ( ( this->GetLanguage0() & 0b11111 ) << 10 )
+            | ( ( this->GetLanguage1() & 0b11111 ) <<  5 )
+            | ( ( this->GetLanguage2() & 0b11111 ) <<  0 )
+        );
+
+        stream.WriteBigEndianUInt16( u16 );
+        stream.WriteBigEndianUInt16( this->GetPredefined() );
+    }
+
     void MDHD::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -30,11 +30,12 @@
 
 #include <ISOBMFF/META.hpp>
 #include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class META::IMPL
+    class META::IMPL: public ResourceAllocated
     {
         public:
             
@@ -44,6 +45,7 @@ namespace ISOBMFF
             
             bool                                  _isFullBox;
             std::vector< std::shared_ptr< Box > > _boxes;
+            std::vector< uint8_t >                _padding;
     };
     
     META::META():
@@ -96,9 +98,40 @@ namespace ISOBMFF
             FullBox::ReadData( parser, stream );
         }
         
+        container.SetSourceRange( this->GetSourceOffset(), this->GetSourceSize(), this->GetSourceHeaderSize() );
         container.ReadData( parser, stream );
         
-        this->impl->_boxes = container.GetBoxes();
+        this->impl->_boxes   = container.GetBoxes();
+        this->impl->_padding = container.GetPadding();
+    }
+    
+    uint64_t META::GetDataSize() const
+    {
+        uint64_t size( ( this->impl->_isFullBox ) ? FullBox::GetDataSize() : 0 );
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            size += box->GetSize();
+        }
+        
+        size += this->impl->_padding.size();
+        
+        return size;
+    }
+    
+    void META::WriteData( BinaryOutputStream & stream ) const
+    {
+        if( this->impl->_isFullBox )
+        {
+            FullBox::WriteData( stream );
+        }
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            box->Write( stream );
+        }
+        
+        stream.Write( this->impl->_padding );
     }
     
     void META::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
@@ -128,13 +161,19 @@ namespace ISOBMFF
         return this->impl->_boxes;
     }
     
+    Span< const std::shared_ptr< Box > > META::GetBoxesSpan() const
+    {
+        return this->impl->_boxes;
+    }
+    
     META::IMPL::IMPL():
         _isFullBox( true )
     {}
 
     META::IMPL::IMPL( const IMPL & o ):
         _isFullBox( o._isFullBox ),
-        _boxes( o._boxes )
+        _boxes( o._boxes ),
+        _padding( o._padding )
     {}
 
     META::IMPL::~IMPL()
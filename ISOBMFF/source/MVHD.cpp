@@ -29,11 +29,12 @@
  */
 
 #include <ISOBMFF/MVHD.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class MVHD::IMPL
+    class MVHD::IMPL: public ResourceAllocated
     {
         public:
             
@@ -128,6 +129,47 @@ namespace ISOBMFF
         this->SetNextTrackID( stream.ReadBigEndianUInt32() );
     }
     
+    uint64_t MVHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 28 : 16 ) + 80;
+    }
+    
+    void MVHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->GetCreationTime() );
+            stream.WriteBigEndianUInt64( this->GetModificationTime() );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt64( this->GetDuration() );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetCreationTime() ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetModificationTime() ) );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetDuration() ) );
+        }
+        
+        stream.WriteBigEndianUInt32( this->GetRate() );
+        stream.WriteBigEndianUInt16( this->GetVolume() );
+        
+        stream.WriteBigEndianUInt16( this->impl->_reserved1 );
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 1 ] );
+        
+        stream.WriteMatrix( this->GetMatrix() );
+        
+        for( uint32_t predefined: this->impl->_predefined )
+        {
+            stream.WriteBigEndianUInt32( predefined );
+        }
+        
+        stream.WriteBigEndianUInt32( this->GetNextTrackID() );
+    }
+    
     std::vector< std::pair< std::string, std::string > > MVHD::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/Matrix.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class Matrix::IMPL
+    class Matrix::IMPL: public ResourceAllocated
     {
         public:
             
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MemoryResource.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/MemoryResource.hpp>
+#include <new>
+
+namespace ISOBMFF
+{
+    static thread_local std::shared_ptr< MemoryResource > CurrentResource;
+    
+    const std::shared_ptr< MemoryResource > & MemoryResource::GetCurrent()
+    {
+        return CurrentResource;
+    }
+    
+    void MemoryResource::SetCurrent( const std::shared_ptr< MemoryResource > & resource )
+    {
+        CurrentResource = resource;
+    }
+    
+    /*
+     * Each object is preceded by a header holding a reference to the
+     * memory resource, padded to keep the object suitably aligned.
+     */
+    static constexpr size_t HeaderSize = ( ( sizeof( std::shared_ptr< MemoryResource > ) + alignof( std::max_align_t ) - 1 ) / alignof( std::max_align_t ) ) * alignof( std::max_align_t );
+    
+    void * ResourceAllocated::operator new( size_t size )
+    {
+        const std::shared_ptr< MemoryResource > & resource = MemoryResource::GetCurrent();
+        uint8_t                                 * p;
+        
+        if( resource == nullptr )
+        {
+            p = static_cast< uint8_t * >( ::operator new( HeaderSize + size ) );
+        }
+        else
+        {
+            p = static_cast< uint8_t * >( resource->Allocate( HeaderSize + size, alignof( std::max_align_t ) ) );
+        }
+        
+        new( p ) std::shared_ptr< MemoryResource >( resource );
+        
+        return p + HeaderSize;
+    }
+    
+    void ResourceAllocated::operator delete( void * p, size_t size ) noexcept
+    {
+        uint8_t                           * header;
+        std::shared_ptr< MemoryResource > * stored;
+        std::shared_ptr< MemoryResource >   resource;
+        
+        if( p == nullptr )
+        {
+            return;
+        }
+        
+        header   = static_cast< uint8_t * >( p ) - HeaderSize;
+        stored   = reinterpret_cast< std::shared_ptr< MemoryResource > * >( header );
+        resource = std::move( *( stored ) );
+        
+        stored->~shared_ptr();
+        
+        if( resource == nullptr )
+        {
+            ::operator delete( header );
+        }
+        else
+        {
+            resource->Deallocate( header, HeaderSize + size, alignof( std::max_align_t ) );
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MonotonicBufferResource.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/MemoryResource.hpp>
+#include <vector>
+#include <new>
+#include <stdexcept>
+#include <algorithm>
+
+namespace ISOBMFF
+{
+    class MonotonicBufferResource::IMPL
+    {
+        public:
+            
+            IMPL( size_t blockSize );
+            ~IMPL();
+            
+            std::vector< void * > _blocks;
+            size_t                _blockSize;
+            uint8_t             * _pos;
+            size_t                _available;
+            size_t                _allocated;
+    };
+    
+    MonotonicBufferResource::MonotonicBufferResource( size_t blockSize ):
+        impl( std::make_unique< IMPL >( blockSize ) )
+    {}
+    
+    MonotonicBufferResource::~MonotonicBufferResource()
+    {}
+    
+    void * MonotonicBufferResource::Allocate( size_t size, size_t alignment )
+    {
+        size_t padding;
+        
+        if( alignment == 0 || ( alignment & ( alignment - 1 ) ) != 0 )
+        {
+            throw std::runtime_error( "Invalid alignment" );
+        }
+        
+        padding = ( alignment - ( reinterpret_cast< uintptr_t >( this->impl->_pos ) & ( alignment - 1 ) ) ) & ( alignment - 1 );
+        
+        if( this->impl->_pos == nullptr || padding + size > this->impl->_available )
+        {
+            size_t blockSize = std::max( this->impl->_blockSize, size + alignment );
+            void * block     = ::operator new( blockSize );
+            
+            this->impl->_blocks.push_back( block );
+            
+            this->impl->_pos        = static_cast< uint8_t * >( block );
+            this->impl->_available  = blockSize;
+            this->impl->_allocated += blockSize;
+            this->impl->_blockSize *= 2;
+            padding                 = ( alignment - ( reinterpret_cast< uintptr_t >( this->impl->_pos ) & ( alignment - 1 ) ) ) & ( alignment - 1 );
+        }
+        
+        {
+            uint8_t * p = this->impl->_pos + padding;
+            
+            this->impl->_pos       += padding + size;
+            this->impl->_available -= padding + size;
+            
+            return p;
+        }
+    }
+    
+    void MonotonicBufferResource::Deallocate( void * p, size_t size, size_t alignment )
+    {
+        ( void )p;
+        ( void )size;
+        ( void )alignment;
+    }
+    
+    size_t MonotonicBufferResource::GetAllocatedBytes() const
+    {
+        return this->impl->_allocated;
+    }
+    
+    MonotonicBufferResource::IMPL::IMPL( size_t blockSize ):
+        _blockSize( std::max( blockSize, static_cast< size_t >( 64 ) ) ),
+        _pos( nullptr ),
+        _available( 0 ),
+        _allocated( 0 )
+    {}
+    
+    MonotonicBufferResource::IMPL::~IMPL()
+    {
+        for( void * block: this->_blocks )
+        {
+            ::operator delete( block );
+        }
+    }
+}
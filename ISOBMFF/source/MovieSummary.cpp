@@ -0,0 +1,322 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MovieSummary.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/MovieSummary.hpp>
+#include <ISOBMFF/BinaryFileStream.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    static constexpr uint32_t Type( const char * s )
+    {
+        return   ( static_cast< uint32_t >( static_cast< uint8_t >( s[ 0 ] ) ) << 24 )
+               | ( static_cast< uint32_t >( static_cast< uint8_t >( s[ 1 ] ) ) << 16 )
+               | ( static_cast< uint32_t >( static_cast< uint8_t >( s[ 2 ] ) ) <<  8 )
+               |   static_cast< uint32_t >( static_cast< uint8_t >( s[ 3 ] ) );
+    }
+    
+    static uint64_t ReadUInt( const uint8_t * data, size_t size, size_t pos, size_t length );
+    static void     ReadFourCC( const uint8_t * data, size_t size, size_t pos, char * fourCC );
+    static size_t   ReadPayload( BinaryStream & stream, uint64_t begin, uint64_t end, uint8_t * data, size_t size );
+    static void     ReadMovie( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary & summary );
+    static void     ReadTrack( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary::Track & track );
+    static void     ReadMedia( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary::Track & track );
+    static void     ReadSampleTable( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary::Track & track );
+    
+    template< class _F_ >
+    static void ForEachBox( BinaryStream & stream, uint64_t begin, uint64_t end, _F_ callback );
+    
+    constexpr size_t MovieSummary::MaxTracks;
+    
+    MovieSummary MovieSummary::Read( BinaryStream & stream )
+    {
+        MovieSummary summary{};
+        uint64_t     end;
+        bool         found( false );
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::End );
+        
+        end = stream.Tell();
+        
+        ForEachBox
+        (
+            stream,
+            0,
+            end,
+            [ & ]( uint32_t type, uint64_t begin, uint64_t boxEnd )
+            {
+                if( type == Type( "moov" ) && found == false )
+                {
+                    found = true;
+                    
+                    ReadMovie( stream, begin, boxEnd, summary );
+                }
+            }
+        );
+        
+        if( found == false )
+        {
+            throw std::runtime_error( "Invalid file - No MOOV box" );
+        }
+        
+        return summary;
+    }
+    
+    MovieSummary MovieSummary::Read( const std::string & path )
+    {
+        BinaryFileStream stream( path );
+        
+        return Read( stream );
+    }
+    
+    static uint64_t ReadUInt( const uint8_t * data, size_t size, size_t pos, size_t length )
+    {
+        uint64_t value( 0 );
+        
+        if( pos > size || length > size - pos )
+        {
+            throw std::runtime_error( "Invalid box - Not enough data available" );
+        }
+        
+        for( size_t i = 0; i < length; i++ )
+        {
+            value = ( value << 8 ) | data[ pos + i ];
+        }
+        
+        return value;
+    }
+    
+    static void ReadFourCC( const uint8_t * data, size_t size, size_t pos, char * fourCC )
+    {
+        if( pos > size || 4 > size - pos )
+        {
+            throw std::runtime_error( "Invalid box - Not enough data available" );
+        }
+        
+        memcpy( fourCC, data + pos, 4 );
+        
+        fourCC[ 4 ] = 0;
+    }
+    
+    static size_t ReadPayload( BinaryStream & stream, uint64_t begin, uint64_t end, uint8_t * data, size_t size )
+    {
+        size_t length( static_cast< size_t >( std::min< uint64_t >( end - begin, size ) ) );
+        
+        stream.Seek( begin, BinaryStream::SeekDirection::Begin );
+        stream.Read( data, length );
+        
+        return length;
+    }
+    
+    static void ReadMovie( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary & summary )
+    {
+        ForEachBox
+        (
+            stream,
+            begin,
+            end,
+            [ & ]( uint32_t type, uint64_t boxBegin, uint64_t boxEnd )
+            {
+                if( type == Type( "mvhd" ) )
+                {
+                    uint8_t data[ 32 ];
+                    size_t  size( ReadPayload( stream, boxBegin, boxEnd, data, sizeof( data ) ) );
+                    bool    v1( ReadUInt( data, size, 0, 1 ) == 1 );
+                    
+                    summary.timescale = static_cast< uint32_t >( ReadUInt( data, size, ( v1 ) ? 20 : 12, 4 ) );
+                    summary.duration  = ReadUInt( data, size, ( v1 ) ? 24 : 16, ( v1 ) ? 8 : 4 );
+                }
+                else if( type == Type( "trak" ) )
+                {
+                    if( summary.trackCount < MovieSummary::MaxTracks )
+                    {
+                        ReadTrack( stream, boxBegin, boxEnd, summary.tracks[ summary.trackCount ] );
+                    }
+                    
+                    summary.trackCount++;
+                }
+            }
+        );
+    }
+    
+    static void ReadTrack( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary::Track & track )
+    {
+        ForEachBox
+        (
+            stream,
+            begin,
+            end,
+            [ & ]( uint32_t type, uint64_t boxBegin, uint64_t boxEnd )
+            {
+                if( type == Type( "tkhd" ) )
+                {
+                    uint8_t data[ 96 ];
+                    size_t  size( ReadPayload( stream, boxBegin, boxEnd, data, sizeof( data ) ) );
+                    bool    v1( ReadUInt( data, size, 0, 1 ) == 1 );
+                    size_t  dimensions( ( v1 ) ? 88 : 76 );
+                    
+                    track.trackID = static_cast< uint32_t >( ReadUInt( data, size, ( v1 ) ? 20 : 12, 4 ) );
+                    track.width   = static_cast< uint32_t >( ReadUInt( data, size, dimensions,     4 ) >> 16 );
+                    track.height  = static_cast< uint32_t >( ReadUInt( data, size, dimensions + 4, 4 ) >> 16 );
+                }
+                else if( type == Type( "mdia" ) )
+                {
+                    ReadMedia( stream, boxBegin, boxEnd, track );
+                }
+            }
+        );
+    }
+    
+    static void ReadMedia( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary::Track & track )
+    {
+        ForEachBox
+        (
+            stream,
+            begin,
+            end,
+            [ & ]( uint32_t type, uint64_t boxBegin, uint64_t boxEnd )
+            {
+                uint8_t data[ 36 ];
+                
+                if( type == Type( "mdhd" ) )
+                {
+                    size_t   size( ReadPayload( stream, boxBegin, boxEnd, data, sizeof( data ) ) );
+                    bool     v1( ReadUInt( data, size, 0, 1 ) == 1 );
+                    uint64_t language;
+                    
+                    track.timescale = static_cast< uint32_t >( ReadUInt( data, size, ( v1 ) ? 20 : 12, 4 ) );
+                    track.duration  = ReadUInt( data, size, ( v1 ) ? 24 : 16, ( v1 ) ? 8 : 4 );
+                    language        = ReadUInt( data, size, ( v1 ) ? 32 : 20, 2 );
+                    
+                    /* Values below 0x400 are QuickTime Macintosh language codes */
+                    if( language >= 0x400 )
+                    {
+                        track.language[ 0 ] = static_cast< char >( ( ( language >> 10 ) & 0x1F ) + 0x60 );
+                        track.language[ 1 ] = static_cast< char >( ( ( language >>  5 ) & 0x1F ) + 0x60 );
+                        track.language[ 2 ] = static_cast< char >( (   language          & 0x1F ) + 0x60 );
+                    }
+                }
+                else if( type == Type( "hdlr" ) )
+                {
+                    ReadFourCC( data, ReadPayload( stream, boxBegin, boxEnd, data, 12 ), 8, track.handlerType );
+                }
+                else if( type == Type( "minf" ) )
+                {
+                    ForEachBox
+                    (
+                        stream,
+                        boxBegin,
+                        boxEnd,
+                        [ & ]( uint32_t minfType, uint64_t minfBegin, uint64_t minfEnd )
+                        {
+                            if( minfType == Type( "stbl" ) )
+                            {
+                                ReadSampleTable( stream, minfBegin, minfEnd, track );
+                            }
+                        }
+                    );
+                }
+            }
+        );
+    }
+    
+    static void ReadSampleTable( BinaryStream & stream, uint64_t begin, uint64_t end, MovieSummary::Track & track )
+    {
+        ForEachBox
+        (
+            stream,
+            begin,
+            end,
+            [ & ]( uint32_t type, uint64_t boxBegin, uint64_t boxEnd )
+            {
+                uint8_t data[ 16 ];
+                
+                if( type == Type( "stsd" ) )
+                {
+                    size_t size( ReadPayload( stream, boxBegin, boxEnd, data, 16 ) );
+                    
+                    if( ReadUInt( data, size, 4, 4 ) > 0 )
+                    {
+                        ReadFourCC( data, size, 12, track.codec );
+                    }
+                }
+                else if( type == Type( "stsz" ) || type == Type( "stz2" ) )
+                {
+                    size_t size( ReadPayload( stream, boxBegin, boxEnd, data, 12 ) );
+                    
+                    track.sampleCount = static_cast< uint32_t >( ReadUInt( data, size, 8, 4 ) );
+                }
+            }
+        );
+    }
+    
+    template< class _F_ >
+    static void ForEachBox( BinaryStream & stream, uint64_t begin, uint64_t end, _F_ callback )
+    {
+        uint64_t pos( begin );
+        
+        while( end - pos >= 8 )
+        {
+            uint8_t  header[ 16 ];
+            uint64_t size;
+            uint64_t headerSize( 8 );
+            uint32_t type;
+            
+            stream.Seek( pos, BinaryStream::SeekDirection::Begin );
+            stream.Read( header, 8 );
+            
+            size = ReadUInt( header, 8, 0, 4 );
+            type = static_cast< uint32_t >( ReadUInt( header, 8, 4, 4 ) );
+            
+            if( size == 1 )
+            {
+                stream.Read( header + 8, 8 );
+                
+                size       = ReadUInt( header, 16, 8, 8 );
+                headerSize = 16;
+            }
+            else if( size == 0 )
+            {
+                size = end - pos;
+            }
+            
+            if( size < headerSize || size > end - pos )
+            {
+                throw std::runtime_error( "Invalid box - Invalid box size" );
+            }
+            
+            callback( type, pos + headerSize, pos + size );
+            
+            pos += size;
+        }
+    }
+}
@@ -0,0 +1,511 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Muxer.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Muxer.hpp>
+#include <ISOBMFF/SampleTableBuilder.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/Matrix.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Muxer::IMPL
+    {
+        public:
+            
+            class Track
+            {
+                public:
+                    
+                    std::string            _handlerType;
+                    uint32_t               _timescale;
+                    std::vector< uint8_t > _sampleEntry;
+                    uint16_t               _width;
+                    uint16_t               _height;
+                    SampleTableBuilder     _table;
+                    size_t                 _chunkSize;
+            };
+            
+            IMPL( BinaryOutputStream & stream, Layout layout, uint64_t reservedSize );
+            ~IMPL();
+            
+            void Start();
+            void WriteMOOV( BinaryOutputStream & stream ) const;
+            void WriteTRAK( BinaryOutputStream & stream, const Track & track, uint32_t trackID ) const;
+            
+            BinaryOutputStream       * _stream;
+            Layout                     _layout;
+            uint64_t                   _reservedSize;
+            std::string                _majorBrand;
+            uint32_t                   _minorVersion;
+            std::vector< std::string > _compatibleBrands;
+            uint32_t                   _timescale;
+            size_t                     _maxChunkSize;
+            std::vector< Track >       _tracks;
+            uint32_t                   _currentTrackID;
+            size_t                     _reservedOffset;
+            size_t                     _mdatOffset;
+            bool                       _started;
+            bool                       _finished;
+    };
+    
+    static uint64_t Rescale( uint64_t value, uint32_t from, uint32_t to );
+    
+    Muxer::Muxer( BinaryOutputStream & stream, Layout layout, uint64_t reservedSize ):
+        impl( std::make_unique< IMPL >( stream, layout, reservedSize ) )
+    {}
+    
+    Muxer::Muxer( Muxer && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Muxer::~Muxer()
+    {}
+    
+    Muxer & Muxer::operator =( Muxer o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    uint64_t Muxer::EstimateMoovSize( size_t tracks, size_t samples )
+    {
+        /*
+         * Worst case per sample: STSZ (4), STTS (8), CTTS (8), STSS (4),
+         * STSC (12) and CO64 (8), with one sample per chunk.
+         */
+        return 1024 + ( static_cast< uint64_t >( tracks ) * 2048 ) + ( static_cast< uint64_t >( samples ) * 44 );
+    }
+    
+    void Muxer::SetBrands( const std::string & majorBrand, uint32_t minorVersion, const std::vector< std::string > & compatibleBrands )
+    {
+        if( this->impl->_started )
+        {
+            throw std::runtime_error( "Invalid muxer state - Brands must be set before writing samples" );
+        }
+        
+        this->impl->_majorBrand       = majorBrand;
+        this->impl->_minorVersion     = minorVersion;
+        this->impl->_compatibleBrands = compatibleBrands;
+    }
+    
+    void Muxer::SetTimescale( uint32_t value )
+    {
+        if( value == 0 )
+        {
+            throw std::runtime_error( "Invalid timescale" );
+        }
+        
+        this->impl->_timescale = value;
+    }
+    
+    void Muxer::SetMaxChunkSize( size_t value )
+    {
+        this->impl->_maxChunkSize = value;
+    }
+    
+    uint32_t Muxer::AddTrack( const std::string & handlerType, uint32_t timescale, Span< const uint8_t > sampleEntry )
+    {
+        IMPL::Track track;
+        
+        if( this->impl->_finished )
+        {
+            throw std::runtime_error( "Invalid muxer state - Already finished" );
+        }
+        
+        if( handlerType.size() != 4 || timescale == 0 )
+        {
+            throw std::runtime_error( "Invalid track - Invalid handler type or timescale" );
+        }
+        
+        if
+        (
+               sampleEntry.size() < 8
+            || ( ( static_cast< uint32_t >( sampleEntry[ 0 ] ) << 24 ) | ( static_cast< uint32_t >( sampleEntry[ 1 ] ) << 16 ) | ( static_cast< uint32_t >( sampleEntry[ 2 ] ) << 8 ) | sampleEntry[ 3 ] ) != sampleEntry.size()
+        )
+        {
+            throw std::runtime_error( "Invalid track - Invalid sample entry" );
+        }
+        
+        track._handlerType = handlerType;
+        track._timescale   = timescale;
+        track._sampleEntry = std::vector< uint8_t >( sampleEntry.begin(), sampleEntry.end() );
+        track._width       = 0;
+        track._height      = 0;
+        track._chunkSize   = 0;
+        
+        /* VisualSampleEntry: width and height follow 8 + 16 bytes of fields */
+        if( handlerType == "vide" && sampleEntry.size() >= 36 )
+        {
+            track._width  = static_cast< uint16_t >( ( sampleEntry[ 32 ] << 8 ) | sampleEntry[ 33 ] );
+            track._height = static_cast< uint16_t >( ( sampleEntry[ 34 ] << 8 ) | sampleEntry[ 35 ] );
+        }
+        
+        this->impl->_tracks.push_back( std::move( track ) );
+        
+        return static_cast< uint32_t >( this->impl->_tracks.size() );
+    }
+    
+    void Muxer::WriteSample( uint32_t trackID, Span< const uint8_t > data, uint32_t duration, int32_t compositionOffset, bool sync )
+    {
+        IMPL::Track * track;
+        
+        if( this->impl->_finished )
+        {
+            throw std::runtime_error( "Invalid muxer state - Already finished" );
+        }
+        
+        if( trackID == 0 || trackID > this->impl->_tracks.size() )
+        {
+            throw std::runtime_error( "Invalid track ID: " + std::to_string( trackID ) );
+        }
+        
+        if( data.size() > UINT32_MAX )
+        {
+            throw std::runtime_error( "Invalid sample - Sample is too large" );
+        }
+        
+        this->impl->Start();
+        
+        track = &( this->impl->_tracks[ trackID - 1 ] );
+        
+        if( this->impl->_currentTrackID != trackID || ( track->_chunkSize > 0 && track->_chunkSize + data.size() > this->impl->_maxChunkSize ) )
+        {
+            track->_table.AddChunk( this->impl->_stream->Tell() );
+            
+            track->_chunkSize           = 0;
+            this->impl->_currentTrackID = trackID;
+        }
+        
+        this->impl->_stream->Write( data );
+        
+        track->_table.AddSample( static_cast< uint32_t >( data.size() ), duration, compositionOffset, sync );
+        
+        track->_chunkSize += data.size();
+    }
+    
+    void Muxer::Finish()
+    {
+        BinaryDataOutputStream moov;
+        size_t                 end;
+        
+        if( this->impl->_finished )
+        {
+            return;
+        }
+        
+        this->impl->Start();
+        
+        end = this->impl->_stream->Tell();
+        
+        this->impl->_stream->Seek( this->impl->_mdatOffset + 8, BinaryOutputStream::SeekDirection::Begin );
+        this->impl->_stream->WriteBigEndianUInt64( end - this->impl->_mdatOffset );
+        this->impl->_stream->Seek( end, BinaryOutputStream::SeekDirection::Begin );
+        
+        this->impl->WriteMOOV( moov );
+        
+        if
+        (
+               this->impl->_layout == Layout::MoovAtFront
+            && (
+                      moov.GetData().size() == this->impl->_reservedSize
+                   || moov.GetData().size() + 8 <= this->impl->_reservedSize
+               )
+        )
+        {
+            this->impl->_stream->Seek( this->impl->_reservedOffset, BinaryOutputStream::SeekDirection::Begin );
+            this->impl->_stream->Write( moov.GetData() );
+            
+            if( moov.GetData().size() < this->impl->_reservedSize )
+            {
+                this->impl->_stream->WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_reservedSize - moov.GetData().size() ) );
+                this->impl->_stream->WriteFourCC( "free" );
+            }
+            
+            this->impl->_stream->Seek( end, BinaryOutputStream::SeekDirection::Begin );
+        }
+        else
+        {
+            this->impl->_stream->Write( moov.GetData() );
+        }
+        
+        this->impl->_finished = true;
+    }
+    
+    void swap( Muxer & o1, Muxer & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    Muxer::IMPL::IMPL( BinaryOutputStream & stream, Layout layout, uint64_t reservedSize ):
+        _stream( &stream ),
+        _layout( layout ),
+        _reservedSize( reservedSize ),
+        _majorBrand( "isom" ),
+        _minorVersion( 512 ),
+        _compatibleBrands( { "isom", "iso2", "mp41" } ),
+        _timescale( 1000 ),
+        _maxChunkSize( DefaultMaxChunkSize ),
+        _currentTrackID( 0 ),
+        _reservedOffset( 0 ),
+        _mdatOffset( 0 ),
+        _started( false ),
+        _finished( false )
+    {
+        if( layout == Layout::MoovAtFront && ( reservedSize < 8 || reservedSize > UINT32_MAX ) )
+        {
+            throw std::runtime_error( "Invalid reserved size for the MOOV box" );
+        }
+    }
+    
+    Muxer::IMPL::~IMPL()
+    {}
+    
+    void Muxer::IMPL::Start()
+    {
+        size_t box;
+        
+        if( this->_started )
+        {
+            return;
+        }
+        
+        box = this->_stream->BeginBox( "ftyp" );
+        
+        this->_stream->WriteFourCC( this->_majorBrand );
+        this->_stream->WriteBigEndianUInt32( this->_minorVersion );
+        
+        for( const auto & brand: this->_compatibleBrands )
+        {
+            this->_stream->WriteFourCC( brand );
+        }
+        
+        this->_stream->EndBox( box );
+        
+        if( this->_layout == Layout::MoovAtFront )
+        {
+            this->_reservedOffset = this->_stream->Tell();
+            
+            this->_stream->WriteBigEndianUInt32( static_cast< uint32_t >( this->_reservedSize ) );
+            this->_stream->WriteFourCC( "free" );
+            this->_stream->WriteZeros( static_cast< size_t >( this->_reservedSize - 8 ) );
+        }
+        
+        /* The MDAT size is written by Finish(), as a 64-bit size */
+        this->_mdatOffset = this->_stream->Tell();
+        
+        this->_stream->WriteBigEndianUInt32( 1 );
+        this->_stream->WriteFourCC( "mdat" );
+        this->_stream->WriteBigEndianUInt64( 0 );
+        
+        this->_started = true;
+    }
+    
+    void Muxer::IMPL::WriteMOOV( BinaryOutputStream & stream ) const
+    {
+        uint64_t duration( 0 );
+        size_t   moov;
+        size_t   box;
+        uint8_t  version;
+        
+        for( const auto & track: this->_tracks )
+        {
+            duration = std::max( duration, Rescale( track._table.GetDuration(), track._timescale, this->_timescale ) );
+        }
+        
+        version = ( duration > UINT32_MAX ) ? 1 : 0;
+        moov    = stream.BeginBox( "moov" );
+        box     = stream.BeginFullBox( "mvhd", version, 0 );
+        
+        if( version == 1 )
+        {
+            stream.WriteBigEndianUInt64( 0 );
+            stream.WriteBigEndianUInt64( 0 );
+            stream.WriteBigEndianUInt32( this->_timescale );
+            stream.WriteBigEndianUInt64( duration );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( this->_timescale );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( duration ) );
+        }
+        
+        stream.WriteBigEndianUInt32( 0x00010000 );
+        stream.WriteBigEndianUInt16( 0x0100 );
+        stream.WriteZeros( 10 );
+        stream.WriteMatrix( Matrix( 0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000 ) );
+        stream.WriteZeros( 24 );
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->_tracks.size() + 1 ) );
+        stream.EndBox( box );
+        
+        for( size_t i = 0; i < this->_tracks.size(); i++ )
+        {
+            this->WriteTRAK( stream, this->_tracks[ i ], static_cast< uint32_t >( i + 1 ) );
+        }
+        
+        stream.EndBox( moov );
+    }
+    
+    void Muxer::IMPL::WriteTRAK( BinaryOutputStream & stream, const Track & track, uint32_t trackID ) const
+    {
+        uint64_t    mediaDuration( track._table.GetDuration() );
+        uint64_t    duration( Rescale( mediaDuration, track._timescale, this->_timescale ) );
+        uint8_t     version( ( mediaDuration > UINT32_MAX || duration > UINT32_MAX ) ? 1 : 0 );
+        std::string name;
+        size_t      trak;
+        size_t      mdia;
+        size_t      minf;
+        size_t      dinf;
+        size_t      dref;
+        size_t      box;
+        
+        trak = stream.BeginBox( "trak" );
+        box  = stream.BeginFullBox( "tkhd", version, 0x000003 );
+        
+        if( version == 1 )
+        {
+            stream.WriteBigEndianUInt64( 0 );
+            stream.WriteBigEndianUInt64( 0 );
+            stream.WriteBigEndianUInt32( trackID );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt64( duration );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( trackID );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( duration ) );
+        }
+        
+        stream.WriteZeros( 8 );
+        stream.WriteBigEndianUInt16( 0 );
+        stream.WriteBigEndianUInt16( 0 );
+        stream.WriteBigEndianUInt16( ( track._handlerType == "soun" ) ? 0x0100 : 0 );
+        stream.WriteBigEndianUInt16( 0 );
+        stream.WriteMatrix( Matrix( 0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000 ) );
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( track._width ) << 16 );
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( track._height ) << 16 );
+        stream.EndBox( box );
+        
+        mdia = stream.BeginBox( "mdia" );
+        box  = stream.BeginFullBox( "mdhd", version, 0 );
+        
+        if( version == 1 )
+        {
+            stream.WriteBigEndianUInt64( 0 );
+            stream.WriteBigEndianUInt64( 0 );
+            stream.WriteBigEndianUInt32( track._timescale );
+            stream.WriteBigEndianUInt64( mediaDuration );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( track._timescale );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( mediaDuration ) );
+        }
+        
+        /* Packed ISO-639-2 code for "und" */
+        stream.WriteBigEndianUInt16( 0x55C4 );
+        stream.WriteBigEndianUInt16( 0 );
+        stream.EndBox( box );
+        
+        if( track._handlerType == "vide" )
+        {
+            name = "VideoHandler";
+        }
+        else if( track._handlerType == "soun" )
+        {
+            name = "SoundHandler";
+        }
+        else
+        {
+            name = "DataHandler";
+        }
+        
+        box = stream.BeginFullBox( "hdlr", 0, 0 );
+        
+        stream.WriteBigEndianUInt32( 0 );
+        stream.WriteFourCC( track._handlerType );
+        stream.WriteZeros( 12 );
+        stream.WriteNULLTerminatedString( name );
+        stream.EndBox( box );
+        
+        minf = stream.BeginBox( "minf" );
+        
+        if( track._handlerType == "vide" )
+        {
+            box = stream.BeginFullBox( "vmhd", 0, 0x000001 );
+            
+            stream.WriteZeros( 8 );
+        }
+        else if( track._handlerType == "soun" )
+        {
+            box = stream.BeginFullBox( "smhd", 0, 0 );
+            
+            stream.WriteZeros( 4 );
+        }
+        else
+        {
+            box = stream.BeginFullBox( "nmhd", 0, 0 );
+        }
+        
+        stream.EndBox( box );
+        
+        dinf = stream.BeginBox( "dinf" );
+        dref = stream.BeginFullBox( "dref", 0, 0 );
+        
+        stream.WriteBigEndianUInt32( 1 );
+        stream.EndBox( stream.BeginFullBox( "url ", 0, 0x000001 ) );
+        stream.EndBox( dref );
+        stream.EndBox( dinf );
+        
+        track._table.Write( stream, { Span< const uint8_t >( track._sampleEntry ) } );
+        
+        stream.EndBox( minf );
+        stream.EndBox( mdia );
+        stream.EndBox( trak );
+    }
+    
+    uint64_t Rescale( uint64_t value, uint32_t from, uint32_t to )
+    {
+        return ( ( value / from ) * to ) + ( ( ( value % from ) * to ) / from );
+    }
+}
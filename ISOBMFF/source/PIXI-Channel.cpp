@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/PIXI.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class PIXI::Channel::IMPL
+    class PIXI::Channel::IMPL: public ResourceAllocated
     {
         public:
             
@@ -30,10 +30,11 @@
 
 #include <ISOBMFF/PIXI.hpp>
 #include <ISOBMFF/Utils.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class PIXI::IMPL
+    class PIXI::IMPL: public ResourceAllocated
     {
         public:
             
@@ -91,7 +92,24 @@ namespace ISOBMFF
         
         for( i = 0; i < count; i++ )
         {
-            this->AddChannel( std::make_shared< Channel >( stream ) );
+            this->AddChannel( MakeShared< Channel >( stream ) );
+        }
+    }
+    
+    uint64_t PIXI::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 1 + this->impl->_channels.size();
+    }
+    
+    void PIXI::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteUInt8( static_cast< uint8_t >( this->impl->_channels.size() ) );
+        
+        for( const auto & channel: this->impl->_channels )
+        {
+            stream.WriteUInt8( channel->GetBitsPerChannel() );
         }
     }
     
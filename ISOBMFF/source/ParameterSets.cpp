@@ -0,0 +1,780 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ParameterSets.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ParameterSets.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <ISOBMFF/RBSP.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ISOBMFF
+{
+    template< class _T_, class _F_ >
+    static _T_ Parse( Span< const uint8_t > nal, size_t headerSize, _F_ parse );
+    
+    static uint8_t GetAVCNALUnitType( Span< const uint8_t > nal );
+    static uint8_t GetHEVCNALUnitType( Span< const uint8_t > nal );
+    static void    ReadProfileTierLevel( BitReader & reader, uint8_t maxSubLayersMinus1, uint8_t & profileIDC, uint8_t & levelIDC );
+    static void    SkipSubLayerOrderingInfo( BitReader & reader, uint8_t maxSubLayersMinus1 );
+    static void    SkipAVCScalingList( BitReader & reader, unsigned int size );
+    static void    SkipHEVCScalingListData( BitReader & reader );
+    static void    SkipShortTermRefPicSet( BitReader & reader, uint32_t index, uint32_t * numDeltaPocs );
+    static void    ReadVideoSignalType( BitReader & reader, SequenceParameterSet & sps );
+    static void    ReadAVCVUI( BitReader & reader, SequenceParameterSet & sps );
+    static void    ReadHEVCVUI( BitReader & reader, SequenceParameterSet & sps );
+    static void    SetCropping( SequenceParameterSet & sps, uint32_t unitX, uint32_t unitY, uint32_t left, uint32_t right, uint32_t top, uint32_t bottom );
+    
+    VideoParameterSet VideoParameterSet::ReadHEVC( Span< const uint8_t > nal )
+    {
+        if( GetHEVCNALUnitType( nal ) != 32 )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not a video parameter set" );
+        }
+        
+        return Parse< VideoParameterSet >
+        (
+            nal,
+            2,
+            []( BitReader & reader )
+            {
+                VideoParameterSet vps{};
+                uint8_t           maxLayerID;
+                uint32_t          numLayerSets;
+                
+                vps.id                = static_cast< uint8_t >( reader.ReadBits( 4 ) );
+                
+                reader.SkipBits( 2 );
+                
+                vps.maxLayers         = static_cast< uint8_t >( reader.ReadBits( 6 ) + 1 );
+                vps.maxSubLayers      = static_cast< uint8_t >( reader.ReadBits( 3 ) + 1 );
+                vps.temporalIDNesting = reader.ReadBit();
+                
+                reader.SkipBits( 16 );
+                ReadProfileTierLevel( reader, vps.maxSubLayers - 1, vps.profileIDC, vps.levelIDC );
+                SkipSubLayerOrderingInfo( reader, vps.maxSubLayers - 1 );
+                
+                maxLayerID   = static_cast< uint8_t >( reader.ReadBits( 6 ) );
+                numLayerSets = reader.ReadUE() + 1;
+                
+                if( numLayerSets > 1024 )
+                {
+                    throw std::runtime_error( "Invalid VPS - Too many layer sets" );
+                }
+                
+                reader.SkipBits( static_cast< size_t >( numLayerSets - 1 ) * ( maxLayerID + 1U ) );
+                
+                vps.hasTiming = reader.ReadBit();
+                
+                if( vps.hasTiming )
+                {
+                    vps.numUnitsInTick = reader.ReadBits( 32 );
+                    vps.timeScale      = reader.ReadBits( 32 );
+                }
+                
+                return vps;
+            }
+        );
+    }
+    
+    SequenceParameterSet SequenceParameterSet::ReadAVC( Span< const uint8_t > nal )
+    {
+        if( GetAVCNALUnitType( nal ) != 7 )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not a sequence parameter set" );
+        }
+        
+        return Parse< SequenceParameterSet >
+        (
+            nal,
+            1,
+            []( BitReader & reader )
+            {
+                SequenceParameterSet sps{};
+                uint32_t             id;
+                uint32_t             pocType;
+                uint32_t             widthInMBs;
+                uint32_t             heightInMapUnits;
+                
+                sps.profileIDC = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                
+                reader.SkipBits( 8 );
+                
+                sps.levelIDC       = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                id                 = reader.ReadUE();
+                sps.chromaFormat   = 1;
+                sps.bitDepthLuma   = 8;
+                sps.bitDepthChroma = 8;
+                
+                if( id > 31 )
+                {
+                    throw std::runtime_error( "Invalid SPS - Invalid identifier" );
+                }
+                
+                sps.id = static_cast< uint8_t >( id );
+                
+                switch( sps.profileIDC )
+                {
+                    case 100: case 110: case 122: case 244: case 44:
+                    case 83:  case 86:  case 118: case 128: case 138:
+                    case 139: case 134: case 135:
+                        
+                        sps.chromaFormat = static_cast< uint8_t >( reader.ReadUE() );
+                        
+                        if( sps.chromaFormat > 3 )
+                        {
+                            throw std::runtime_error( "Invalid SPS - Invalid chroma format" );
+                        }
+                        
+                        if( sps.chromaFormat == 3 )
+                        {
+                            sps.separateColourPlane = reader.ReadBit();
+                        }
+                        
+                        sps.bitDepthLuma   = static_cast< uint8_t >( reader.ReadUE() + 8 );
+                        sps.bitDepthChroma = static_cast< uint8_t >( reader.ReadUE() + 8 );
+                        
+                        reader.SkipBits( 1 );
+                        
+                        if( reader.ReadBit() )
+                        {
+                            for( unsigned int i = 0; i < ( ( sps.chromaFormat != 3 ) ? 8U : 12U ); i++ )
+                            {
+                                if( reader.ReadBit() )
+                                {
+                                    SkipAVCScalingList( reader, ( i < 6 ) ? 16 : 64 );
+                                }
+                            }
+                        }
+                        
+                        break;
+                        
+                    default: break;
+                }
+                
+                reader.ReadUE();
+                
+                pocType = reader.ReadUE();
+                
+                if( pocType == 0 )
+                {
+                    reader.ReadUE();
+                }
+                else if( pocType == 1 )
+                {
+                    uint32_t cycle;
+                    
+                    reader.SkipBits( 1 );
+                    reader.ReadSE();
+                    reader.ReadSE();
+                    
+                    cycle = reader.ReadUE();
+                    
+                    if( cycle > 255 )
+                    {
+                        throw std::runtime_error( "Invalid SPS - Invalid picture order count cycle" );
+                    }
+                    
+                    for( uint32_t i = 0; i < cycle; i++ )
+                    {
+                        reader.ReadSE();
+                    }
+                }
+                
+                reader.ReadUE();
+                reader.SkipBits( 1 );
+                
+                widthInMBs       = reader.ReadUE() + 1;
+                heightInMapUnits = reader.ReadUE() + 1;
+                sps.frameMBsOnly = reader.ReadBit();
+                
+                if( widthInMBs > 0xFFFF || heightInMapUnits > 0xFFFF )
+                {
+                    throw std::runtime_error( "Invalid SPS - Invalid picture size" );
+                }
+                
+                sps.codedWidth  = widthInMBs * 16;
+                sps.codedHeight = heightInMapUnits * 16 * ( sps.frameMBsOnly ? 1 : 2 );
+                
+                if( sps.frameMBsOnly == false )
+                {
+                    reader.SkipBits( 1 );
+                }
+                
+                reader.SkipBits( 1 );
+                
+                {
+                    uint32_t unitX( 1 );
+                    uint32_t unitY( sps.frameMBsOnly ? 1 : 2 );
+                    
+                    if( sps.separateColourPlane == false && sps.chromaFormat != 0 )
+                    {
+                        unitX *= ( sps.chromaFormat == 3 ) ? 1 : 2;
+                        unitY *= ( sps.chromaFormat == 1 ) ? 2 : 1;
+                    }
+                    
+                    if( reader.ReadBit() )
+                    {
+                        uint32_t left(   reader.ReadUE() );
+                        uint32_t right(  reader.ReadUE() );
+                        uint32_t top(    reader.ReadUE() );
+                        uint32_t bottom( reader.ReadUE() );
+                        
+                        SetCropping( sps, unitX, unitY, left, right, top, bottom );
+                    }
+                    else
+                    {
+                        SetCropping( sps, unitX, unitY, 0, 0, 0, 0 );
+                    }
+                }
+                
+                if( reader.ReadBit() )
+                {
+                    ReadAVCVUI( reader, sps );
+                }
+                
+                return sps;
+            }
+        );
+    }
+    
+    SequenceParameterSet SequenceParameterSet::ReadHEVC( Span< const uint8_t > nal )
+    {
+        if( GetHEVCNALUnitType( nal ) != 33 )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not a sequence parameter set" );
+        }
+        
+        return Parse< SequenceParameterSet >
+        (
+            nal,
+            2,
+            []( BitReader & reader )
+            {
+                SequenceParameterSet sps{};
+                uint32_t             id;
+                uint32_t             chromaFormat;
+                uint32_t             cropping[ 4 ] = { 0, 0, 0, 0 };
+                uint32_t             log2MaxPOCLSB;
+                uint32_t             numShortTermRefPicSets;
+                uint32_t             numDeltaPocs[ 64 ];
+                
+                reader.SkipBits( 4 );
+                
+                sps.maxSubLayers = static_cast< uint8_t >( reader.ReadBits( 3 ) + 1 );
+                
+                reader.SkipBits( 1 );
+                ReadProfileTierLevel( reader, sps.maxSubLayers - 1, sps.profileIDC, sps.levelIDC );
+                
+                id           = reader.ReadUE();
+                chromaFormat = reader.ReadUE();
+                
+                if( id > 15 )
+                {
+                    throw std::runtime_error( "Invalid SPS - Invalid identifier" );
+                }
+                
+                if( chromaFormat > 3 )
+                {
+                    throw std::runtime_error( "Invalid SPS - Invalid chroma format" );
+                }
+                
+                sps.id           = static_cast< uint8_t >( id );
+                sps.chromaFormat = static_cast< uint8_t >( chromaFormat );
+                
+                if( sps.chromaFormat == 3 )
+                {
+                    sps.separateColourPlane = reader.ReadBit();
+                }
+                
+                sps.codedWidth  = reader.ReadUE();
+                sps.codedHeight = reader.ReadUE();
+                
+                if( reader.ReadBit() )
+                {
+                    for( uint32_t & value: cropping )
+                    {
+                        value = reader.ReadUE();
+                    }
+                }
+                
+                {
+                    uint32_t unitX( 1 );
+                    uint32_t unitY( 1 );
+                    
+                    if( sps.separateColourPlane == false && sps.chromaFormat != 0 )
+                    {
+                        unitX = ( sps.chromaFormat == 3 ) ? 1 : 2;
+                        unitY = ( sps.chromaFormat == 1 ) ? 2 : 1;
+                    }
+                    
+                    SetCropping( sps, unitX, unitY, cropping[ 0 ], cropping[ 1 ], cropping[ 2 ], cropping[ 3 ] );
+                }
+                
+                sps.bitDepthLuma   = static_cast< uint8_t >( reader.ReadUE() + 8 );
+                sps.bitDepthChroma = static_cast< uint8_t >( reader.ReadUE() + 8 );
+                log2MaxPOCLSB      = reader.ReadUE() + 4;
+                
+                if( log2MaxPOCLSB > 16 )
+                {
+                    throw std::runtime_error( "Invalid SPS - Invalid picture order count size" );
+                }
+                
+                SkipSubLayerOrderingInfo( reader, sps.maxSubLayers - 1 );
+                
+                sps.log2MinCodingBlockSize  = static_cast< uint8_t >( reader.ReadUE() + 3 );
+                sps.log2CodingTreeBlockSize = static_cast< uint8_t >( sps.log2MinCodingBlockSize + reader.ReadUE() );
+                
+                if( sps.log2CodingTreeBlockSize > 6 )
+                {
+                    throw std::runtime_error( "Invalid SPS - Invalid coding tree block size" );
+                }
+                
+                reader.ReadUE();
+                reader.ReadUE();
+                reader.ReadUE();
+                reader.ReadUE();
+                
+                if( reader.ReadBit() && reader.ReadBit() )
+                {
+                    SkipHEVCScalingListData( reader );
+                }
+                
+                reader.SkipBits( 2 );
+                
+                if( reader.ReadBit() )
+                {
+                    reader.SkipBits( 8 );
+                    reader.ReadUE();
+                    reader.ReadUE();
+                    reader.SkipBits( 1 );
+                }
+                
+                numShortTermRefPicSets = reader.ReadUE();
+                
+                if( numShortTermRefPicSets > 64 )
+                {
+                    throw std::runtime_error( "Invalid SPS - Too many short-term reference picture sets" );
+                }
+                
+                for( uint32_t i = 0; i < numShortTermRefPicSets; i++ )
+                {
+                    SkipShortTermRefPicSet( reader, i, numDeltaPocs );
+                }
+                
+                if( reader.ReadBit() )
+                {
+                    uint32_t count( reader.ReadUE() );
+                    
+                    if( count > 32 )
+                    {
+                        throw std::runtime_error( "Invalid SPS - Too many long-term reference pictures" );
+                    }
+                    
+                    reader.SkipBits( count * ( log2MaxPOCLSB + 1 ) );
+                }
+                
+                reader.SkipBits( 2 );
+                
+                if( reader.ReadBit() )
+                {
+                    ReadHEVCVUI( reader, sps );
+                }
+                
+                return sps;
+            }
+        );
+    }
+    
+    SequenceParameterSet SequenceParameterSet::Read( const AVCC & avcc )
+    {
+        std::vector< std::shared_ptr< AVCC::NALUnit > > units( avcc.GetSequenceParameterSetNALUnits() );
+        
+        if( units.size() == 0 )
+        {
+            throw std::runtime_error( "Invalid AVCC - No sequence parameter set" );
+        }
+        
+        return ReadAVC( units[ 0 ]->GetDataSpan() );
+    }
+    
+    SequenceParameterSet SequenceParameterSet::Read( const HVCC & hvcc )
+    {
+        for( const auto & array: hvcc.GetArrays() )
+        {
+            if( array->GetNALUnitType() != 33 )
+            {
+                continue;
+            }
+            
+            for( const auto & unit: array->GetNALUnits() )
+            {
+                return ReadHEVC( unit->GetDataSpan() );
+            }
+        }
+        
+        throw std::runtime_error( "Invalid HVCC - No sequence parameter set" );
+    }
+    
+    PictureParameterSet PictureParameterSet::ReadAVC( Span< const uint8_t > nal )
+    {
+        if( GetAVCNALUnitType( nal ) != 8 )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not a picture parameter set" );
+        }
+        
+        return Parse< PictureParameterSet >
+        (
+            nal,
+            1,
+            []( BitReader & reader )
+            {
+                PictureParameterSet pps{};
+                uint32_t            id( reader.ReadUE() );
+                uint32_t            spsID( reader.ReadUE() );
+                
+                if( id > 255 || spsID > 31 )
+                {
+                    throw std::runtime_error( "Invalid PPS - Invalid identifier" );
+                }
+                
+                pps.id                = static_cast< uint8_t >( id );
+                pps.spsID             = static_cast< uint8_t >( spsID );
+                pps.entropyCodingMode = reader.ReadBit();
+                
+                return pps;
+            }
+        );
+    }
+    
+    PictureParameterSet PictureParameterSet::ReadHEVC( Span< const uint8_t > nal )
+    {
+        if( GetHEVCNALUnitType( nal ) != 34 )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not a picture parameter set" );
+        }
+        
+        return Parse< PictureParameterSet >
+        (
+            nal,
+            2,
+            []( BitReader & reader )
+            {
+                PictureParameterSet pps{};
+                uint32_t            id( reader.ReadUE() );
+                uint32_t            spsID( reader.ReadUE() );
+                
+                if( id > 63 || spsID > 15 )
+                {
+                    throw std::runtime_error( "Invalid PPS - Invalid identifier" );
+                }
+                
+                pps.id                            = static_cast< uint8_t >( id );
+                pps.spsID                         = static_cast< uint8_t >( spsID );
+                pps.dependentSliceSegmentsEnabled = reader.ReadBit();
+                pps.outputFlagPresent             = reader.ReadBit();
+                pps.numExtraSliceHeaderBits       = static_cast< uint8_t >( reader.ReadBits( 3 ) );
+                
+                reader.SkipBits( 2 );
+                reader.ReadUE();
+                reader.ReadUE();
+                reader.ReadSE();
+                reader.SkipBits( 2 );
+                
+                if( reader.ReadBit() )
+                {
+                    reader.ReadUE();
+                }
+                
+                reader.ReadSE();
+                reader.ReadSE();
+                reader.SkipBits( 4 );
+                
+                pps.tilesEnabled             = reader.ReadBit();
+                pps.entropyCodingSyncEnabled = reader.ReadBit();
+                
+                return pps;
+            }
+        );
+    }
+    
+    template< class _T_, class _F_ >
+    static _T_ Parse( Span< const uint8_t > nal, size_t headerSize, _F_ parse )
+    {
+        uint8_t                buffer[ 256 ];
+        std::vector< uint8_t > large;
+        Span< uint8_t >        rbsp( buffer, sizeof( buffer ) );
+        
+        if( nal.size() - headerSize > sizeof( buffer ) )
+        {
+            large.resize( nal.size() - headerSize );
+            
+            rbsp = large;
+        }
+        
+        {
+            BitReader reader( rbsp.subspan( 0, RBSP::Extract( nal.subspan( headerSize, nal.size() - headerSize ), rbsp ) ) );
+            
+            return parse( reader );
+        }
+    }
+    
+    static uint8_t GetAVCNALUnitType( Span< const uint8_t > nal )
+    {
+        if( nal.size() < 2 )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not enough data" );
+        }
+        
+        return nal[ 0 ] & 0x1F;
+    }
+    
+    static uint8_t GetHEVCNALUnitType( Span< const uint8_t > nal )
+    {
+        if( nal.size() < 3 )
+        {
+            throw std::runtime_error( "Invalid NAL unit - Not enough data" );
+        }
+        
+        return ( nal[ 0 ] >> 1 ) & 0x3F;
+    }
+    
+    static void ReadProfileTierLevel( BitReader & reader, uint8_t maxSubLayersMinus1, uint8_t & profileIDC, uint8_t & levelIDC )
+    {
+        bool profilePresent[ 8 ];
+        bool levelPresent[ 8 ];
+        
+        reader.SkipBits( 3 );
+        
+        profileIDC = static_cast< uint8_t >( reader.ReadBits( 5 ) );
+        
+        reader.SkipBits( 32 + 48 );
+        
+        levelIDC = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+        
+        for( uint8_t i = 0; i < maxSubLayersMinus1; i++ )
+        {
+            profilePresent[ i ] = reader.ReadBit();
+            levelPresent[ i ]   = reader.ReadBit();
+        }
+        
+        if( maxSubLayersMinus1 > 0 )
+        {
+            reader.SkipBits( 2U * ( 8U - maxSubLayersMinus1 ) );
+        }
+        
+        for( uint8_t i = 0; i < maxSubLayersMinus1; i++ )
+        {
+            reader.SkipBits( ( profilePresent[ i ] ? 88U : 0U ) + ( levelPresent[ i ] ? 8U : 0U ) );
+        }
+    }
+    
+    static void SkipSubLayerOrderingInfo( BitReader & reader, uint8_t maxSubLayersMinus1 )
+    {
+        for( uint8_t i = ( reader.ReadBit() ) ? 0 : maxSubLayersMinus1; i <= maxSubLayersMinus1; i++ )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+    }
+    
+    static void SkipAVCScalingList( BitReader & reader, unsigned int size )
+    {
+        int32_t last( 8 );
+        int32_t next( 8 );
+        
+        for( unsigned int i = 0; i < size; i++ )
+        {
+            if( next != 0 )
+            {
+                next = ( last + reader.ReadSE() + 256 ) % 256;
+            }
+            
+            last = ( next == 0 ) ? last : next;
+        }
+    }
+    
+    static void SkipHEVCScalingListData( BitReader & reader )
+    {
+        for( unsigned int sizeID = 0; sizeID < 4; sizeID++ )
+        {
+            for( unsigned int matrixID = 0; matrixID < 6; matrixID += ( sizeID == 3 ) ? 3 : 1 )
+            {
+                if( reader.ReadBit() == false )
+                {
+                    reader.ReadUE();
+                    
+                    continue;
+                }
+                
+                if( sizeID > 1 )
+                {
+                    reader.ReadSE();
+                }
+                
+                for( unsigned int i = 0, n = std::min( 64U, 1U << ( 4 + ( sizeID << 1 ) ) ); i < n; i++ )
+                {
+                    reader.ReadSE();
+                }
+            }
+        }
+    }
+    
+    static void SkipShortTermRefPicSet( BitReader & reader, uint32_t index, uint32_t * numDeltaPocs )
+    {
+        if( index != 0 && reader.ReadBit() )
+        {
+            uint32_t count( 0 );
+            
+            reader.SkipBits( 1 );
+            reader.ReadUE();
+            
+            for( uint32_t i = 0; i <= numDeltaPocs[ index - 1 ]; i++ )
+            {
+                if( reader.ReadBit() || reader.ReadBit() )
+                {
+                    count++;
+                }
+            }
+            
+            numDeltaPocs[ index ] = count;
+        }
+        else
+        {
+            uint32_t negative( reader.ReadUE() );
+            uint32_t positive( reader.ReadUE() );
+            
+            if( negative > 16 || positive > 16 )
+            {
+                throw std::runtime_error( "Invalid SPS - Invalid short-term reference picture set" );
+            }
+            
+            for( uint32_t i = 0; i < negative + positive; i++ )
+            {
+                reader.ReadUE();
+                reader.SkipBits( 1 );
+            }
+            
+            numDeltaPocs[ index ] = negative + positive;
+        }
+    }
+    
+    static void ReadVideoSignalType( BitReader & reader, SequenceParameterSet & sps )
+    {
+        if( reader.ReadBit() )
+        {
+            if( reader.ReadBits( 8 ) == 255 )
+            {
+                reader.SkipBits( 32 );
+            }
+        }
+        
+        if( reader.ReadBit() )
+        {
+            reader.SkipBits( 1 );
+        }
+        
+        sps.hasVideoSignalType = reader.ReadBit();
+        
+        if( sps.hasVideoSignalType )
+        {
+            sps.videoFormat          = static_cast< uint8_t >( reader.ReadBits( 3 ) );
+            sps.fullRange            = reader.ReadBit();
+            sps.hasColourDescription = reader.ReadBit();
+            
+            if( sps.hasColourDescription )
+            {
+                sps.colourPrimaries         = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                sps.transferCharacteristics = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                sps.matrixCoefficients      = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+            }
+        }
+        
+        if( reader.ReadBit() )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+    }
+    
+    static void ReadAVCVUI( BitReader & reader, SequenceParameterSet & sps )
+    {
+        ReadVideoSignalType( reader, sps );
+        
+        sps.hasTiming = reader.ReadBit();
+        
+        if( sps.hasTiming )
+        {
+            sps.numUnitsInTick = reader.ReadBits( 32 );
+            sps.timeScale      = reader.ReadBits( 32 );
+        }
+    }
+    
+    static void ReadHEVCVUI( BitReader & reader, SequenceParameterSet & sps )
+    {
+        ReadVideoSignalType( reader, sps );
+        reader.SkipBits( 3 );
+        
+        if( reader.ReadBit() )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+        
+        sps.hasTiming = reader.ReadBit();
+        
+        if( sps.hasTiming )
+        {
+            sps.numUnitsInTick = reader.ReadBits( 32 );
+            sps.timeScale      = reader.ReadBits( 32 );
+        }
+    }
+    
+    static void SetCropping( SequenceParameterSet & sps, uint32_t unitX, uint32_t unitY, uint32_t left, uint32_t right, uint32_t top, uint32_t bottom )
+    {
+        uint64_t x( ( static_cast< uint64_t >( left ) + right ) * unitX );
+        uint64_t y( ( static_cast< uint64_t >( top ) + bottom ) * unitY );
+        
+        if( x > sps.codedWidth || y > sps.codedHeight )
+        {
+            throw std::runtime_error( "Invalid SPS - Invalid cropping window" );
+        }
+        
+        sps.cropLeft   = left   * unitX;
+        sps.cropRight  = right  * unitX;
+        sps.cropTop    = top    * unitY;
+        sps.cropBottom = bottom * unitY;
+        sps.width      = sps.codedWidth  - static_cast< uint32_t >( x );
+        sps.height     = sps.codedHeight - static_cast< uint32_t >( y );
+    }
+}
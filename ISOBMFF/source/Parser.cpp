@@ -52,6 +52,7 @@
 #include <ISOBMFF/DIMG.hpp>
 #include <ISOBMFF/THMB.hpp>
 #include <ISOBMFF/CDSC.hpp>
+#include <ISOBMFF/SingleItemTypeReferenceBox.hpp>
 #include <ISOBMFF/COLR.hpp>
 #include <ISOBMFF/ISPE.hpp>
 #include <ISOBMFF/IPMA.hpp>
@@ -60,6 +61,7 @@
 #include <ISOBMFF/STSD.hpp>
 #include <ISOBMFF/STSS.hpp>
 #include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/CTTS.hpp>
 #include <ISOBMFF/FRMA.hpp>
 #include <ISOBMFF/SCHM.hpp>
 #include <ISOBMFF/HVC1.hpp>
@@ -67,9 +69,16 @@
 #include <ISOBMFF/STSC.hpp>
 #include <ISOBMFF/STCO.hpp>
 #include <ISOBMFF/CO64.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <map>
 #include <stdexcept>
 #include <cstring>
+#include <atomic>
 
 namespace ISOBMFF
 {
@@ -162,7 +171,19 @@ namespace ISOBMFF
             }
         }
         
-        return std::make_shared< Box >( type );
+        return MakeShared< Box >( type );
+    }
+    
+    std::function< std::shared_ptr< Box >() > Parser::GetBoxFactory( const std::string & type ) const
+    {
+        auto it( this->impl->_types.find( type ) );
+        
+        if( it == this->impl->_types.end() )
+        {
+            return nullptr;
+        }
+        
+        return it->second;
     }
     
     void Parser::Parse( const std::string & path ) noexcept( false )
@@ -183,7 +204,8 @@ namespace ISOBMFF
     
     void Parser::Parse( BinaryStream & stream ) noexcept( false )
     {
-        char n[ 4 ] = { 0, 0, 0, 0 };
+        char                                     n[ 4 ] = { 0, 0, 0, 0 };
+        std::unique_ptr< MemoryResource::Scope > arena;
         
         if( stream.HasBytesAvailable() == false )
         {
@@ -212,8 +234,13 @@ namespace ISOBMFF
             throw std::runtime_error( std::string( "Data is not an ISO media file" ) );
         }
         
+        if( this->HasOption( Options::UseArena ) )
+        {
+            arena = std::make_unique< MemoryResource::Scope >( std::make_shared< MonotonicBufferResource >() );
+        }
+        
         this->impl->_path = "";
-        this->impl->_file = std::make_shared< File >();
+        this->impl->_file = MakeShared< File >();
         
         if( stream.HasBytesAvailable() )
         {
@@ -221,6 +248,69 @@ namespace ISOBMFF
         }
     }
     
+    void Parser::ParseMany( const std::vector< std::string > & paths, uint64_t options, const ParseManyCallback & callback ) const noexcept( false )
+    {
+        this->ParseMany( paths, options, callback, *( Executor::GetDefault() ) );
+    }
+    
+    void Parser::ParseMany( const std::vector< std::string > & paths, uint64_t options, const ParseManyCallback & callback, Executor & executor ) const noexcept( false )
+    {
+        std::atomic< size_t > next( 0 );
+        std::atomic< bool >   stop( false );
+        size_t                workers;
+        
+        if( paths.size() == 0 )
+        {
+            return;
+        }
+        
+        workers = std::min( std::max( executor.GetConcurrency(), static_cast< size_t >( 1 ) ), paths.size() );
+        
+        executor.ParallelFor
+        (
+            0,
+            workers,
+            1,
+            [ & ]( size_t, size_t )
+            {
+                Parser parser( *( this ) );
+                size_t i;
+                
+                parser.SetOptions( options );
+                
+                while( stop == false && ( i = next++ ) < paths.size() )
+                {
+                    std::shared_ptr< File > file;
+                    std::exception_ptr      error;
+                    
+                    try
+                    {
+                        parser.Parse( paths[ i ] );
+                        
+                        file = parser.GetFile();
+                    }
+                    catch( ... )
+                    {
+                        error = std::current_exception();
+                    }
+                    
+                    parser.impl->_file = nullptr;
+                    
+                    try
+                    {
+                        callback( i, paths[ i ], file, error );
+                    }
+                    catch( ... )
+                    {
+                        stop = true;
+                        
+                        throw;
+                    }
+                }
+            }
+        );
+    }
+    
     std::shared_ptr< File > Parser::GetFile() const
     {
         return this->impl->_file;
@@ -321,7 +411,7 @@ namespace ISOBMFF
             type,
             [ = ]() -> std::shared_ptr< Box >
             {
-                return std::make_shared< ContainerBox >( type );
+                return MakeShared< ContainerBox >( type );
             }
         );
     }
@@ -350,40 +440,47 @@ namespace ISOBMFF
         this->RegisterContainerBox( "tapt" );
         this->RegisterContainerBox( "schi" );
         
-        this->RegisterBox( "ftyp", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< FTYP >(); } );
-        this->RegisterBox( "mvhd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< MVHD >(); } );
-        this->RegisterBox( "tkhd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< TKHD >(); } );
-        this->RegisterBox( "meta", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< META >(); } );
-        this->RegisterBox( "hdlr", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< HDLR >(); } );
-        this->RegisterBox( "mdhd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< MDHD >(); } );
-        this->RegisterBox( "pitm", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< PITM >(); } );
-        this->RegisterBox( "iinf", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IINF >(); } );
-        this->RegisterBox( "dref", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< DREF >(); } );
-        this->RegisterBox( "url ", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< URL  >(); } );
-        this->RegisterBox( "urn ", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< URN  >(); } );
-        this->RegisterBox( "iloc", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< ILOC >(); } );
-        this->RegisterBox( "iref", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IREF >(); } );
-        this->RegisterBox( "infe", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< INFE >(); } );
-        this->RegisterBox( "irot", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IROT >(); } );
-        this->RegisterBox( "hvcC", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< HVCC >(); } );
-        this->RegisterBox( "avcC", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< AVCC >(); } );
-        this->RegisterBox( "dimg", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< DIMG >(); } );
-        this->RegisterBox( "thmb", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< THMB >(); } );
-        this->RegisterBox( "cdsc", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< CDSC >(); } );
-        this->RegisterBox( "colr", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< COLR >(); } );
-        this->RegisterBox( "ispe", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< ISPE >(); } );
-        this->RegisterBox( "ipma", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IPMA >(); } );
-        this->RegisterBox( "pixi", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< PIXI >(); } );
-        this->RegisterBox( "ipco", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IPCO >(); } );
-        this->RegisterBox( "stsd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STSD >(); } );
-        this->RegisterBox( "stss", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STSS >(); } );
-        this->RegisterBox( "stts", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STTS >(); } );
-        this->RegisterBox( "frma", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< FRMA >(); } );
-        this->RegisterBox( "schm", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SCHM >(); } );
-        this->RegisterBox( "hvc1", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< HVC1 >(); } );
-        this->RegisterBox( "avc1", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< AVC1 >(); } );
-        this->RegisterBox( "stsc", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STSC >(); } );
-        this->RegisterBox( "stco", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STCO >(); } );
-        this->RegisterBox( "co64", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< CO64 >(); } );
+        this->RegisterBox( "ftyp", [ = ]() -> std::shared_ptr< Box > { return MakeShared< FTYP >(); } );
+        this->RegisterBox( "mvhd", [ = ]() -> std::shared_ptr< Box > { return MakeShared< MVHD >(); } );
+        this->RegisterBox( "tkhd", [ = ]() -> std::shared_ptr< Box > { return MakeShared< TKHD >(); } );
+        this->RegisterBox( "meta", [ = ]() -> std::shared_ptr< Box > { return MakeShared< META >(); } );
+        this->RegisterBox( "hdlr", [ = ]() -> std::shared_ptr< Box > { return MakeShared< HDLR >(); } );
+        this->RegisterBox( "mdhd", [ = ]() -> std::shared_ptr< Box > { return MakeShared< MDHD >(); } );
+        this->RegisterBox( "pitm", [ = ]() -> std::shared_ptr< Box > { return MakeShared< PITM >(); } );
+        this->RegisterBox( "iinf", [ = ]() -> std::shared_ptr< Box > { return MakeShared< IINF >(); } );
+        this->RegisterBox( "dref", [ = ]() -> std::shared_ptr< Box > { return MakeShared< DREF >(); } );
+        this->RegisterBox( "url ", [ = ]() -> std::shared_ptr< Box > { return MakeShared< URL  >(); } );
+        this->RegisterBox( "urn ", [ = ]() -> std::shared_ptr< Box > { return MakeShared< URN  >(); } );
+        this->RegisterBox( "iloc", [ = ]() -> std::shared_ptr< Box > { return MakeShared< ILOC >(); } );
+        this->RegisterBox( "iref", [ = ]() -> std::shared_ptr< Box > { return MakeShared< IREF >(); } );
+        this->RegisterBox( "infe", [ = ]() -> std::shared_ptr< Box > { return MakeShared< INFE >(); } );
+        this->RegisterBox( "irot", [ = ]() -> std::shared_ptr< Box > { return MakeShared< IROT >(); } );
+        this->RegisterBox( "hvcC", [ = ]() -> std::shared_ptr< Box > { return MakeShared< HVCC >(); } );
+        this->RegisterBox( "avcC", [ = ]() -> std::shared_ptr< Box > { return MakeShared< AVCC >(); } );
+        this->RegisterBox( "dimg", [ = ]() -> std::shared_ptr< Box > { return MakeShared< DIMG >(); } );
+        this->RegisterBox( "thmb", [ = ]() -> std::shared_ptr< Box > { return MakeShared< THMB >(); } );
+        this->RegisterBox( "cdsc", [ = ]() -> std::shared_ptr< Box > { return MakeShared< CDSC >(); } );
+        this->RegisterBox( "auxl", [ = ]() -> std::shared_ptr< Box > { return MakeShared< SingleItemTypeReferenceBox >( "auxl" ); } );
+        this->RegisterBox( "colr", [ = ]() -> std::shared_ptr< Box > { return MakeShared< COLR >(); } );
+        this->RegisterBox( "ispe", [ = ]() -> std::shared_ptr< Box > { return MakeShared< ISPE >(); } );
+        this->RegisterBox( "ipma", [ = ]() -> std::shared_ptr< Box > { return MakeShared< IPMA >(); } );
+        this->RegisterBox( "pixi", [ = ]() -> std::shared_ptr< Box > { return MakeShared< PIXI >(); } );
+        this->RegisterBox( "ipco", [ = ]() -> std::shared_ptr< Box > { return MakeShared< IPCO >(); } );
+        this->RegisterBox( "stsd", [ = ]() -> std::shared_ptr< Box > { return MakeShared< STSD >(); } );
+        this->RegisterBox( "stss", [ = ]() -> std::shared_ptr< Box > { return MakeShared< STSS >(); } );
+        this->RegisterBox( "stts", [ = ]() -> std::shared_ptr< Box > { return MakeShared< STTS >(); } );
+        this->RegisterBox( "ctts", [ = ]() -> std::shared_ptr< Box > { return MakeShared< CTTS >(); } );
+        this->RegisterBox( "frma", [ = ]() -> std::shared_ptr< Box > { return MakeShared< FRMA >(); } );
+        this->RegisterBox( "schm", [ = ]() -> std::shared_ptr< Box > { return MakeShared< SCHM >(); } );
+        this->RegisterBox( "hvc1", [ = ]() -> std::shared_ptr< Box > { return MakeShared< HVC1 >(); } );
+        this->RegisterBox( "avc1", [ = ]() -> std::shared_ptr< Box > { return MakeShared< AVC1 >(); } );
+        this->RegisterBox( "stsc", [ = ]() -> std::shared_ptr< Box > { return MakeShared< STSC >(); } );
+        this->RegisterBox( "stco", [ = ]() -> std::shared_ptr< Box > { return MakeShared< STCO >(); } );
+        this->RegisterBox( "co64", [ = ]() -> std::shared_ptr< Box > { return MakeShared< CO64 >(); } );
+        this->RegisterBox( "stsz", [ = ]() -> std::shared_ptr< Box > { return MakeShared< STSZ >(); } );
+        this->RegisterBox( "trex", [ = ]() -> std::shared_ptr< Box > { return MakeShared< TREX >(); } );
+        this->RegisterBox( "tfhd", [ = ]() -> std::shared_ptr< Box > { return MakeShared< TFHD >(); } );
+        this->RegisterBox( "tfdt", [ = ]() -> std::shared_ptr< Box > { return MakeShared< TFDT >(); } );
+        this->RegisterBox( "trun", [ = ]() -> std::shared_ptr< Box > { return MakeShared< TRUN >(); } );
     }
 }
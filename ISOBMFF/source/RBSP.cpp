@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        RBSP.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/RBSP.hpp>
+#include <stdexcept>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    namespace RBSP
+    {
+        static bool HasZeroByte( const uint8_t * data );
+        
+        size_t Extract( Span< const uint8_t > data, Span< uint8_t > buffer )
+        {
+            size_t   size( data.size() );
+            size_t   start( 0 );
+            size_t   written( 0 );
+            unsigned zeros( 0 );
+            
+            if( buffer.size() < size )
+            {
+                throw std::runtime_error( "Invalid RBSP buffer - Buffer is too small" );
+            }
+            
+            for( size_t i = 0; i < size; )
+            {
+                if( zeros < 2 && size - i >= sizeof( uint64_t ) && HasZeroByte( data.data() + i ) == false )
+                {
+                    zeros  = 0;
+                    i     += sizeof( uint64_t );
+                    
+                    continue;
+                }
+                
+                if( zeros >= 2 && data[ i ] == 0x03 )
+                {
+                    memcpy( buffer.data() + written, data.data() + start, i - start );
+                    
+                    written += i - start;
+                    start    = i + 1;
+                    zeros    = 0;
+                }
+                else
+                {
+                    zeros = ( data[ i ] == 0 ) ? zeros + 1 : 0;
+                }
+                
+                i++;
+            }
+            
+            if( size > start )
+            {
+                memcpy( buffer.data() + written, data.data() + start, size - start );
+                
+                written += size - start;
+            }
+            
+            return written;
+        }
+        
+        std::vector< uint8_t > Extract( Span< const uint8_t > data )
+        {
+            std::vector< uint8_t > rbsp( data.size() );
+            
+            rbsp.resize( Extract( data, rbsp ) );
+            
+            return rbsp;
+        }
+        
+        static bool HasZeroByte( const uint8_t * data )
+        {
+            uint64_t word;
+            
+            memcpy( &word, data, sizeof( word ) );
+            
+            return ( ( word - 0x0101010101010101ULL ) & ~word & 0x8080808080808080ULL ) != 0;
+        }
+    }
+}
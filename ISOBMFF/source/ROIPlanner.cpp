@@ -0,0 +1,285 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ROIPlanner.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ROIPlanner.hpp>
+#include <ISOBMFF/ItemGraph.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/ISPE.hpp>
+#include <ISOBMFF/IROT.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ISOBMFF
+{
+    class ROIPlanner::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void Load( const META & meta, uint32_t itemID, const Span< const uint8_t > * file, BinaryStream * stream );
+            
+            ImageGrid               _grid;
+            ItemReader              _reader;
+            std::vector< uint32_t > _tileIDs;
+            uint8_t                 _rotation;
+            uint64_t                _width;
+            uint64_t                _height;
+            uint64_t                _tileWidth;
+            uint64_t                _tileHeight;
+    };
+    
+    ROIPlanner::ROIPlanner( const META & meta, uint32_t itemID, Span< const uint8_t > file ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->impl->Load( meta, itemID, &file, nullptr );
+    }
+    
+    ROIPlanner::ROIPlanner( const META & meta, uint32_t itemID, BinaryStream & stream ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->impl->Load( meta, itemID, nullptr, &stream );
+    }
+    
+    ROIPlanner::ROIPlanner( const ROIPlanner & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ROIPlanner::ROIPlanner( ROIPlanner && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ROIPlanner::~ROIPlanner()
+    {}
+    
+    ROIPlanner & ROIPlanner::operator =( ROIPlanner o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ROIPlanner & o1, ROIPlanner & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    const ImageGrid & ROIPlanner::GetGrid() const
+    {
+        return this->impl->_grid;
+    }
+    
+    uint8_t ROIPlanner::GetRotation() const
+    {
+        return this->impl->_rotation;
+    }
+    
+    uint64_t ROIPlanner::GetDisplayWidth() const
+    {
+        return ( this->impl->_rotation % 2 ) ? this->impl->_height : this->impl->_width;
+    }
+    
+    uint64_t ROIPlanner::GetDisplayHeight() const
+    {
+        return ( this->impl->_rotation % 2 ) ? this->impl->_width : this->impl->_height;
+    }
+    
+    uint64_t ROIPlanner::GetTileWidth() const
+    {
+        return this->impl->_tileWidth;
+    }
+    
+    uint64_t ROIPlanner::GetTileHeight() const
+    {
+        return this->impl->_tileHeight;
+    }
+    
+    ROIPlanner::Plan ROIPlanner::GetPlan( const Rectangle & region ) const
+    {
+        Plan     plan{ { 0, 0, 0, 0 }, {} };
+        uint64_t w( this->impl->_width );
+        uint64_t h( this->impl->_height );
+        uint64_t columns( static_cast< uint64_t >( this->impl->_grid.GetColumns() ) + 1 );
+        uint64_t rows( static_cast< uint64_t >( this->impl->_grid.GetRows() ) + 1 );
+        uint64_t dx0;
+        uint64_t dx1;
+        uint64_t dy0;
+        uint64_t dy1;
+        uint64_t x0;
+        uint64_t x1;
+        uint64_t y0;
+        uint64_t y1;
+        
+        if
+        (
+               region.width  == 0
+            || region.height == 0
+            || region.x      >= this->GetDisplayWidth()
+            || region.y      >= this->GetDisplayHeight()
+        )
+        {
+            return plan;
+        }
+        
+        dx0 = region.x;
+        dy0 = region.y;
+        dx1 = dx0 + std::min( region.width,  this->GetDisplayWidth()  - dx0 );
+        dy1 = dy0 + std::min( region.height, this->GetDisplayHeight() - dy0 );
+        
+        /* IROT is an anti-clockwise rotation - Map display coordinates back to the canvas */
+        switch( this->impl->_rotation )
+        {
+            case 1:  x0 = w - dy1; x1 = w - dy0; y0 = dx0;     y1 = dx1;     break;
+            case 2:  x0 = w - dx1; x1 = w - dx0; y0 = h - dy1; y1 = h - dy0; break;
+            case 3:  x0 = dy0;     x1 = dy1;     y0 = h - dx1; y1 = h - dx0; break;
+            default: x0 = dx0;     x1 = dx1;     y0 = dy0;     y1 = dy1;     break;
+        }
+        
+        plan.region = { x0, y0, x1 - x0, y1 - y0 };
+        
+        {
+            uint64_t c0( x0 / this->impl->_tileWidth );
+            uint64_t r0( y0 / this->impl->_tileHeight );
+            uint64_t c1( std::min( ( x1 - 1 ) / this->impl->_tileWidth,  columns - 1 ) );
+            uint64_t r1( std::min( ( y1 - 1 ) / this->impl->_tileHeight, rows    - 1 ) );
+            
+            for( uint64_t r = r0; r <= r1 && r0 < rows; r++ )
+            {
+                for( uint64_t c = c0; c <= c1 && c0 < columns; c++ )
+                {
+                    uint32_t id( this->impl->_tileIDs[ static_cast< size_t >( r * columns + c ) ] );
+                    
+                    plan.tiles.push_back
+                    (
+                        {
+                            id,
+                            static_cast< uint32_t >( r ),
+                            static_cast< uint32_t >( c ),
+                            { c * this->impl->_tileWidth, r * this->impl->_tileHeight, this->impl->_tileWidth, this->impl->_tileHeight },
+                            this->impl->_reader.GetRanges( id )
+                        }
+                    );
+                }
+            }
+        }
+        
+        return plan;
+    }
+    
+    ROIPlanner::IMPL::IMPL():
+        _rotation(   0 ),
+        _width(      0 ),
+        _height(     0 ),
+        _tileWidth(  0 ),
+        _tileHeight( 0 )
+    {}
+    
+    ROIPlanner::IMPL::IMPL( const IMPL & o ):
+        _grid(       o._grid ),
+        _reader(     o._reader ),
+        _tileIDs(    o._tileIDs ),
+        _rotation(   o._rotation ),
+        _width(      o._width ),
+        _height(     o._height ),
+        _tileWidth(  o._tileWidth ),
+        _tileHeight( o._tileHeight )
+    {}
+    
+    ROIPlanner::IMPL::~IMPL()
+    {}
+    
+    void ROIPlanner::IMPL::Load( const META & meta, uint32_t itemID, const Span< const uint8_t > * file, BinaryStream * stream )
+    {
+        ItemGraph               graph( meta );
+        std::vector< uint8_t >  data;
+        std::shared_ptr< ISPE > ispe( graph.GetTypedProperty< ISPE >( itemID, "ispe" ) );
+        std::shared_ptr< IROT > irot( graph.GetTypedProperty< IROT >( itemID, "irot" ) );
+        
+        if( graph.GetItemType( itemID ) != "grid" )
+        {
+            throw std::runtime_error( "Invalid item - Item " + std::to_string( itemID ) + " is not a grid" );
+        }
+        
+        this->_reader  = ItemReader( meta );
+        this->_tileIDs = graph.GetReferences( itemID, "dimg" );
+        
+        if( stream != nullptr )
+        {
+            data = this->_reader.ReadItem( itemID, *( stream ) );
+        }
+        else
+        {
+            for( const auto & span: this->_reader.GetItemSpans( itemID, *( file ) ) )
+            {
+                data.insert( data.end(), span.begin(), span.end() );
+            }
+        }
+        
+        {
+            BinaryDataStream grid( data );
+            
+            this->_grid = ImageGrid( grid );
+        }
+        
+        if( this->_tileIDs.size() != ( static_cast< size_t >( this->_grid.GetRows() ) + 1 ) * ( static_cast< size_t >( this->_grid.GetColumns() ) + 1 ) )
+        {
+            throw std::runtime_error( "Invalid grid - Tile count does not match rows and columns" );
+        }
+        
+        this->_width    = ( ispe != nullptr ) ? ispe->GetDisplayWidth()  : this->_grid.GetOutputWidth();
+        this->_height   = ( ispe != nullptr ) ? ispe->GetDisplayHeight() : this->_grid.GetOutputHeight();
+        this->_rotation = ( irot != nullptr ) ? irot->GetAngle() % 4     : 0;
+        
+        ispe = graph.GetTypedProperty< ISPE >( this->_tileIDs[ 0 ], "ispe" );
+        
+        if( ispe != nullptr )
+        {
+            this->_tileWidth  = ispe->GetDisplayWidth();
+            this->_tileHeight = ispe->GetDisplayHeight();
+        }
+        else
+        {
+            this->_tileWidth  = ( this->_width  + this->_grid.GetColumns() ) / ( static_cast< uint64_t >( this->_grid.GetColumns() ) + 1 );
+            this->_tileHeight = ( this->_height + this->_grid.GetRows() )    / ( static_cast< uint64_t >( this->_grid.GetRows() )    + 1 );
+        }
+        
+        if( this->_tileWidth == 0 || this->_tileHeight == 0 )
+        {
+            throw std::runtime_error( "Invalid grid - Empty tiles" );
+        }
+    }
+}
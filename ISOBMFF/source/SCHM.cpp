@@ -30,11 +30,12 @@
 
 #include <ISOBMFF/SCHM.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstdint>
 
 namespace ISOBMFF
 {
-    class SCHM::IMPL
+    class SCHM::IMPL: public ResourceAllocated
     {
         public:
             
@@ -42,9 +43,10 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
-            std::string _schemeType;
-            uint32_t    _schemeVersion;
-            std::string _schemeURI;
+            std::string        _schemeType;
+            uint32_t           _schemeVersion;
+            std::string        _schemeURI;
+            Parser::StringType _stringType;
     };
     
     SCHM::SCHM():
@@ -90,6 +92,8 @@ namespace ISOBMFF
         this->SetSchemeType( stream.ReadFourCC() );
         this->SetSchemeVersion( stream.ReadBigEndianUInt32() );
         
+        this->impl->_stringType = parser.GetPreferredStringType();
+        
         if( this->GetFlags() & 0x000001 )
         {
             if( parser.GetPreferredStringType() == Parser::StringType::Pascal )
@@ -103,6 +107,38 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t SCHM::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() + 8 );
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            size += this->GetSchemeURI().size() + 1;
+        }
+        
+        return size;
+    }
+    
+    void SCHM::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteFourCC( this->GetSchemeType() );
+        stream.WriteBigEndianUInt32( this->GetSchemeVersion() );
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            if( this->impl->_stringType == Parser::StringType::Pascal )
+            {
+                stream.WritePascalString( this->GetSchemeURI() );
+            }
+            else
+            {
+                stream.WriteNULLTerminatedString( this->GetSchemeURI() );
+            }
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > SCHM::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -145,13 +181,15 @@ namespace ISOBMFF
     }
     
     SCHM::IMPL::IMPL():
-        _schemeVersion( 0 )
+        _schemeVersion( 0 ),
+        _stringType( Parser::StringType::NULLTerminated )
     {}
 
     SCHM::IMPL::IMPL( const IMPL & o ):
         _schemeType( o._schemeType ),
         _schemeVersion( o._schemeVersion ),
-        _schemeURI( o._schemeURI )
+        _schemeURI( o._schemeURI ),
+        _stringType( o._stringType )
     {}
 
     SCHM::IMPL::~IMPL()
@@ -30,12 +30,13 @@
 
 #include <ISOBMFF/STCO.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class STCO::IMPL
+    class STCO::IMPL: public ResourceAllocated
     {
         public:
 
@@ -94,6 +95,23 @@ namespace ISOBMFF
         }
     }
 
+    uint64_t STCO::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + 4 * static_cast< uint64_t >( this->impl->_chunk_offset_table.size() );
+    }
+
+    void STCO::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_chunk_offset_table.size() ) );
+
+        for( uint32_t offset: this->impl->_chunk_offset_table )
+        {
+            stream.WriteBigEndianUInt32( offset );
+        }
+    }
+
     std::vector< std::pair< std::string, std::string > > STCO::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -116,6 +134,16 @@ namespace ISOBMFF
         return this->impl->_chunk_offset_table[ index ];
     }
 
+    void STCO::SetChunkOffset( size_t index, uint32_t value )
+    {
+        this->impl->_chunk_offset_table[ index ] = value;
+    }
+
+    void STCO::AddChunkOffset( uint32_t value )
+    {
+        this->impl->_chunk_offset_table.push_back( value );
+    }
+
     STCO::IMPL::IMPL()
     {}
 
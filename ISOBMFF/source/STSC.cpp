@@ -30,12 +30,13 @@
 
 #include <ISOBMFF/STSC.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class STSC::IMPL
+    class STSC::IMPL: public ResourceAllocated
     {
         public:
 
@@ -90,7 +91,30 @@ namespace ISOBMFF
 
         for( uint32_t i = 0; i < entry_count; i++ )
         {
-            this->impl->_sample_to_chunk_table.emplace_back(stream.ReadBigEndianUInt32(), stream.ReadBigEndianUInt32(), stream.ReadBigEndianUInt32());
+            uint32_t first_chunk              = stream.ReadBigEndianUInt32();
+            uint32_t samples_per_chunk        = stream.ReadBigEndianUInt32();
+            uint32_t sample_description_index = stream.ReadBigEndianUInt32();
+
+            this->impl->_sample_to_chunk_table.emplace_back(first_chunk, samples_per_chunk, sample_description_index);
+        }
+    }
+
+    uint64_t STSC::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + 12 * static_cast< uint64_t >( this->impl->_sample_to_chunk_table.size() );
+    }
+
+    void STSC::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sample_to_chunk_table.size() ) );
+
+        for( const auto & entry: this->impl->_sample_to_chunk_table )
+        {
+            stream.WriteBigEndianUInt32( entry.firstChunk );
+            stream.WriteBigEndianUInt32( entry.samplesPerChunk );
+            stream.WriteBigEndianUInt32( entry.sampleDescriptionId );
         }
     }
 
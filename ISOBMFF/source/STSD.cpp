@@ -30,10 +30,11 @@
 
 #include <ISOBMFF/STSD.hpp>
 #include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class STSD::IMPL
+    class STSD::IMPL: public ResourceAllocated
     {
         public:
             
@@ -42,6 +43,7 @@ namespace ISOBMFF
             ~IMPL();
             
             std::vector< std::shared_ptr< Box > > _boxes;
+            std::vector< uint8_t >                _padding;
     };
     
     STSD::STSD():
@@ -86,9 +88,39 @@ namespace ISOBMFF
         
         FullBox::ReadData( parser, stream );
         stream.ReadBigEndianUInt32();
+        container.SetSourceRange( this->GetSourceOffset(), this->GetSourceSize(), this->GetSourceHeaderSize() );
         container.ReadData( parser, stream );
         
-        this->impl->_boxes = container.GetBoxes();
+        this->impl->_boxes   = container.GetBoxes();
+        this->impl->_padding = container.GetPadding();
+    }
+    
+    uint64_t STSD::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() + 4 );
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            size += box->GetSize();
+        }
+        
+        size += this->impl->_padding.size();
+        
+        return size;
+    }
+    
+    void STSD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_boxes.size() ) );
+        
+        for( const auto & box: this->impl->_boxes )
+        {
+            box->Write( stream );
+        }
+        
+        stream.Write( this->impl->_padding );
     }
     
     void STSD::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
@@ -110,11 +142,17 @@ namespace ISOBMFF
         return this->impl->_boxes;
     }
     
+    Span< const std::shared_ptr< Box > > STSD::GetBoxesSpan() const
+    {
+        return this->impl->_boxes;
+    }
+    
     STSD::IMPL::IMPL()
     {}
 
     STSD::IMPL::IMPL( const IMPL & o ):
-        _boxes( o._boxes )
+        _boxes( o._boxes ),
+        _padding( o._padding )
     {}
 
     STSD::IMPL::~IMPL()
@@ -30,12 +30,13 @@
 
 #include <ISOBMFF/STSS.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class STSS::IMPL
+    class STSS::IMPL: public ResourceAllocated
     {
         public:
 
@@ -94,6 +95,23 @@ namespace ISOBMFF
         }
     }
 
+    uint64_t STSS::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + 4 * static_cast< uint64_t >( this->impl->_sample_number.size() );
+    }
+
+    void STSS::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sample_number.size() ) );
+
+        for( uint32_t sample: this->impl->_sample_number )
+        {
+            stream.WriteBigEndianUInt32( sample );
+        }
+    }
+
     std::vector< std::pair< std::string, std::string > > STSS::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        STSZ.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class STSZ::IMPL: public ResourceAllocated
+    {
+        public:
+
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+
+            uint32_t                _sample_size;
+            uint32_t                _sample_count;
+            std::vector< uint32_t > _entry_size;
+    };
+
+    STSZ::STSZ():
+        FullBox( "stsz" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+
+    STSZ::STSZ( const STSZ & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+
+    STSZ::STSZ( STSZ && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+
+    STSZ::~STSZ()
+    {}
+
+    STSZ & STSZ::operator =( STSZ o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+
+        return *( this );
+    }
+
+    void swap( STSZ & o1, STSZ & o2 )
+    {
+        using std::swap;
+
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+
+    void STSZ::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+
+        this->impl->_sample_size  = stream.ReadBigEndianUInt32();
+        this->impl->_sample_count = stream.ReadBigEndianUInt32();
+
+        this->impl->_entry_size.clear();
+
+        if( this->impl->_sample_size != 0 )
+        {
+            return;
+        }
+
+        if( this->impl->_sample_count > stream.AvailableBytes() / 4 )
+        {
+            throw std::runtime_error( "Invalid STSZ - Not enough data for sample count" );
+        }
+
+        this->impl->_entry_size.reserve( this->impl->_sample_count );
+
+        for( uint32_t i = 0; i < this->impl->_sample_count; i++ )
+        {
+            this->impl->_entry_size.emplace_back( stream.ReadBigEndianUInt32() );
+        }
+    }
+
+    uint64_t STSZ::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 8 + ( ( this->impl->_sample_size == 0 ) ? 4 * static_cast< uint64_t >( this->impl->_entry_size.size() ) : 0 );
+    }
+
+    void STSZ::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( this->impl->_sample_size );
+        stream.WriteBigEndianUInt32( this->impl->_sample_count );
+
+        if( this->impl->_sample_size != 0 )
+        {
+            return;
+        }
+
+        for( uint32_t size: this->impl->_entry_size )
+        {
+            stream.WriteBigEndianUInt32( size );
+        }
+    }
+
+    std::vector< std::pair< std::string, std::string > > STSZ::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+
+        props.push_back( { "Sample Size",  std::to_string( this->GetSampleSize() ) } );
+        props.push_back( { "Sample Count", std::to_string( this->GetSampleCount() ) } );
+
+        for( unsigned int index = 0; index < this->impl->_entry_size.size(); index++ )
+        {
+            props.push_back( { "Entry Size",  std::to_string( this->GetEntrySize( index ) ) } );
+        }
+
+        return props;
+    }
+
+    uint32_t STSZ::GetSampleSize() const
+    {
+        return this->impl->_sample_size;
+    }
+
+    uint32_t STSZ::GetSampleCount() const
+    {
+        return this->impl->_sample_count;
+    }
+
+    uint32_t STSZ::GetEntrySize( size_t index ) const
+    {
+        if( this->impl->_sample_size != 0 )
+        {
+            return this->impl->_sample_size;
+        }
+
+        return this->impl->_entry_size[ index ];
+    }
+
+    STSZ::IMPL::IMPL():
+        _sample_size( 0 ),
+        _sample_count( 0 )
+    {}
+
+    STSZ::IMPL::IMPL( const IMPL & o )
+    {
+        this->_sample_size   = o._sample_size;
+        this->_sample_count  = o._sample_count;
+        this->_entry_size    = o._entry_size;
+    }
+
+    STSZ::IMPL::~IMPL()
+    {}
+}
@@ -30,12 +30,13 @@
 
 #include <ISOBMFF/STTS.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstdint>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class STTS::IMPL
+    class STTS::IMPL: public ResourceAllocated
     {
         public:
 
@@ -96,6 +97,24 @@ namespace ISOBMFF
         }
     }
 
+    uint64_t STTS::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + 8 * static_cast< uint64_t >( this->impl->_sample_count.size() );
+    }
+
+    void STTS::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sample_count.size() ) );
+
+        for( size_t i = 0; i < this->impl->_sample_count.size(); i++ )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_sample_count[ i ] );
+            stream.WriteBigEndianUInt32( this->impl->_sample_offset[ i ] );
+        }
+    }
+
     std::vector< std::pair< std::string, std::string > > STTS::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
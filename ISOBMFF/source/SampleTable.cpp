@@ -0,0 +1,371 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SampleTable.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/STSC.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/CO64.hpp>
+#include <ISOBMFF/STSS.hpp>
+#include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/CTTS.hpp>
+#include <stdexcept>
+#include <algorithm>
+#include <vector>
+
+namespace ISOBMFF
+{
+    class SampleTable::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void CheckSample( size_t sample ) const;
+            void CheckChunk( size_t chunk )   const;
+            
+            std::vector< uint64_t > _offsets;
+            std::vector< uint32_t > _sizes;
+            std::vector< bool >     _sync;
+            std::vector< uint64_t > _times;
+            std::vector< int32_t >  _compositionOffsets;
+            std::vector< uint64_t > _chunkOffsets;
+            std::vector< size_t >   _chunkFirstSamples;
+            std::vector< uint32_t > _chunkSampleDescriptionIndexes;
+    };
+    
+    SampleTable::SampleTable():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SampleTable::SampleTable( const Container & stbl ):
+        impl( std::make_unique< IMPL >() )
+    {
+        std::shared_ptr< STSZ > stsz( stbl.GetTypedBox< STSZ >( "stsz" ) );
+        std::shared_ptr< STSC > stsc( stbl.GetTypedBox< STSC >( "stsc" ) );
+        std::shared_ptr< STCO > stco( stbl.GetTypedBox< STCO >( "stco" ) );
+        std::shared_ptr< CO64 > co64( stbl.GetTypedBox< CO64 >( "co64" ) );
+        std::shared_ptr< STSS > stss( stbl.GetTypedBox< STSS >( "stss" ) );
+        std::shared_ptr< STTS > stts( stbl.GetTypedBox< STTS >( "stts" ) );
+        std::shared_ptr< CTTS > ctts( stbl.GetTypedBox< CTTS >( "ctts" ) );
+        size_t                  sampleCount;
+        size_t                  sample( 0 );
+        
+        if( stsz == nullptr || stsc == nullptr || ( stco == nullptr && co64 == nullptr ) )
+        {
+            throw std::runtime_error( "Invalid sample table - Missing STSZ, STSC or chunk offset box" );
+        }
+        
+        sampleCount = stsz->GetSampleCount();
+        
+        if( stco != nullptr )
+        {
+            for( size_t i = 0; i < stco->GetEntryCount(); i++ )
+            {
+                this->impl->_chunkOffsets.push_back( stco->GetChunkOffset( i ) );
+            }
+        }
+        else
+        {
+            for( size_t i = 0; i < co64->GetEntryCount(); i++ )
+            {
+                this->impl->_chunkOffsets.push_back( co64->GetChunkOffset( i ) );
+            }
+        }
+        
+        this->impl->_chunkFirstSamples.clear();
+        this->impl->_offsets.reserve( sampleCount );
+        this->impl->_sizes.reserve( sampleCount );
+        this->impl->_chunkFirstSamples.reserve( this->impl->_chunkOffsets.size() + 1 );
+        this->impl->_chunkSampleDescriptionIndexes.reserve( this->impl->_chunkOffsets.size() );
+        
+        for( size_t i = 0; i < stsc->GetEntryCount(); i++ )
+        {
+            SampleToChunk entry( stsc->GetSampleToChunk( i ) );
+            size_t        first( entry.firstChunk );
+            size_t        last( this->impl->_chunkOffsets.size() );
+            
+            if( i + 1 < stsc->GetEntryCount() )
+            {
+                last = std::min< size_t >( last, stsc->GetSampleToChunk( i + 1 ).firstChunk - 1 );
+            }
+            
+            if( first == 0 || first - 1 != this->impl->_chunkFirstSamples.size() || last < first - 1 )
+            {
+                throw std::runtime_error( "Invalid sample table - Invalid STSC entry" );
+            }
+            
+            for( size_t chunk = first - 1; chunk < last; chunk++ )
+            {
+                uint64_t offset( this->impl->_chunkOffsets[ chunk ] );
+                
+                if( entry.samplesPerChunk > sampleCount - sample )
+                {
+                    throw std::runtime_error( "Invalid sample table - STSC describes more samples than STSZ" );
+                }
+                
+                this->impl->_chunkFirstSamples.push_back( sample );
+                this->impl->_chunkSampleDescriptionIndexes.push_back( entry.sampleDescriptionId );
+                
+                for( uint32_t j = 0; j < entry.samplesPerChunk; j++, sample++ )
+                {
+                    uint32_t size( stsz->GetEntrySize( sample ) );
+                    
+                    this->impl->_offsets.push_back( offset );
+                    this->impl->_sizes.push_back( size );
+                    
+                    offset += size;
+                }
+            }
+        }
+        
+        if( sample != sampleCount || this->impl->_chunkFirstSamples.size() != this->impl->_chunkOffsets.size() )
+        {
+            throw std::runtime_error( "Invalid sample table - STSC does not match STSZ and chunk offsets" );
+        }
+        
+        this->impl->_chunkFirstSamples.push_back( sample );
+        
+        if( stss != nullptr )
+        {
+            this->impl->_sync.resize( sampleCount, false );
+            
+            for( size_t i = 0; i < stss->GetEntryCount(); i++ )
+            {
+                uint32_t number( stss->GetSampleNumber( i ) );
+                
+                if( number > 0 && number <= sampleCount )
+                {
+                    this->impl->_sync[ number - 1 ] = true;
+                }
+            }
+        }
+        
+        this->impl->_times.clear();
+        this->impl->_times.reserve( sampleCount + 1 );
+        
+        if( stts != nullptr )
+        {
+            uint64_t time( 0 );
+            
+            for( size_t i = 0; i < stts->GetEntryCount() && this->impl->_times.size() < sampleCount; i++ )
+            {
+                uint32_t count( stts->GetSampleCount( i ) );
+                uint32_t delta( stts->GetSampleOffset( i ) );
+                
+                for( uint32_t j = 0; j < count && this->impl->_times.size() < sampleCount; j++ )
+                {
+                    this->impl->_times.push_back( time );
+                    
+                    time += delta;
+                }
+            }
+            
+            /* Samples not described by the STTS box have no duration */
+            this->impl->_times.resize( sampleCount + 1, time );
+        }
+        else
+        {
+            this->impl->_times.resize( sampleCount + 1, 0 );
+        }
+        
+        if( ctts != nullptr )
+        {
+            this->impl->_compositionOffsets.reserve( sampleCount );
+            
+            for( size_t i = 0; i < ctts->GetEntryCount() && this->impl->_compositionOffsets.size() < sampleCount; i++ )
+            {
+                uint32_t count( ctts->GetSampleCount( i ) );
+                int32_t  offset( ctts->GetSampleOffset( i ) );
+                
+                for( uint32_t j = 0; j < count && this->impl->_compositionOffsets.size() < sampleCount; j++ )
+                {
+                    this->impl->_compositionOffsets.push_back( offset );
+                }
+            }
+            
+            this->impl->_compositionOffsets.resize( sampleCount, 0 );
+        }
+    }
+    
+    SampleTable::SampleTable( const SampleTable & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SampleTable::SampleTable( SampleTable && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SampleTable::~SampleTable()
+    {}
+    
+    SampleTable & SampleTable::operator =( SampleTable o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SampleTable & o1, SampleTable & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    size_t SampleTable::GetSampleCount() const
+    {
+        return this->impl->_sizes.size();
+    }
+    
+    uint64_t SampleTable::GetSampleOffset( size_t sample ) const
+    {
+        this->impl->CheckSample( sample );
+        
+        return this->impl->_offsets[ sample ];
+    }
+    
+    uint32_t SampleTable::GetSampleSize( size_t sample ) const
+    {
+        this->impl->CheckSample( sample );
+        
+        return this->impl->_sizes[ sample ];
+    }
+    
+    bool SampleTable::IsSyncSample( size_t sample ) const
+    {
+        this->impl->CheckSample( sample );
+        
+        return this->impl->_sync.empty() || this->impl->_sync[ sample ];
+    }
+    
+    uint64_t SampleTable::GetSampleTime( size_t sample ) const
+    {
+        this->impl->CheckSample( sample );
+        
+        return this->impl->_times[ sample ];
+    }
+    
+    uint32_t SampleTable::GetSampleDuration( size_t sample ) const
+    {
+        this->impl->CheckSample( sample );
+        
+        return static_cast< uint32_t >( this->impl->_times[ sample + 1 ] - this->impl->_times[ sample ] );
+    }
+    
+    bool SampleTable::HasCompositionOffsets() const
+    {
+        return this->impl->_compositionOffsets.empty() == false;
+    }
+    
+    int32_t SampleTable::GetCompositionOffset( size_t sample ) const
+    {
+        this->impl->CheckSample( sample );
+        
+        return ( this->impl->_compositionOffsets.empty() ) ? 0 : this->impl->_compositionOffsets[ sample ];
+    }
+    
+    uint64_t SampleTable::GetDuration() const
+    {
+        return this->impl->_times.back();
+    }
+    
+    size_t SampleTable::GetChunkCount() const
+    {
+        return this->impl->_chunkOffsets.size();
+    }
+    
+    uint64_t SampleTable::GetChunkOffset( size_t chunk ) const
+    {
+        this->impl->CheckChunk( chunk );
+        
+        return this->impl->_chunkOffsets[ chunk ];
+    }
+    
+    size_t SampleTable::GetChunkFirstSample( size_t chunk ) const
+    {
+        this->impl->CheckChunk( chunk );
+        
+        return this->impl->_chunkFirstSamples[ chunk ];
+    }
+    
+    size_t SampleTable::GetChunkSampleCount( size_t chunk ) const
+    {
+        this->impl->CheckChunk( chunk );
+        
+        return this->impl->_chunkFirstSamples[ chunk + 1 ] - this->impl->_chunkFirstSamples[ chunk ];
+    }
+    
+    uint32_t SampleTable::GetChunkSampleDescriptionIndex( size_t chunk ) const
+    {
+        this->impl->CheckChunk( chunk );
+        
+        return this->impl->_chunkSampleDescriptionIndexes[ chunk ];
+    }
+    
+    SampleTable::IMPL::IMPL():
+        _times( 1, 0 ),
+        _chunkFirstSamples( 1, 0 )
+    {}
+    
+    SampleTable::IMPL::IMPL( const IMPL & o ):
+        _offsets( o._offsets ),
+        _sizes( o._sizes ),
+        _sync( o._sync ),
+        _times( o._times ),
+        _compositionOffsets( o._compositionOffsets ),
+        _chunkOffsets( o._chunkOffsets ),
+        _chunkFirstSamples( o._chunkFirstSamples ),
+        _chunkSampleDescriptionIndexes( o._chunkSampleDescriptionIndexes )
+    {}
+    
+    SampleTable::IMPL::~IMPL()
+    {}
+    
+    void SampleTable::IMPL::CheckSample( size_t sample ) const
+    {
+        if( sample >= this->_sizes.size() )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+    }
+    
+    void SampleTable::IMPL::CheckChunk( size_t chunk ) const
+    {
+        if( chunk >= this->_chunkOffsets.size() )
+        {
+            throw std::runtime_error( "Invalid chunk index" );
+        }
+    }
+}
@@ -0,0 +1,431 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SampleTableBuilder.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SampleTableBuilder.hpp>
+#include <ISOBMFF/STSC.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class SampleTableBuilder::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void CloseChunk( std::vector< SampleToChunk > & entries, size_t chunk, uint32_t samples, uint32_t sampleDescriptionIndex ) const;
+            
+            std::vector< std::pair< uint32_t, uint32_t > > _timeToSample;
+            std::vector< std::pair< uint32_t, int32_t > >  _compositionOffsets;
+            std::vector< SampleToChunk >                   _sampleToChunk;
+            std::vector< uint64_t >                        _chunkOffsets;
+            std::vector< uint32_t >                        _sizes;
+            std::vector< uint32_t >                        _syncSamples;
+            uint32_t                                       _constantSize;
+            bool                                           _allSync;
+            bool                                           _hasCompositionOffsets;
+            bool                                           _hasNegativeCompositionOffsets;
+            size_t                                         _sampleCount;
+            uint64_t                                       _duration;
+            uint32_t                                       _chunkSamples;
+            uint32_t                                       _chunkSampleDescriptionIndex;
+    };
+    
+    SampleTableBuilder::SampleTableBuilder():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SampleTableBuilder::SampleTableBuilder( const SampleTableBuilder & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SampleTableBuilder::SampleTableBuilder( SampleTableBuilder && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SampleTableBuilder::~SampleTableBuilder()
+    {}
+    
+    SampleTableBuilder & SampleTableBuilder::operator =( SampleTableBuilder o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void SampleTableBuilder::AddChunk( uint64_t offset, uint32_t sampleDescriptionIndex )
+    {
+        if( sampleDescriptionIndex == 0 )
+        {
+            throw std::runtime_error( "Invalid sample description index" );
+        }
+        
+        if( this->impl->_chunkOffsets.size() > 0 && this->impl->_chunkSamples == 0 )
+        {
+            this->impl->_chunkOffsets.back()         = offset;
+            this->impl->_chunkSampleDescriptionIndex = sampleDescriptionIndex;
+            
+            return;
+        }
+        
+        if( this->impl->_chunkOffsets.size() > 0 )
+        {
+            this->impl->CloseChunk( this->impl->_sampleToChunk, this->impl->_chunkOffsets.size(), this->impl->_chunkSamples, this->impl->_chunkSampleDescriptionIndex );
+        }
+        
+        this->impl->_chunkOffsets.push_back( offset );
+        
+        this->impl->_chunkSamples                = 0;
+        this->impl->_chunkSampleDescriptionIndex = sampleDescriptionIndex;
+    }
+    
+    void SampleTableBuilder::AddSample( uint32_t size, uint32_t duration, int32_t compositionOffset, bool sync )
+    {
+        if( this->impl->_chunkOffsets.size() == 0 )
+        {
+            throw std::runtime_error( "Invalid sample - No chunk was started" );
+        }
+        
+        if( this->impl->_sampleCount >= UINT32_MAX )
+        {
+            throw std::runtime_error( "Invalid sample - Too many samples" );
+        }
+        
+        if( this->impl->_timeToSample.size() > 0 && this->impl->_timeToSample.back().second == duration )
+        {
+            this->impl->_timeToSample.back().first++;
+        }
+        else
+        {
+            this->impl->_timeToSample.emplace_back( 1, duration );
+        }
+        
+        if( this->impl->_compositionOffsets.size() > 0 && this->impl->_compositionOffsets.back().second == compositionOffset )
+        {
+            this->impl->_compositionOffsets.back().first++;
+        }
+        else
+        {
+            this->impl->_compositionOffsets.emplace_back( 1, compositionOffset );
+        }
+        
+        if( compositionOffset != 0 )
+        {
+            this->impl->_hasCompositionOffsets = true;
+        }
+        
+        if( compositionOffset < 0 )
+        {
+            this->impl->_hasNegativeCompositionOffsets = true;
+        }
+        
+        /* Sizes are only stored once they differ */
+        if( this->impl->_sampleCount == 0 )
+        {
+            this->impl->_constantSize = size;
+        }
+        else if( this->impl->_sizes.size() == 0 && size != this->impl->_constantSize )
+        {
+            this->impl->_sizes.assign( this->impl->_sampleCount, this->impl->_constantSize );
+        }
+        
+        if( this->impl->_sizes.size() > 0 )
+        {
+            this->impl->_sizes.push_back( size );
+        }
+        
+        /* Sync samples are only stored once a sample is not a sync sample */
+        if( sync == false && this->impl->_allSync )
+        {
+            this->impl->_allSync = false;
+            
+            for( size_t i = 0; i < this->impl->_sampleCount; i++ )
+            {
+                this->impl->_syncSamples.push_back( static_cast< uint32_t >( i + 1 ) );
+            }
+        }
+        
+        if( sync && this->impl->_allSync == false )
+        {
+            this->impl->_syncSamples.push_back( static_cast< uint32_t >( this->impl->_sampleCount + 1 ) );
+        }
+        
+        this->impl->_sampleCount++;
+        this->impl->_chunkSamples++;
+        
+        this->impl->_duration += duration;
+    }
+    
+    void SampleTableBuilder::SetLastSampleDuration( uint32_t duration )
+    {
+        if( this->impl->_sampleCount == 0 )
+        {
+            throw std::runtime_error( "Invalid sample - No sample was added" );
+        }
+        
+        std::pair< uint32_t, uint32_t > & last( this->impl->_timeToSample.back() );
+        
+        this->impl->_duration = this->impl->_duration - last.second + duration;
+        
+        if( last.second == duration )
+        {
+            return;
+        }
+        
+        if( last.first > 1 )
+        {
+            last.first--;
+            
+            this->impl->_timeToSample.emplace_back( 1, duration );
+        }
+        else if( this->impl->_timeToSample.size() > 1 && this->impl->_timeToSample[ this->impl->_timeToSample.size() - 2 ].second == duration )
+        {
+            this->impl->_timeToSample.pop_back();
+            this->impl->_timeToSample.back().first++;
+        }
+        else
+        {
+            last.second = duration;
+        }
+    }
+    
+    size_t SampleTableBuilder::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    size_t SampleTableBuilder::GetChunkCount() const
+    {
+        return this->impl->_chunkOffsets.size();
+    }
+    
+    uint64_t SampleTableBuilder::GetDuration() const
+    {
+        return this->impl->_duration;
+    }
+    
+    void SampleTableBuilder::Write( BinaryOutputStream & stream, const std::vector< Span< const uint8_t > > & sampleEntries ) const
+    {
+        std::vector< SampleToChunk > sampleToChunk( this->impl->_sampleToChunk );
+        size_t                       chunks( this->impl->_chunkOffsets.size() );
+        bool                         large( false );
+        size_t                       stbl;
+        size_t                       box;
+        
+        /* A trailing chunk without samples is not written */
+        if( chunks > 0 && this->impl->_chunkSamples == 0 )
+        {
+            chunks--;
+        }
+        else if( chunks > 0 )
+        {
+            this->impl->CloseChunk( sampleToChunk, chunks, this->impl->_chunkSamples, this->impl->_chunkSampleDescriptionIndex );
+        }
+        
+        for( size_t i = 0; i < chunks; i++ )
+        {
+            if( this->impl->_chunkOffsets[ i ] > UINT32_MAX )
+            {
+                large = true;
+                
+                break;
+            }
+        }
+        
+        stbl = stream.BeginBox( "stbl" );
+        
+        {
+            box = stream.BeginFullBox( "stsd", 0, 0 );
+            
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( sampleEntries.size() ) );
+            
+            for( const auto & entry: sampleEntries )
+            {
+                stream.Write( entry );
+            }
+            
+            stream.EndBox( box );
+        }
+        
+        {
+            box = stream.BeginFullBox( "stts", 0, 0 );
+            
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_timeToSample.size() ) );
+            
+            for( const auto & entry: this->impl->_timeToSample )
+            {
+                stream.WriteBigEndianUInt32( entry.first );
+                stream.WriteBigEndianUInt32( entry.second );
+            }
+            
+            stream.EndBox( box );
+        }
+        
+        if( this->impl->_hasCompositionOffsets )
+        {
+            box = stream.BeginFullBox( "ctts", ( this->impl->_hasNegativeCompositionOffsets ) ? 1 : 0, 0 );
+            
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_compositionOffsets.size() ) );
+            
+            for( const auto & entry: this->impl->_compositionOffsets )
+            {
+                stream.WriteBigEndianUInt32( entry.first );
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( entry.second ) );
+            }
+            
+            stream.EndBox( box );
+        }
+        
+        {
+            box = stream.BeginFullBox( "stsc", 0, 0 );
+            
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( sampleToChunk.size() ) );
+            
+            for( const auto & entry: sampleToChunk )
+            {
+                stream.WriteBigEndianUInt32( entry.firstChunk );
+                stream.WriteBigEndianUInt32( entry.samplesPerChunk );
+                stream.WriteBigEndianUInt32( entry.sampleDescriptionId );
+            }
+            
+            stream.EndBox( box );
+        }
+        
+        {
+            box = stream.BeginFullBox( "stsz", 0, 0 );
+            
+            if( this->impl->_sizes.size() == 0 )
+            {
+                stream.WriteBigEndianUInt32( this->impl->_constantSize );
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sampleCount ) );
+            }
+            else
+            {
+                stream.WriteBigEndianUInt32( 0 );
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sampleCount ) );
+                
+                for( uint32_t size: this->impl->_sizes )
+                {
+                    stream.WriteBigEndianUInt32( size );
+                }
+            }
+            
+            stream.EndBox( box );
+        }
+        
+        {
+            box = stream.BeginFullBox( ( large ) ? "co64" : "stco", 0, 0 );
+            
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( chunks ) );
+            
+            for( size_t i = 0; i < chunks; i++ )
+            {
+                if( large )
+                {
+                    stream.WriteBigEndianUInt64( this->impl->_chunkOffsets[ i ] );
+                }
+                else
+                {
+                    stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_chunkOffsets[ i ] ) );
+                }
+            }
+            
+            stream.EndBox( box );
+        }
+        
+        if( this->impl->_allSync == false )
+        {
+            box = stream.BeginFullBox( "stss", 0, 0 );
+            
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_syncSamples.size() ) );
+            
+            for( uint32_t sample: this->impl->_syncSamples )
+            {
+                stream.WriteBigEndianUInt32( sample );
+            }
+            
+            stream.EndBox( box );
+        }
+        
+        stream.EndBox( stbl );
+    }
+    
+    void swap( SampleTableBuilder & o1, SampleTableBuilder & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    SampleTableBuilder::IMPL::IMPL():
+        _constantSize( 0 ),
+        _allSync( true ),
+        _hasCompositionOffsets( false ),
+        _hasNegativeCompositionOffsets( false ),
+        _sampleCount( 0 ),
+        _duration( 0 ),
+        _chunkSamples( 0 ),
+        _chunkSampleDescriptionIndex( 1 )
+    {}
+    
+    SampleTableBuilder::IMPL::IMPL( const IMPL & o ):
+        _timeToSample( o._timeToSample ),
+        _compositionOffsets( o._compositionOffsets ),
+        _sampleToChunk( o._sampleToChunk ),
+        _chunkOffsets( o._chunkOffsets ),
+        _sizes( o._sizes ),
+        _syncSamples( o._syncSamples ),
+        _constantSize( o._constantSize ),
+        _allSync( o._allSync ),
+        _hasCompositionOffsets( o._hasCompositionOffsets ),
+        _hasNegativeCompositionOffsets( o._hasNegativeCompositionOffsets ),
+        _sampleCount( o._sampleCount ),
+        _duration( o._duration ),
+        _chunkSamples( o._chunkSamples ),
+        _chunkSampleDescriptionIndex( o._chunkSampleDescriptionIndex )
+    {}
+    
+    SampleTableBuilder::IMPL::~IMPL()
+    {}
+    
+    void SampleTableBuilder::IMPL::CloseChunk( std::vector< SampleToChunk > & entries, size_t chunk, uint32_t samples, uint32_t sampleDescriptionIndex ) const
+    {
+        if( entries.size() > 0 && entries.back().samplesPerChunk == samples && entries.back().sampleDescriptionId == sampleDescriptionIndex )
+        {
+            return;
+        }
+        
+        entries.emplace_back( static_cast< uint32_t >( chunk ), samples, sampleDescriptionIndex );
+    }
+}
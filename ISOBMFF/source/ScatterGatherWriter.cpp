@@ -0,0 +1,534 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ScatterGatherWriter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ScatterGatherWriter.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <ISOBMFF/WIN32.hpp>
+#else
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+namespace ISOBMFF
+{
+    class ScatterGatherWriter::IMPL
+    {
+        public:
+            
+            IMPL( const std::string & path, const std::string & sourcePath, Mode mode );
+            ~IMPL();
+            
+            void WriteVector( const uint8_t * buf, size_t size );
+            void CopyInKernel( uint64_t & offset, uint64_t & size );
+            void CopyInUserSpace( uint64_t offset, uint64_t size );
+            
+            static int  Open( const std::string & path, bool write, bool truncate );
+            static void WriteAll( int fd, const uint8_t * buf, size_t size, const std::string & path );
+            
+            int                    _fd;
+            int                    _source;
+            std::string            _path;
+            std::vector< uint8_t > _buffer;
+            uint64_t               _pos;
+            uint64_t               _size;
+    };
+    
+    ScatterGatherWriter::ScatterGatherWriter( const std::string & path ):
+        impl( std::make_unique< IMPL >( path, "", Mode::Truncate ) )
+    {}
+    
+    ScatterGatherWriter::ScatterGatherWriter( const std::string & path, const std::string & sourcePath ):
+        impl( std::make_unique< IMPL >( path, sourcePath, Mode::Truncate ) )
+    {}
+    
+    ScatterGatherWriter::ScatterGatherWriter( const std::string & path, Mode mode ):
+        impl( std::make_unique< IMPL >( path, "", mode ) )
+    {}
+    
+    ScatterGatherWriter::~ScatterGatherWriter()
+    {
+        try
+        {
+            this->Flush();
+        }
+        catch( ... )
+        {}
+    }
+    
+    void ScatterGatherWriter::Write( const uint8_t * buf, size_t size )
+    {
+        if( size >= LargeWriteSize )
+        {
+            this->impl->WriteVector( buf, size );
+            
+            return;
+        }
+        
+        if( this->impl->_buffer.size() + size > BufferSize )
+        {
+            this->Flush();
+        }
+        
+        this->impl->_buffer.insert( this->impl->_buffer.end(), buf, buf + size );
+    }
+    
+    void ScatterGatherWriter::Seek( std::streamoff offset, SeekDirection dir )
+    {
+        uint64_t pos;
+        
+        this->Flush();
+        
+        if( dir == SeekDirection::Begin )
+        {
+            if( offset < 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = numeric_cast< uint64_t >( offset );
+        }
+        else if( dir == SeekDirection::End )
+        {
+            if( offset > 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = this->impl->_size - numeric_cast< uint64_t >( std::abs( offset ) );
+        }
+        else if( offset < 0 )
+        {
+            pos = this->impl->_pos - numeric_cast< uint64_t >( std::abs( offset ) );
+        }
+        else
+        {
+            pos = this->impl->_pos + numeric_cast< uint64_t >( offset );
+        }
+        
+        if( pos > this->impl->_size )
+        {
+            throw std::runtime_error( "Invalid seek offset" );
+        }
+        
+        #ifdef _WIN32
+        if( _lseeki64( this->impl->_fd, numeric_cast< __int64 >( pos ), SEEK_SET ) < 0 )
+        #else
+        if( lseek( this->impl->_fd, numeric_cast< off_t >( pos ), SEEK_SET ) < 0 )
+        #endif
+        {
+            throw std::runtime_error( "Invalid seek - Cannot seek in file: " + this->impl->_path );
+        }
+        
+        this->impl->_pos = pos;
+    }
+    
+    size_t ScatterGatherWriter::Tell() const
+    {
+        return numeric_cast< size_t >( this->impl->_pos + this->impl->_buffer.size() );
+    }
+    
+    void ScatterGatherWriter::WriteSourceRange( uint64_t offset, uint64_t size )
+    {
+        uint64_t total( size );
+        
+        if( this->impl->_source < 0 )
+        {
+            BinaryOutputStream::WriteSourceRange( offset, size );
+        }
+        
+        this->Flush();
+        
+        this->impl->CopyInKernel( offset, size );
+        this->impl->CopyInUserSpace( offset, size );
+        
+        this->impl->_pos += total;
+        this->impl->_size = std::max( this->impl->_size, this->impl->_pos );
+    }
+    
+    void ScatterGatherWriter::SetSourceFile( const std::string & sourcePath )
+    {
+        int source( IMPL::Open( sourcePath, false, false ) );
+        
+        if( source < 0 )
+        {
+            throw std::runtime_error( "Cannot open file: " + sourcePath );
+        }
+        
+        if( this->impl->_source >= 0 )
+        {
+            #ifdef _WIN32
+            _close( this->impl->_source );
+            #else
+            close( this->impl->_source );
+            #endif
+        }
+        
+        this->impl->_source = source;
+    }
+    
+    void ScatterGatherWriter::Flush()
+    {
+        if( this->impl->_buffer.size() > 0 )
+        {
+            this->impl->WriteVector( nullptr, 0 );
+        }
+    }
+    
+    ScatterGatherWriter::IMPL::IMPL( const std::string & path, const std::string & sourcePath, Mode mode ):
+        _fd( -1 ),
+        _source( -1 ),
+        _path( path ),
+        _pos( 0 ),
+        _size( 0 )
+    {
+        if( sourcePath.length() > 0 )
+        {
+            this->_source = Open( sourcePath, false, false );
+            
+            if( this->_source < 0 )
+            {
+                throw std::runtime_error( "Cannot open file: " + sourcePath );
+            }
+        }
+        
+        this->_fd = Open( path, true, mode == Mode::Truncate );
+        
+        if( this->_fd < 0 )
+        {
+            if( this->_source >= 0 )
+            {
+                #ifdef _WIN32
+                _close( this->_source );
+                #else
+                close( this->_source );
+                #endif
+            }
+            
+            throw std::runtime_error( "Cannot open file for writing: " + path );
+        }
+        
+        if( mode == Mode::Update )
+        {
+            #ifdef _WIN32
+            __int64 size( _lseeki64( this->_fd, 0, SEEK_END ) );
+            bool    rewound( _lseeki64( this->_fd, 0, SEEK_SET ) == 0 );
+            #else
+            off_t   size( lseek( this->_fd, 0, SEEK_END ) );
+            bool    rewound( lseek( this->_fd, 0, SEEK_SET ) == 0 );
+            #endif
+            
+            if( size < 0 || rewound == false )
+            {
+                #ifdef _WIN32
+                _close( this->_fd );
+                #else
+                close( this->_fd );
+                #endif
+                
+                throw std::runtime_error( "Invalid seek - Cannot seek in file: " + path );
+            }
+            
+            this->_size = static_cast< uint64_t >( size );
+        }
+        
+        this->_buffer.reserve( BufferSize );
+    }
+    
+    ScatterGatherWriter::IMPL::~IMPL()
+    {
+        #ifdef _WIN32
+        _close( this->_fd );
+        
+        if( this->_source >= 0 )
+        {
+            _close( this->_source );
+        }
+        #else
+        close( this->_fd );
+        
+        if( this->_source >= 0 )
+        {
+            close( this->_source );
+        }
+        #endif
+    }
+    
+    void ScatterGatherWriter::IMPL::WriteVector( const uint8_t * buf, size_t size )
+    {
+        uint64_t total( this->_buffer.size() + size );
+        
+        #ifdef _WIN32
+        
+        WriteAll( this->_fd, this->_buffer.data(), this->_buffer.size(), this->_path );
+        WriteAll( this->_fd, buf, size, this->_path );
+        
+        #else
+        
+        struct iovec iov[ 2 ];
+        int          count( 0 );
+        int          first( 0 );
+        
+        if( this->_buffer.size() > 0 )
+        {
+            iov[ count ].iov_base = this->_buffer.data();
+            iov[ count ].iov_len  = this->_buffer.size();
+            
+            count++;
+        }
+        
+        if( size > 0 )
+        {
+            iov[ count ].iov_base = const_cast< uint8_t * >( buf );
+            iov[ count ].iov_len  = size;
+            
+            count++;
+        }
+        
+        while( first < count )
+        {
+            ssize_t n( writev( this->_fd, iov + first, count - first ) );
+            size_t  written;
+            
+            if( n < 0 )
+            {
+                if( errno == EINTR )
+                {
+                    continue;
+                }
+                
+                throw std::runtime_error( "Invalid write - Cannot write to file: " + this->_path );
+            }
+            
+            written = static_cast< size_t >( n );
+            
+            while( first < count && written >= iov[ first ].iov_len )
+            {
+                written -= iov[ first ].iov_len;
+                
+                first++;
+            }
+            
+            if( first < count )
+            {
+                iov[ first ].iov_base  = static_cast< uint8_t * >( iov[ first ].iov_base ) + written;
+                iov[ first ].iov_len  -= written;
+            }
+        }
+        
+        #endif
+        
+        this->_buffer.clear();
+        
+        this->_pos += total;
+        this->_size = std::max( this->_size, this->_pos );
+    }
+    
+    void ScatterGatherWriter::IMPL::CopyInKernel( uint64_t & offset, uint64_t & size )
+    {
+        #ifdef __linux__
+        
+        bool useCopyFileRange( true );
+        
+        while( size > 0 )
+        {
+            size_t  count( static_cast< size_t >( std::min< uint64_t >( size, 0x40000000 ) ) );
+            ssize_t n;
+            
+            if( useCopyFileRange )
+            {
+                loff_t in( numeric_cast< loff_t >( offset ) );
+                
+                n = copy_file_range( this->_source, &in, this->_fd, nullptr, count, 0 );
+                
+                if( n < 0 && errno != EINTR )
+                {
+                    // Not supported for these files, like across file systems on older kernels
+                    useCopyFileRange = false;
+                    
+                    continue;
+                }
+            }
+            else
+            {
+                off_t in( numeric_cast< off_t >( offset ) );
+                
+                n = sendfile( this->_fd, this->_source, &in, count );
+                
+                if( n < 0 && errno != EINTR )
+                {
+                    return;
+                }
+            }
+            
+            if( n == 0 )
+            {
+                throw std::runtime_error( "Invalid source range - Not enough data in source file" );
+            }
+            
+            if( n > 0 )
+            {
+                offset += static_cast< uint64_t >( n );
+                size   -= static_cast< uint64_t >( n );
+            }
+        }
+        
+        #else
+        
+        ( void )offset;
+        ( void )size;
+        
+        #endif
+    }
+    
+    void ScatterGatherWriter::IMPL::CopyInUserSpace( uint64_t offset, uint64_t size )
+    {
+        std::vector< uint8_t > data;
+        
+        if( size == 0 )
+        {
+            return;
+        }
+        
+        data.resize( static_cast< size_t >( std::min< uint64_t >( size, 1024 * 1024 ) ) );
+        
+        while( size > 0 )
+        {
+            size_t count( static_cast< size_t >( std::min< uint64_t >( size, data.size() ) ) );
+            
+            #ifdef _WIN32
+            
+            int n( -1 );
+            
+            if( _lseeki64( this->_source, numeric_cast< __int64 >( offset ), SEEK_SET ) >= 0 )
+            {
+                n = _read( this->_source, data.data(), static_cast< unsigned int >( count ) );
+            }
+            
+            #else
+            
+            ssize_t n( pread( this->_source, data.data(), count, numeric_cast< off_t >( offset ) ) );
+            
+            if( n < 0 && errno == EINTR )
+            {
+                continue;
+            }
+            
+            #endif
+            
+            if( n < 0 )
+            {
+                throw std::runtime_error( "Invalid read - Cannot read from source file" );
+            }
+            
+            if( n == 0 )
+            {
+                throw std::runtime_error( "Invalid source range - Not enough data in source file" );
+            }
+            
+            WriteAll( this->_fd, data.data(), static_cast< size_t >( n ), this->_path );
+            
+            offset += static_cast< uint64_t >( n );
+            size   -= static_cast< uint64_t >( n );
+        }
+    }
+    
+    int ScatterGatherWriter::IMPL::Open( const std::string & path, bool write, bool truncate )
+    {
+        #ifdef _WIN32
+        
+        if( write && truncate )
+        {
+            return _wopen( ISOBMFF::StringToWideString( path ).c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE );
+        }
+        
+        if( write )
+        {
+            return _wopen( ISOBMFF::StringToWideString( path ).c_str(), _O_WRONLY | _O_BINARY );
+        }
+        
+        return _wopen( ISOBMFF::StringToWideString( path ).c_str(), _O_RDONLY | _O_BINARY );
+        
+        #else
+        
+        if( write && truncate )
+        {
+            return open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        }
+        
+        if( write )
+        {
+            return open( path.c_str(), O_WRONLY );
+        }
+        
+        return open( path.c_str(), O_RDONLY );
+        
+        #endif
+    }
+    
+    void ScatterGatherWriter::IMPL::WriteAll( int fd, const uint8_t * buf, size_t size, const std::string & path )
+    {
+        while( size > 0 )
+        {
+            #ifdef _WIN32
+            int n( _write( fd, buf, static_cast< unsigned int >( std::min< size_t >( size, 0x40000000 ) ) ) );
+            #else
+            ssize_t n( write( fd, buf, size ) );
+            
+            if( n < 0 && errno == EINTR )
+            {
+                continue;
+            }
+            #endif
+            
+            if( n <= 0 )
+            {
+                throw std::runtime_error( "Invalid write - Cannot write to file: " + path );
+            }
+            
+            buf  += n;
+            size -= static_cast< size_t >( n );
+        }
+    }
+}
@@ -0,0 +1,528 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Segmenter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Segmenter.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/Track.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MVHD.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Segmenter::IMPL
+    {
+        public:
+            
+            IMPL( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void Split( uint32_t segmentDuration );
+            void CheckSegment( size_t number ) const;
+            
+            static std::shared_ptr< ContainerBox > FindTRAK( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID );
+            static uint32_t                        GetTrackID( const std::shared_ptr< Box > & trak );
+            static void                            WriteBox( BinaryOutputStream & stream, const std::shared_ptr< Box > & box );
+            static void                            WriteSTBL( BinaryOutputStream & stream, const Container & stbl );
+            static void                            WriteMVEX( BinaryOutputStream & stream, const ContainerBox & moov, const std::vector< uint32_t > & trackIDs );
+            
+            std::shared_ptr< ContainerBox > _moov;
+            Track                           _track;
+            std::vector< uint32_t >         _table;
+    };
+    
+    Segmenter::Segmenter( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID, uint32_t segmentDuration ):
+        impl( std::make_unique< IMPL >( moov, trackID ) )
+    {
+        if( segmentDuration == 0 )
+        {
+            throw std::runtime_error( "Invalid segment duration" );
+        }
+        
+        this->impl->Split( segmentDuration );
+    }
+    
+    Segmenter::Segmenter( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID, const std::vector< uint32_t > & table ):
+        impl( std::make_unique< IMPL >( moov, trackID ) )
+    {
+        size_t count( this->impl->_track.GetSampleTable().GetSampleCount() );
+        
+        if( table.empty() || table.front() != 0 || table.back() != count )
+        {
+            throw std::runtime_error( "Invalid segment table - Does not match the track" );
+        }
+        
+        for( size_t i = 1; i < table.size(); i++ )
+        {
+            if( table[ i ] <= table[ i - 1 ] )
+            {
+                throw std::runtime_error( "Invalid segment table - Empty segment" );
+            }
+        }
+        
+        this->impl->_table = table;
+    }
+    
+    Segmenter::Segmenter( const Segmenter & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Segmenter::Segmenter( Segmenter && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Segmenter::~Segmenter()
+    {}
+    
+    Segmenter & Segmenter::operator =( Segmenter o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Segmenter & o1, Segmenter & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    void Segmenter::WriteInitSegment( BinaryOutputStream & stream, const ContainerBox & moov, const std::vector< uint32_t > & trackIDs )
+    {
+        BinaryDataOutputStream init;
+        size_t                 box;
+        
+        if( moov.GetTypedBox< MVHD >( "mvhd" ) == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No MVHD box" );
+        }
+        
+        box = init.BeginBox( "ftyp" );
+        
+        init.WriteFourCC( "iso6" );
+        init.WriteBigEndianUInt32( 0 );
+        init.WriteFourCC( "iso6" );
+        init.WriteFourCC( "mp41" );
+        init.EndBox( box );
+        
+        box = init.BeginBox( "moov" );
+        
+        for( const auto & child: moov.GetBoxesSpan() )
+        {
+            if( child->GetName() == "trak" && std::find( trackIDs.begin(), trackIDs.end(), IMPL::GetTrackID( child ) ) == trackIDs.end() )
+            {
+                continue;
+            }
+            
+            IMPL::WriteBox( init, child );
+        }
+        
+        IMPL::WriteMVEX( init, moov, trackIDs );
+        init.EndBox( box );
+        
+        stream.Write( init.GetData() );
+    }
+    
+    uint32_t Segmenter::GetTrackID() const
+    {
+        return this->impl->_track.GetTrackID();
+    }
+    
+    uint32_t Segmenter::GetTimescale() const
+    {
+        return this->impl->_track.GetTimescale();
+    }
+    
+    const std::vector< uint32_t > & Segmenter::GetSegmentTable() const
+    {
+        return this->impl->_table;
+    }
+    
+    size_t Segmenter::GetSegmentCount() const
+    {
+        return this->impl->_table.size() - 1;
+    }
+    
+    uint64_t Segmenter::GetSegmentTime( size_t number ) const
+    {
+        this->impl->CheckSegment( number );
+        
+        return this->impl->_track.GetSampleTable().GetSampleTime( this->impl->_table[ number ] );
+    }
+    
+    uint64_t Segmenter::GetSegmentDuration( size_t number ) const
+    {
+        const SampleTable & table( this->impl->_track.GetSampleTable() );
+        size_t              last;
+        
+        this->impl->CheckSegment( number );
+        
+        last = this->impl->_table[ number + 1 ] - 1;
+        
+        return table.GetSampleTime( last ) + table.GetSampleDuration( last ) - table.GetSampleTime( this->impl->_table[ number ] );
+    }
+    
+    std::vector< uint8_t > Segmenter::GetInitSegment() const
+    {
+        BinaryDataOutputStream stream;
+        
+        WriteInitSegment( stream, *( this->impl->_moov ), { this->GetTrackID() } );
+        
+        return stream.TakeData();
+    }
+    
+    Segmenter::Segment Segmenter::GetSegment( size_t number, uint32_t sequenceNumber ) const
+    {
+        const SampleTable    & table( this->impl->_track.GetSampleTable() );
+        BinaryDataOutputStream moof;
+        Segment                segment;
+        uint64_t               payload( 0 );
+        uint64_t               header;
+        uint64_t               offset;
+        uint64_t               size;
+        bool                   negative( false );
+        uint32_t               flags;
+        size_t                 first;
+        size_t                 last;
+        size_t                 dataOffset;
+        size_t                 box;
+        size_t                 traf;
+        size_t                 moofBox;
+        
+        this->impl->CheckSegment( number );
+        
+        first = this->impl->_table[ number ];
+        last  = this->impl->_table[ number + 1 ];
+        
+        for( size_t i = first; i < last; i++ )
+        {
+            payload  += table.GetSampleSize( i );
+            negative  = negative || table.GetCompositionOffset( i ) < 0;
+        }
+        
+        header = ( payload + 8 > ( std::numeric_limits< uint32_t >::max )() ) ? 16 : 8;
+        
+        /* data-offset, sample-duration, sample-size, sample-flags and sample-composition-time-offsets */
+        flags = 0x000001 | 0x000100 | 0x000200 | 0x000400 | ( ( table.HasCompositionOffsets() ) ? 0x000800 : 0 );
+        
+        moofBox = moof.BeginBox( "moof" );
+        box     = moof.BeginFullBox( "mfhd", 0, 0 );
+        
+        moof.WriteBigEndianUInt32( ( sequenceNumber == 0 ) ? numeric_cast< uint32_t >( number + 1 ) : sequenceNumber );
+        moof.EndBox( box );
+        
+        traf = moof.BeginBox( "traf" );
+        box  = moof.BeginFullBox( "tfhd", 0, 0x020000 ); /* default-base-is-moof */
+        
+        moof.WriteBigEndianUInt32( this->GetTrackID() );
+        moof.EndBox( box );
+        
+        box = moof.BeginFullBox( "tfdt", 1, 0 );
+        
+        moof.WriteBigEndianUInt64( table.GetSampleTime( first ) );
+        moof.EndBox( box );
+        
+        box = moof.BeginFullBox( "trun", ( negative ) ? 1 : 0, flags );
+        
+        moof.WriteBigEndianUInt32( numeric_cast< uint32_t >( last - first ) );
+        
+        dataOffset = moof.Tell();
+        
+        moof.WriteBigEndianUInt32( 0 );
+        
+        for( size_t i = first; i < last; i++ )
+        {
+            moof.WriteBigEndianUInt32( table.GetSampleDuration( i ) );
+            moof.WriteBigEndianUInt32( table.GetSampleSize( i ) );
+            
+            /* sample_depends_on 2 for sync samples, otherwise sample_depends_on 1 and sample_is_non_sync_sample */
+            moof.WriteBigEndianUInt32( ( table.IsSyncSample( i ) ) ? 0x02000000 : 0x01010000 );
+            
+            if( table.HasCompositionOffsets() )
+            {
+                moof.WriteBigEndianUInt32( static_cast< uint32_t >( table.GetCompositionOffset( i ) ) );
+            }
+        }
+        
+        moof.EndBox( box );
+        moof.EndBox( traf );
+        moof.EndBox( moofBox );
+        
+        moof.Seek( numeric_cast< std::streamoff >( dataOffset ), BinaryOutputStream::SeekDirection::Begin );
+        moof.WriteBigEndianUInt32( numeric_cast< uint32_t >( moof.GetData().size() + header ) );
+        moof.Seek( 0, BinaryOutputStream::SeekDirection::End );
+        
+        if( header == 16 )
+        {
+            moof.WriteBigEndianUInt32( 1 );
+            moof.WriteFourCC( "mdat" );
+            moof.WriteBigEndianUInt64( payload + 16 );
+        }
+        else
+        {
+            moof.WriteBigEndianUInt32( static_cast< uint32_t >( payload + 8 ) );
+            moof.WriteFourCC( "mdat" );
+        }
+        
+        segment.header = moof.TakeData();
+        
+        segment.ranges.push_back( { Source::Header, 0, segment.header.size() } );
+        
+        /* Contiguous samples are a single range */
+        offset = table.GetSampleOffset( first );
+        size   = 0;
+        
+        for( size_t i = first; i < last; i++ )
+        {
+            if( table.GetSampleOffset( i ) != offset + size )
+            {
+                segment.ranges.push_back( { Source::File, offset, size } );
+                
+                offset = table.GetSampleOffset( i );
+                size   = 0;
+            }
+            
+            size += table.GetSampleSize( i );
+        }
+        
+        if( size > 0 )
+        {
+            segment.ranges.push_back( { Source::File, offset, size } );
+        }
+        
+        return segment;
+    }
+    
+    void Segmenter::WriteSegment( BinaryOutputStream & stream, size_t number, uint32_t sequenceNumber ) const
+    {
+        Segment segment( this->GetSegment( number, sequenceNumber ) );
+        
+        for( const auto & range: segment.ranges )
+        {
+            if( range.source == Source::Header )
+            {
+                stream.Write( segment.header.data() + range.offset, numeric_cast< size_t >( range.length ) );
+            }
+            else
+            {
+                stream.WriteSourceRange( range.offset, range.length );
+            }
+        }
+    }
+    
+    Segmenter::IMPL::IMPL( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID ):
+        _moov( moov ),
+        _track( FindTRAK( moov, trackID ) )
+    {}
+    
+    Segmenter::IMPL::IMPL( const IMPL & o ):
+        _moov( o._moov ),
+        _track( o._track ),
+        _table( o._table )
+    {}
+    
+    Segmenter::IMPL::~IMPL()
+    {}
+    
+    void Segmenter::IMPL::Split( uint32_t segmentDuration )
+    {
+        const SampleTable & table( this->_track.GetSampleTable() );
+        uint64_t            target( ( static_cast< uint64_t >( segmentDuration ) * this->_track.GetTimescale() ) / 1000 );
+        size_t              count( table.GetSampleCount() );
+        size_t              first( 0 );
+        
+        this->_table.clear();
+        this->_table.push_back( 0 );
+        
+        for( size_t i = 1; i < count; i++ )
+        {
+            if( table.IsSyncSample( i ) && table.GetSampleTime( i ) - table.GetSampleTime( first ) >= target )
+            {
+                this->_table.push_back( numeric_cast< uint32_t >( i ) );
+                
+                first = i;
+            }
+        }
+        
+        if( count > 0 )
+        {
+            this->_table.push_back( numeric_cast< uint32_t >( count ) );
+        }
+    }
+    
+    void Segmenter::IMPL::CheckSegment( size_t number ) const
+    {
+        if( number + 1 >= this->_table.size() )
+        {
+            throw std::runtime_error( "Invalid segment number" );
+        }
+    }
+    
+    std::shared_ptr< ContainerBox > Segmenter::IMPL::FindTRAK( const std::shared_ptr< ContainerBox > & moov, uint32_t trackID )
+    {
+        if( moov == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No MOOV box" );
+        }
+        
+        if( moov->GetBox( "mvex" ) != nullptr )
+        {
+            throw std::runtime_error( "Unsupported file - The file is already fragmented" );
+        }
+        
+        for( const auto & box: moov->GetBoxesSpan() )
+        {
+            if( box->GetName() == "trak" && GetTrackID( box ) == trackID )
+            {
+                return std::dynamic_pointer_cast< ContainerBox >( box );
+            }
+        }
+        
+        throw std::runtime_error( "Invalid track ID" );
+    }
+    
+    uint32_t Segmenter::IMPL::GetTrackID( const std::shared_ptr< Box > & trak )
+    {
+        std::shared_ptr< ContainerBox > container( std::dynamic_pointer_cast< ContainerBox >( trak ) );
+        std::shared_ptr< TKHD >         tkhd( ( container != nullptr ) ? container->GetTypedBox< TKHD >( "tkhd" ) : nullptr );
+        
+        return ( tkhd != nullptr ) ? tkhd->GetTrackID() : 0;
+    }
+    
+    void Segmenter::IMPL::WriteBox( BinaryOutputStream & stream, const std::shared_ptr< Box > & box )
+    {
+        std::shared_ptr< ContainerBox > container( std::dynamic_pointer_cast< ContainerBox >( box ) );
+        std::string                     name( box->GetName() );
+        
+        if( container != nullptr && name == "stbl" )
+        {
+            WriteSTBL( stream, *( container ) );
+        }
+        else if( container != nullptr && ( name == "trak" || name == "mdia" || name == "minf" ) )
+        {
+            size_t offset( stream.BeginBox( name ) );
+            
+            for( const auto & child: container->GetBoxesSpan() )
+            {
+                WriteBox( stream, child );
+            }
+            
+            stream.EndBox( offset );
+        }
+        else
+        {
+            box->Write( stream );
+        }
+    }
+    
+    void Segmenter::IMPL::WriteSTBL( BinaryOutputStream & stream, const Container & stbl )
+    {
+        std::shared_ptr< Box > stsd( stbl.GetBox( "stsd" ) );
+        size_t                 offset;
+        size_t                 box;
+        
+        if( stsd == nullptr )
+        {
+            throw std::runtime_error( "Invalid sample table - No STSD box" );
+        }
+        
+        /* Samples are described by the fragments, so the tables are empty */
+        offset = stream.BeginBox( "stbl" );
+        
+        stsd->Write( stream );
+        
+        box = stream.BeginFullBox( "stts", 0, 0 );
+        
+        stream.WriteBigEndianUInt32( 0 );
+        stream.EndBox( box );
+        
+        box = stream.BeginFullBox( "stsc", 0, 0 );
+        
+        stream.WriteBigEndianUInt32( 0 );
+        stream.EndBox( box );
+        
+        box = stream.BeginFullBox( "stsz", 0, 0 );
+        
+        stream.WriteBigEndianUInt32( 0 );
+        stream.WriteBigEndianUInt32( 0 );
+        stream.EndBox( box );
+        
+        box = stream.BeginFullBox( "stco", 0, 0 );
+        
+        stream.WriteBigEndianUInt32( 0 );
+        stream.EndBox( box );
+        stream.EndBox( offset );
+    }
+    
+    void Segmenter::IMPL::WriteMVEX( BinaryOutputStream & stream, const ContainerBox & moov, const std::vector< uint32_t > & trackIDs )
+    {
+        uint64_t duration( moov.GetTypedBox< MVHD >( "mvhd" )->GetDuration() );
+        size_t   mvex;
+        size_t   box;
+        
+        mvex = stream.BeginBox( "mvex" );
+        
+        if( duration > ( std::numeric_limits< uint32_t >::max )() )
+        {
+            box = stream.BeginFullBox( "mehd", 1, 0 );
+            
+            stream.WriteBigEndianUInt64( duration );
+        }
+        else
+        {
+            box = stream.BeginFullBox( "mehd", 0, 0 );
+            
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( duration ) );
+        }
+        
+        stream.EndBox( box );
+        
+        for( uint32_t trackID: trackIDs )
+        {
+            box = stream.BeginFullBox( "trex", 0, 0 );
+            
+            stream.WriteBigEndianUInt32( trackID );
+            stream.WriteBigEndianUInt32( 1 );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.WriteBigEndianUInt32( 0 );
+            stream.EndBox( box );
+        }
+        
+        stream.EndBox( mvex );
+    }
+}
@@ -32,10 +32,11 @@
 #include <ISOBMFF/IREF.hpp>
 #include <ISOBMFF/Parser.hpp>
 #include <ISOBMFF/Utils.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class SingleItemTypeReferenceBox::IMPL
+    class SingleItemTypeReferenceBox::IMPL: public ResourceAllocated
     {
         public:
             
@@ -43,8 +44,12 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
             
+            void SetModified();
+            
             uint32_t                _fromItemID;
             std::vector< uint32_t > _toItemIDs;
+            uint8_t                 _idSize;
+            std::shared_ptr< bool > _modified;
     };
     
     SingleItemTypeReferenceBox::SingleItemTypeReferenceBox( const std::string & name ):
@@ -91,15 +96,19 @@ namespace ISOBMFF
         
         iref = static_cast< const IREF * >( parser.GetInfo( "iref" ) );
         
-        if( iref == nullptr )
+        if( iref == nullptr || iref->GetVersion() > 1 )
         {
             Box::ReadData( parser, stream );
             
+            this->impl->_idSize = 0;
+            
             return;
         }
         
         if( iref->GetVersion() == 0 )
         {
+            this->impl->_idSize = 2;
+            
             this->SetFromItemID( stream.ReadBigEndianUInt16() );
             
             count = stream.ReadBigEndianUInt16();
@@ -111,6 +120,8 @@ namespace ISOBMFF
         }
         else if( iref->GetVersion() == 1 )
         {
+            this->impl->_idSize = 4;
+            
             this->SetFromItemID( stream.ReadBigEndianUInt32() );
             
             count = stream.ReadBigEndianUInt16();
@@ -122,6 +133,44 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t SingleItemTypeReferenceBox::GetDataSize() const
+    {
+        if( this->impl->_idSize == 0 )
+        {
+            return Box::GetDataSize();
+        }
+        
+        return this->impl->_idSize + 2 + this->impl->_idSize * static_cast< uint64_t >( this->impl->_toItemIDs.size() );
+    }
+    
+    void SingleItemTypeReferenceBox::WriteData( BinaryOutputStream & stream ) const
+    {
+        if( this->impl->_idSize == 0 )
+        {
+            Box::WriteData( stream );
+        }
+        else if( this->impl->_idSize == 2 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetFromItemID() ) );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_toItemIDs.size() ) );
+            
+            for( uint32_t id: this->impl->_toItemIDs )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( id ) );
+            }
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( this->GetFromItemID() );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_toItemIDs.size() ) );
+            
+            for( uint32_t id: this->impl->_toItemIDs )
+            {
+                stream.WriteBigEndianUInt32( id );
+            }
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > SingleItemTypeReferenceBox::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -142,25 +191,49 @@ namespace ISOBMFF
         return this->impl->_toItemIDs;
     }
     
+    Span< const uint32_t > SingleItemTypeReferenceBox::GetToItemIDsSpan() const
+    {
+        return this->impl->_toItemIDs;
+    }
+    
     void SingleItemTypeReferenceBox::SetFromItemID( uint32_t value )
     {
         this->impl->_fromItemID = value;
+        
+        this->impl->SetModified();
     }
     
     void SingleItemTypeReferenceBox::AddToItemID( uint32_t value )
     {
         this->impl->_toItemIDs.push_back( value );
+        
+        this->impl->SetModified();
+    }
+    
+    void SingleItemTypeReferenceBox::SetModifiedFlag( const std::shared_ptr< bool > & flag )
+    {
+        this->impl->_modified = flag;
     }
     
     SingleItemTypeReferenceBox::IMPL::IMPL():
-        _fromItemID( 0 )
+        _fromItemID( 0 ),
+        _idSize( 2 )
     {}
 
     SingleItemTypeReferenceBox::IMPL::IMPL( const IMPL & o ):
         _fromItemID( o._fromItemID ),
-        _toItemIDs( o._toItemIDs )
+        _toItemIDs( o._toItemIDs ),
+        _idSize( o._idSize )
     {}
 
     SingleItemTypeReferenceBox::IMPL::~IMPL()
     {}
+    
+    void SingleItemTypeReferenceBox::IMPL::SetModified()
+    {
+        if( this->_modified != nullptr )
+        {
+            *( this->_modified ) = true;
+        }
+    }
 }
@@ -0,0 +1,910 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Splicer.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Splicer.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/ScatterGatherWriter.hpp>
+#include <ISOBMFF/SampleTableBuilder.hpp>
+#include <ISOBMFF/Track.hpp>
+#include <ISOBMFF/MVHD.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/STSD.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Splicer::IMPL
+    {
+        public:
+            
+            /*
+             * A time range of an input file.
+             */
+            struct Clip
+            {
+                std::string path;
+                double      start;
+                double      end;
+            };
+            
+            /*
+             * How the presentation of a track maps to its media, from its
+             * edit list: the media time presented first, after a delay
+             * in seconds (empty edits).
+             */
+            struct Timeline
+            {
+                double   delay;
+                uint64_t mediaTime;
+            };
+            
+            /*
+             * The boxes and tracks of an input file.
+             */
+            struct Input
+            {
+                std::shared_ptr< ContainerBox > moov;
+                std::shared_ptr< Box >          ftyp;
+                std::vector< Track >            tracks;
+                std::vector< Timeline >         timelines;
+                uint32_t                        timescale;
+                uint64_t                        duration;
+            };
+            
+            /*
+             * Samples of a track which are contiguous in an input file.
+             * Each run is copied as a single range, and becomes a chunk.
+             */
+            struct Run
+            {
+                size_t   clip;
+                size_t   track;
+                uint32_t sampleDescriptionIndex;
+                size_t   firstSample;
+                size_t   sampleCount;
+                uint64_t offset;
+                uint64_t size;
+            };
+            
+            /*
+             * An edit list entry. The media time is -1 for an empty edit.
+             */
+            struct Edit
+            {
+                uint64_t segmentDuration;
+                int64_t  mediaTime;
+            };
+            
+            /*
+             * A track of the output file. Clip ends are presentation times
+             * of the output, in seconds.
+             */
+            struct Output
+            {
+                std::vector< std::vector< uint8_t > > entries;
+                std::vector< Edit >                   edits;
+                uint64_t                              mediaDuration;
+                std::vector< double >                 clipEnds;
+            };
+            
+            /*
+             * The tables of the output file, for a given MDAT position.
+             */
+            struct Movie
+            {
+                const Input                     * input;
+                const std::vector< Output >     * outputs;
+                std::vector< SampleTableBuilder > tables;
+                std::vector< uint64_t >           durations;
+            };
+            
+            IMPL( StartMode mode );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void  Select( size_t clip, const Input & input, uint32_t timescale, std::vector< Output > & outputs, std::vector< Run > & runs ) const;
+            Movie Build( const std::vector< Input > & inputs, const std::vector< Output > & outputs, const std::vector< Run > & runs, uint64_t base ) const;
+            void  WriteBox( BinaryOutputStream & stream, const Movie & movie, size_t track, const std::shared_ptr< Box > & box ) const;
+            
+            static Input                   LoadInput( const std::string & path );
+            static Timeline                ReadTimeline( const Track & track, uint32_t timescale );
+            static std::vector< uint32_t > MapSampleEntries( const Track & track, Output & output );
+            static size_t                  FindSample( const SampleTable & table, uint64_t time );
+            static size_t                  FindStart( const SampleTable & table, uint64_t time );
+            static int64_t                 GetCompositionTime( const SampleTable & table, size_t sample );
+            static uint64_t                ToMediaTime( double time, uint32_t timescale );
+            static uint64_t                ToMediaTime( const Input & input, size_t track, double time );
+            static double                  ToPresentationTime( const Input & input, size_t track, int64_t time );
+            
+            StartMode           _mode;
+            std::vector< Clip > _clips;
+    };
+    
+    static uint64_t Rescale( uint64_t value, uint32_t from, uint32_t to );
+    
+    Splicer::Splicer( StartMode mode ):
+        impl( std::make_unique< IMPL >( mode ) )
+    {}
+    
+    Splicer::Splicer( const Splicer & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Splicer::Splicer( Splicer && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Splicer::~Splicer()
+    {}
+    
+    Splicer & Splicer::operator =( Splicer o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Splicer & o1, Splicer & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    void Splicer::AddClip( const std::string & path, double start, double end )
+    {
+        if( std::isnan( start ) || std::isnan( end ) || start < 0 || end <= start )
+        {
+            throw std::runtime_error( "Invalid clip - Invalid time range" );
+        }
+        
+        this->impl->_clips.push_back( { path, start, end } );
+    }
+    
+    size_t Splicer::GetClipCount() const
+    {
+        return this->impl->_clips.size();
+    }
+    
+    void Splicer::Write( const std::string & path ) const
+    {
+        std::vector< IMPL::Input >  inputs;
+        std::vector< IMPL::Output > outputs;
+        std::vector< IMPL::Run >    runs;
+        std::vector< uint8_t >      ftyp;
+        std::vector< uint8_t >      moov;
+        uint64_t                    payload( 0 );
+        uint64_t                    header;
+        std::string                 source;
+        
+        if( this->impl->_clips.size() == 0 )
+        {
+            throw std::runtime_error( "Invalid splice - No clips" );
+        }
+        
+        for( const auto & clip: this->impl->_clips )
+        {
+            if( clip.path == path )
+            {
+                throw std::runtime_error( "Invalid output path - Cannot rewrite an input file" );
+            }
+            
+            inputs.push_back( IMPL::LoadInput( clip.path ) );
+        }
+        
+        outputs.resize( inputs.front().tracks.size(), IMPL::Output{ {}, {}, 0, {} } );
+        
+        for( size_t i = 0; i < inputs.size(); i++ )
+        {
+            const IMPL::Input & input( inputs[ i ] );
+            
+            if( input.tracks.size() != outputs.size() )
+            {
+                throw std::runtime_error( "Incompatible inputs - Different number of tracks" );
+            }
+            
+            for( size_t j = 0; j < input.tracks.size(); j++ )
+            {
+                if
+                (
+                       input.tracks[ j ].GetHandlerType() != inputs.front().tracks[ j ].GetHandlerType()
+                    || input.tracks[ j ].GetTimescale()   != inputs.front().tracks[ j ].GetTimescale()
+                )
+                {
+                    throw std::runtime_error( "Incompatible inputs - Tracks do not match" );
+                }
+            }
+            
+            this->impl->Select( i, input, inputs.front().timescale, outputs, runs );
+        }
+        
+        {
+            BinaryDataOutputStream stream;
+            
+            if( inputs.front().ftyp != nullptr )
+            {
+                inputs.front().ftyp->Write( stream );
+            }
+            else
+            {
+                size_t box( stream.BeginBox( "ftyp" ) );
+                
+                stream.WriteFourCC( "isom" );
+                stream.WriteBigEndianUInt32( 512 );
+                stream.WriteFourCC( "isom" );
+                stream.WriteFourCC( "iso2" );
+                stream.WriteFourCC( "mp41" );
+                stream.EndBox( box );
+            }
+            
+            ftyp = stream.TakeData();
+        }
+        
+        for( const auto & run: runs )
+        {
+            payload += run.size;
+        }
+        
+        header = ( payload + 8 > UINT32_MAX ) ? 16 : 8;
+        
+        /* Chunk offsets depend on the size of the MOOV box, which grows if they need CO64 */
+        for( ;; )
+        {
+            BinaryDataOutputStream stream;
+            IMPL::Movie            movie( this->impl->Build( inputs, outputs, runs, ftyp.size() + moov.size() + header ) );
+            size_t                 box( stream.BeginBox( "moov" ) );
+            uint64_t               size( moov.size() );
+            
+            for( const auto & child: inputs.front().moov->GetBoxesSpan() )
+            {
+                this->impl->WriteBox( stream, movie, outputs.size(), child );
+            }
+            
+            stream.EndBox( box );
+            
+            moov = stream.TakeData();
+            
+            if( moov.size() == size )
+            {
+                break;
+            }
+        }
+        
+        ScatterGatherWriter stream( path );
+        
+        stream.Write( ftyp );
+        stream.Write( moov );
+        
+        if( header == 16 )
+        {
+            stream.WriteBigEndianUInt32( 1 );
+            stream.WriteFourCC( "mdat" );
+            stream.WriteBigEndianUInt64( payload + 16 );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( payload + 8 ) );
+            stream.WriteFourCC( "mdat" );
+        }
+        
+        for( const auto & run: runs )
+        {
+            if( this->impl->_clips[ run.clip ].path != source )
+            {
+                source = this->impl->_clips[ run.clip ].path;
+                
+                stream.SetSourceFile( source );
+            }
+            
+            stream.WriteSourceRange( run.offset, run.size );
+        }
+        
+        stream.Flush();
+    }
+    
+    Splicer::IMPL::IMPL( StartMode mode ):
+        _mode( mode )
+    {}
+    
+    Splicer::IMPL::IMPL( const IMPL & o ):
+        _mode( o._mode ),
+        _clips( o._clips )
+    {}
+    
+    Splicer::IMPL::~IMPL()
+    {}
+    
+    void Splicer::IMPL::Select( size_t clip, const Input & input, uint32_t timescale, std::vector< Output > & outputs, std::vector< Run > & runs ) const
+    {
+        double                start( this->_clips[ clip ].start );
+        double                end( this->_clips[ clip ].end );
+        size_t                count( input.tracks.size() );
+        std::vector< size_t > first( count );
+        std::vector< size_t > last( count, 0 );
+        std::vector< Run >    selected;
+        bool                  empty( true );
+        double                duration;
+        
+        /*
+         * Clip times are presentation times, mapped to composition times
+         * through the edit list of each track. Decoding starts at the last
+         * sync sample presented before the start time, tracks ending
+         * before it are empty.
+         */
+        for( size_t i = 0; i < count; i++ )
+        {
+            const SampleTable & table( input.tracks[ i ].GetSampleTable() );
+            uint64_t            time( ToMediaTime( input, i, start ) );
+            
+            first[ i ] = table.GetSampleCount();
+            
+            if( table.GetSampleCount() == 0 )
+            {
+                continue;
+            }
+            
+            {
+                size_t  sample( table.GetSampleCount() - 1 );
+                int64_t finish( GetCompositionTime( table, sample ) + table.GetSampleDuration( sample ) );
+                
+                if( numeric_cast< int64_t >( time ) >= std::max( finish, numeric_cast< int64_t >( table.GetDuration() ) ) )
+                {
+                    continue;
+                }
+            }
+            
+            first[ i ] = FindStart( table, time );
+        }
+        
+        /* Without edit lists, all tracks start at the earliest sync sample, to stay synchronized */
+        if( this->_mode == StartMode::SyncSample )
+        {
+            double snapped( start );
+            
+            for( size_t i = 0; i < count; i++ )
+            {
+                const SampleTable & table( input.tracks[ i ].GetSampleTable() );
+                
+                if( first[ i ] < table.GetSampleCount() )
+                {
+                    snapped = std::min( snapped, ToPresentationTime( input, i, GetCompositionTime( table, first[ i ] ) ) );
+                }
+            }
+            
+            snapped = std::max( snapped, 0.0 );
+            
+            for( size_t i = 0; i < count; i++ )
+            {
+                const SampleTable & table( input.tracks[ i ].GetSampleTable() );
+                
+                if( first[ i ] >= table.GetSampleCount() )
+                {
+                    continue;
+                }
+                
+                first[ i ] = FindStart( table, ToMediaTime( input, i, snapped ) );
+            }
+            
+            start = snapped;
+        }
+        
+        for( size_t i = 0; i < count; i++ )
+        {
+            const SampleTable & table( input.tracks[ i ].GetSampleTable() );
+            
+            last[ i ] = table.GetSampleCount();
+            
+            /* Trailing samples presented after the end time are dropped, in decoding order */
+            if( std::isinf( end ) == false )
+            {
+                int64_t time( numeric_cast< int64_t >( ToMediaTime( input, i, end ) ) );
+                
+                while( last[ i ] > first[ i ] && GetCompositionTime( table, last[ i ] - 1 ) >= time )
+                {
+                    last[ i ]--;
+                }
+            }
+            
+            empty = empty && last[ i ] <= first[ i ];
+        }
+        
+        if( empty )
+        {
+            throw std::runtime_error( "Invalid clip - No samples in the time range: " + this->_clips[ clip ].path );
+        }
+        
+        duration = std::min( end, static_cast< double >( input.duration ) / input.timescale ) - start;
+        
+        for( size_t i = 0; i < count; i++ )
+        {
+            const SampleTable     & table( input.tracks[ i ].GetSampleTable() );
+            std::vector< uint32_t > entries( MapSampleEntries( input.tracks[ i ], outputs[ i ] ) );
+            uint64_t                segmentDuration( ( duration > 0 ) ? static_cast< uint64_t >( std::llround( duration * timescale ) ) : 0 );
+            
+            outputs[ i ].clipEnds.push_back( ( outputs[ i ].clipEnds.empty() ? 0 : outputs[ i ].clipEnds.back() ) + std::max( duration, 0.0 ) );
+            
+            if( last[ i ] <= first[ i ] )
+            {
+                outputs[ i ].edits.push_back( { segmentDuration, -1 } );
+                
+                continue;
+            }
+            
+            /* A track starting later in the input also starts later in the clip */
+            if( start < input.timelines[ i ].delay )
+            {
+                uint64_t delay( std::min( segmentDuration, static_cast< uint64_t >( std::llround( ( input.timelines[ i ].delay - start ) * timescale ) ) ) );
+                
+                outputs[ i ].edits.push_back( { delay, -1 } );
+                
+                segmentDuration -= delay;
+            }
+            
+            for( size_t chunk = 0; chunk < table.GetChunkCount(); chunk++ )
+            {
+                size_t   a( std::max( first[ i ], table.GetChunkFirstSample( chunk ) ) );
+                size_t   b( std::min( last[ i ], table.GetChunkFirstSample( chunk ) + table.GetChunkSampleCount( chunk ) ) );
+                uint32_t index( table.GetChunkSampleDescriptionIndex( chunk ) );
+                
+                if( a >= b )
+                {
+                    continue;
+                }
+                
+                if( index == 0 || index > entries.size() )
+                {
+                    throw std::runtime_error( "Invalid sample table - Invalid sample description index" );
+                }
+                
+                selected.push_back
+                (
+                    {
+                        clip,
+                        i,
+                        entries[ index - 1 ],
+                        a,
+                        b - a,
+                        table.GetSampleOffset( a ),
+                        table.GetSampleOffset( b - 1 ) + table.GetSampleSize( b - 1 ) - table.GetSampleOffset( a )
+                    }
+                );
+            }
+            
+            {
+                uint64_t begin( table.GetSampleTime( first[ i ] ) );
+                uint64_t finish( ( last[ i ] < table.GetSampleCount() ) ? table.GetSampleTime( last[ i ] ) : table.GetDuration() );
+                int64_t  skip( numeric_cast< int64_t >( ToMediaTime( input, i, start ) ) - numeric_cast< int64_t >( begin ) );
+                
+                /*
+                 * The output media of the clip starts at the first decoded
+                 * sample, so the edit combines the media time of the input
+                 * edit list, the start time, and the position of the clip.
+                 * The skip is negative when the first sample is presented
+                 * before it is decoded.
+                 */
+                outputs[ i ].edits.push_back( { segmentDuration, std::max< int64_t >( numeric_cast< int64_t >( outputs[ i ].mediaDuration ) + skip, 0 ) } );
+                
+                outputs[ i ].mediaDuration += finish - begin;
+            }
+        }
+        
+        /* Runs are copied in the order of the input file, which keeps its interleaving */
+        std::stable_sort
+        (
+            selected.begin(),
+            selected.end(),
+            []( const Run & r1, const Run & r2 )
+            {
+                return r1.offset < r2.offset;
+            }
+        );
+        
+        runs.insert( runs.end(), selected.begin(), selected.end() );
+    }
+    
+    Splicer::IMPL::Movie Splicer::IMPL::Build( const std::vector< Input > & inputs, const std::vector< Output > & outputs, const std::vector< Run > & runs, uint64_t base ) const
+    {
+        Movie                   movie{ &( inputs.front() ), &outputs, std::vector< SampleTableBuilder >( outputs.size() ), {} };
+        std::vector< size_t >   clips( outputs.size(), std::numeric_limits< size_t >::max() );
+        std::vector< uint32_t > durations( outputs.size(), 0 );
+        
+        for( const auto & run: runs )
+        {
+            const SampleTable  & table( inputs[ run.clip ].tracks[ run.track ].GetSampleTable() );
+            SampleTableBuilder & builder( movie.tables[ run.track ] );
+            
+            /*
+             * Without edit lists, a clip must last as long in every track,
+             * or the tracks drift apart in the following clips. Samples
+             * presented after the end time are dropped, so the last sample
+             * of a track is extended to the end of the previous clip.
+             */
+            if( this->_mode == StartMode::SyncSample && clips[ run.track ] < run.clip )
+            {
+                double   time( outputs[ run.track ].clipEnds[ run.clip - 1 ] );
+                uint64_t end( static_cast< uint64_t >( std::llround( time * movie.input->tracks[ run.track ].GetTimescale() ) ) );
+                
+                if( builder.GetDuration() < end )
+                {
+                    builder.SetLastSampleDuration( numeric_cast< uint32_t >( durations[ run.track ] + end - builder.GetDuration() ) );
+                }
+            }
+            
+            clips[ run.track ] = run.clip;
+            
+            builder.AddChunk( base, run.sampleDescriptionIndex );
+            
+            for( size_t i = run.firstSample; i < run.firstSample + run.sampleCount; i++ )
+            {
+                builder.AddSample( table.GetSampleSize( i ), table.GetSampleDuration( i ), table.GetCompositionOffset( i ), table.IsSyncSample( i ) );
+            }
+            
+            durations[ run.track ] = table.GetSampleDuration( run.firstSample + run.sampleCount - 1 );
+            
+            base += run.size;
+        }
+        
+        for( size_t i = 0; i < outputs.size(); i++ )
+        {
+            uint64_t duration( 0 );
+            
+            if( this->_mode == StartMode::EditList )
+            {
+                for( const auto & edit: outputs[ i ].edits )
+                {
+                    duration += edit.segmentDuration;
+                }
+            }
+            else
+            {
+                duration = Rescale( movie.tables[ i ].GetDuration(), movie.input->tracks[ i ].GetTimescale(), movie.input->timescale );
+            }
+            
+            movie.durations.push_back( duration );
+        }
+        
+        return movie;
+    }
+    
+    void Splicer::IMPL::WriteBox( BinaryOutputStream & stream, const Movie & movie, size_t track, const std::shared_ptr< Box > & box ) const
+    {
+        std::shared_ptr< ContainerBox > container( std::dynamic_pointer_cast< ContainerBox >( box ) );
+        std::string                     name( box->GetName() );
+        bool                            inTrack( track < movie.tables.size() );
+        
+        if( name == "mvex" || name == "edts" )
+        {
+            return;
+        }
+        
+        if( name == "mvhd" )
+        {
+            MVHD     mvhd( *( std::dynamic_pointer_cast< MVHD >( box ) ) );
+            uint64_t duration( 0 );
+            
+            for( uint64_t d: movie.durations )
+            {
+                duration = std::max( duration, d );
+            }
+            
+            mvhd.SetDuration( duration );
+            mvhd.SetVersion( ( duration > UINT32_MAX || mvhd.GetVersion() == 1 ) ? 1 : 0 );
+            mvhd.Write( stream );
+        }
+        else if( name == "tkhd" && inTrack )
+        {
+            TKHD                        tkhd( *( std::dynamic_pointer_cast< TKHD >( box ) ) );
+            const std::vector< Edit > & edits( ( *( movie.outputs ) )[ track ].edits );
+            uint8_t                     version( 0 );
+            size_t                      edts;
+            size_t                      elst;
+            
+            tkhd.SetDuration( movie.durations[ track ] );
+            tkhd.SetVersion( ( movie.durations[ track ] > UINT32_MAX || tkhd.GetVersion() == 1 ) ? 1 : 0 );
+            tkhd.Write( stream );
+            
+            if( this->_mode != StartMode::EditList )
+            {
+                return;
+            }
+            
+            for( const auto & edit: edits )
+            {
+                if( edit.segmentDuration > UINT32_MAX || edit.mediaTime > INT32_MAX )
+                {
+                    version = 1;
+                }
+            }
+            
+            edts = stream.BeginBox( "edts" );
+            elst = stream.BeginFullBox( "elst", version, 0 );
+            
+            stream.WriteBigEndianUInt32( numeric_cast< uint32_t >( edits.size() ) );
+            
+            for( const auto & edit: edits )
+            {
+                if( version == 1 )
+                {
+                    stream.WriteBigEndianUInt64( edit.segmentDuration );
+                    stream.WriteBigEndianUInt64( static_cast< uint64_t >( edit.mediaTime ) );
+                }
+                else
+                {
+                    stream.WriteBigEndianUInt32( static_cast< uint32_t >( edit.segmentDuration ) );
+                    stream.WriteBigEndianUInt32( static_cast< uint32_t >( edit.mediaTime ) );
+                }
+                
+                stream.WriteBigEndianUInt16( 1 );
+                stream.WriteBigEndianUInt16( 0 );
+            }
+            
+            stream.EndBox( elst );
+            stream.EndBox( edts );
+        }
+        else if( name == "mdhd" && inTrack )
+        {
+            MDHD     mdhd( *( std::dynamic_pointer_cast< MDHD >( box ) ) );
+            uint64_t duration( movie.tables[ track ].GetDuration() );
+            
+            mdhd.SetDuration( duration );
+            mdhd.SetVersion( ( duration > UINT32_MAX || mdhd.GetVersion() == 1 ) ? 1 : 0 );
+            mdhd.Write( stream );
+        }
+        else if( name == "stbl" && inTrack )
+        {
+            std::vector< Span< const uint8_t > > entries;
+            
+            for( const auto & entry: ( *( movie.outputs ) )[ track ].entries )
+            {
+                entries.push_back( entry );
+            }
+            
+            movie.tables[ track ].Write( stream, entries );
+        }
+        else if( container != nullptr && ( name == "trak" || name == "mdia" || name == "minf" ) )
+        {
+            size_t offset( stream.BeginBox( name ) );
+            
+            if( name == "trak" )
+            {
+                for( track = 0; track < movie.input->tracks.size(); track++ )
+                {
+                    if( movie.input->tracks[ track ].GetTRAK() == container )
+                    {
+                        break;
+                    }
+                }
+            }
+            
+            for( const auto & child: container->GetBoxesSpan() )
+            {
+                this->WriteBox( stream, movie, track, child );
+            }
+            
+            stream.EndBox( offset );
+        }
+        else
+        {
+            box->Write( stream );
+        }
+    }
+    
+    Splicer::IMPL::Input Splicer::IMPL::LoadInput( const std::string & path )
+    {
+        Parser                 parser;
+        std::shared_ptr< File > file;
+        std::shared_ptr< MVHD > mvhd;
+        Input                  input;
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( path );
+        
+        file       = parser.GetFile();
+        input.moov = file->GetTypedBox< ContainerBox >( "moov" );
+        input.ftyp = file->GetBox( "ftyp" );
+        mvhd       = ( input.moov != nullptr ) ? input.moov->GetTypedBox< MVHD >( "mvhd" ) : nullptr;
+        
+        if( mvhd == nullptr || mvhd->GetTimescale() == 0 )
+        {
+            throw std::runtime_error( "Invalid file - No MOOV or MVHD box: " + path );
+        }
+        
+        if( input.moov->GetBox( "mvex" ) != nullptr )
+        {
+            throw std::runtime_error( "Unsupported file - Fragmented files must be defragmented first: " + path );
+        }
+        
+        input.tracks    = Track::GetTracks( *( input.moov ) );
+        input.timescale = mvhd->GetTimescale();
+        input.duration  = mvhd->GetDuration();
+        
+        for( const auto & track: input.tracks )
+        {
+            if( track.GetTimescale() == 0 )
+            {
+                throw std::runtime_error( "Invalid track - Invalid timescale: " + path );
+            }
+            
+            input.timelines.push_back( ReadTimeline( track, input.timescale ) );
+        }
+        
+        return input;
+    }
+    
+    Splicer::IMPL::Timeline Splicer::IMPL::ReadTimeline( const Track & track, uint32_t timescale )
+    {
+        std::shared_ptr< ContainerBox > edts( track.GetTRAK()->GetTypedBox< ContainerBox >( "edts" ) );
+        std::shared_ptr< Box >          elst( ( edts != nullptr ) ? edts->GetBox( "elst" ) : nullptr );
+        Timeline                        timeline{ 0, 0 };
+        
+        if( elst == nullptr )
+        {
+            return timeline;
+        }
+        
+        BinaryDataStream stream( elst->GetData() );
+        uint8_t          version( static_cast< uint8_t >( stream.ReadBigEndianUInt32() >> 24 ) );
+        uint32_t         count( stream.ReadBigEndianUInt32() );
+        
+        /* Like most players, only the first edit with media is used, after the empty ones */
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            uint64_t segmentDuration( ( version == 1 ) ? stream.ReadBigEndianUInt64() : stream.ReadBigEndianUInt32() );
+            int64_t  mediaTime( ( version == 1 ) ? static_cast< int64_t >( stream.ReadBigEndianUInt64() ) : static_cast< int32_t >( stream.ReadBigEndianUInt32() ) );
+            
+            /* Media rate */
+            stream.ReadBigEndianUInt32();
+            
+            if( mediaTime < 0 )
+            {
+                timeline.delay += static_cast< double >( segmentDuration ) / timescale;
+                
+                continue;
+            }
+            
+            timeline.mediaTime = static_cast< uint64_t >( mediaTime );
+            
+            break;
+        }
+        
+        return timeline;
+    }
+    
+    std::vector< uint32_t > Splicer::IMPL::MapSampleEntries( const Track & track, Output & output )
+    {
+        std::shared_ptr< ContainerBox > mdia( track.GetTRAK()->GetTypedBox< ContainerBox >( "mdia" ) );
+        std::shared_ptr< ContainerBox > minf( mdia->GetTypedBox< ContainerBox >( "minf" ) );
+        std::shared_ptr< ContainerBox > stbl( minf->GetTypedBox< ContainerBox >( "stbl" ) );
+        std::shared_ptr< STSD >         stsd( stbl->GetTypedBox< STSD >( "stsd" ) );
+        std::vector< uint32_t >         indexes;
+        
+        if( stsd == nullptr )
+        {
+            throw std::runtime_error( "Invalid sample table - No STSD box" );
+        }
+        
+        /* Identical sample entries are shared, so tracks are merged */
+        for( const auto & box: stsd->GetBoxesSpan() )
+        {
+            BinaryDataOutputStream stream;
+            
+            box->Write( stream );
+            
+            auto it( std::find( output.entries.begin(), output.entries.end(), stream.GetData() ) );
+            
+            if( it == output.entries.end() )
+            {
+                output.entries.push_back( stream.TakeData() );
+                
+                it = output.entries.end() - 1;
+            }
+            
+            indexes.push_back( numeric_cast< uint32_t >( it - output.entries.begin() + 1 ) );
+        }
+        
+        return indexes;
+    }
+    
+    size_t Splicer::IMPL::FindSample( const SampleTable & table, uint64_t time )
+    {
+        size_t lower( 0 );
+        size_t upper( table.GetSampleCount() );
+        
+        /* Last sample starting at or before the time */
+        while( upper - lower > 1 )
+        {
+            size_t middle( lower + ( upper - lower ) / 2 );
+            
+            if( table.GetSampleTime( middle ) <= time )
+            {
+                lower = middle;
+            }
+            else
+            {
+                upper = middle;
+            }
+        }
+        
+        return lower;
+    }
+    
+    size_t Splicer::IMPL::FindStart( const SampleTable & table, uint64_t time )
+    {
+        size_t sample( FindSample( table, time ) );
+        
+        /* Decode times are before composition times, so the sync sample is searched backwards */
+        while( sample > 0 && ( table.IsSyncSample( sample ) == false || GetCompositionTime( table, sample ) > numeric_cast< int64_t >( time ) ) )
+        {
+            sample--;
+        }
+        
+        return sample;
+    }
+    
+    int64_t Splicer::IMPL::GetCompositionTime( const SampleTable & table, size_t sample )
+    {
+        return numeric_cast< int64_t >( table.GetSampleTime( sample ) ) + table.GetCompositionOffset( sample );
+    }
+    
+    uint64_t Splicer::IMPL::ToMediaTime( double time, uint32_t timescale )
+    {
+        return static_cast< uint64_t >( std::floor( time * timescale + 0.5 ) );
+    }
+    
+    uint64_t Splicer::IMPL::ToMediaTime( const Input & input, size_t track, double time )
+    {
+        const Timeline & timeline( input.timelines[ track ] );
+        
+        return timeline.mediaTime + ToMediaTime( std::max( time - timeline.delay, 0.0 ), input.tracks[ track ].GetTimescale() );
+    }
+    
+    double Splicer::IMPL::ToPresentationTime( const Input & input, size_t track, int64_t time )
+    {
+        const Timeline & timeline( input.timelines[ track ] );
+        
+        return timeline.delay + static_cast< double >( time - numeric_cast< int64_t >( timeline.mediaTime ) ) / input.tracks[ track ].GetTimescale();
+    }
+    
+    uint64_t Rescale( uint64_t value, uint32_t from, uint32_t to )
+    {
+        return ( ( value / from ) * to ) + ( ( ( value % from ) * to ) / from );
+    }
+}
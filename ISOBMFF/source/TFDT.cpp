@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TFDT.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    class TFDT::IMPL: public ResourceAllocated
+    {
+        public:
+
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+
+            uint64_t _baseMediaDecodeTime;
+    };
+
+    TFDT::TFDT():
+        FullBox( "tfdt" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+
+    TFDT::TFDT( const TFDT & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+
+    TFDT::TFDT( TFDT && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+
+    TFDT::~TFDT()
+    {}
+
+    TFDT & TFDT::operator =( TFDT o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+
+        return *( this );
+    }
+
+    void swap( TFDT & o1, TFDT & o2 )
+    {
+        using std::swap;
+
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+
+    void TFDT::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+
+        if( this->GetVersion() == 1 )
+        {
+            this->impl->_baseMediaDecodeTime = stream.ReadBigEndianUInt64();
+        }
+        else
+        {
+            this->impl->_baseMediaDecodeTime = stream.ReadBigEndianUInt32();
+        }
+    }
+
+    uint64_t TFDT::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 8 : 4 );
+    }
+
+    void TFDT::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->impl->_baseMediaDecodeTime );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_baseMediaDecodeTime ) );
+        }
+    }
+
+    std::vector< std::pair< std::string, std::string > > TFDT::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+
+        props.push_back( { "Base media decode time", std::to_string( this->GetBaseMediaDecodeTime() ) } );
+
+        return props;
+    }
+
+    uint64_t TFDT::GetBaseMediaDecodeTime() const
+    {
+        return this->impl->_baseMediaDecodeTime;
+    }
+
+    TFDT::IMPL::IMPL():
+        _baseMediaDecodeTime( 0 )
+    {}
+
+    TFDT::IMPL::IMPL( const IMPL & o ):
+        _baseMediaDecodeTime( o._baseMediaDecodeTime )
+    {}
+
+    TFDT::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,286 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TFHD.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    class TFHD::IMPL: public ResourceAllocated
+    {
+        public:
+
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+
+            uint32_t _trackID;
+            uint64_t _baseDataOffset;
+            uint32_t _sampleDescriptionIndex;
+            uint32_t _defaultSampleDuration;
+            uint32_t _defaultSampleSize;
+            uint32_t _defaultSampleFlags;
+    };
+
+    TFHD::TFHD():
+        FullBox( "tfhd" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+
+    TFHD::TFHD( const TFHD & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+
+    TFHD::TFHD( TFHD && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+
+    TFHD::~TFHD()
+    {}
+
+    TFHD & TFHD::operator =( TFHD o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+
+        return *( this );
+    }
+
+    void swap( TFHD & o1, TFHD & o2 )
+    {
+        using std::swap;
+
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+
+    void TFHD::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+
+        this->impl->_trackID = stream.ReadBigEndianUInt32();
+
+        if( this->HasBaseDataOffset() )
+        {
+            this->impl->_baseDataOffset = stream.ReadBigEndianUInt64();
+        }
+
+        if( this->HasSampleDescriptionIndex() )
+        {
+            this->impl->_sampleDescriptionIndex = stream.ReadBigEndianUInt32();
+        }
+
+        if( this->HasDefaultSampleDuration() )
+        {
+            this->impl->_defaultSampleDuration = stream.ReadBigEndianUInt32();
+        }
+
+        if( this->HasDefaultSampleSize() )
+        {
+            this->impl->_defaultSampleSize = stream.ReadBigEndianUInt32();
+        }
+
+        if( this->HasDefaultSampleFlags() )
+        {
+            this->impl->_defaultSampleFlags = stream.ReadBigEndianUInt32();
+        }
+    }
+
+    uint64_t TFHD::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() + 4 );
+
+        size += ( this->HasBaseDataOffset() )         ? 8 : 0;
+        size += ( this->HasSampleDescriptionIndex() ) ? 4 : 0;
+        size += ( this->HasDefaultSampleDuration() )  ? 4 : 0;
+        size += ( this->HasDefaultSampleSize() )      ? 4 : 0;
+        size += ( this->HasDefaultSampleFlags() )     ? 4 : 0;
+
+        return size;
+    }
+
+    void TFHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( this->impl->_trackID );
+
+        if( this->HasBaseDataOffset() )
+        {
+            stream.WriteBigEndianUInt64( this->impl->_baseDataOffset );
+        }
+
+        if( this->HasSampleDescriptionIndex() )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_sampleDescriptionIndex );
+        }
+
+        if( this->HasDefaultSampleDuration() )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_defaultSampleDuration );
+        }
+
+        if( this->HasDefaultSampleSize() )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_defaultSampleSize );
+        }
+
+        if( this->HasDefaultSampleFlags() )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_defaultSampleFlags );
+        }
+    }
+
+    std::vector< std::pair< std::string, std::string > > TFHD::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+
+        props.push_back( { "Track ID", std::to_string( this->GetTrackID() ) } );
+
+        if( this->HasBaseDataOffset() )
+        {
+            props.push_back( { "Base data offset", std::to_string( this->GetBaseDataOffset() ) } );
+        }
+
+        if( this->HasSampleDescriptionIndex() )
+        {
+            props.push_back( { "Sample description index", std::to_string( this->GetSampleDescriptionIndex() ) } );
+        }
+
+        if( this->HasDefaultSampleDuration() )
+        {
+            props.push_back( { "Default sample duration", std::to_string( this->GetDefaultSampleDuration() ) } );
+        }
+
+        if( this->HasDefaultSampleSize() )
+        {
+            props.push_back( { "Default sample size", std::to_string( this->GetDefaultSampleSize() ) } );
+        }
+
+        if( this->HasDefaultSampleFlags() )
+        {
+            props.push_back( { "Default sample flags", std::to_string( this->GetDefaultSampleFlags() ) } );
+        }
+
+        return props;
+    }
+
+    bool TFHD::HasBaseDataOffset() const
+    {
+        return ( this->GetFlags() & 0x000001 ) != 0;
+    }
+
+    bool TFHD::HasSampleDescriptionIndex() const
+    {
+        return ( this->GetFlags() & 0x000002 ) != 0;
+    }
+
+    bool TFHD::HasDefaultSampleDuration() const
+    {
+        return ( this->GetFlags() & 0x000008 ) != 0;
+    }
+
+    bool TFHD::HasDefaultSampleSize() const
+    {
+        return ( this->GetFlags() & 0x000010 ) != 0;
+    }
+
+    bool TFHD::HasDefaultSampleFlags() const
+    {
+        return ( this->GetFlags() & 0x000020 ) != 0;
+    }
+
+    bool TFHD::IsDurationEmpty() const
+    {
+        return ( this->GetFlags() & 0x010000 ) != 0;
+    }
+
+    bool TFHD::IsDefaultBaseMOOF() const
+    {
+        return ( this->GetFlags() & 0x020000 ) != 0;
+    }
+
+    uint32_t TFHD::GetTrackID() const
+    {
+        return this->impl->_trackID;
+    }
+
+    uint64_t TFHD::GetBaseDataOffset() const
+    {
+        return this->impl->_baseDataOffset;
+    }
+
+    uint32_t TFHD::GetSampleDescriptionIndex() const
+    {
+        return this->impl->_sampleDescriptionIndex;
+    }
+
+    uint32_t TFHD::GetDefaultSampleDuration() const
+    {
+        return this->impl->_defaultSampleDuration;
+    }
+
+    uint32_t TFHD::GetDefaultSampleSize() const
+    {
+        return this->impl->_defaultSampleSize;
+    }
+
+    uint32_t TFHD::GetDefaultSampleFlags() const
+    {
+        return this->impl->_defaultSampleFlags;
+    }
+
+    TFHD::IMPL::IMPL():
+        _trackID( 0 ),
+        _baseDataOffset( 0 ),
+        _sampleDescriptionIndex( 0 ),
+        _defaultSampleDuration( 0 ),
+        _defaultSampleSize( 0 ),
+        _defaultSampleFlags( 0 )
+    {}
+
+    TFHD::IMPL::IMPL( const IMPL & o ):
+        _trackID( o._trackID ),
+        _baseDataOffset( o._baseDataOffset ),
+        _sampleDescriptionIndex( o._sampleDescriptionIndex ),
+        _defaultSampleDuration( o._defaultSampleDuration ),
+        _defaultSampleSize( o._defaultSampleSize ),
+        _defaultSampleFlags( o._defaultSampleFlags )
+    {}
+
+    TFHD::IMPL::~IMPL()
+    {}
+}
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/THMB.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class THMB::IMPL
+    class THMB::IMPL: public ResourceAllocated
     {
         public:
             
@@ -29,11 +29,12 @@
  */
 
 #include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 #include <cstring>
 
 namespace ISOBMFF
 {
-    class TKHD::IMPL
+    class TKHD::IMPL: public ResourceAllocated
     {
         public:
             
@@ -131,6 +132,45 @@ namespace ISOBMFF
         this->SetHeight( stream.ReadBigEndianFixedPoint( 16, 16 ) );
     }
     
+    uint64_t TKHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 32 : 20 ) + 60;
+    }
+    
+    void TKHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->GetCreationTime() );
+            stream.WriteBigEndianUInt64( this->GetModificationTime() );
+            stream.WriteBigEndianUInt32( this->GetTrackID() );
+            stream.WriteBigEndianUInt32( this->impl->_reserved1 );
+            stream.WriteBigEndianUInt64( this->GetDuration() );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetCreationTime() ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetModificationTime() ) );
+            stream.WriteBigEndianUInt32( this->GetTrackID() );
+            stream.WriteBigEndianUInt32( this->impl->_reserved1 );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetDuration() ) );
+        }
+        
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 1 ] );
+        
+        stream.WriteBigEndianUInt16( this->GetLayer() );
+        stream.WriteBigEndianUInt16( this->GetAlternateGroup() );
+        stream.WriteBigEndianUInt16( this->GetVolume() );
+        stream.WriteBigEndianUInt16( this->impl->_reserved3 );
+        
+        stream.WriteMatrix( this->GetMatrix() );
+        stream.WriteBigEndianFixedPoint( this->GetWidth(), 16, 16 );
+        stream.WriteBigEndianFixedPoint( this->GetHeight(), 16, 16 );
+    }
+    
     std::vector< std::pair< std::string, std::string > > TKHD::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
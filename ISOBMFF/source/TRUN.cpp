@@ -0,0 +1,312 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TRUN.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    class TRUN::IMPL: public ResourceAllocated
+    {
+        public:
+
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+
+            uint32_t                _sampleCount;
+            int32_t                 _dataOffset;
+            uint32_t                _firstSampleFlags;
+            std::vector< uint32_t > _sampleDuration;
+            std::vector< uint32_t > _sampleSize;
+            std::vector< uint32_t > _sampleFlags;
+            std::vector< int32_t >  _sampleCompositionTimeOffset;
+    };
+
+    TRUN::TRUN():
+        FullBox( "trun" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+
+    TRUN::TRUN( const TRUN & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+
+    TRUN::TRUN( TRUN && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+
+    TRUN::~TRUN()
+    {}
+
+    TRUN & TRUN::operator =( TRUN o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+
+        return *( this );
+    }
+
+    void swap( TRUN & o1, TRUN & o2 )
+    {
+        using std::swap;
+
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+
+    void TRUN::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+
+        this->impl->_sampleCount = stream.ReadBigEndianUInt32();
+
+        if( this->HasDataOffset() )
+        {
+            this->impl->_dataOffset = static_cast< int32_t >( stream.ReadBigEndianUInt32() );
+        }
+
+        if( this->HasFirstSampleFlags() )
+        {
+            this->impl->_firstSampleFlags = stream.ReadBigEndianUInt32();
+        }
+
+        for( uint32_t i = 0; i < this->impl->_sampleCount; i++ )
+        {
+            if( this->HasSampleDurations() )
+            {
+                this->impl->_sampleDuration.push_back( stream.ReadBigEndianUInt32() );
+            }
+
+            if( this->HasSampleSizes() )
+            {
+                this->impl->_sampleSize.push_back( stream.ReadBigEndianUInt32() );
+            }
+
+            if( this->HasSampleFlags() )
+            {
+                this->impl->_sampleFlags.push_back( stream.ReadBigEndianUInt32() );
+            }
+
+            if( this->HasSampleCompositionTimeOffsets() )
+            {
+                this->impl->_sampleCompositionTimeOffset.push_back( static_cast< int32_t >( stream.ReadBigEndianUInt32() ) );
+            }
+        }
+    }
+
+    uint64_t TRUN::GetDataSize() const
+    {
+        uint64_t size( FullBox::GetDataSize() + 4 );
+        uint64_t sample( 0 );
+
+        size   += ( this->HasDataOffset() )                   ? 4 : 0;
+        size   += ( this->HasFirstSampleFlags() )             ? 4 : 0;
+        sample += ( this->HasSampleDurations() )              ? 4 : 0;
+        sample += ( this->HasSampleSizes() )                  ? 4 : 0;
+        sample += ( this->HasSampleFlags() )                  ? 4 : 0;
+        sample += ( this->HasSampleCompositionTimeOffsets() ) ? 4 : 0;
+
+        return size + sample * this->impl->_sampleCount;
+    }
+
+    void TRUN::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+
+        stream.WriteBigEndianUInt32( this->impl->_sampleCount );
+
+        if( this->HasDataOffset() )
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_dataOffset ) );
+        }
+
+        if( this->HasFirstSampleFlags() )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_firstSampleFlags );
+        }
+
+        for( size_t i = 0; i < this->impl->_sampleCount; i++ )
+        {
+            if( this->HasSampleDurations() )
+            {
+                stream.WriteBigEndianUInt32( this->impl->_sampleDuration[ i ] );
+            }
+
+            if( this->HasSampleSizes() )
+            {
+                stream.WriteBigEndianUInt32( this->impl->_sampleSize[ i ] );
+            }
+
+            if( this->HasSampleFlags() )
+            {
+                stream.WriteBigEndianUInt32( this->impl->_sampleFlags[ i ] );
+            }
+
+            if( this->HasSampleCompositionTimeOffsets() )
+            {
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sampleCompositionTimeOffset[ i ] ) );
+            }
+        }
+    }
+
+    std::vector< std::pair< std::string, std::string > > TRUN::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+
+        props.push_back( { "Sample count", std::to_string( this->GetSampleCount() ) } );
+
+        if( this->HasDataOffset() )
+        {
+            props.push_back( { "Data offset", std::to_string( this->GetDataOffset() ) } );
+        }
+
+        if( this->HasFirstSampleFlags() )
+        {
+            props.push_back( { "First sample flags", std::to_string( this->GetFirstSampleFlags() ) } );
+        }
+
+        for( unsigned int index = 0; index < this->GetSampleCount(); index++ )
+        {
+            if( this->HasSampleDurations() )
+            {
+                props.push_back( { "Sample duration", std::to_string( this->GetSampleDuration( index ) ) } );
+            }
+
+            if( this->HasSampleSizes() )
+            {
+                props.push_back( { "Sample size", std::to_string( this->GetSampleSize( index ) ) } );
+            }
+
+            if( this->HasSampleFlags() )
+            {
+                props.push_back( { "Sample flags", std::to_string( this->GetSampleFlags( index ) ) } );
+            }
+
+            if( this->HasSampleCompositionTimeOffsets() )
+            {
+                props.push_back( { "Sample composition time offset", std::to_string( this->GetSampleCompositionTimeOffset( index ) ) } );
+            }
+        }
+
+        return props;
+    }
+
+    bool TRUN::HasDataOffset() const
+    {
+        return ( this->GetFlags() & 0x000001 ) != 0;
+    }
+
+    bool TRUN::HasFirstSampleFlags() const
+    {
+        return ( this->GetFlags() & 0x000004 ) != 0;
+    }
+
+    bool TRUN::HasSampleDurations() const
+    {
+        return ( this->GetFlags() & 0x000100 ) != 0;
+    }
+
+    bool TRUN::HasSampleSizes() const
+    {
+        return ( this->GetFlags() & 0x000200 ) != 0;
+    }
+
+    bool TRUN::HasSampleFlags() const
+    {
+        return ( this->GetFlags() & 0x000400 ) != 0;
+    }
+
+    bool TRUN::HasSampleCompositionTimeOffsets() const
+    {
+        return ( this->GetFlags() & 0x000800 ) != 0;
+    }
+
+    uint32_t TRUN::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+
+    int32_t TRUN::GetDataOffset() const
+    {
+        return this->impl->_dataOffset;
+    }
+
+    uint32_t TRUN::GetFirstSampleFlags() const
+    {
+        return this->impl->_firstSampleFlags;
+    }
+
+    uint32_t TRUN::GetSampleDuration( size_t index ) const
+    {
+        return ( index < this->impl->_sampleDuration.size() ) ? this->impl->_sampleDuration[ index ] : 0;
+    }
+
+    uint32_t TRUN::GetSampleSize( size_t index ) const
+    {
+        return ( index < this->impl->_sampleSize.size() ) ? this->impl->_sampleSize[ index ] : 0;
+    }
+
+    uint32_t TRUN::GetSampleFlags( size_t index ) const
+    {
+        return ( index < this->impl->_sampleFlags.size() ) ? this->impl->_sampleFlags[ index ] : 0;
+    }
+
+    int32_t TRUN::GetSampleCompositionTimeOffset( size_t index ) const
+    {
+        return ( index < this->impl->_sampleCompositionTimeOffset.size() ) ? this->impl->_sampleCompositionTimeOffset[ index ] : 0;
+    }
+
+    TRUN::IMPL::IMPL():
+        _sampleCount( 0 ),
+        _dataOffset( 0 ),
+        _firstSampleFlags( 0 )
+    {}
+
+    TRUN::IMPL::IMPL( const IMPL & o ):
+        _sampleCount( o._sampleCount ),
+        _dataOffset( o._dataOffset ),
+        _firstSampleFlags( o._firstSampleFlags ),
+        _sampleDuration( o._sampleDuration ),
+        _sampleSize( o._sampleSize ),
+        _sampleFlags( o._sampleFlags ),
+        _sampleCompositionTimeOffset( o._sampleCompositionTimeOffset )
+    {}
+
+    TRUN::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,282 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ThreadPoolExecutor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ThreadPoolExecutor.hpp>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+namespace ISOBMFF
+{
+    class ThreadPoolExecutor::IMPL
+    {
+        public:
+            
+            class Queue
+            {
+                public:
+                    
+                    std::mutex                            _mutex;
+                    std::deque< std::function< void() > > _tasks;
+            };
+            
+            IMPL( size_t threads );
+            ~IMPL();
+            
+            void Run( size_t index );
+            bool Pop( size_t index, std::function< void() > & task );
+            void Report( std::exception_ptr e );
+            
+            std::vector< std::unique_ptr< Queue > >     _queues;
+            std::vector< std::thread >                  _threads;
+            std::atomic< size_t >                       _next;
+            std::mutex                                  _mutex;
+            std::condition_variable                     _cv;
+            size_t                                      _pending;
+            bool                                        _stop;
+            std::function< void( std::exception_ptr ) > _handler;
+            std::exception_ptr                          _exception;
+    };
+    
+    static thread_local const void * CurrentPool  = nullptr;
+    static thread_local size_t       CurrentIndex = 0;
+    
+    ThreadPoolExecutor::ThreadPoolExecutor( size_t threads ):
+        impl( std::make_unique< IMPL >( threads ) )
+    {}
+    
+    ThreadPoolExecutor::~ThreadPoolExecutor()
+    {}
+    
+    void ThreadPoolExecutor::Submit( const std::function< void() > & task )
+    {
+        size_t index;
+        
+        if( CurrentPool == this->impl.get() )
+        {
+            index = CurrentIndex;
+        }
+        else
+        {
+            index = this->impl->_next++ % this->impl->_queues.size();
+        }
+        
+        /*
+         * The task is counted while it is queued, so a worker popping it
+         * right away never decrements the counter before it was incremented.
+         */
+        {
+            std::lock_guard< std::mutex > l1( this->impl->_mutex );
+            std::lock_guard< std::mutex > l2( this->impl->_queues[ index ]->_mutex );
+            
+            this->impl->_queues[ index ]->_tasks.push_back( task );
+            this->impl->_pending++;
+        }
+        
+        this->impl->_cv.notify_one();
+    }
+    
+    void ThreadPoolExecutor::SetExceptionHandler( const std::function< void( std::exception_ptr ) > & handler )
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mutex );
+        
+        this->impl->_handler = handler;
+    }
+    
+    std::exception_ptr ThreadPoolExecutor::TakeException()
+    {
+        std::lock_guard< std::mutex > l( this->impl->_mutex );
+        std::exception_ptr            e( this->impl->_exception );
+        
+        this->impl->_exception = nullptr;
+        
+        return e;
+    }
+    
+    size_t ThreadPoolExecutor::GetConcurrency() const
+    {
+        return this->impl->_threads.size();
+    }
+    
+    ThreadPoolExecutor::IMPL::IMPL( size_t threads ):
+        _next( 0 ),
+        _pending( 0 ),
+        _stop( false )
+    {
+        if( threads == 0 )
+        {
+            threads = std::max( std::thread::hardware_concurrency(), 1U );
+        }
+        
+        for( size_t i = 0; i < threads; i++ )
+        {
+            this->_queues.push_back( std::make_unique< Queue >() );
+        }
+        
+        for( size_t i = 0; i < threads; i++ )
+        {
+            this->_threads.emplace_back( [ = ] { this->Run( i ); } );
+        }
+    }
+    
+    ThreadPoolExecutor::IMPL::~IMPL()
+    {
+        {
+            std::lock_guard< std::mutex > l( this->_mutex );
+            
+            this->_stop = true;
+        }
+        
+        this->_cv.notify_all();
+        
+        for( auto & thread: this->_threads )
+        {
+            thread.join();
+        }
+    }
+    
+    void ThreadPoolExecutor::IMPL::Run( size_t index )
+    {
+        CurrentPool  = this;
+        CurrentIndex = index;
+        
+        while( true )
+        {
+            std::function< void() > task;
+            
+            if( this->Pop( index, task ) )
+            {
+                {
+                    std::lock_guard< std::mutex > l( this->_mutex );
+                    
+                    this->_pending--;
+                }
+                
+                try
+                {
+                    task();
+                }
+                catch( ... )
+                {
+                    this->Report( std::current_exception() );
+                }
+                
+                continue;
+            }
+            
+            {
+                std::unique_lock< std::mutex > l( this->_mutex );
+                
+                this->_cv.wait( l, [ & ] { return this->_stop || this->_pending > 0; } );
+                
+                if( this->_stop && this->_pending == 0 )
+                {
+                    break;
+                }
+            }
+        }
+        
+        CurrentPool = nullptr;
+    }
+    
+    bool ThreadPoolExecutor::IMPL::Pop( size_t index, std::function< void() > & task )
+    {
+        {
+            std::lock_guard< std::mutex > l( this->_queues[ index ]->_mutex );
+            
+            if( this->_queues[ index ]->_tasks.empty() == false )
+            {
+                task = std::move( this->_queues[ index ]->_tasks.back() );
+                
+                this->_queues[ index ]->_tasks.pop_back();
+                
+                return true;
+            }
+        }
+        
+        for( size_t i = 1; i < this->_queues.size(); i++ )
+        {
+            Queue & queue = *( this->_queues[ ( index + i ) % this->_queues.size() ] );
+            
+            std::lock_guard< std::mutex > l( queue._mutex );
+            
+            if( queue._tasks.empty() == false )
+            {
+                task = std::move( queue._tasks.front() );
+                
+                queue._tasks.pop_front();
+                
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    void ThreadPoolExecutor::IMPL::Report( std::exception_ptr e )
+    {
+        std::function< void( std::exception_ptr ) > handler;
+        
+        {
+            std::lock_guard< std::mutex > l( this->_mutex );
+            
+            if( this->_handler == nullptr )
+            {
+                if( this->_exception == nullptr )
+                {
+                    this->_exception = e;
+                }
+                
+                return;
+            }
+            
+            handler = this->_handler;
+        }
+        
+        try
+        {
+            handler( e );
+        }
+        catch( ... )
+        {
+            std::lock_guard< std::mutex > l( this->_mutex );
+            
+            if( this->_exception == nullptr )
+            {
+                this->_exception = std::current_exception();
+            }
+        }
+    }
+}
@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ThumbnailProbe.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ThumbnailProbe.hpp>
+#include <ISOBMFF/ItemGraph.hpp>
+#include <ISOBMFF/HEIFSummary.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class ThumbnailProbe::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void Load( BinaryStream & stream );
+            
+            std::shared_ptr< META >          _meta;
+            ItemReader                       _reader;
+            uint32_t                         _primaryItemID;
+            uint32_t                         _itemID;
+            std::string                      _itemType;
+            std::shared_ptr< HVCC >          _hvcc;
+            std::shared_ptr< ISPE >          _ispe;
+            std::vector< ItemReader::Range > _ranges;
+    };
+    
+    ThumbnailProbe::ThumbnailProbe( const std::string & path ):
+        impl( std::make_unique< IMPL >() )
+    {
+        BinaryFileStream stream( path );
+        
+        this->impl->Load( stream );
+    }
+    
+    ThumbnailProbe::ThumbnailProbe( BinaryStream & stream ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->impl->Load( stream );
+    }
+    
+    ThumbnailProbe::ThumbnailProbe( const ThumbnailProbe & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ThumbnailProbe::ThumbnailProbe( ThumbnailProbe && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ThumbnailProbe::~ThumbnailProbe()
+    {}
+    
+    ThumbnailProbe & ThumbnailProbe::operator =( ThumbnailProbe o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ThumbnailProbe & o1, ThumbnailProbe & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::shared_ptr< META > ThumbnailProbe::GetMETA() const
+    {
+        return this->impl->_meta;
+    }
+    
+    uint32_t ThumbnailProbe::GetPrimaryItemID() const
+    {
+        return this->impl->_primaryItemID;
+    }
+    
+    bool ThumbnailProbe::HasThumbnail() const
+    {
+        return this->impl->_itemID != 0;
+    }
+    
+    uint32_t ThumbnailProbe::GetItemID() const
+    {
+        return this->impl->_itemID;
+    }
+    
+    std::string ThumbnailProbe::GetItemType() const
+    {
+        return this->impl->_itemType;
+    }
+    
+    std::shared_ptr< HVCC > ThumbnailProbe::GetHVCC() const
+    {
+        return this->impl->_hvcc;
+    }
+    
+    std::shared_ptr< ISPE > ThumbnailProbe::GetISPE() const
+    {
+        return this->impl->_ispe;
+    }
+    
+    const std::vector< ItemReader::Range > & ThumbnailProbe::GetRanges() const
+    {
+        return this->impl->_ranges;
+    }
+    
+    std::vector< uint8_t > ThumbnailProbe::ReadData( BinaryStream & stream ) const
+    {
+        if( this->HasThumbnail() == false )
+        {
+            throw std::runtime_error( "No thumbnail for the primary item" );
+        }
+        
+        return this->impl->_reader.ReadItem( this->impl->_itemID, stream );
+    }
+    
+    ThumbnailProbe::IMPL::IMPL():
+        _primaryItemID( 0 ),
+        _itemID(        0 )
+    {}
+    
+    ThumbnailProbe::IMPL::IMPL( const IMPL & o ):
+        _meta(          o._meta ),
+        _reader(        o._reader ),
+        _primaryItemID( o._primaryItemID ),
+        _itemID(        o._itemID ),
+        _itemType(      o._itemType ),
+        _hvcc(          o._hvcc ),
+        _ispe(          o._ispe ),
+        _ranges(        o._ranges )
+    {}
+    
+    ThumbnailProbe::IMPL::~IMPL()
+    {}
+    
+    void ThumbnailProbe::IMPL::Load( BinaryStream & stream )
+    {
+        uint64_t offset;
+        uint64_t size;
+        
+        if( HEIFSummary::FindMETA( stream, offset, size ) )
+        {
+            Parser                 parser;
+            std::shared_ptr< Box > box( parser.CreateBox( "meta" ) );
+            uint64_t               header;
+            
+            stream.Seek( offset, BinaryStream::SeekDirection::Begin );
+            
+            header = ( stream.ReadBigEndianUInt32() == 1 ) ? 16 : 8;
+            
+            stream.Seek( offset + header, BinaryStream::SeekDirection::Begin );
+            box->SetSourceRange( offset, size, header );
+            
+            {
+                BinaryDataStream content( stream.Read( static_cast< size_t >( size - header ) ) );
+                
+                box->ReadData( parser, content );
+            }
+            
+            this->_meta = std::dynamic_pointer_cast< META >( box );
+        }
+        
+        if( this->_meta == nullptr )
+        {
+            throw std::runtime_error( "Invalid file - No META box" );
+        }
+        
+        {
+            ItemGraph               graph( *( this->_meta ) );
+            std::vector< uint32_t > thumbnails;
+            
+            this->_reader        = ItemReader( *( this->_meta ) );
+            this->_primaryItemID = graph.GetPrimaryItemID();
+            thumbnails           = graph.GetReferencingItems( this->_primaryItemID, "thmb" );
+            
+            if( thumbnails.size() == 0 )
+            {
+                return;
+            }
+            
+            this->_itemID   = thumbnails[ 0 ];
+            this->_itemType = graph.GetItemType( this->_itemID );
+            this->_hvcc     = graph.GetTypedProperty< HVCC >( this->_itemID, "hvcC" );
+            this->_ispe     = graph.GetTypedProperty< ISPE >( this->_itemID, "ispe" );
+            this->_ranges   = this->_reader.GetRanges( this->_itemID );
+        }
+    }
+}
@@ -0,0 +1,233 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Track.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Track.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/HDLR.hpp>
+#include <ISOBMFF/STSD.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Track::IMPL
+    {
+        public:
+            
+            IMPL( std::shared_ptr< ContainerBox > trak );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::shared_ptr< ContainerBox > _trak;
+            std::shared_ptr< TKHD >         _tkhd;
+            std::shared_ptr< MDHD >         _mdhd;
+            std::shared_ptr< HDLR >         _hdlr;
+            std::shared_ptr< Box >          _sampleEntry;
+            std::shared_ptr< AVCC >         _avcc;
+            std::shared_ptr< HVCC >         _hvcc;
+            SampleTable                     _sampleTable;
+    };
+    
+    Track::Track( std::shared_ptr< ContainerBox > trak ):
+        impl( std::make_unique< IMPL >( trak ) )
+    {}
+    
+    Track::Track( const Track & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Track::Track( Track && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Track::~Track()
+    {}
+    
+    Track & Track::operator =( Track o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Track & o1, Track & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::vector< Track > Track::GetTracks( const Container & moov )
+    {
+        std::vector< Track > tracks;
+        
+        for( const auto & box: moov.GetBoxes( "trak" ) )
+        {
+            std::shared_ptr< ContainerBox > trak( std::dynamic_pointer_cast< ContainerBox >( box ) );
+            
+            if( trak != nullptr )
+            {
+                tracks.emplace_back( trak );
+            }
+        }
+        
+        return tracks;
+    }
+    
+    std::shared_ptr< ContainerBox > Track::GetTRAK() const
+    {
+        return this->impl->_trak;
+    }
+    
+    uint32_t Track::GetTrackID() const
+    {
+        return this->impl->_tkhd->GetTrackID();
+    }
+    
+    std::string Track::GetHandlerType() const
+    {
+        return this->impl->_hdlr->GetHandlerType();
+    }
+    
+    uint32_t Track::GetTimescale() const
+    {
+        return this->impl->_mdhd->GetTimescale();
+    }
+    
+    uint64_t Track::GetDuration() const
+    {
+        return this->impl->_mdhd->GetDuration();
+    }
+    
+    std::shared_ptr< Box > Track::GetSampleEntry() const
+    {
+        return this->impl->_sampleEntry;
+    }
+    
+    std::string Track::GetCodec() const
+    {
+        return ( this->impl->_sampleEntry != nullptr ) ? this->impl->_sampleEntry->GetName() : "";
+    }
+    
+    std::shared_ptr< AVCC > Track::GetAVCC() const
+    {
+        return this->impl->_avcc;
+    }
+    
+    std::shared_ptr< HVCC > Track::GetHVCC() const
+    {
+        return this->impl->_hvcc;
+    }
+    
+    const SampleTable & Track::GetSampleTable() const
+    {
+        return this->impl->_sampleTable;
+    }
+    
+    uint8_t Track::GetNALUnitLengthSize() const
+    {
+        if( this->impl->_avcc != nullptr )
+        {
+            return static_cast< uint8_t >( this->impl->_avcc->GetLengthSizeMinusOne() + 1 );
+        }
+        
+        if( this->impl->_hvcc != nullptr )
+        {
+            return static_cast< uint8_t >( this->impl->_hvcc->GetLengthSizeMinusOne() + 1 );
+        }
+        
+        return 0;
+    }
+    
+    Track::IMPL::IMPL( std::shared_ptr< ContainerBox > trak ):
+        _trak( trak )
+    {
+        std::shared_ptr< ContainerBox > mdia;
+        std::shared_ptr< ContainerBox > minf;
+        std::shared_ptr< ContainerBox > stbl;
+        std::shared_ptr< STSD >         stsd;
+        
+        if( trak == nullptr )
+        {
+            throw std::runtime_error( "Invalid track - No TRAK box" );
+        }
+        
+        this->_tkhd = trak->GetTypedBox< TKHD >( "tkhd" );
+        mdia        = trak->GetTypedBox< ContainerBox >( "mdia" );
+        minf        = ( mdia != nullptr ) ? mdia->GetTypedBox< ContainerBox >( "minf" ) : nullptr;
+        stbl        = ( minf != nullptr ) ? minf->GetTypedBox< ContainerBox >( "stbl" ) : nullptr;
+        
+        if( this->_tkhd == nullptr || mdia == nullptr || stbl == nullptr )
+        {
+            throw std::runtime_error( "Invalid track - Missing TKHD, MDIA or STBL box" );
+        }
+        
+        this->_mdhd = mdia->GetTypedBox< MDHD >( "mdhd" );
+        this->_hdlr = mdia->GetTypedBox< HDLR >( "hdlr" );
+        
+        if( this->_mdhd == nullptr || this->_hdlr == nullptr )
+        {
+            throw std::runtime_error( "Invalid track - Missing MDHD or HDLR box" );
+        }
+        
+        stsd               = stbl->GetTypedBox< STSD >( "stsd" );
+        this->_sampleTable = SampleTable( *( stbl ) );
+        
+        if( stsd != nullptr && stsd->GetBoxes().size() > 0 )
+        {
+            const Container * entry;
+            
+            this->_sampleEntry = stsd->GetBoxes()[ 0 ];
+            entry              = dynamic_cast< const Container * >( this->_sampleEntry.get() );
+            
+            if( entry != nullptr )
+            {
+                this->_avcc = entry->GetTypedBox< AVCC >( "avcC" );
+                this->_hvcc = entry->GetTypedBox< HVCC >( "hvcC" );
+            }
+        }
+    }
+    
+    Track::IMPL::IMPL( const IMPL & o ):
+        _trak( o._trak ),
+        _tkhd( o._tkhd ),
+        _mdhd( o._mdhd ),
+        _hdlr( o._hdlr ),
+        _sampleEntry( o._sampleEntry ),
+        _avcc( o._avcc ),
+        _hvcc( o._hvcc ),
+        _sampleTable( o._sampleTable )
+    {}
+    
+    Track::IMPL::~IMPL()
+    {}
+}
@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/URL.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class URL::IMPL
+    class URL::IMPL: public ResourceAllocated
     {
         public:
             
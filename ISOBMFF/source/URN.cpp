@@ -29,10 +29,11 @@
  */
 
 #include <ISOBMFF/URN.hpp>
+#include <ISOBMFF/MemoryResource.hpp>
 
 namespace ISOBMFF
 {
-    class URN::IMPL
+    class URN::IMPL: public ResourceAllocated
     {
         public:
             